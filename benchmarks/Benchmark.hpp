@@ -0,0 +1,98 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+
+namespace tbf::bench {
+
+template <typename Type>
+[[gnu::always_inline]]
+inline void DoNotOptimize(const Type& value) noexcept {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+[[gnu::always_inline]]
+inline void ClobberMemory() noexcept {
+    asm volatile("" : : : "memory");
+}
+
+struct Result {
+    double ns_per_op;
+    uint64_t iterations;
+};
+
+// Runs `func` in batches of doubling size until the batch takes at least `min_time_ms`, and reports
+// the time per call of the last batch. `func` must perform one operation per call.
+template <typename Func>
+Result Run(Func&& func, double min_time_ms = 200.0) noexcept {
+    using Clock = std::chrono::steady_clock;
+
+    uint64_t iterations = 1;
+    while (true) {
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < iterations; ++i) {
+            func();
+            ClobberMemory();
+        }
+        double elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        if (elapsed_ms >= min_time_ms || iterations >= (1ull << 40)) {
+            return {.ns_per_op = elapsed_ms * 1e6 / static_cast<double>(iterations), .iterations = iterations};
+        }
+
+        iterations *= 2;
+    }
+}
+
+// Repeats Run and keeps the fastest result, for operations of a few nanoseconds where scheduling
+// noise would otherwise dominate.
+template <typename Func>
+Result RunBest(Func&& func, uint32_t repetitions = 5, double min_time_ms = 50.0) noexcept {
+    Result best = Run(func, min_time_ms);
+    for (uint32_t i = 1; i < repetitions; ++i) {
+        Result result = Run(func, min_time_ms);
+        if (result.ns_per_op < best.ns_per_op) {
+            best = result;
+        }
+    }
+    return best;
+}
+
+inline void PrintHeader(std::string_view title) noexcept {
+    std::printf("\n%.*s\n", static_cast<int>(title.size()), title.data());
+    std::printf("%-48s %14s %14s\n", "benchmark", "ns/op", "iterations");
+}
+
+inline void PrintResult(std::string_view name, const Result& result) noexcept {
+    std::printf("%-48.*s %14.2f %14llu\n", static_cast<int>(name.size()), name.data(), result.ns_per_op,
+                static_cast<unsigned long long>(result.iterations));
+}
+
+}  // namespace tbf::bench
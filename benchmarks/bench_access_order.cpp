@@ -0,0 +1,125 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+// Measures the per-field cost of reading every field of an object in wire order, in reverse and in
+// a shuffled order, for each index mode. The first pass includes constructing the Reader and
+// parsing the object, the warm pass only the lookups on an object that was already read.
+
+#include "Benchmark.hpp"
+#include "tbf/DataTag.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+struct Message {
+    Writer writer;
+    std::vector<std::string> names;
+    std::vector<DataTag> tags;
+
+    explicit Message(bool name_based) : writer(name_based) {}
+};
+
+void BuildMessage(Message& message, bool name_based, uint32_t field_count) {
+    message.names.reserve(field_count);
+    for (uint32_t i = 0; i < field_count; ++i) {
+        message.names.push_back("field_" + std::to_string(i));
+        message.tags.push_back(name_based ? DataTag(std::string_view(message.names.back())) : DataTag(static_cast<DataTag::Id>(i + 1)));
+        message.writer.RootObject().FieldInt32(message.tags.back(), static_cast<int32_t>(i));
+    }
+    message.writer.Finish();
+}
+
+void BenchmarkOrder(Message& message, bool name_based, IndexMode mode, const std::vector<uint32_t>& order, const std::string& label) {
+    auto result = bench::RunBest([&] {
+        Reader reader(message.writer.Data(), message.writer.Size(), name_based, mode);
+        const ObjectReader& root = reader.RootObject();
+        for (uint32_t index : order) {
+            bench::DoNotOptimize(root.ReadInt32(message.tags[index]));
+        }
+    });
+    result.ns_per_op /= order.size();
+    bench::PrintResult(label + ", first pass", result);
+
+    Reader reader(message.writer.Data(), message.writer.Size(), name_based, mode);
+    const ObjectReader& root = reader.RootObject();
+    for (const DataTag& tag : message.tags) {
+        bench::DoNotOptimize(root.ReadInt32(tag));
+    }
+
+    auto warm = bench::RunBest([&] {
+        for (uint32_t index : order) {
+            bench::DoNotOptimize(root.ReadInt32(message.tags[index]));
+        }
+    });
+    warm.ns_per_op /= order.size();
+    bench::PrintResult(label + ", warm", warm);
+}
+
+}  // namespace
+
+int main() {
+    const struct {
+        const char* label;
+        IndexMode mode;
+    } modes[] = {
+        {"eager", IndexMode::Eager},
+        {"lazy", IndexMode::Lazy},
+        {"document", IndexMode::Document},
+    };
+
+    for (bool name_based : {true, false}) {
+        for (uint32_t field_count : {8u, 64u}) {
+            Message message(name_based);
+            BuildMessage(message, name_based, field_count);
+
+            std::vector<uint32_t> in_order(field_count);
+            for (uint32_t i = 0; i < field_count; ++i) {
+                in_order[i] = i;
+            }
+            std::vector<uint32_t> reverse(in_order.rbegin(), in_order.rend());
+            std::vector<uint32_t> shuffled = in_order;
+            std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(7));
+
+            bench::PrintHeader(std::string(name_based ? "Name-based" : "ID-based") + " object of " + std::to_string(field_count) + " fields (per field)");
+
+            for (const auto& mode : modes) {
+                BenchmarkOrder(message, name_based, mode.mode, in_order, std::string(mode.label) + " in order");
+                BenchmarkOrder(message, name_based, mode.mode, reverse, std::string(mode.label) + " reverse");
+                BenchmarkOrder(message, name_based, mode.mode, shuffled, std::string(mode.label) + " shuffled");
+            }
+        }
+    }
+
+    return 0;
+}
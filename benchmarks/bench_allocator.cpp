@@ -0,0 +1,185 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+// Compares the allocation count and wall time of reading every object of a deep and a wide
+// document when the object indexes are allocated from the global heap, from the arena owned by
+// the Reader, and from a caller supplied pool resource.
+
+#include "Benchmark.hpp"
+#include "tbf/DataTag.hpp"
+#include "tbf/FieldIndex.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <string>
+
+static size_t g_allocation_count = 0;
+
+void* operator new(std::size_t size) {
+    g_allocation_count++;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+// std::pmr::new_delete_resource allocates through the aligned overloads
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    g_allocation_count++;
+    size_t align = static_cast<size_t>(alignment);
+    if (void* ptr = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+using namespace tbf;
+
+namespace {
+
+// Enough fields per object to leave the inline storage and allocate a table
+constexpr uint32_t FIELDS_PER_OBJECT = FieldIndex::INLINE_CAPACITY + 4;
+constexpr uint32_t DEEP_LEVELS = 1000;
+constexpr uint32_t WIDE_ELEMENTS = 10000;
+
+constexpr DataTag TAG_CHILD = DataTag(1000, "child");
+constexpr DataTag TAG_ELEMENTS = DataTag(1001, "elements");
+
+void WriteFields(ObjectWriter& object, uint32_t value) {
+    for (uint32_t i = 1; i <= FIELDS_PER_OBJECT; ++i) {
+        object.FieldInt32(DataTag(static_cast<DataTag::Id>(i)), static_cast<int32_t>(value + i));
+    }
+}
+
+void WriteDeep(ObjectWriter& object, uint32_t depth) {
+    WriteFields(object, depth);
+    if (depth > 1) {
+        auto child = object.FieldObject(TAG_CHILD);
+        WriteDeep(child, depth - 1);
+        child.Finish();
+    }
+}
+
+void WriteWide(Writer& writer) {
+    auto elements = writer.RootObject().FieldObjectArray(TAG_ELEMENTS);
+    for (uint32_t i = 0; i < WIDE_ELEMENTS; ++i) {
+        auto element = elements.CreateElement();
+        WriteFields(element, i);
+        element.Finish();
+    }
+    elements.Finish();
+}
+
+int64_t ReadDeep(const ObjectReader& object) {
+    int64_t sum = object.ReadInt32(DataTag(static_cast<DataTag::Id>(FIELDS_PER_OBJECT))).value_or(0);
+    auto child = object.ReadObject(TAG_CHILD);
+    if (child.has_value()) {
+        sum += ReadDeep(*child);
+    }
+    return sum;
+}
+
+int64_t ReadWide(const ObjectReader& root) {
+    int64_t sum = 0;
+    auto elements = root.ReadObjectArray(TAG_ELEMENTS);
+    for (const auto& element : *elements) {
+        sum += element.ReadInt32(DataTag(static_cast<DataTag::Id>(FIELDS_PER_OBJECT))).value_or(0);
+    }
+    return sum;
+}
+
+template <typename ReadFunc>
+void BenchmarkDocument(Writer& writer, ReadFunc&& read, const char* document) {
+    std::pmr::unsynchronized_pool_resource pool;
+
+    struct Config {
+        const char* label;
+        std::pmr::memory_resource* resource;
+    };
+    const Config configs[] = {
+        {"default heap", std::pmr::get_default_resource()},
+        {"reader arena", nullptr},
+        {"pool resource", &pool},
+    };
+
+    for (const Config& config : configs) {
+        auto read_document = [&] {
+            Reader reader(writer.Data(), writer.Size(), false, IndexMode::Eager, config.resource);
+            bench::DoNotOptimize(read(reader.RootObject()));
+        };
+
+        // Warm up the pool so it reports its steady state
+        read_document();
+
+        size_t allocations_before = g_allocation_count;
+        read_document();
+        size_t allocations = g_allocation_count - allocations_before;
+
+        auto result = bench::Run(read_document);
+        std::string name = std::string(document) + " " + config.label;
+        bench::PrintResult(name, result);
+        std::printf("%-48s %14zu\n", "  global allocations per document", allocations);
+    }
+}
+
+}  // namespace
+
+int main() {
+    bench::PrintHeader("Object index allocation (" + std::to_string(FIELDS_PER_OBJECT) + " fields per object)");
+
+    Writer deep(false);
+    WriteDeep(deep.RootObject(), DEEP_LEVELS);
+    deep.Finish();
+    BenchmarkDocument(deep, ReadDeep, "deep (1000 levels)");
+
+    Writer wide(false);
+    WriteWide(wide);
+    wide.Finish();
+    BenchmarkDocument(wide, ReadWide, "wide (10000 elements)");
+
+    return 0;
+}
@@ -0,0 +1,161 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+// Measures random access by index into String and Object arrays of 100k elements, against
+// iterating the same arrays in order. The first lookup on a plain array reader pays for building its
+// offset table, so the random access results include it. Indexed arrays store that table, which
+// the last section compares by opening readers on both layouts.
+
+#include "Benchmark.hpp"
+#include "tbf/DataTag.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+constexpr uint32_t ELEMENT_COUNT = 100000;
+constexpr uint32_t LOOKUP_COUNT = 1000;
+
+constexpr DataTag TAG_NAMES = DataTag(1, "names");
+constexpr DataTag TAG_SAMPLES = DataTag(2, "samples");
+constexpr DataTag TAG_VALUE = DataTag(3, "value");
+constexpr DataTag TAG_INDEXED_NAMES = DataTag(4, "indexed_names");
+constexpr DataTag TAG_INDEXED_SAMPLES = DataTag(5, "indexed_samples");
+
+void WriteArrays(ObjectWriter& root, const DataTag& names_tag, const DataTag& samples_tag, ArrayLayout layout) {
+    auto names = root.FieldStringArray(names_tag, layout);
+    for (uint32_t i = 0; i < ELEMENT_COUNT; ++i) {
+        names.AddElement("name_" + std::to_string(i));
+    }
+    names.Finish();
+
+    auto samples = root.FieldObjectArray(samples_tag, layout);
+    for (uint32_t i = 0; i < ELEMENT_COUNT; ++i) {
+        auto sample = samples.CreateElement();
+        sample.FieldUInt32(TAG_VALUE, i);
+        sample.Finish();
+    }
+    samples.Finish();
+}
+
+}  // namespace
+
+int main() {
+    Writer writer(false);
+    WriteArrays(writer.RootObject(), TAG_NAMES, TAG_SAMPLES, ArrayLayout::Plain);
+    WriteArrays(writer.RootObject(), TAG_INDEXED_NAMES, TAG_INDEXED_SAMPLES, ArrayLayout::Indexed);
+    writer.Finish();
+
+    Reader reader(writer.Data(), writer.Size(), false);
+    const ObjectReader& root = reader.RootObject();
+
+    std::vector<uint32_t> indexes(LOOKUP_COUNT);
+    std::mt19937 rng(7);
+    for (uint32_t& index : indexes) {
+        index = rng() % ELEMENT_COUNT;
+    }
+
+    bench::PrintHeader(std::to_string(LOOKUP_COUNT) + " random lookups into arrays of " + std::to_string(ELEMENT_COUNT) + " elements (per lookup)");
+
+    for (ArrayLayout layout : {ArrayLayout::Plain, ArrayLayout::Indexed}) {
+        const bool indexed_layout = layout == ArrayLayout::Indexed;
+        const DataTag& names_tag = indexed_layout ? TAG_INDEXED_NAMES : TAG_NAMES;
+        const DataTag& samples_tag = indexed_layout ? TAG_INDEXED_SAMPLES : TAG_SAMPLES;
+        const std::string suffix = indexed_layout ? " (indexed)" : " (plain)";
+
+        auto strings = bench::RunBest([&] {
+            auto names = root.ReadStringArray(names_tag);
+            size_t length = 0;
+            for (uint32_t index : indexes) {
+                length += names->GetElement(index).value_or("").size();
+            }
+            bench::DoNotOptimize(length);
+        });
+        strings.ns_per_op /= LOOKUP_COUNT;
+        bench::PrintResult("StringArray GetElement" + suffix, strings);
+
+        auto objects = bench::RunBest([&] {
+            auto samples = root.ReadObjectArray(samples_tag);
+            uint64_t sum = 0;
+            for (uint32_t index : indexes) {
+                sum += samples->GetElement(index)->ReadUInt32(TAG_VALUE).value_or(0);
+            }
+            bench::DoNotOptimize(sum);
+        });
+        objects.ns_per_op /= LOOKUP_COUNT;
+        bench::PrintResult("ObjectArray GetElement" + suffix, objects);
+    }
+
+    bench::PrintHeader("Sequential access over " + std::to_string(ELEMENT_COUNT) + " elements (per element)");
+
+    auto indexed = bench::RunBest([&] {
+        auto samples = root.ReadObjectArray(TAG_SAMPLES);
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < samples->Size(); ++i) {
+            sum += samples->GetElement(i)->ReadUInt32(TAG_VALUE).value_or(0);
+        }
+        bench::DoNotOptimize(sum);
+    });
+    indexed.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("ObjectArray GetElement(i) loop", indexed);
+
+    auto iterated = bench::RunBest([&] {
+        auto samples = root.ReadObjectArray(TAG_SAMPLES);
+        uint64_t sum = 0;
+        for (const auto& sample : *samples) {
+            sum += sample.ReadUInt32(TAG_VALUE).value_or(0);
+        }
+        bench::DoNotOptimize(sum);
+    });
+    iterated.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("ObjectArray iterator", iterated);
+
+    bench::PrintHeader("Opening a StringArray of " + std::to_string(ELEMENT_COUNT) + " elements and reading its size");
+
+    auto open_plain = bench::RunBest([&] {
+        bench::DoNotOptimize(root.ReadStringArray(TAG_NAMES)->Size());
+    });
+    bench::PrintResult("Plain, checked", open_plain);
+
+    auto open_indexed = bench::RunBest([&] {
+        bench::DoNotOptimize(root.ReadStringArray(TAG_INDEXED_NAMES)->Size());
+    });
+    bench::PrintResult("Indexed, checked", open_indexed);
+
+    TrustedReader trusted_reader(writer.Data(), writer.Size(), false);
+    auto open_trusted = bench::RunBest([&] {
+        bench::DoNotOptimize(trusted_reader.RootObject().ReadStringArray(TAG_INDEXED_NAMES)->Size());
+    });
+    bench::PrintResult("Indexed, trusted", open_trusted);
+
+    return 0;
+}
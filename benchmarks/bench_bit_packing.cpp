@@ -0,0 +1,120 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+// Measures packing and unpacking 1M booleans with a bit by bit loop against the BitPacking kernels,
+// and counting the elements set in both of two masks on bool arrays against packed bits.
+
+#include "Benchmark.hpp"
+#include "tbf/BitPacking.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+constexpr uint32_t ELEMENT_COUNT = 1 << 20;
+
+}  // namespace
+
+int main() {
+    auto visible = std::make_unique<bool[]>(ELEMENT_COUNT);
+    auto selected = std::make_unique<bool[]>(ELEMENT_COUNT);
+    std::mt19937 rng(16);
+    for (uint32_t i = 0; i < ELEMENT_COUNT; ++i) {
+        visible[i] = (rng() & 1) != 0;
+        selected[i] = (rng() & 3) == 0;
+    }
+
+    std::vector<uint8_t> visible_bits(PackedBitsSize(ELEMENT_COUNT));
+    std::vector<uint8_t> selected_bits(PackedBitsSize(ELEMENT_COUNT));
+    auto unpacked = std::make_unique<bool[]>(ELEMENT_COUNT);
+
+    bench::PrintHeader("Packing " + std::to_string(ELEMENT_COUNT) + " booleans (per element)");
+
+    auto pack_loop = bench::RunBest([&] {
+        for (uint32_t i = 0; i < ELEMENT_COUNT; i += 8) {
+            uint8_t byte = 0;
+            for (uint32_t bit = 0; bit < 8; ++bit) {
+                byte |= static_cast<uint8_t>(visible[i + bit] << bit);
+            }
+            visible_bits[i / 8] = byte;
+        }
+        bench::DoNotOptimize(visible_bits.data());
+    });
+    pack_loop.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("Bit by bit loop", pack_loop);
+
+    auto pack = bench::RunBest([&] {
+        PackBooleans(visible.get(), visible_bits.data(), ELEMENT_COUNT);
+        bench::DoNotOptimize(visible_bits.data());
+    });
+    pack.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("PackBooleans", pack);
+
+    PackBooleans(selected.get(), selected_bits.data(), ELEMENT_COUNT);
+
+    bench::PrintHeader("Unpacking " + std::to_string(ELEMENT_COUNT) + " booleans (per element)");
+
+    auto unpack_loop = bench::RunBest([&] {
+        for (uint32_t i = 0; i < ELEMENT_COUNT; ++i) {
+            unpacked[i] = GetPackedBit(visible_bits.data(), i);
+        }
+        bench::DoNotOptimize(unpacked.get());
+    });
+    unpack_loop.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("GetPackedBit loop", unpack_loop);
+
+    auto unpack = bench::RunBest([&] {
+        UnpackBooleans(visible_bits.data(), unpacked.get(), ELEMENT_COUNT);
+        bench::DoNotOptimize(unpacked.get());
+    });
+    unpack.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("UnpackBooleans", unpack);
+
+    bench::PrintHeader("Counting elements set in both masks (per element)");
+
+    auto count_bools = bench::RunBest([&] {
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < ELEMENT_COUNT; ++i) {
+            count += visible[i] & selected[i];
+        }
+        bench::DoNotOptimize(count);
+    });
+    count_bools.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("bool arrays", count_bools);
+
+    auto count_bits = bench::RunBest([&] {
+        bench::DoNotOptimize(CountCombinedBits(visible_bits.data(), selected_bits.data(), ELEMENT_COUNT, BitOperation::And));
+    });
+    count_bits.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("CountCombinedBits", count_bits);
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+// Measures the byte swapping kernels of Endianness.hpp against an element by element loop, for
+// arrays of 2, 4 and 8 byte elements, and the cost of reading a Float32Array through a view and
+// through CopyArray. The read results only include a swap in builds with TBF_FORCE_BYTE_SWAP.
+
+#include "Benchmark.hpp"
+#include "tbf/DataTag.hpp"
+#include "tbf/Endianness.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+constexpr uint32_t ELEMENT_COUNT = 1 << 16;
+
+constexpr DataTag TAG_SAMPLES = DataTag(1, "samples");
+
+template <uint32_t size>
+void BenchKernels(const std::vector<uint8_t>& source, std::vector<uint8_t>& dest) {
+    const std::string name = std::to_string(size) + " byte elements";
+
+    auto scalar = bench::RunBest([&] {
+        detail::ByteSwapScalar<size>(dest.data(), source.data(), ELEMENT_COUNT);
+        bench::DoNotOptimize(dest.data());
+    });
+    scalar.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("Scalar, " + name, scalar);
+
+    auto vector = bench::RunBest([&] {
+        ByteSwapArray<size>(dest.data(), source.data(), ELEMENT_COUNT);
+        bench::DoNotOptimize(dest.data());
+    });
+    vector.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("ByteSwapArray, " + name, vector);
+}
+
+}  // namespace
+
+int main() {
+    std::vector<uint8_t> source(ELEMENT_COUNT * 8);
+    for (size_t i = 0; i < source.size(); ++i) {
+        source[i] = static_cast<uint8_t>(i * 31);
+    }
+    std::vector<uint8_t> dest(source.size());
+
+    bench::PrintHeader("Swapping " + std::to_string(ELEMENT_COUNT) + " elements (per element)");
+    BenchKernels<2>(source, dest);
+    BenchKernels<4>(source, dest);
+    BenchKernels<8>(source, dest);
+
+    std::vector<float> samples(ELEMENT_COUNT);
+    for (uint32_t i = 0; i < ELEMENT_COUNT; ++i) {
+        samples[i] = static_cast<float>(i) * 0.5f;
+    }
+
+    Writer writer(false);
+    writer.RootObject().FieldArrayFloat32(TAG_SAMPLES, samples.data(), ELEMENT_COUNT);
+    writer.Finish();
+
+    bench::PrintHeader(std::string("Reading a Float32Array of ") + std::to_string(ELEMENT_COUNT) + " elements (per element" +
+                       (NEEDS_BYTE_SWAP ? ", swapped)" : ", native)"));
+
+    Reader reader(writer.Data(), writer.Size(), false);
+    auto view = bench::RunBest([&] {
+        // A fresh reader each time, converted views live as long as the reader that made them
+        Reader fresh(writer.Data(), writer.Size(), false);
+        bench::DoNotOptimize(fresh.RootObject().ReadFloat32Array(TAG_SAMPLES).data());
+    });
+    view.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("ReadFloat32Array", view);
+
+    std::vector<float> copied(ELEMENT_COUNT);
+    auto copy = bench::RunBest([&] {
+        bench::DoNotOptimize(reader.RootObject().CopyArray<DataType::Float32Array>(TAG_SAMPLES, std::span<float>(copied)));
+    });
+    copy.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("CopyArray", copy);
+
+    return 0;
+}
@@ -0,0 +1,181 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+// Measures the compression ratio and the compression and decompression speed of the block codec on
+// 4 MiB of log text, raw integer and float arrays and random bytes, and the cost of reading a
+// compressed Binary field through ObjectReader::ReadCompressed against reading it uncompressed.
+// Speeds are reported in GB/s of uncompressed data.
+
+#include "Benchmark.hpp"
+#include "tbf/Compression.hpp"
+#include "tbf/DataTag.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+constexpr size_t PAYLOAD_SIZE = 4 << 20;
+
+constexpr DataTag TAG_PAYLOAD = "payload";
+
+std::vector<uint8_t> LogText(std::mt19937& rng) {
+    static const char* const METHODS[] = {"GET", "GET", "GET", "POST", "PUT", "DELETE"};
+    static const char* const PATHS[] = {"/api/v1/users", "/api/v1/orders", "/api/v1/orders/items", "/health", "/static/app.js"};
+    static const char* const STATUSES[] = {"200", "200", "200", "201", "304", "404", "500"};
+
+    std::string text;
+    text.reserve(PAYLOAD_SIZE + 256);
+    uint64_t timestamp = 1700000000000;
+    while (text.size() < PAYLOAD_SIZE) {
+        timestamp += rng() % 50;
+        text += "{\"ts\":" + std::to_string(timestamp) + ",\"method\":\"" + METHODS[rng() % std::size(METHODS)] + "\",\"path\":\"" +
+                PATHS[rng() % std::size(PATHS)] + "\",\"status\":" + STATUSES[rng() % std::size(STATUSES)] +
+                ",\"latency_ms\":" + std::to_string(rng() % 400) + ",\"user\":" + std::to_string(rng() % 5000) + "}\n";
+    }
+    text.resize(PAYLOAD_SIZE);
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+// Counters and identifiers that change slowly from one element to the next
+std::vector<uint8_t> IntegerArray(std::mt19937& rng) {
+    std::vector<uint32_t> values(PAYLOAD_SIZE / sizeof(uint32_t));
+    uint32_t value = 1000000;
+    for (uint32_t& element : values) {
+        value += rng() % 4 == 0 ? rng() % 100 : 0;
+        element = value;
+    }
+    std::vector<uint8_t> bytes(PAYLOAD_SIZE);
+    std::memcpy(bytes.data(), values.data(), PAYLOAD_SIZE);
+    return bytes;
+}
+
+// A noisy sensor signal, whose low mantissa bits are close to random
+std::vector<uint8_t> FloatArray(std::mt19937& rng) {
+    std::vector<float> values(PAYLOAD_SIZE / sizeof(float));
+    std::normal_distribution<float> noise(0.0f, 0.01f);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = std::sin(static_cast<float>(i) * 0.001f) + noise(rng);
+    }
+    std::vector<uint8_t> bytes(PAYLOAD_SIZE);
+    std::memcpy(bytes.data(), values.data(), PAYLOAD_SIZE);
+    return bytes;
+}
+
+std::vector<uint8_t> RandomBytes(std::mt19937& rng) {
+    std::vector<uint8_t> bytes(PAYLOAD_SIZE);
+    for (uint8_t& byte : bytes) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    return bytes;
+}
+
+void RunPayload(const char* name, const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> compressed(MaxCompressedSize(data.size()));
+    std::vector<uint8_t> decompressed(data.size());
+    const size_t compressed_size = CompressBlock(data.data(), data.size(), compressed.data());
+
+    bench::PrintHeader(std::string(name) + " (per 4 MiB)");
+    std::printf("%-48s %14zu\n", "  compressed (bytes)", compressed_size);
+    std::printf("%-48s %14.2f\n", "  ratio", static_cast<double>(data.size()) / static_cast<double>(compressed_size));
+
+    auto copy = bench::RunBest([&] {
+        std::memcpy(decompressed.data(), data.data(), data.size());
+        bench::DoNotOptimize(decompressed.data());
+    });
+    bench::PrintResult("memcpy", copy);
+
+    auto compress = bench::RunBest([&] {
+        bench::DoNotOptimize(CompressBlock(data.data(), data.size(), compressed.data()));
+    });
+    bench::PrintResult("CompressBlock", compress);
+    std::printf("%-48s %14.2f\n", "  CompressBlock (GB/s)", static_cast<double>(data.size()) / compress.ns_per_op);
+
+    auto decompress = bench::RunBest([&] {
+        bench::DoNotOptimize(DecompressBlock(compressed.data(), compressed_size, decompressed.data(), data.size()));
+    });
+    bench::PrintResult("DecompressBlock", decompress);
+    std::printf("%-48s %14.2f\n", "  DecompressBlock (GB/s)", static_cast<double>(data.size()) / decompress.ns_per_op);
+}
+
+}  // namespace
+
+int main() {
+    std::mt19937 rng(20);
+
+    const std::vector<uint8_t> text = LogText(rng);
+    RunPayload("JSON log lines", text);
+    RunPayload("uint32 counters, raw array", IntegerArray(rng));
+    RunPayload("float32 sensor samples, raw array", FloatArray(rng));
+    RunPayload("Random bytes", RandomBytes(rng));
+
+    Writer plain_writer(true);
+    plain_writer.RootObject().FieldBinary(TAG_PAYLOAD, text.data(), text.size());
+    plain_writer.Finish();
+
+    Writer compressed_writer(true);
+    compressed_writer.RootObject().FieldCompressedBinary(TAG_PAYLOAD, text.data(), text.size());
+    compressed_writer.Finish();
+
+    bench::PrintHeader("4 MiB Binary field of JSON log lines (per read)");
+    std::printf("%-48s %14zu\n", "  plain document (bytes)", plain_writer.Size());
+    std::printf("%-48s %14zu\n", "  compressed document (bytes)", compressed_writer.Size());
+
+    auto read_plain = bench::RunBest([&] {
+        Reader reader(plain_writer.Data(), plain_writer.Size(), true);
+        std::span<const uint8_t> value = reader.RootObject().ReadBinary(TAG_PAYLOAD);
+        bench::DoNotOptimize(value[value.size() / 2]);
+    });
+    bench::PrintResult("Read plain field", read_plain);
+
+    // The scratch buffer keeps its capacity from one read to the next
+    std::vector<uint8_t> scratch;
+    auto read_compressed = bench::RunBest([&] {
+        Reader reader(compressed_writer.Data(), compressed_writer.Size(), true);
+        auto field = reader.RootObject().ReadCompressed(TAG_PAYLOAD, scratch);
+        std::span<const uint8_t> value = field->ReadBinary(TAG_PAYLOAD);
+        bench::DoNotOptimize(value[value.size() / 2]);
+    });
+    bench::PrintResult("Read compressed field into reused scratch", read_compressed);
+
+    auto write_compressed = bench::RunBest([&] {
+        Writer writer(true, PAYLOAD_SIZE);
+        writer.RootObject().FieldCompressedBinary(TAG_PAYLOAD, text.data(), text.size());
+        writer.Finish();
+        bench::DoNotOptimize(writer.Data());
+    });
+    bench::PrintResult("Write compressed field", write_compressed);
+
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+// Measures the size of 1M low cardinality strings written as a dictionary string array against a
+// plain string array, the cost of reading every element of each, and an equality filter done with
+// string compares against one done with the codes of the dictionary.
+
+#include "Benchmark.hpp"
+#include "tbf/DataTag.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string_view>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+constexpr uint32_t ELEMENT_COUNT = 1 << 20;
+
+constexpr DataTag TAG_VALUES = "values";
+
+const std::string_view STATUSES[] = {"pending", "processing", "shipped", "delivered", "cancelled", "returned", "refunded",
+                                     "on-hold"};
+
+}  // namespace
+
+int main() {
+    std::mt19937 rng(19);
+    std::vector<std::string_view> values(ELEMENT_COUNT);
+    for (std::string_view& value : values) {
+        value = STATUSES[rng() % std::size(STATUSES)];
+    }
+
+    Writer plain_writer(true);
+    plain_writer.RootObject().FieldStringArray(TAG_VALUES, values.data(), ELEMENT_COUNT);
+    plain_writer.Finish();
+
+    Writer dictionary_writer(true);
+    dictionary_writer.RootObject().FieldDictionaryStringArray(TAG_VALUES, values);
+    dictionary_writer.Finish();
+
+    Reader plain_reader(plain_writer.Data(), plain_writer.Size(), true);
+    Reader dictionary_reader(dictionary_writer.Data(), dictionary_writer.Size(), true);
+    const auto plain_array = plain_reader.RootObject().ReadStringArray(TAG_VALUES);
+    const StringArrayReader& plain = *plain_array;
+    const DictionaryStringArrayReader dictionary = *dictionary_reader.RootObject().ReadDictionaryStringArray(TAG_VALUES);
+
+    bench::PrintHeader("1M strings out of 8 values (per element)");
+    std::printf("%-48s %14zu\n", "  plain string array (bytes)", plain_writer.Size());
+    std::printf("%-48s %14zu\n", "  dictionary string array (bytes)", dictionary_writer.Size());
+
+    auto write_plain = bench::RunBest([&] {
+        Writer writer(true);
+        writer.RootObject().FieldStringArray(TAG_VALUES, values.data(), ELEMENT_COUNT);
+        writer.Finish();
+        bench::DoNotOptimize(writer.Data());
+    });
+    write_plain.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("Write plain", write_plain);
+
+    auto write_dictionary = bench::RunBest([&] {
+        Writer writer(true);
+        writer.RootObject().FieldDictionaryStringArray(TAG_VALUES, values);
+        writer.Finish();
+        bench::DoNotOptimize(writer.Data());
+    });
+    write_dictionary.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("Write dictionary", write_dictionary);
+
+    auto read_plain = bench::RunBest([&] {
+        size_t total = 0;
+        std::string_view value;
+        for (uint32_t i = 0; i < ELEMENT_COUNT; ++i) {
+            plain.GetElement(i, value);
+            total += value.size();
+        }
+        bench::DoNotOptimize(total);
+    });
+    read_plain.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("Read every element, plain", read_plain);
+
+    auto read_dictionary = bench::RunBest([&] {
+        size_t total = 0;
+        std::string_view value;
+        for (uint32_t i = 0; i < ELEMENT_COUNT; ++i) {
+            dictionary.GetElement(i, value);
+            total += value.size();
+        }
+        bench::DoNotOptimize(total);
+    });
+    read_dictionary.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("Read every element, dictionary", read_dictionary);
+
+    auto filter_strings = bench::RunBest([&] {
+        size_t matches = 0;
+        std::string_view value;
+        for (uint32_t i = 0; i < ELEMENT_COUNT; ++i) {
+            plain.GetElement(i, value);
+            matches += value == "shipped";
+        }
+        bench::DoNotOptimize(matches);
+    });
+    filter_strings.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("Filter == \"shipped\", string compares", filter_strings);
+
+    std::vector<uint32_t> codes(ELEMENT_COUNT);
+    auto filter_codes = bench::RunBest([&] {
+        const uint32_t shipped = *dictionary.FindEntry("shipped");
+        dictionary.DecodeCodes(codes);
+        size_t matches = 0;
+        for (uint32_t code : codes) {
+            matches += code == shipped;
+        }
+        bench::DoNotOptimize(matches);
+    });
+    filter_codes.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("Filter == \"shipped\", DecodeCodes", filter_codes);
+
+    return 0;
+}
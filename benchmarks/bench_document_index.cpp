@@ -0,0 +1,170 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+// Measures reading every object of a scene document with per-object caches (eager and lazy)
+// against IndexMode::Document, which indexes the whole document in a single pass. Nodes are read
+// once in wire order, and then through GetElement in a shuffled order.
+
+#include "Benchmark.hpp"
+#include "tbf/DataTag.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory_resource>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+constexpr uint32_t NODE_COUNT = 5000;
+
+constexpr DataTag TAG_NODES = "nodes";
+constexpr DataTag TAG_ID = "id";
+constexpr DataTag TAG_NAME = "name";
+constexpr DataTag TAG_TRANSFORM = "transform";
+constexpr DataTag TAG_MATERIAL = "material";
+constexpr DataTag TAG_X = "x";
+constexpr DataTag TAG_Y = "y";
+constexpr DataTag TAG_Z = "z";
+constexpr DataTag TAG_SCALE = "scale";
+constexpr DataTag TAG_ROUGHNESS = "roughness";
+constexpr DataTag TAG_METALLIC = "metallic";
+constexpr DataTag TAG_COLOR = "color";
+
+void BuildScene(Writer& writer, uint32_t node_count) {
+    auto nodes = writer.RootObject().FieldObjectArray(TAG_NODES);
+
+    for (uint32_t i = 0; i < node_count; ++i) {
+        auto node = nodes.CreateElement();
+        node.FieldUInt32(TAG_ID, i);
+        node.FieldString(TAG_NAME, "node_" + std::to_string(i));
+
+        auto transform = node.FieldObject(TAG_TRANSFORM);
+        transform.FieldFloat32(TAG_X, static_cast<float>(i));
+        transform.FieldFloat32(TAG_Y, 1.0f);
+        transform.FieldFloat32(TAG_Z, 2.0f);
+        transform.FieldFloat32(TAG_SCALE, 1.0f);
+        transform.Finish();
+
+        auto material = node.FieldObject(TAG_MATERIAL);
+        material.FieldFloat32(TAG_ROUGHNESS, 0.5f);
+        material.FieldFloat32(TAG_METALLIC, 0.0f);
+        material.FieldUInt32(TAG_COLOR, 0xFFFFFFFF);
+        material.Finish();
+
+        node.Finish();
+    }
+    nodes.Finish();
+
+    writer.Finish();
+}
+
+double ReadScene(const Reader& reader) {
+    double sum = 0.0;
+
+    auto nodes = reader.RootObject().ReadObjectArray(TAG_NODES);
+    for (const auto& node : *nodes) {
+        sum += node.ReadUInt32(TAG_ID).value_or(0);
+
+        auto transform = node.ReadObject(TAG_TRANSFORM);
+        sum += transform->ReadFloat32(TAG_X).value_or(0.0f) + transform->ReadFloat32(TAG_SCALE).value_or(0.0f);
+
+        auto material = node.ReadObject(TAG_MATERIAL);
+        sum += material->ReadFloat32(TAG_ROUGHNESS).value_or(0.0f);
+    }
+
+    return sum;
+}
+
+double ReadNode(const ObjectReader& node) {
+    auto transform = node.ReadObject(TAG_TRANSFORM);
+    auto material = node.ReadObject(TAG_MATERIAL);
+    return transform->ReadFloat32(TAG_X).value_or(0.0f) + material->ReadFloat32(TAG_ROUGHNESS).value_or(0.0f);
+}
+
+double ReadSceneShuffled(const Reader& reader, const std::vector<uint32_t>& order) {
+    double sum = 0.0;
+
+    auto nodes = reader.RootObject().ReadObjectArray(TAG_NODES);
+    for (uint32_t index : order) {
+        sum += ReadNode(*nodes->GetElement(index));
+    }
+
+    return sum;
+}
+
+}  // namespace
+
+int main() {
+    for (bool name_based : {true, false}) {
+        Writer writer(name_based);
+        BuildScene(writer, NODE_COUNT);
+
+        bench::PrintHeader(std::string(name_based ? "Name-based" : "ID-based") + " scene of " + std::to_string(NODE_COUNT) + " nodes (" + std::to_string(writer.Size()) + " bytes)");
+
+        // The document index is a few large arrays. Returning them to the heap after every
+        // document can cost page faults on the next one, which a reused pool avoids.
+        std::pmr::unsynchronized_pool_resource pool({.max_blocks_per_chunk = 0, .largest_required_pool_block = 8 << 20});
+
+        const struct {
+            const char* label;
+            IndexMode mode;
+            std::pmr::memory_resource* resource;
+        } modes[] = {
+            {"eager per-object caches", IndexMode::Eager, std::pmr::get_default_resource()},
+            {"lazy per-object caches", IndexMode::Lazy, std::pmr::get_default_resource()},
+            {"document index", IndexMode::Document, std::pmr::get_default_resource()},
+            {"document index (pool)", IndexMode::Document, &pool},
+        };
+
+        for (const auto& mode : modes) {
+            auto result = bench::Run([&] {
+                Reader reader(writer.Data(), writer.Size(), name_based, mode.mode, mode.resource);
+                bench::DoNotOptimize(ReadScene(reader));
+            });
+            bench::PrintResult(std::string(mode.label) + ", in order", result);
+        }
+
+        std::vector<uint32_t> order(NODE_COUNT);
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+        for (const auto& mode : modes) {
+            auto result = bench::Run([&] {
+                Reader reader(writer.Data(), writer.Size(), name_based, mode.mode, mode.resource);
+                bench::DoNotOptimize(ReadSceneShuffled(reader, order));
+            });
+            bench::PrintResult(std::string(mode.label) + ", shuffled", result);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,210 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+// Compares the flat FieldIndex used by ObjectReader against the std::unordered_map based cache
+// it replaced, for objects with 4, 32 and 512 fields in both tag modes.
+
+#include "Benchmark.hpp"
+#include "tbf/DataTag.hpp"
+#include "tbf/FieldIndex.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+// Bucket count reserved by the previous unordered_map based cache
+constexpr uint32_t LEGACY_INITIAL_CACHE_SIZE = 100;
+
+struct Keys {
+    std::vector<DataTag::Id> ids;
+    std::vector<std::string> names;
+};
+
+Keys MakeKeys(uint32_t count) {
+    Keys keys;
+    for (uint32_t i = 0; i < count; ++i) {
+        keys.ids.push_back(static_cast<DataTag::Id>(i * 40503u + 1u));
+        keys.names.push_back("component_field_" + std::to_string(i));
+    }
+    return keys;
+}
+
+CacheEntry MakeEntry(uint32_t i) {
+    return {.type = DataType::Int32, .value = {.v_int32 = static_cast<int32_t>(i)}};
+}
+
+void BenchmarkIdKeys(const Keys& keys) {
+    const uint32_t count = static_cast<uint32_t>(keys.ids.size());
+    const std::string suffix = " (" + std::to_string(count) + " fields)";
+
+    auto build_map = bench::Run([&] {
+        std::unordered_map<DataTag::Id, CacheEntry> map;
+        map.reserve(LEGACY_INITIAL_CACHE_SIZE);
+        for (uint32_t i = 0; i < count; ++i) {
+            map.emplace(keys.ids[i], MakeEntry(i));
+        }
+        bench::DoNotOptimize(map);
+    });
+    bench::PrintResult("id build unordered_map" + suffix, build_map);
+
+    auto build_index = bench::Run([&] {
+        FieldIndex index;
+        index.Reset(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            index.Insert(keys.ids[i], MakeEntry(i));
+        }
+        bench::DoNotOptimize(index);
+    });
+    bench::PrintResult("id build FieldIndex" + suffix, build_index);
+
+    std::unordered_map<DataTag::Id, CacheEntry> map;
+    FieldIndex index;
+    index.Reset(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        map.emplace(keys.ids[i], MakeEntry(i));
+        index.Insert(keys.ids[i], MakeEntry(i));
+    }
+
+    auto lookup_map = bench::Run([&] {
+        for (DataTag::Id id : keys.ids) {
+            auto it = map.find(id);
+            bench::DoNotOptimize(it->second.value.v_int32);
+        }
+    });
+    lookup_map.ns_per_op /= count;
+    bench::PrintResult("id lookup unordered_map" + suffix, lookup_map);
+
+    auto lookup_index = bench::Run([&] {
+        CacheEntry entry{};
+        for (DataTag::Id id : keys.ids) {
+            index.Find(id, entry);
+            bench::DoNotOptimize(entry.value.v_int32);
+        }
+    });
+    lookup_index.ns_per_op /= count;
+    bench::PrintResult("id lookup FieldIndex" + suffix, lookup_index);
+}
+
+void BenchmarkNameKeys(const Keys& keys) {
+    const uint32_t count = static_cast<uint32_t>(keys.names.size());
+    const std::string suffix = " (" + std::to_string(count) + " fields)";
+
+    auto build_map = bench::Run([&] {
+        std::unordered_map<std::string_view, CacheEntry> map;
+        map.reserve(LEGACY_INITIAL_CACHE_SIZE);
+        for (uint32_t i = 0; i < count; ++i) {
+            map.emplace(keys.names[i], MakeEntry(i));
+        }
+        bench::DoNotOptimize(map);
+    });
+    bench::PrintResult("name build unordered_map" + suffix, build_map);
+
+    auto build_index = bench::Run([&] {
+        FieldIndex index;
+        index.Reset(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            std::string_view name = keys.names[i];
+            index.Insert(name, TagLookupHash(name), MakeEntry(i));
+        }
+        bench::DoNotOptimize(index);
+    });
+    bench::PrintResult("name build FieldIndex" + suffix, build_index);
+
+    std::unordered_map<std::string_view, CacheEntry> map;
+    FieldIndex index;
+    index.Reset(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        map.emplace(keys.names[i], MakeEntry(i));
+        index.Insert(keys.names[i], TagLookupHash(keys.names[i]), MakeEntry(i));
+    }
+
+    // Lookups go through DataTags, which carry their name hash
+    std::vector<DataTag> tags;
+    for (const std::string& name : keys.names) {
+        tags.emplace_back(std::string_view(name));
+    }
+
+    auto lookup_map = bench::Run([&] {
+        for (const std::string& name : keys.names) {
+            auto it = map.find(name);
+            bench::DoNotOptimize(it->second.value.v_int32);
+        }
+    });
+    lookup_map.ns_per_op /= count;
+    bench::PrintResult("name lookup unordered_map" + suffix, lookup_map);
+
+    auto lookup_index = bench::Run([&] {
+        CacheEntry entry{};
+        for (const DataTag& tag : tags) {
+            index.Find(tag.GetName(), tag.GetHash(), entry);
+            bench::DoNotOptimize(entry.value.v_int32);
+        }
+    });
+    lookup_index.ns_per_op /= count;
+    bench::PrintResult("name lookup FieldIndex" + suffix, lookup_index);
+}
+
+void BenchmarkObjectReader(const Keys& keys, bool name_based) {
+    const uint32_t count = static_cast<uint32_t>(keys.ids.size());
+
+    Writer writer(name_based);
+    for (uint32_t i = 0; i < count; ++i) {
+        DataTag tag = name_based ? DataTag(std::string_view(keys.names[i])) : DataTag(keys.ids[i]);
+        writer.RootObject().FieldInt32(tag, static_cast<int32_t>(i));
+    }
+    writer.Finish();
+
+    auto result = bench::Run([&] {
+        Reader reader(writer.Data(), writer.Size(), name_based);
+        bench::DoNotOptimize(reader.RootObject().ReadInt32(name_based ? DataTag(std::string_view(keys.names[0])) : DataTag(keys.ids[0])));
+    });
+
+    std::string name = std::string(name_based ? "name" : "id") + " ObjectReader build + 1 read (" + std::to_string(count) + " fields)";
+    bench::PrintResult(name, result);
+}
+
+}  // namespace
+
+int main() {
+    for (uint32_t count : {4u, 32u, 512u}) {
+        Keys keys = MakeKeys(count);
+
+        bench::PrintHeader("Field index: " + std::to_string(count) + " fields");
+        BenchmarkIdKeys(keys);
+        BenchmarkNameKeys(keys);
+        BenchmarkObjectReader(keys, false);
+        BenchmarkObjectReader(keys, true);
+    }
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+// Measures Float16 conversion of 1M values with the scalar helpers against the dispatched bulk
+// kernels, and the cost of writing and reading a Float16Array from and to float spans.
+
+#include "Benchmark.hpp"
+#include "tbf/DataTag.hpp"
+#include "tbf/Float16.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+constexpr uint32_t ELEMENT_COUNT = 1 << 20;
+
+constexpr DataTag TAG_POSITIONS = DataTag(1, "positions");
+
+}  // namespace
+
+int main() {
+    std::vector<float> floats(ELEMENT_COUNT);
+    for (uint32_t i = 0; i < ELEMENT_COUNT; ++i) {
+        floats[i] = static_cast<float>(i % 4096) * 0.37f - 700.0f;
+    }
+    std::vector<uint16_t> halves(ELEMENT_COUNT);
+    std::vector<float> converted(ELEMENT_COUNT);
+
+    bench::PrintHeader("Converting " + std::to_string(ELEMENT_COUNT) + " values (per value)");
+
+    auto to_half_scalar = bench::RunBest([&] {
+        for (uint32_t i = 0; i < ELEMENT_COUNT; ++i) {
+            halves[i] = FloatToHalf(floats[i]);
+        }
+        bench::DoNotOptimize(halves.data());
+    });
+    to_half_scalar.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("FloatToHalf loop", to_half_scalar);
+
+    auto to_half = bench::RunBest([&] {
+        FloatToHalfArray(floats.data(), halves.data(), ELEMENT_COUNT);
+        bench::DoNotOptimize(halves.data());
+    });
+    to_half.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("FloatToHalfArray", to_half);
+
+    auto to_float_scalar = bench::RunBest([&] {
+        for (uint32_t i = 0; i < ELEMENT_COUNT; ++i) {
+            converted[i] = HalfToFloat(halves[i]);
+        }
+        bench::DoNotOptimize(converted.data());
+    });
+    to_float_scalar.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("HalfToFloat loop", to_float_scalar);
+
+    auto to_float = bench::RunBest([&] {
+        HalfToFloatArray(halves.data(), converted.data(), ELEMENT_COUNT);
+        bench::DoNotOptimize(converted.data());
+    });
+    to_float.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("HalfToFloatArray", to_float);
+
+    bench::PrintHeader("Float16Array of " + std::to_string(ELEMENT_COUNT) + " values from and to float (per value)");
+
+    Writer writer(false, ELEMENT_COUNT * sizeof(uint16_t) + 1024);
+    auto write = bench::RunBest([&] {
+        Writer fresh(false, ELEMENT_COUNT * sizeof(uint16_t) + 1024);
+        fresh.RootObject().FieldArrayFloat16(TAG_POSITIONS, std::span<const float>(floats));
+        fresh.Finish();
+        bench::DoNotOptimize(fresh.Data());
+    });
+    write.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("FieldArrayFloat16 (float span)", write);
+
+    writer.RootObject().FieldArrayFloat16(TAG_POSITIONS, std::span<const float>(floats));
+    writer.Finish();
+
+    Reader reader(writer.Data(), writer.Size(), false);
+    auto read = bench::RunBest([&] {
+        bench::DoNotOptimize(reader.RootObject().ReadFloat16Array(TAG_POSITIONS, std::span<float>(converted)));
+    });
+    read.ns_per_op /= ELEMENT_COUNT;
+    bench::PrintResult("ReadFloat16Array (float span)", read);
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+// Measures the packed size of 1M sorted IDs, steady timestamps and random values, and the speed of
+// packing and unpacking them against copying the raw array. Unpacking throughput is reported in GB/s
+// of decoded values.
+
+#include "Benchmark.hpp"
+#include "tbf/IntegerPacking.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+constexpr uint32_t ELEMENT_COUNT = 1 << 20;
+
+template <typename Type>
+void RunSequence(const char* name, const std::vector<Type>& values) {
+    std::vector<uint8_t> packed(MaxPackedIntegersSize(values.size(), sizeof(Type)));
+    std::vector<Type> unpacked(values.size());
+    const size_t packed_size = PackIntegers(values.data(), values.size(), packed.data());
+
+    bench::PrintHeader(std::string(name) + " (per value)");
+    std::printf("%-48s %14zu\n", "  raw (bytes)", values.size() * sizeof(Type));
+    std::printf("%-48s %14zu\n", "  packed (bytes)", packed_size);
+
+    auto copy = bench::RunBest([&] {
+        std::memcpy(unpacked.data(), values.data(), values.size() * sizeof(Type));
+        bench::DoNotOptimize(unpacked.data());
+    });
+    copy.ns_per_op /= static_cast<double>(values.size());
+    bench::PrintResult("memcpy of the raw array", copy);
+
+    auto pack = bench::RunBest([&] {
+        bench::DoNotOptimize(PackIntegers(values.data(), values.size(), packed.data()));
+    });
+    pack.ns_per_op /= static_cast<double>(values.size());
+    bench::PrintResult("PackIntegers", pack);
+
+    auto unpack = bench::RunBest([&] {
+        bench::DoNotOptimize(UnpackIntegers(packed.data(), packed_size, unpacked.data(), values.size()));
+    });
+    unpack.ns_per_op /= static_cast<double>(values.size());
+    bench::PrintResult("UnpackIntegers", unpack);
+    std::printf("%-48s %14.2f\n", "  UnpackIntegers (GB/s decoded)", sizeof(Type) / unpack.ns_per_op);
+}
+
+}  // namespace
+
+int main() {
+    std::mt19937_64 rng(18);
+
+    std::vector<uint32_t> ids(ELEMENT_COUNT);
+    std::vector<int64_t> timestamps(ELEMENT_COUNT);
+    std::vector<uint32_t> clustered(ELEMENT_COUNT);
+    std::vector<uint64_t> random(ELEMENT_COUNT);
+
+    uint32_t id = 0;
+    int64_t timestamp = 1700000000000;
+    for (uint32_t i = 0; i < ELEMENT_COUNT; ++i) {
+        id += 1 + static_cast<uint32_t>(rng() % 16);
+        timestamp += 1000 + static_cast<int64_t>(rng() % 4);
+        ids[i] = id;
+        timestamps[i] = timestamp;
+        clustered[i] = 100000 + static_cast<uint32_t>(rng() % 1000);
+        random[i] = rng();
+    }
+
+    RunSequence("Sorted uint32 IDs, gaps of 1 to 16", ids);
+    RunSequence("int64 millisecond timestamps, 1 s apart with jitter", timestamps);
+    RunSequence("uint32 values within 1000 of each other", clustered);
+    RunSequence("Random uint64 values", random);
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+// Measures the per-message cost of reading the first header fields of a ~10 KB object with the
+// eager index, which parses every field on the first lookup, against IndexMode::Lazy.
+
+#include "Benchmark.hpp"
+#include "tbf/DataTag.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <cstdint>
+#include <string>
+
+using namespace tbf;
+
+namespace {
+
+constexpr DataTag TAG_ROUTE = "route";
+constexpr DataTag TAG_SEQUENCE = "sequence";
+
+void BuildMessage(Writer& writer, uint32_t payload_fields) {
+    auto& root = writer.RootObject();
+
+    root.FieldInt32(TAG_ROUTE, 12);
+    root.FieldInt64(TAG_SEQUENCE, 987654321);
+
+    for (uint32_t i = 0; i < payload_fields; ++i) {
+        std::string name = "payload_" + std::to_string(i);
+        root.FieldInt64(DataTag(std::string_view(name)), i);
+    }
+
+    writer.Finish();
+}
+
+void BenchmarkMode(Writer& writer, bool name_based, IndexMode mode, const char* label) {
+    auto one_field = bench::Run([&] {
+        Reader reader(writer.Data(), writer.Size(), name_based, mode);
+        bench::DoNotOptimize(reader.RootObject().ReadInt32(TAG_ROUTE));
+    });
+    bench::PrintResult(std::string(label) + " read 1 header field", one_field);
+
+    auto two_fields = bench::Run([&] {
+        Reader reader(writer.Data(), writer.Size(), name_based, mode);
+        bench::DoNotOptimize(reader.RootObject().ReadInt32(TAG_ROUTE));
+        bench::DoNotOptimize(reader.RootObject().ReadInt64(TAG_SEQUENCE));
+    });
+    bench::PrintResult(std::string(label) + " read 2 header fields", two_fields);
+}
+
+}  // namespace
+
+int main() {
+    for (bool name_based : {true, false}) {
+        // Roughly 10 KB per message in both modes
+        Writer writer(name_based);
+        BuildMessage(writer, name_based ? 480 : 900);
+
+        bench::PrintHeader(std::string(name_based ? "Name-based" : "ID-based") + " message of " + std::to_string(writer.Size()) + " bytes");
+        BenchmarkMode(writer, name_based, IndexMode::Eager, "eager");
+        BenchmarkMode(writer, name_based, IndexMode::Lazy, "lazy");
+    }
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+// Measures decoding a 1M element entity array in order on one thread, against the parallel
+// algorithms on pools of increasing size. The gain is bounded by the hardware threads of the
+// machine running the benchmark, which is printed with the results.
+
+#include "Benchmark.hpp"
+#include "tbf/DataTag.hpp"
+#include "tbf/Parallel.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+using namespace tbf;
+
+namespace {
+
+constexpr uint32_t ENTITY_COUNT = 1000000;
+
+constexpr DataTag TAG_ENTITIES = DataTag(1, "entities");
+constexpr DataTag TAG_INDEXED_ENTITIES = DataTag(2, "indexed_entities");
+constexpr DataTag TAG_ID = DataTag(3, "id");
+constexpr DataTag TAG_HEALTH = DataTag(4, "health");
+constexpr DataTag TAG_POSITION = DataTag(5, "position");
+
+void WriteEntities(ObjectWriter& root, const DataTag& tag, ArrayLayout layout) {
+    auto entities = root.FieldObjectArray(tag, layout);
+    for (uint32_t i = 0; i < ENTITY_COUNT; ++i) {
+        const float position[3] = {static_cast<float>(i), 0.0f, 1.0f};
+
+        auto entity = entities.CreateElement();
+        entity.FieldUInt32(TAG_ID, i);
+        entity.FieldInt32(TAG_HEALTH, static_cast<int32_t>(i % 100));
+        entity.FieldVector3f32(TAG_POSITION, position);
+        entity.Finish();
+    }
+    entities.Finish();
+}
+
+int64_t EntityScore(const ObjectReader& entity) noexcept {
+    const float* position = entity.ReadVector3f32(TAG_POSITION);
+    return entity.ReadInt32(TAG_HEALTH).value_or(0) + static_cast<int64_t>(position != nullptr ? position[2] : 0.0f);
+}
+
+}  // namespace
+
+int main() {
+    Writer writer(false);
+    WriteEntities(writer.RootObject(), TAG_ENTITIES, ArrayLayout::Plain);
+    WriteEntities(writer.RootObject(), TAG_INDEXED_ENTITIES, ArrayLayout::Indexed);
+    writer.Finish();
+
+    Reader reader(writer.Data(), writer.Size(), false);
+    const ObjectReader& root = reader.RootObject();
+
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    bench::PrintHeader("Scoring " + std::to_string(ENTITY_COUNT) + " entities (per entity)");
+
+    auto sequential = bench::Run([&] {
+        auto entities = root.ReadObjectArray(TAG_INDEXED_ENTITIES);
+        int64_t score = 0;
+        for (const auto& entity : *entities) {
+            score += EntityScore(entity);
+        }
+        bench::DoNotOptimize(score);
+    });
+    sequential.ns_per_op /= ENTITY_COUNT;
+    bench::PrintResult("Sequential iterator", sequential);
+
+    auto add = [](int64_t a, int64_t b) noexcept { return a + b; };
+
+    for (uint32_t threads : {1u, 2u, 4u, 8u}) {
+        ThreadPool pool(threads);
+
+        for (const DataTag* tag : {&TAG_ENTITIES, &TAG_INDEXED_ENTITIES}) {
+            auto parallel = bench::Run([&] {
+                auto entities = root.ReadObjectArray(*tag);
+                auto score = ParallelTransformReduce(*entities, int64_t(0), add, EntityScore, pool);
+                bench::DoNotOptimize(score);
+            });
+            parallel.ns_per_op /= ENTITY_COUNT;
+
+            const char* layout = tag == &TAG_ENTITIES ? "plain" : "indexed";
+            bench::PrintResult("TransformReduce, " + std::to_string(threads) + " threads, " + layout, parallel);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,160 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+// Compares filling a struct from an object with one ReadFields call against reading each field on
+// its own. The object has 16 fields of mixed types, 12 of which are bound to struct members. Every
+// iteration constructs the Reader, so index building is part of the per-field reads.
+
+#include "Benchmark.hpp"
+#include "tbf/DataTag.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+using namespace tbf;
+
+namespace {
+
+constexpr DataTag TAG_ID = DataTag(1, "id");
+constexpr DataTag TAG_NAME = DataTag(2, "name");
+constexpr DataTag TAG_EMAIL = DataTag(3, "email");
+constexpr DataTag TAG_AGE = DataTag(4, "age");
+constexpr DataTag TAG_SCORE = DataTag(5, "score");
+constexpr DataTag TAG_ACTIVE = DataTag(6, "active");
+constexpr DataTag TAG_CREATED = DataTag(7, "created");
+constexpr DataTag TAG_UPDATED = DataTag(8, "updated");
+constexpr DataTag TAG_LEVEL = DataTag(9, "level");
+constexpr DataTag TAG_RATIO = DataTag(10, "ratio");
+constexpr DataTag TAG_FLAGS = DataTag(11, "flags");
+constexpr DataTag TAG_HISTORY = DataTag(12, "history");
+
+constexpr DataTag TAG_UNUSED_1 = DataTag(13, "unused_1");
+constexpr DataTag TAG_UNUSED_2 = DataTag(14, "unused_2");
+constexpr DataTag TAG_UNUSED_3 = DataTag(15, "unused_3");
+constexpr DataTag TAG_UNUSED_4 = DataTag(16, "unused_4");
+
+struct Record {
+    int64_t id;
+    std::string_view name;
+    std::string_view email;
+    uint8_t age;
+    double score;
+    bool active;
+    uint64_t created;
+    uint64_t updated;
+    int32_t level;
+    float ratio;
+    uint32_t flags;
+    std::span<const int32_t> history;
+};
+
+void WriteRecord(Writer& writer) {
+    static const int32_t history[] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    auto& root = writer.RootObject();
+    root.FieldInt64(TAG_ID, 123456789);
+    root.FieldString(TAG_NAME, "John Doe");
+    root.FieldInt32(TAG_UNUSED_1, 1);
+    root.FieldString(TAG_EMAIL, "john.doe@example.com");
+    root.FieldUInt8(TAG_AGE, 42);
+    root.FieldFloat64(TAG_SCORE, 98.5);
+    root.FieldString(TAG_UNUSED_2, "unused");
+    root.FieldBoolean(TAG_ACTIVE, true);
+    root.FieldUInt64(TAG_CREATED, 1700000000);
+    root.FieldUInt64(TAG_UPDATED, 1700000500);
+    root.FieldFloat32(TAG_UNUSED_3, 1.0f);
+    root.FieldInt32(TAG_LEVEL, 7);
+    root.FieldFloat32(TAG_RATIO, 0.25f);
+    root.FieldUInt32(TAG_FLAGS, 0xF0);
+    root.FieldInt64(TAG_UNUSED_4, 4);
+    root.FieldArrayInt32(TAG_HISTORY, history, 8);
+    writer.Finish();
+}
+
+void ReadEach(const ObjectReader& root, Record& record) {
+    root.ReadInt64(TAG_ID, record.id);
+    root.ReadString(TAG_NAME, record.name);
+    root.ReadString(TAG_EMAIL, record.email);
+    root.ReadUInt8(TAG_AGE, record.age);
+    root.ReadFloat64(TAG_SCORE, record.score);
+    root.ReadBoolean(TAG_ACTIVE, record.active);
+    root.ReadUInt64(TAG_CREATED, record.created);
+    root.ReadUInt64(TAG_UPDATED, record.updated);
+    root.ReadInt32(TAG_LEVEL, record.level);
+    root.ReadFloat32(TAG_RATIO, record.ratio);
+    root.ReadUInt32(TAG_FLAGS, record.flags);
+    record.history = root.ReadInt32Array(TAG_HISTORY);
+}
+
+ReadFieldsResult ReadBatch(const ObjectReader& root, Record& record) {
+    return root.ReadFields(record,
+                           Bind<DataType::Int64>(TAG_ID, &Record::id),
+                           Bind<DataType::String>(TAG_NAME, &Record::name),
+                           Bind<DataType::String>(TAG_EMAIL, &Record::email),
+                           Bind<DataType::UInt8>(TAG_AGE, &Record::age),
+                           Bind<DataType::Float64>(TAG_SCORE, &Record::score),
+                           Bind<DataType::Boolean>(TAG_ACTIVE, &Record::active),
+                           Bind<DataType::UInt64>(TAG_CREATED, &Record::created),
+                           Bind<DataType::UInt64>(TAG_UPDATED, &Record::updated),
+                           Bind<DataType::Int32>(TAG_LEVEL, &Record::level),
+                           Bind<DataType::Float32>(TAG_RATIO, &Record::ratio),
+                           Bind<DataType::UInt32>(TAG_FLAGS, &Record::flags),
+                           Bind<DataType::Int32Array>(TAG_HISTORY, &Record::history));
+}
+
+}  // namespace
+
+int main() {
+    for (bool name_based : {true, false}) {
+        Writer writer(name_based);
+        WriteRecord(writer);
+
+        bench::PrintHeader(std::string(name_based ? "Name-based" : "ID-based") + " record of 16 fields, 12 read (per record)");
+
+        for (IndexMode mode : {IndexMode::Eager, IndexMode::Lazy}) {
+            auto result = bench::RunBest([&] {
+                Reader reader(writer.Data(), writer.Size(), name_based, mode);
+                Record record;
+                ReadEach(reader.RootObject(), record);
+                bench::DoNotOptimize(record);
+            });
+            bench::PrintResult(mode == IndexMode::Eager ? "field reads, eager" : "field reads, lazy", result);
+        }
+
+        auto result = bench::RunBest([&] {
+            Reader reader(writer.Data(), writer.Size(), name_based);
+            Record record;
+            bench::DoNotOptimize(ReadBatch(reader.RootObject(), record));
+            bench::DoNotOptimize(record);
+        });
+        bench::PrintResult("ReadFields", result);
+    }
+
+    return 0;
+}
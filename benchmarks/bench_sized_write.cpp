@@ -0,0 +1,160 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+// Measures producers of small messages, a few hundred bytes each, written by a default Writer,
+// whose first chunk is 1 MiB, by a Writer with the smallest chunks, and by a sizing pass through
+// SizeCounter followed by a Writer of exactly the counted capacity or by a buffer reused across
+// messages.
+
+#include "Benchmark.hpp"
+#include "tbf/DataTag.hpp"
+#include "tbf/SizeCounter.hpp"
+#include "tbf/Writer.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+constexpr DataTag TAG_ID = "id";
+constexpr DataTag TAG_TIMESTAMP = "timestamp";
+constexpr DataTag TAG_HOST = "host";
+constexpr DataTag TAG_LEVEL = "level";
+constexpr DataTag TAG_MESSAGE = "message";
+constexpr DataTag TAG_LOCATION = "location";
+constexpr DataTag TAG_TAGS = "tags";
+constexpr DataTag TAG_METRICS = "metrics";
+constexpr DataTag TAG_NAME = "name";
+constexpr DataTag TAG_VALUE = "value";
+
+constexpr uint32_t MESSAGE_COUNT = 10000;
+
+// A log event of 16 fields, written through an ObjectWriter or counted through a SizeCounter
+template <typename Object>
+void WriteEvent(Object& root, uint64_t id) {
+    const std::string_view tags[] = {"api", "eu-west", "canary"};
+    const double location[] = {41.38, 2.17};
+
+    root.FieldUInt64(TAG_ID, id);
+    root.FieldVarInt64(TAG_TIMESTAMP, 1700000000000 + static_cast<int64_t>(id));
+    root.FieldString(TAG_HOST, "api-server-07.internal");
+    root.FieldUInt8(TAG_LEVEL, static_cast<uint8_t>(id % 4));
+    root.FieldString(TAG_MESSAGE, "request completed in the expected time");
+    root.FieldVector2f64(TAG_LOCATION, location);
+    root.FieldStringArray(TAG_TAGS, tags, 3);
+
+    auto metrics = root.FieldObjectArray(TAG_METRICS);
+    for (uint32_t i = 0; i < 4; i++) {
+        auto metric = metrics.CreateElement();
+        metric.FieldString(TAG_NAME, "latency");
+        metric.FieldFloat64(TAG_VALUE, static_cast<double>(id + i) * 0.25);
+        metric.Finish();
+    }
+    metrics.Finish();
+
+    root.Finish();
+}
+
+void RunMode(const char* name, bool name_based) {
+    bench::PrintHeader(std::string(name) + " messages (per message)");
+
+    auto growing = bench::RunBest([&] {
+        for (uint64_t i = 0; i < MESSAGE_COUNT; i++) {
+            Writer writer(name_based);
+            WriteEvent(writer.RootObject(), i);
+            bench::DoNotOptimize(writer.Data());
+        }
+    }, 10, 100.0);
+    growing.ns_per_op /= MESSAGE_COUNT;
+    bench::PrintResult("Writer (1 MiB first chunk)", growing);
+
+    auto small = bench::RunBest([&] {
+        for (uint64_t i = 0; i < MESSAGE_COUNT; i++) {
+            Writer writer(name_based, 1024);
+            WriteEvent(writer.RootObject(), i);
+            bench::DoNotOptimize(writer.Data());
+        }
+    }, 10, 100.0);
+    small.ns_per_op /= MESSAGE_COUNT;
+    bench::PrintResult("Writer (1 KiB first chunk)", small);
+
+    auto counting = bench::RunBest([&] {
+        for (uint64_t i = 0; i < MESSAGE_COUNT; i++) {
+            SizeCounter counter(name_based);
+            WriteEvent(counter, i);
+            bench::DoNotOptimize(counter.Size());
+        }
+    }, 10, 100.0);
+    counting.ns_per_op /= MESSAGE_COUNT;
+    bench::PrintResult("SizeCounter only", counting);
+
+    auto exact = bench::RunBest([&] {
+        for (uint64_t i = 0; i < MESSAGE_COUNT; i++) {
+            SizeCounter counter(name_based);
+            WriteEvent(counter, i);
+            Writer writer(counter);
+            WriteEvent(writer.RootObject(), i);
+            bench::DoNotOptimize(writer.Data());
+        }
+    }, 10, 100.0);
+    exact.ns_per_op /= MESSAGE_COUNT;
+    bench::PrintResult("SizeCounter + exact Writer", exact);
+
+    std::vector<uint8_t> buffer;
+    auto reused = bench::RunBest([&] {
+        for (uint64_t i = 0; i < MESSAGE_COUNT; i++) {
+            SizeCounter counter(name_based);
+            WriteEvent(counter, i);
+            if (buffer.size() < counter.Capacity()) {
+                buffer.resize(counter.Capacity());
+            }
+            Writer writer(std::span<uint8_t>(buffer), name_based);
+            WriteEvent(writer.RootObject(), i);
+            bench::DoNotOptimize(writer.Data());
+        }
+    }, 10, 100.0);
+    reused.ns_per_op /= MESSAGE_COUNT;
+    bench::PrintResult("SizeCounter + reused caller buffer", reused);
+
+    SizeCounter counter(name_based);
+    WriteEvent(counter, 0);
+    std::printf("%-48s %14zu\n", "  message (bytes)", counter.Size());
+    std::printf("%-48s %14zu\n", "  exact Writer allocation (bytes)", counter.Capacity());
+}
+
+}  // namespace
+
+int main() {
+    RunMode("Name-based", true);
+    RunMode("ID-based", false);
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+// Compares TagLookupHash, used to index wire names in name-based mode, against std::hash for tag
+// names of typical lengths.
+
+#include "Benchmark.hpp"
+#include "tbf/DataTag.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+std::vector<std::string> MakeNames(uint32_t length) {
+    std::vector<std::string> names;
+    for (uint32_t i = 0; i < 64; ++i) {
+        std::string name = "f" + std::to_string(i) + "_";
+        name.resize(length, 'x');
+        names.push_back(name);
+    }
+    return names;
+}
+
+}  // namespace
+
+int main() {
+    bench::PrintHeader("Tag name hashing (per name)");
+
+    for (uint32_t length : {4u, 8u, 16u, 32u}) {
+        std::vector<std::string> names = MakeNames(length);
+        const std::string suffix = " (" + std::to_string(length) + " chars)";
+
+        auto std_hash = bench::Run([&] {
+            for (const std::string& name : names) {
+                bench::DoNotOptimize(std::hash<std::string_view>{}(name));
+            }
+        });
+        std_hash.ns_per_op /= names.size();
+        bench::PrintResult("std::hash" + suffix, std_hash);
+
+        auto lookup_hash = bench::Run([&] {
+            for (const std::string& name : names) {
+                bench::DoNotOptimize(TagLookupHash(name));
+            }
+        });
+        lookup_hash.ns_per_op /= names.size();
+        bench::PrintResult("TagLookupHash" + suffix, lookup_hash);
+    }
+
+    return 0;
+}
@@ -0,0 +1,166 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+// Compares Writer and Reader, which take the tag mode of the document at run time, with NameWriter,
+// IdWriter, NameReader and IdReader, which fix it at compile time. Writing covers 10M primitive
+// fields and small 64 field documents, reading covers an array of 20000 records of 16 fields that
+// is validated, indexed as a whole, and read object by object through per-object caches.
+
+#include "Benchmark.hpp"
+#include "tbf/DataTag.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+using namespace tbf;
+
+namespace {
+
+constexpr uint32_t FIELD_COUNT = 10'000'000;
+constexpr uint32_t RECORD_COUNT = 20'000;
+
+constexpr DataTag TAG_RECORDS = DataTag(100, "records");
+
+constexpr DataTag TAGS[16] = {
+    DataTag(1, "id"),       DataTag(2, "age"),       DataTag(3, "score"),    DataTag(4, "active"),
+    DataTag(5, "created"),  DataTag(6, "level"),     DataTag(7, "ratio"),    DataTag(8, "flags"),
+    DataTag(9, "parent"),   DataTag(10, "weight"),   DataTag(11, "height"),  DataTag(12, "visible"),
+    DataTag(13, "updated"), DataTag(14, "priority"), DataTag(15, "quality"), DataTag(16, "mask"),
+};
+
+template <TagMode Mode>
+void WriteFields(BasicObjectWriter<Mode>& obj, uint32_t field_count, uint32_t seed) {
+    for (uint32_t i = 0; i < field_count; i += 8) {
+        const uint32_t value = seed + i;
+        obj.FieldUInt64(TAGS[0], value);
+        obj.FieldUInt8(TAGS[1], static_cast<uint8_t>(value));
+        obj.FieldFloat32(TAGS[2], static_cast<float>(value) * 0.25f);
+        obj.FieldBoolean(TAGS[3], (value & 8) != 0);
+        obj.FieldInt64(TAGS[4], -static_cast<int64_t>(value));
+        obj.FieldUInt16(TAGS[5], static_cast<uint16_t>(value));
+        obj.FieldFloat64(TAGS[6], static_cast<double>(value) / 3.0);
+        obj.FieldInt32(TAGS[7], static_cast<int32_t>(value ^ 0x55));
+    }
+}
+
+// Records use the first eight tags in the first half and the other eight in the second
+template <TagMode Mode>
+void WriteRecords(BasicWriter<Mode>& writer) {
+    BasicObjectWriter<Mode>& root = writer.RootObject();
+    {
+        BasicObjectArrayWriter<Mode> records = root.FieldObjectArray(TAG_RECORDS);
+        for (uint32_t i = 0; i < RECORD_COUNT; ++i) {
+            BasicObjectWriter<Mode> record = records.CreateElement();
+            WriteFields(record, 8, i);
+            for (uint32_t j = 8; j < 16; ++j) {
+                record.FieldUInt32(TAGS[j], i * j);
+            }
+            record.Finish();
+        }
+    }
+    writer.Finish();
+}
+
+template <typename WriterType, typename... Args>
+void RunWrite(const char* name, Args... args) {
+    auto write = bench::RunBest([&] {
+        WriterType writer(args...);
+        WriteFields(writer.RootObject(), FIELD_COUNT, 0);
+        writer.Finish();
+        bench::DoNotOptimize(writer.Size());
+    }, 5, 0.0);
+    bench::PrintResult(std::string(name) + ", 10M fields", write);
+    std::printf("%-48s %14.2f\n", "  per field (ns)", write.ns_per_op / FIELD_COUNT);
+
+    auto small = bench::RunBest([&] {
+        WriterType writer(args..., 4096);
+        WriteFields(writer.RootObject(), 64, 0);
+        writer.Finish();
+        bench::DoNotOptimize(writer.Size());
+    });
+    bench::PrintResult(std::string(name) + ", 64 fields in 4 KiB", small);
+    std::printf("%-48s %14.2f\n", "  per field (ns)", small.ns_per_op / 64);
+}
+
+// Reads one field of every record, which builds the cache of each record
+uint64_t ReadRecords(const ObjectReader& root) {
+    uint64_t sum = 0;
+    auto records = root.ReadObjectArray(TAG_RECORDS);
+    for (const ObjectReader& record : *records) {
+        sum += record.ReadUInt32(TAGS[15]).value_or(0);
+    }
+    return sum;
+}
+
+template <typename ReaderType, typename... Args>
+void RunRead(const char* name, const void* data, size_t size, Args... args) {
+    auto validate = bench::RunBest([&] {
+        bench::DoNotOptimize(ReaderType::Validate(data, size, args...));
+    });
+    bench::PrintResult(std::string(name) + ", Validate", validate);
+
+    auto document = bench::RunBest([&] {
+        ReaderType reader(data, size, args..., IndexMode::Document);
+        bench::DoNotOptimize(reader.IsValid());
+    });
+    bench::PrintResult(std::string(name) + ", IndexMode::Document", document);
+
+    auto eager = bench::RunBest([&] {
+        ReaderType reader(data, size, args...);
+        bench::DoNotOptimize(ReadRecords(reader.RootObject()));
+    });
+    bench::PrintResult(std::string(name) + ", per-object caches", eager);
+    std::printf("%-48s %14.2f\n", "  per field (ns)", eager.ns_per_op / (RECORD_COUNT * 16));
+}
+
+}  // namespace
+
+int main() {
+    bench::PrintHeader("Name mode, writing (per document)");
+    RunWrite<Writer>("Writer", true);
+    RunWrite<NameWriter>("NameWriter");
+
+    bench::PrintHeader("ID mode, writing (per document)");
+    RunWrite<Writer>("Writer", false);
+    RunWrite<IdWriter>("IdWriter");
+
+    NameWriter names;
+    WriteRecords(names);
+    IdWriter ids;
+    WriteRecords(ids);
+
+    bench::PrintHeader("Name mode, 20000 records of 16 fields (per document)");
+    RunRead<Reader>("Reader", names.Data(), names.Size(), true);
+    RunRead<NameReader>("NameReader", names.Data(), names.Size());
+
+    bench::PrintHeader("ID mode, 20000 records of 16 fields (per document)");
+    RunRead<Reader>("Reader", ids.Data(), ids.Size(), false);
+    RunRead<IdReader>("IdReader", ids.Data(), ids.Size());
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+// Compares reading a document with the always-checked Reader against validating it once and then
+// reading it through a TrustedReader. Each pass reads every field of an array of objects, as a
+// pipeline that re-reads the same buffer would.
+
+#include "Benchmark.hpp"
+#include "tbf/DataTag.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <cstdint>
+#include <string>
+
+using namespace tbf;
+
+namespace {
+
+constexpr uint32_t ELEMENT_COUNT = 10000;
+
+constexpr DataTag TAG_SAMPLES = DataTag(1000, "samples");
+constexpr DataTag TAG_ID = DataTag(1, "id");
+constexpr DataTag TAG_NAME = DataTag(2, "name");
+constexpr DataTag TAG_VALUE = DataTag(3, "value");
+constexpr DataTag TAG_WEIGHT = DataTag(4, "weight");
+constexpr DataTag TAG_HISTORY = DataTag(5, "history");
+constexpr DataTag TAG_ACTIVE = DataTag(6, "active");
+
+void WriteSamples(Writer& writer) {
+    const int32_t history[] = {1, 2, 3, 4};
+
+    auto samples = writer.RootObject().FieldObjectArray(TAG_SAMPLES);
+    for (uint32_t i = 0; i < ELEMENT_COUNT; ++i) {
+        auto sample = samples.CreateElement();
+        sample.FieldInt64(TAG_ID, i);
+        sample.FieldString(TAG_NAME, "sample");
+        sample.FieldFloat64(TAG_VALUE, i * 0.5);
+        sample.FieldFloat32(TAG_WEIGHT, 1.0f);
+        sample.FieldArrayInt32(TAG_HISTORY, history, 4);
+        sample.FieldBoolean(TAG_ACTIVE, true);
+        sample.Finish();
+    }
+    samples.Finish();
+    writer.Finish();
+}
+
+template <typename ReaderType>
+double ReadAll(Writer& writer, bool name_based, IndexMode mode) {
+    ReaderType reader(writer.Data(), writer.Size(), name_based, mode);
+
+    double sum = 0;
+    auto samples = reader.RootObject().ReadObjectArray(TAG_SAMPLES);
+    for (const auto& sample : *samples) {
+        sum += static_cast<double>(sample.ReadInt64(TAG_ID).value_or(0));
+        sum += static_cast<double>(sample.ReadString(TAG_NAME).value_or("").size());
+        sum += sample.ReadFloat64(TAG_VALUE).value_or(0.0);
+        sum += sample.ReadFloat32(TAG_WEIGHT).value_or(0.0f);
+        sum += static_cast<double>(sample.ReadInt32Array(TAG_HISTORY).size());
+        sum += sample.ReadBoolean(TAG_ACTIVE).value_or(false) ? 1.0 : 0.0;
+    }
+    return sum;
+}
+
+}  // namespace
+
+int main() {
+    for (bool name_based : {true, false}) {
+        Writer writer(name_based);
+        WriteSamples(writer);
+
+        bench::PrintHeader(std::string(name_based ? "Name-based" : "ID-based") + " document, " + std::to_string(ELEMENT_COUNT) + " objects of 6 fields (per pass)");
+
+        auto validate = bench::RunBest([&] {
+            bench::DoNotOptimize(Reader::Validate(writer.Data(), writer.Size(), name_based));
+        });
+        bench::PrintResult("Validate", validate);
+
+        for (IndexMode mode : {IndexMode::Eager, IndexMode::Lazy}) {
+            const std::string label = mode == IndexMode::Eager ? "eager" : "lazy";
+
+            auto checked = bench::RunBest([&] {
+                bench::DoNotOptimize(ReadAll<Reader>(writer, name_based, mode));
+            });
+            bench::PrintResult("checked read, " + label, checked);
+
+            auto trusted = bench::RunBest([&] {
+                bench::DoNotOptimize(ReadAll<TrustedReader>(writer, name_based, mode));
+            });
+            bench::PrintResult("trusted read, " + label, trusted);
+        }
+    }
+
+    return 0;
+}
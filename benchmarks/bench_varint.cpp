@@ -0,0 +1,98 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+// Measures the encoded size of 1M ID-like integers as fixed 8 byte values against varints, and
+// decoding them with a DecodeVarint loop against the bulk DecodeVarints kernel.
+
+#include "Benchmark.hpp"
+#include "tbf/Varint.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+constexpr uint32_t ELEMENT_COUNT = 1 << 20;
+
+struct Distribution {
+    const char* name;
+    uint64_t (*generate)(std::mt19937_64& rng);
+};
+
+const Distribution DISTRIBUTIONS[] = {
+    {"small (< 128)", [](std::mt19937_64& rng) -> uint64_t { return rng() % 128; }},
+    {"mostly small, 1 in 8 up to 2^32", [](std::mt19937_64& rng) -> uint64_t {
+         return rng() % 8 == 0 ? rng() >> 32 : rng() % 128;
+     }},
+    {"IDs up to 2^20", [](std::mt19937_64& rng) -> uint64_t { return rng() % (1 << 20); }},
+    {"random lengths of 1 to 4 bytes", [](std::mt19937_64& rng) -> uint64_t {
+         return rng() >> (64 - 7 * (1 + rng() % 4));
+     }},
+};
+
+}  // namespace
+
+int main() {
+    std::vector<uint64_t> values(ELEMENT_COUNT);
+    std::vector<uint64_t> decoded(ELEMENT_COUNT);
+    std::vector<uint8_t> encoded(ELEMENT_COUNT * MAX_VARINT_SIZE);
+
+    for (const Distribution& distribution : DISTRIBUTIONS) {
+        std::mt19937_64 rng(17);
+        for (uint64_t& value : values) {
+            value = distribution.generate(rng);
+        }
+        const size_t encoded_size = EncodeVarints(values.data(), ELEMENT_COUNT, encoded.data());
+
+        bench::PrintHeader(std::string("Decoding ") + std::to_string(ELEMENT_COUNT) + " varints, " + distribution.name +
+                           " (per value)");
+        std::printf("%-48s %14zu\n", "  fixed 8 byte values (bytes)", static_cast<size_t>(ELEMENT_COUNT) * 8);
+        std::printf("%-48s %14zu\n", "  varints (bytes)", encoded_size);
+
+        auto loop = bench::RunBest([&] {
+            const uint8_t* src = encoded.data();
+            const uint8_t* end = src + encoded_size;
+            for (uint32_t i = 0; i < ELEMENT_COUNT; ++i) {
+                src += DecodeVarint(src, end, decoded[i]);
+            }
+            bench::DoNotOptimize(decoded.data());
+        });
+        loop.ns_per_op /= ELEMENT_COUNT;
+        bench::PrintResult("DecodeVarint loop", loop);
+
+        auto bulk = bench::RunBest([&] {
+            bench::DoNotOptimize(DecodeVarints(encoded.data(), encoded_size, decoded.data(), ELEMENT_COUNT));
+        });
+        bulk.ns_per_op /= ELEMENT_COUNT;
+        bench::PrintResult("DecodeVarints", bulk);
+    }
+
+    return 0;
+}
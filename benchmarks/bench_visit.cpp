@@ -0,0 +1,115 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+// Measures streaming over every field of an array of objects with ObjectReader::Visit against
+// reading the same values through indexed ObjectReaders, and the cost of stepping over a subtree
+// that the visitor skips.
+
+#include "Benchmark.hpp"
+#include "tbf/DataTag.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <cstdint>
+#include <string>
+
+using namespace tbf;
+
+namespace {
+
+constexpr uint32_t ELEMENT_COUNT = 10000;
+constexpr uint32_t FIELD_COUNT = 16;
+
+constexpr DataTag TAG_SAMPLES = DataTag(1000, "samples");
+
+DataTag FieldTag(uint32_t field) {
+    return DataTag(static_cast<DataTag::Id>(field + 1));
+}
+
+void WriteSamples(Writer& writer) {
+    auto samples = writer.RootObject().FieldObjectArray(TAG_SAMPLES);
+    for (uint32_t i = 0; i < ELEMENT_COUNT; ++i) {
+        auto sample = samples.CreateElement();
+        for (uint32_t field = 0; field < FIELD_COUNT; ++field) {
+            sample.FieldInt32(FieldTag(field), static_cast<int32_t>(i + field));
+        }
+        sample.Finish();
+    }
+    samples.Finish();
+    writer.Finish();
+}
+
+}  // namespace
+
+int main() {
+    Writer writer(false);
+    WriteSamples(writer);
+
+    bench::PrintHeader("Sum of " + std::to_string(ELEMENT_COUNT) + " objects of " + std::to_string(FIELD_COUNT) + " fields (per field)");
+
+    for (IndexMode mode : {IndexMode::Eager, IndexMode::Lazy}) {
+        auto result = bench::RunBest([&] {
+            Reader reader(writer.Data(), writer.Size(), false, mode);
+            int64_t sum = 0;
+            auto samples = reader.RootObject().ReadObjectArray(TAG_SAMPLES);
+            for (const auto& sample : *samples) {
+                for (uint32_t field = 0; field < FIELD_COUNT; ++field) {
+                    sum += sample.ReadInt32(FieldTag(field)).value_or(0);
+                }
+            }
+            bench::DoNotOptimize(sum);
+        });
+        result.ns_per_op /= ELEMENT_COUNT * FIELD_COUNT;
+        bench::PrintResult(mode == IndexMode::Eager ? "indexed reads, eager" : "indexed reads, lazy", result);
+    }
+
+    auto visit = bench::RunBest([&] {
+        Reader reader(writer.Data(), writer.Size(), false, IndexMode::Lazy);
+        int64_t sum = 0;
+        reader.RootObject().Visit([&sum](const FieldView& field) {
+            int32_t value;
+            if (field.Get<DataType::Int32>(value)) {
+                sum += value;
+            }
+            return VisitAction::Continue;
+        });
+        bench::DoNotOptimize(sum);
+    });
+    visit.ns_per_op /= ELEMENT_COUNT * FIELD_COUNT;
+    bench::PrintResult("Visit", visit);
+
+    auto skip = bench::RunBest([&] {
+        Reader reader(writer.Data(), writer.Size(), false, IndexMode::Lazy);
+        uint32_t fields = 0;
+        reader.RootObject().Visit([&fields](const FieldView&) {
+            fields++;
+            return VisitAction::Skip;
+        });
+        bench::DoNotOptimize(fields);
+    });
+    bench::PrintResult("Visit skipping the array (per document)", skip);
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+// Measures building documents of 10 MB, 100 MB and 1 GB of small records, each a few scalar fields
+// and a 200 byte Binary field, and reading them back as one block through Writer::Data, which
+// coalesces the chunks of the buffer, or as the chunks themselves through Writer::Segments.
+
+#include "Benchmark.hpp"
+#include "tbf/DataTag.hpp"
+#include "tbf/Writer.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+constexpr DataTag TAG_RECORDS = "records";
+constexpr DataTag TAG_ID = "id";
+constexpr DataTag TAG_NAME = "name";
+constexpr DataTag TAG_SCORE = "score";
+constexpr DataTag TAG_PAYLOAD = "payload";
+
+constexpr size_t PAYLOAD_SIZE = 200;
+
+void WriteRecords(Writer& writer, size_t document_size, const uint8_t* payload) {
+    auto records = writer.RootObject().FieldObjectArray(TAG_RECORDS);
+    for (uint64_t i = 0; writer.Size() < document_size; i++) {
+        ObjectWriter record = records.CreateElement();
+        record.FieldUInt64(TAG_ID, i);
+        record.FieldString(TAG_NAME, "record-name-0001");
+        record.FieldFloat64(TAG_SCORE, static_cast<double>(i) * 0.5);
+        record.FieldBinary(TAG_PAYLOAD, payload, PAYLOAD_SIZE);
+        record.Finish();
+    }
+    records.Finish();
+    writer.Finish();
+}
+
+void RunDocument(const char* name, size_t document_size, uint32_t repetitions) {
+    std::vector<uint8_t> payload(PAYLOAD_SIZE);
+    for (size_t i = 0; i < payload.size(); i++) {
+        payload[i] = static_cast<uint8_t>(i);
+    }
+
+    bench::PrintHeader(std::string(name) + " document of 268 byte records (per document)");
+
+    // One build per run, documents this large take long enough to time on their own
+    auto build = bench::RunBest([&] {
+        Writer writer(true);
+        WriteRecords(writer, document_size, payload.data());
+        bench::DoNotOptimize(writer.Segments().size());
+    }, repetitions, 0.0);
+    bench::PrintResult("Build", build);
+    std::printf("%-48s %14.2f\n", "  Build (GB/s)", static_cast<double>(document_size) / build.ns_per_op);
+
+    auto coalesce = bench::RunBest([&] {
+        Writer writer(true);
+        WriteRecords(writer, document_size, payload.data());
+        bench::DoNotOptimize(writer.Data());
+    }, repetitions, 0.0);
+    bench::PrintResult("Build + Data()", coalesce);
+
+    Writer writer(true);
+    WriteRecords(writer, document_size, payload.data());
+    std::printf("%-48s %14zu\n", "  document (bytes)", writer.Size());
+    std::printf("%-48s %14zu\n", "  chunks", writer.Segments().size());
+}
+
+}  // namespace
+
+int main() {
+    RunDocument("10 MB", 10'000'000, 5);
+    RunDocument("100 MB", 100'000'000, 3);
+    RunDocument("1 GB", 1'000'000'000, 1);
+
+    return 0;
+}
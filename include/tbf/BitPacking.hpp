@@ -0,0 +1,100 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tbf {
+
+// Packed bits hold element i in bit i % 8 of byte i / 8, so `count` elements take (count + 7) / 8
+// bytes. Unused bits of the last byte are written as zero and ignored when read.
+
+inline constexpr size_t PackedBitsSize(size_t count) noexcept {
+    return (count + 7) / 8;
+}
+
+inline constexpr bool GetPackedBit(const uint8_t* bits, size_t index) noexcept {
+    return (bits[index / 8] >> (index % 8)) & 1;
+}
+
+// Packs `count` bools into PackedBitsSize(count) bytes of `dest`. Any non-zero byte counts as true.
+void PackBooleans(const bool* src, uint8_t* dest, size_t count) noexcept;
+
+// Unpacks `count` elements into bools
+void UnpackBooleans(const uint8_t* src, bool* dest, size_t count) noexcept;
+
+// Number of set elements
+size_t CountSetBits(const uint8_t* bits, size_t count) noexcept;
+
+// Index of the first element at or after `from` equal to `value`, or `count` if there is none
+size_t FindFirstBit(const uint8_t* bits, size_t count, bool value, size_t from = 0) noexcept;
+
+enum class BitOperation : uint8_t {
+    And,
+    Or,
+    Xor,
+    AndNot,  // Set in the first operand and not in the second
+};
+
+// Applies `operation` to `count` elements of `a` and `b`, writing the packed result to `dest`,
+// which may be one of the operands
+void CombineBits(const uint8_t* a, const uint8_t* b, uint8_t* dest, size_t count, BitOperation operation) noexcept;
+
+// Number of set elements in the result of `operation`, without writing it out
+size_t CountCombinedBits(const uint8_t* a, const uint8_t* b, size_t count, BitOperation operation) noexcept;
+
+// Packed codes extend packed bits to `width` bits per element, from 0 to 32. Element i takes bits
+// i * width to (i + 1) * width - 1 of the bytes, least significant first, so codes of width 1 are
+// laid out like packed bits.
+
+inline constexpr size_t PackedCodesSize(size_t count, uint32_t width) noexcept {
+    return (count * width + 7) / 8;
+}
+
+inline constexpr uint32_t GetPackedCode(const uint8_t* codes, size_t index, uint32_t width) noexcept {
+    if (width == 0) {
+        return 0;
+    }
+
+    const size_t bit = index * width;
+    const size_t first = bit / 8;
+    const size_t last = (bit + width - 1) / 8;
+    uint64_t word = 0;
+    for (size_t byte = first; byte <= last; ++byte) {
+        word |= static_cast<uint64_t>(codes[byte]) << (8 * (byte - first));
+    }
+    return static_cast<uint32_t>((word >> (bit % 8)) & ((uint64_t(1) << width) - 1));
+}
+
+// Packs `count` codes into PackedCodesSize(count, width) bytes of `dest`. Every code must fit in
+// `width` bits.
+void PackCodes(const uint32_t* src, uint8_t* dest, size_t count, uint32_t width) noexcept;
+
+// Unpacks `count` codes
+void UnpackCodes(const uint8_t* src, uint32_t* dest, size_t count, uint32_t width) noexcept;
+
+}  // namespace tbf
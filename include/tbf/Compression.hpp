@@ -0,0 +1,66 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tbf {
+
+// A byte oriented LZ77 codec in the speed class of LZ4, used for Compressed fields. The compressed
+// data is a sequence of
+//
+//   [Token: u8] [Literal length: 0+ bytes] [Literals] [Offset: u16] [Match length: 0+ bytes]
+//
+// The high nibble of the token is the number of literals and the low nibble the match length minus
+// MIN_MATCH_LENGTH. A nibble of 15 is followed by bytes added to it, up to and including the first
+// one below 255. The match copies `match length` bytes starting `offset` bytes back in the output,
+// and may overlap the bytes it produces. The last sequence ends after its literals and has no match.
+
+inline constexpr uint32_t MIN_MATCH_LENGTH = 4;
+inline constexpr uint32_t MAX_MATCH_OFFSET = 65535;
+
+// Upper bound of the bytes CompressBlock writes for `size` bytes of input
+inline constexpr size_t MaxCompressedSize(size_t size) noexcept {
+    return size + size / 255 + 16;
+}
+
+// Upper bound of the bytes `size` bytes of compressed data can decompress to. Every compressed byte
+// produces at most 255 bytes.
+inline constexpr size_t MaxDecompressedSize(size_t size) noexcept {
+    return size * 255;
+}
+
+// Compresses `size` bytes into `dest`, which needs room for MaxCompressedSize(size) bytes. Returns
+// the number of bytes written.
+size_t CompressBlock(const uint8_t* src, size_t size, uint8_t* dest) noexcept;
+
+// Decompresses the `size` bytes at `src`, which must decompress to exactly `raw_size` bytes, into
+// `dest`. Returns false if they do not or the data is malformed, in which case `dest` holds partial
+// results. Nothing is read or written out of either buffer.
+bool DecompressBlock(const uint8_t* src, size_t size, uint8_t* dest, size_t raw_size) noexcept;
+
+}  // namespace tbf
@@ -25,7 +25,12 @@
 
 #pragma once
 
+#include "tbf/Endianness.hpp"
+
+#include <array>
+#include <bit>
 #include <cstdint>
+#include <cstring>
 #include <stdexcept>
 #include <string_view>
 
@@ -77,6 +82,64 @@ consteval uint32_t TagNameHash(std::string_view str) {
     return hash;
 }
 
+namespace detail {
+
+template <typename Word>
+[[gnu::always_inline]]
+constexpr Word LoadTagWord(const char* data) noexcept {
+    if !consteval {
+        Word word;
+        std::memcpy(&word, data, sizeof(Word));
+        if constexpr (std::endian::native == std::endian::big) {
+            word = std::byteswap(word);
+        }
+        return word;
+    }
+
+    Word word = 0;
+    for (size_t i = 0; i < sizeof(Word); ++i) {
+        word |= static_cast<Word>(static_cast<uint8_t>(data[i])) << (i * 8);
+    }
+    return word;
+}
+
+[[gnu::always_inline]]
+constexpr uint64_t MixTagWord(uint64_t hash, uint64_t word) noexcept {
+    hash = (hash ^ word) * 0xBF58476D1CE4E5B9ull;
+    return hash ^ (hash >> 31);
+}
+
+}  // namespace detail
+
+// Hash used to look tag names up in name-based mode. Unlike TagNameHash, which defines the ID of
+// named tags, it is not part of the format. It reads names eight bytes at a time with overlapping
+// loads instead of hashing them byte by byte, and gives the same result at compile time.
+constexpr uint32_t TagLookupHash(std::string_view name) noexcept {
+    const char* data = name.data();
+    const size_t size = name.size();
+
+    uint64_t hash = size * 0x9E3779B97F4A7C15ull;
+
+    if (size >= 8) {
+        size_t offset = 0;
+        for (; offset + 8 < size; offset += 8) {
+            hash = detail::MixTagWord(hash, detail::LoadTagWord<uint64_t>(data + offset));
+        }
+        hash = detail::MixTagWord(hash, detail::LoadTagWord<uint64_t>(data + size - 8));
+    } else if (size >= 4) {
+        uint64_t low = detail::LoadTagWord<uint32_t>(data);
+        uint64_t high = detail::LoadTagWord<uint32_t>(data + size - 4);
+        hash = detail::MixTagWord(hash, low | (high << 32));
+    } else if (size > 0) {
+        uint64_t word = static_cast<uint8_t>(data[0]) | (static_cast<uint64_t>(static_cast<uint8_t>(data[size / 2])) << 8) |
+                        (static_cast<uint64_t>(static_cast<uint8_t>(data[size - 1])) << 16);
+        hash = detail::MixTagWord(hash, word);
+    }
+
+    hash = detail::MixTagWord(hash, 0);
+    return static_cast<uint32_t>(hash ^ (hash >> 32));
+}
+
 class DataTag {
    public:
     using Id = uint16_t;
@@ -85,10 +148,21 @@ class DataTag {
    public:
     static constexpr Id INVALID_ID = 0;
 
+    // Tags created at compile time with names of up to MAX_ENCODED_NAME_LENGTH characters carry their
+    // name-based field header pre-encoded, see GetNameHeader
+    static constexpr size_t NAME_HEADER_SIZE = 16;
+    static constexpr size_t MAX_ENCODED_NAME_LENGTH = NAME_HEADER_SIZE - 2;
+
    private:
     Id id;
+    Id wire_id;     // The ID in the byte order of the buffer
+    uint32_t hash;  // TagLookupHash of the name
     std::string_view name;
 
+    // [Type] [Name size] [Name], the field header of name-based mode. Writers overwrite the type,
+    // which is 1 if the header is encoded and 0 if not.
+    std::array<uint8_t, NAME_HEADER_SIZE> name_header;
+
    private:
     void consteval Validate() const {
         if (!IsTagNameValid(name)) {
@@ -100,27 +174,72 @@ class DataTag {
         }
     }
 
+    static constexpr Id EncodeId(Id id) noexcept {
+        return NEEDS_BYTE_SWAP ? std::byteswap(id) : id;
+    }
+
+    static consteval std::array<uint8_t, NAME_HEADER_SIZE> EncodeNameHeader(std::string_view name) {
+        std::array<uint8_t, NAME_HEADER_SIZE> header{};
+        if (name.size() <= MAX_ENCODED_NAME_LENGTH) {
+            header[0] = 1;
+            header[1] = static_cast<uint8_t>(name.size());
+            for (size_t i = 0; i < name.size(); i++) {
+                header[2 + i] = static_cast<uint8_t>(name[i]);
+            }
+        }
+        return header;
+    }
+
    public:
-    consteval DataTag(const char* name) : id(static_cast<Id>(TagNameHash(name))), name(name) {
+    consteval DataTag(const char* name)
+        : id(static_cast<Id>(TagNameHash(name))),
+          wire_id(EncodeId(id)),
+          hash(TagLookupHash(name)),
+          name(name),
+          name_header(EncodeNameHeader(name)) {
         Validate();
     }
 
-    consteval DataTag(Id id, const char* name) : id(id), name(name) {
+    consteval DataTag(Id id, const char* name)
+        : id(id),
+          wire_id(EncodeId(id)),
+          hash(TagLookupHash(name)),
+          name(name),
+          name_header(EncodeNameHeader(name)) {
         Validate();
     }
 
-    Id GetId() const noexcept { return id; }
-    std::string_view GetName() const noexcept { return name; }
-    bool HasId() const noexcept { return id != INVALID_ID; }
+    constexpr Id GetId() const noexcept { return id; }
+    constexpr uint32_t GetHash() const noexcept { return hash; }
+    constexpr std::string_view GetName() const noexcept { return name; }
+    constexpr bool HasId() const noexcept { return id != INVALID_ID; }
+
+    // The tag as writers store it. Writers copy all NAME_HEADER_SIZE bytes of the name header, then
+    // set the type byte. Tags created at run time, as readers do, skip encoding the header and are
+    // written from their name instead.
+    constexpr Id GetWireId() const noexcept { return wire_id; }
+    constexpr bool HasNameHeader() const noexcept { return name_header[0] != 0; }
+    constexpr const uint8_t* GetNameHeader() const noexcept { return name_header.data(); }
 
-    explicit DataTag(Id id) noexcept : id(id), name() {}
-    explicit DataTag(std::string_view name) noexcept : id(INVALID_ID), name(name) {}
+    explicit DataTag(Id id) noexcept
+        : id(id),
+          wire_id(EncodeId(id)),
+          hash(TagLookupHash(std::string_view())),
+          name(),
+          name_header() {}
+
+    explicit DataTag(std::string_view name) noexcept
+        : id(INVALID_ID),
+          wire_id(INVALID_ID),
+          hash(TagLookupHash(name)),
+          name(name),
+          name_header() {}
 
     bool operator==(const DataTag& other) const noexcept {
         if (HasId() && other.HasId()) {
             return id == other.id;
         }
-        return name == other.name;
+        return hash == other.hash && name == other.name;
     }
 
     bool operator!=(const DataTag& other) const noexcept {
@@ -128,4 +247,12 @@ class DataTag {
     }
 };
 
+// Whether a document stores tags as names or as IDs. Runtime leaves the choice to a constructor
+// argument, Name and Id fix it at compile time for writers and readers that only handle one.
+enum class TagMode : uint8_t {
+    Runtime,
+    Name,
+    Id,
+};
+
 }  // namespace tbf
\ No newline at end of file
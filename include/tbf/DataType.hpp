@@ -39,7 +39,15 @@ enum class DataType : uint8_t {
     // Classification bits
 
     Raw = 0x00,
+    Varint = 0x10,
     Array = 0xA0,
+    IndexedArray = 0xB0,
+    PackedArray = 0xC0,
+    VarintArray = 0xD0,
+
+    // A size prefixed field whose payload is compressed, see Compression.hpp. The type of the field
+    // it wraps follows the size.
+    Compressed = 0xE0,
 
     Vector2 = 0x20,
     Vector3 = 0x30,
@@ -72,6 +80,11 @@ enum class DataType : uint8_t {
     Binary = Raw | NonPrimitive | 0b10,
     Object = Raw | NonPrimitive | 0b11,
 
+    // Varint, a 64 bit integer stored in as few bytes as its value needs
+
+    VarInt64 = Varint | Int64,
+    VarUInt64 = Varint | UInt64,
+
     // Vector2
 
     Vector2i8 = Vector2 | Int8,
@@ -130,6 +143,28 @@ enum class DataType : uint8_t {
     BinaryArray = Array | Binary,
     ObjectArray = Array | Object,
 
+    // Indexed array, a variable-size element array followed by an offset table
+
+    IndexedStringArray = IndexedArray | String,
+    IndexedBinaryArray = IndexedArray | Binary,
+    IndexedObjectArray = IndexedArray | Object,
+
+    // Packed array, an array stored in a denser encoding than one element after another
+
+    PackedBooleanArray = PackedArray | Boolean,
+
+    PackedInt32Array = PackedArray | Int32,
+    PackedInt64Array = PackedArray | Int64,
+    PackedUInt32Array = PackedArray | UInt32,
+    PackedUInt64Array = PackedArray | UInt64,
+
+    DictionaryStringArray = PackedArray | String,
+
+    // Varint array, an element count followed by that many varints
+
+    VarInt64Array = VarintArray | Int64,
+    VarUInt64Array = VarintArray | UInt64,
+
     // Error value
 
     Invalid = 0xFF
@@ -152,22 +187,64 @@ inline constexpr bool IsVectorType(DataType type) {
     return classification >= static_cast<uint8_t>(DataType::Vector2) && classification <= static_cast<uint8_t>(DataType::Vector4);
 }
 
+inline constexpr bool IsIndexedArrayType(DataType type) {
+    return TypeClassification(type) == DataType::IndexedArray;
+}
+
+inline constexpr bool IsVarintType(DataType type) {
+    return TypeClassification(type) == DataType::Varint;
+}
+
+inline constexpr bool IsPackedArrayType(DataType type) {
+    return TypeClassification(type) == DataType::PackedArray;
+}
+
+inline constexpr bool IsVarintArrayType(DataType type) {
+    return TypeClassification(type) == DataType::VarintArray;
+}
+
+// Arrays whose elements are not stored one after another at a fixed size. They are size prefixed
+// like every array, but are read through their own readers and not included in IsArrayType.
+inline constexpr bool IsEncodedArrayType(DataType type) {
+    return IsPackedArrayType(type) || IsVarintArrayType(type);
+}
+
+inline constexpr bool IsCompressedType(DataType type) {
+    return type == DataType::Compressed;
+}
+
 inline constexpr bool IsArrayType(DataType type) {
-    return TypeClassification(type) == DataType::Array;
+    return TypeClassification(type) == DataType::Array || IsIndexedArrayType(type);
 }
 
 inline constexpr bool IsDynamicArrayType(DataType type) {
-    return type == DataType::StringArray || type == DataType::BinaryArray || type == DataType::ObjectArray;
+    return IsArrayType(type) && (BaseDataType(type) == DataType::String || BaseDataType(type) == DataType::Binary ||
+                                 BaseDataType(type) == DataType::Object);
 }
 
 inline constexpr bool IsFixedSizeArrayType(DataType type) {
     return IsArrayType(type) && !IsDynamicArrayType(type);
 }
 
+// Fields whose payload is a u32 size followed by that many bytes, the ones that can be compressed
+inline constexpr bool IsCompressibleType(DataType type) {
+    return type == DataType::Object || type == DataType::Binary || IsArrayType(type) || IsEncodedArrayType(type);
+}
+
 inline constexpr DataType PrimitiveToArrayType(DataType primitive) {
     return static_cast<DataType>(static_cast<uint8_t>(primitive) | static_cast<uint8_t>(DataType::Array));
 }
 
+// Maps an indexed array type to the plain array type with the same elements, any other type is
+// returned unchanged. Readers accept both layouts wherever the plain type is expected.
+inline constexpr DataType PlainArrayType(DataType type) {
+    return IsIndexedArrayType(type) ? PrimitiveToArrayType(BaseDataType(type)) : type;
+}
+
+inline constexpr DataType IndexedArrayType(DataType array_type) {
+    return static_cast<DataType>(static_cast<uint8_t>(BaseDataType(array_type)) | static_cast<uint8_t>(DataType::IndexedArray));
+}
+
 inline constexpr bool IsPrimitive(DataType type) {
     return (static_cast<uint8_t>(type) & 0b1100) != 0b1100;
 }
@@ -178,6 +255,25 @@ inline constexpr bool IsValidDataType(DataType type) {
             return true;
         case DataType::Array:
             return true;
+        case DataType::IndexedArray:
+            return IsDynamicArrayType(type);
+        case DataType::PackedArray:
+            switch (type) {
+                case DataType::PackedBooleanArray:
+                case DataType::PackedInt32Array:
+                case DataType::PackedInt64Array:
+                case DataType::PackedUInt32Array:
+                case DataType::PackedUInt64Array:
+                case DataType::DictionaryStringArray:
+                    return true;
+                default:
+                    return false;
+            }
+        case DataType::Compressed:
+            return type == DataType::Compressed;
+        case DataType::Varint:
+        case DataType::VarintArray:
+            return BaseDataType(type) == DataType::Int64 || BaseDataType(type) == DataType::UInt64;
         case DataType::Vector2:
         case DataType::Vector3:
         case DataType::Vector4:
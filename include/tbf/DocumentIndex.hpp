@@ -0,0 +1,209 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#pragma once
+
+#include "tbf/DataTag.hpp"
+#include "tbf/DataType.hpp"
+#include "tbf/FieldIndex.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+namespace tbf {
+
+// Index of every object in a document, built by a single pass over the buffer. The fields of all
+// objects live in one contiguous array and each object owns a range of it in wire order, so nested
+// ObjectReaders are views into the shared index instead of building a cache of their own. The
+// elements of an object array occupy consecutive objects, which makes element access O(1).
+//
+// Objects with more than LINEAR_SCAN_LIMIT fields also get an open-addressing table of field
+// positions, stored in a single array shared by the whole document.
+class DocumentIndex {
+   public:
+    static constexpr uint32_t LINEAR_SCAN_LIMIT = 8;
+    static constexpr size_t INITIAL_FIELD_CAPACITY = 1024;
+    static constexpr size_t INITIAL_OBJECT_CAPACITY = 256;
+
+    struct Object {
+        uint32_t offset;  // First field, relative to the start of the document
+        FieldSize size;
+        uint32_t first_field;
+        uint32_t field_count;
+        uint32_t table_offset;
+        uint32_t table_mask;  // Zero when the fields are scanned linearly
+        bool valid;
+    };
+
+   private:
+    struct Field {
+        CacheValue value;
+        uint32_t key;          // Tag ID or TagLookupHash of the name
+        uint32_t object;       // See CacheEntry::object
+        uint32_t name_offset;  // Relative to the start of the document (name-based mode only)
+        DataType type;
+        DataTag::NameSize name_size;
+        bool duplicate;  // A previous field of the object has the same tag
+    };
+
+   private:
+    const uint8_t* m_base = nullptr;
+    bool m_name_based = false;
+    bool m_trusted = false;
+
+    std::pmr::vector<Object> m_objects;
+    std::pmr::vector<Field> m_fields;
+    std::pmr::vector<uint32_t> m_table;  // Field position + 1, zero marks an empty slot
+
+   public:
+    explicit DocumentIndex(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept
+        : m_objects(resource), m_fields(resource), m_table(resource) {}
+
+    DocumentIndex(const DocumentIndex&) = delete;
+    DocumentIndex& operator=(const DocumentIndex&) = delete;
+
+    // Indexes the document in `buffer`, whose root object is object 0. Returns whether the root
+    // object is valid. Malformed nested objects are marked invalid without affecting their parent.
+    // Trusted builds skip the bounds and type checks, see TrustedReader.
+    bool Build(const void* buffer, size_t size, bool name_based, bool trusted = false) noexcept;
+    void Clear() noexcept;
+
+    inline bool IsNameBased() const noexcept { return m_name_based; }
+    inline uint32_t ObjectCount() const noexcept { return static_cast<uint32_t>(m_objects.size()); }
+    inline uint32_t FieldCount() const noexcept { return static_cast<uint32_t>(m_fields.size()); }
+    inline const Object& GetObject(uint32_t object) const noexcept { return m_objects[object]; }
+    inline const uint8_t* ObjectData(uint32_t object) const noexcept { return m_base + m_objects[object].offset; }
+    inline std::pmr::memory_resource* GetResource() const noexcept { return m_objects.get_allocator().resource(); }
+
+    // `cursor` is the position of the field expected next in wire order. It is checked before any
+    // other field and moved past the field found.
+    [[gnu::always_inline]]
+    inline bool Find(uint32_t object, const DataTag& tag, uint32_t& cursor, CacheEntry& out_entry) const noexcept {
+        const Object& range = m_objects[object];
+
+        uint32_t position;
+        if (m_name_based) {
+            position = FindPosition<true>(range, tag.GetHash(), tag.GetName(), cursor);
+        } else {
+            position = FindPosition<false>(range, tag.GetId(), std::string_view(), cursor);
+        }
+
+        if (position == FieldIndex::NOT_FOUND) {
+            return false;
+        }
+
+        const Field& field = m_fields[range.first_field + position];
+        out_entry = {.type = field.type, .object = field.object, .value = field.value};
+        cursor = position + 1;
+        return true;
+    }
+
+    // Visits the fields of `object` in wire order, skipping duplicated tags
+    template <typename Callback>
+    void ForEach(uint32_t object, Callback&& callback) const {
+        const Object& range = m_objects[object];
+        for (uint32_t i = range.first_field; i < range.first_field + range.field_count; ++i) {
+            const Field& field = m_fields[i];
+            if (field.duplicate) {
+                continue;
+            }
+
+            CacheEntry entry = {.type = field.type, .object = field.object, .value = field.value};
+            if (m_name_based) {
+                callback(DataTag(FieldName(field)), entry);
+            } else {
+                callback(DataTag(static_cast<DataTag::Id>(field.key)), entry);
+            }
+        }
+    }
+
+   private:
+    [[gnu::always_inline]]
+    static inline uint32_t SlotIndex(uint32_t key, uint32_t mask) noexcept {
+        return static_cast<uint32_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+    }
+
+    inline std::string_view FieldName(const Field& field) const noexcept {
+        return std::string_view(reinterpret_cast<const char*>(m_base) + field.name_offset, field.name_size);
+    }
+
+    template <bool name_based>
+    [[gnu::always_inline]]
+    inline bool Matches(const Field& field, uint32_t key, std::string_view name) const noexcept {
+        if constexpr (name_based) {
+            return field.key == key && FieldName(field) == name;
+        } else {
+            return field.key == key;
+        }
+    }
+
+    template <bool name_based>
+    [[gnu::always_inline]]
+    inline uint32_t FindPosition(const Object& object, uint32_t key, std::string_view name, uint32_t cursor) const noexcept {
+        const Field* fields = m_fields.data() + object.first_field;
+
+        if (cursor < object.field_count && !fields[cursor].duplicate && Matches<name_based>(fields[cursor], key, name)) [[likely]] {
+            return cursor;
+        }
+
+        if (object.table_mask == 0) {
+            // Duplicated tags keep their first occurrence, which a forward scan finds first
+            for (uint32_t i = 0; i < object.field_count; ++i) {
+                if (Matches<name_based>(fields[i], key, name)) {
+                    return i;
+                }
+            }
+            return FieldIndex::NOT_FOUND;
+        }
+
+        const uint32_t* table = m_table.data() + object.table_offset;
+        for (uint32_t i = SlotIndex(key, object.table_mask);; i = (i + 1) & object.table_mask) {
+            uint32_t position = table[i];
+            if (position == 0) {
+                return FieldIndex::NOT_FOUND;
+            }
+
+            if (Matches<name_based>(fields[position - 1], key, name)) [[likely]] {
+                return position - 1;
+            }
+        }
+    }
+
+    uint32_t AddObject(const void* object_ptr) noexcept;
+    uint32_t AddArrayElements(const void* array_ptr, DataType array_type) noexcept;
+
+    // Instantiated for each parse mode, which Build chooses once for the whole document
+    template <bool trusted, bool name_based>
+    void IndexObjects() noexcept;
+    template <bool trusted, bool name_based>
+    void IndexObject(uint32_t object) noexcept;
+
+    void BuildLookup(Object& object) noexcept;
+};
+
+}  // namespace tbf
@@ -25,18 +25,36 @@
 
 #pragma once
 
+#include <array>
 #include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+
+#if defined(__SSSE3__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace tbf {
 
+// Byte order of the wire format. Building with TBF_FORCE_BYTE_SWAP flips it to the opposite of the
+// host, so the byte swapping paths run on little-endian machines. Buffers written that way can only
+// be read by builds with the same setting, the option exists for testing and benchmarking.
+#ifdef TBF_FORCE_BYTE_SWAP
+constexpr std::endian TBF_ENDIANESS = std::endian::native == std::endian::little ? std::endian::big : std::endian::little;
+#else
 constexpr std::endian TBF_ENDIANESS = std::endian::little;
+#endif
+
+// Multi-byte values of a buffer differ from the host representation and are swapped when read
+constexpr bool NEEDS_BYTE_SWAP = std::endian::native != TBF_ENDIANESS;
 
 template <typename Type>
 [[gnu::always_inline]]
 inline void AdjustEndianess(Type& value) {
-    if constexpr (std::endian::native != TBF_ENDIANESS) {
+    if constexpr (NEEDS_BYTE_SWAP) {
         if constexpr (sizeof(Type) == 2) {
             value = std::bit_cast<Type>(std::byteswap(std::bit_cast<uint16_t>(value)));
         } else if constexpr (sizeof(Type) == 4) {
@@ -47,27 +65,123 @@ inline void AdjustEndianess(Type& value) {
     }
 }
 
+namespace detail {
+
+template <uint32_t size>
+struct SwapWord;
+
+template <>
+struct SwapWord<2> {
+    using Type = uint16_t;
+};
+
+template <>
+struct SwapWord<4> {
+    using Type = uint32_t;
+};
+
+template <>
+struct SwapWord<8> {
+    using Type = uint64_t;
+};
+
+// Shuffle control reversing the bytes of every `size` byte element of a 16 byte lane, repeated for
+// both lanes of a 32 byte register
+template <uint32_t size>
+consteval std::array<uint8_t, 32> ByteSwapShuffle() {
+    std::array<uint8_t, 32> shuffle{};
+    for (uint32_t i = 0; i < 32; ++i) {
+        uint32_t lane_byte = i % 16;
+        shuffle[i] = static_cast<uint8_t>(lane_byte - lane_byte % size + (size - 1 - lane_byte % size));
+    }
+    return shuffle;
+}
+
+template <uint32_t size>
+alignas(32) inline constexpr std::array<uint8_t, 32> BYTE_SWAP_SHUFFLE = ByteSwapShuffle<size>();
+
+template <uint32_t size>
+inline void ByteSwapScalar(uint8_t* dest, const uint8_t* src, size_t count) noexcept {
+    using Word = typename SwapWord<size>::Type;
+    for (size_t i = 0; i < count; ++i) {
+        Word word;
+        std::memcpy(&word, src + i * size, size);
+        word = std::byteswap(word);
+        std::memcpy(dest + i * size, &word, size);
+    }
+}
+
+}  // namespace detail
+
+// Reverses the bytes of `count` elements of `size` bytes from `src` into `dest`, which may be the
+// same buffer but must not partially overlap it. Whole 32 and 16 byte blocks go through AVX2,
+// SSSE3 or NEON shuffles when the target supports them, the remaining elements one by one.
 template <uint32_t size>
     requires(size == 1 || size == 2 || size == 4 || size == 8)
-inline void AdjustArrayEndianess(void* data, size_t count) {
-    if constexpr (size > 1 && std::endian::native != TBF_ENDIANESS) {
-        if constexpr (size == 2) {
-            int16_t* int_data = static_cast<int16_t*>(data);
-            for (size_t i = 0; i < count; ++i) {
-                int_data[i] = std::byteswap(int_data[i]);
-            }
-        } else if constexpr (size == 4) {
-            int32_t* int_data = static_cast<int32_t*>(data);
-            for (size_t i = 0; i < count; ++i) {
-                int_data[i] = std::byteswap(int_data[i]);
-            }
-        } else if constexpr (size == 8) {
-            int64_t* int_data = static_cast<int64_t*>(data);
-            for (size_t i = 0; i < count; ++i) {
-                int_data[i] = std::byteswap(int_data[i]);
+inline void ByteSwapArray(void* dest, const void* src, size_t count) noexcept {
+    uint8_t* out = static_cast<uint8_t*>(dest);
+    const uint8_t* in = static_cast<const uint8_t*>(src);
+
+    if constexpr (size == 1) {
+        if (out != in) {
+            std::memmove(out, in, count);
+        }
+    } else {
+        const size_t bytes = count * size;
+        size_t offset = 0;
+
+#if defined(__AVX2__)
+        const __m256i shuffle_256 = _mm256_load_si256(reinterpret_cast<const __m256i*>(detail::BYTE_SWAP_SHUFFLE<size>.data()));
+        for (; offset + 32 <= bytes; offset += 32) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + offset));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + offset), _mm256_shuffle_epi8(block, shuffle_256));
+        }
+#endif
+
+#if defined(__SSSE3__)
+        const __m128i shuffle_128 = _mm_load_si128(reinterpret_cast<const __m128i*>(detail::BYTE_SWAP_SHUFFLE<size>.data()));
+        for (; offset + 16 <= bytes; offset += 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + offset));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + offset), _mm_shuffle_epi8(block, shuffle_128));
+        }
+#elif defined(__ARM_NEON)
+        for (; offset + 16 <= bytes; offset += 16) {
+            uint8x16_t block = vld1q_u8(in + offset);
+            if constexpr (size == 2) {
+                block = vrev16q_u8(block);
+            } else if constexpr (size == 4) {
+                block = vrev32q_u8(block);
+            } else {
+                block = vrev64q_u8(block);
             }
+            vst1q_u8(out + offset, block);
         }
+#endif
+
+        detail::ByteSwapScalar<size>(out + offset, in + offset, (bytes - offset) / size);
+    }
+}
+
+// Converts `count` elements between buffer and host byte order in place. Only buffers owned by the
+// caller may be adjusted this way, reads from a document go through CopyArrayEndianess.
+template <uint32_t size>
+    requires(size == 1 || size == 2 || size == 4 || size == 8)
+inline void AdjustArrayEndianess(void* data, size_t count) {
+    if constexpr (size > 1 && NEEDS_BYTE_SWAP) {
+        ByteSwapArray<size>(data, data, count);
+    }
+}
+
+// Copies `count` elements from `src` to `dest`, converting them between buffer and host byte order.
+// The buffers must not overlap.
+template <uint32_t size>
+    requires(size == 1 || size == 2 || size == 4 || size == 8)
+inline void CopyArrayEndianess(void* dest, const void* src, size_t count) noexcept {
+    if constexpr (size > 1 && NEEDS_BYTE_SWAP) {
+        ByteSwapArray<size>(dest, src, count);
+    } else {
+        std::memcpy(dest, src, count * size);
     }
 }
 
-}  // namespace tbf
\ No newline at end of file
+}  // namespace tbf
@@ -0,0 +1,337 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#pragma once
+
+#include "tbf/DataTag.hpp"
+#include "tbf/DataType.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Number of fields an object can hold before its index falls back to a heap allocated table.
+// Objects up to this size are indexed without any allocation. Configured through CMake.
+#ifndef TBF_INLINE_FIELD_CAPACITY
+#define TBF_INLINE_FIELD_CAPACITY 8
+#endif
+
+namespace tbf {
+
+union CacheValue {
+    const void* ptr;
+
+    int8_t v_int8;
+    int16_t v_int16;
+    int32_t v_int32;
+    int64_t v_int64;
+
+    uint8_t v_uint8;
+    uint16_t v_uint16;
+    uint32_t v_uint32;
+    uint64_t v_uint64;
+
+    bool v_bool;
+    uint16_t v_float16;
+    float v_float32;
+    double v_float64;
+};
+
+struct CacheEntry {
+    static constexpr uint32_t NO_OBJECT = 0xFFFFFFFF;
+
+    DataType type;
+    uint32_t object = NO_OBJECT;  // DocumentIndex object of an Object field, or first element of an ObjectArray
+    CacheValue value;
+};
+
+// Index mapping the tags of a single object to their cache entries. Fields are stored densely in
+// wire order, and a flat open-addressing table of field positions, kept at a load factor of at most
+// 1/2, maps tags to them. Lookups are a linear probe over adjacent memory instead of a bucket chain
+// walk, and every field keeps its position in wire order. Memory is taken from the given resource.
+//
+// The first INLINE_CAPACITY fields are stored inside the index itself and looked up with a
+// branch-free compare over all inline keys. The heap arrays are only created once an object
+// exceeds that size.
+//
+// Duplicated tags are not stored, so positions count the first occurrence of each tag only.
+class FieldIndex {
+   private:
+    struct Slot {
+        const char* name;  // Points into the object buffer (name-based mode only)
+        CacheValue value;
+        uint32_t key;  // Tag ID or TagLookupHash of the name
+        DataTag::NameSize name_size;
+        DataType type;
+    };
+
+   public:
+    static constexpr uint32_t NOT_FOUND = 0xFFFFFFFF;
+    static constexpr uint32_t MIN_CAPACITY = 8;
+    static constexpr uint32_t INLINE_CAPACITY = TBF_INLINE_FIELD_CAPACITY;
+
+    static_assert(INLINE_CAPACITY <= 64, "TBF_INLINE_FIELD_CAPACITY cannot exceed 64");
+
+   private:
+    std::pmr::vector<Slot> m_slots;      // Fields in wire order, empty while they fit inline
+    std::pmr::vector<uint32_t> m_table;  // Field position + 1, zero marks an empty slot
+    uint32_t m_count = 0;
+    uint32_t m_shift = 64;  // 64 - log2(table capacity)
+
+    // Keys are padded to a multiple of 4 so they can be compared in SIMD blocks
+    static constexpr uint32_t INLINE_KEY_COUNT = (INLINE_CAPACITY + 3) & ~3u;
+
+    std::array<uint32_t, INLINE_KEY_COUNT> m_inline_keys{};
+    std::array<Slot, INLINE_CAPACITY> m_inline_slots;
+
+   public:
+    explicit FieldIndex(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept
+        : m_slots(resource), m_table(resource) {}
+
+    inline uint32_t Size() const noexcept { return m_count; }
+    inline uint32_t Capacity() const noexcept { return static_cast<uint32_t>(m_table.size()); }
+    inline bool IsInline() const noexcept { return m_table.empty(); }
+    inline std::pmr::memory_resource* GetResource() const noexcept { return m_slots.get_allocator().resource(); }
+
+    void Reset(uint32_t expected_count) noexcept;
+    void Clear() noexcept;
+
+    inline bool Insert(DataTag::Id id, const CacheEntry& entry) noexcept {
+        return InsertEntry<false>(id, std::string_view(), entry);
+    }
+
+    // `hash` must be the TagLookupHash of `name`
+    inline bool Insert(std::string_view name, uint32_t hash, const CacheEntry& entry) noexcept {
+        return InsertEntry<true>(hash, name, entry);
+    }
+
+    // Position in wire order of the field with the given tag, or NOT_FOUND
+    [[gnu::always_inline]]
+    inline uint32_t Find(DataTag::Id id) const noexcept {
+        return FindPosition<false>(id, std::string_view());
+    }
+
+    [[gnu::always_inline]]
+    inline uint32_t Find(std::string_view name, uint32_t hash) const noexcept {
+        return FindPosition<true>(hash, name);
+    }
+
+    [[gnu::always_inline]]
+    inline bool Find(DataTag::Id id, CacheEntry& out_entry) const noexcept {
+        return EntryAt(Find(id), out_entry);
+    }
+
+    [[gnu::always_inline]]
+    inline bool Find(std::string_view name, uint32_t hash, CacheEntry& out_entry) const noexcept {
+        return EntryAt(Find(name, hash), out_entry);
+    }
+
+    // Checks the field at `position` without probing the table
+    [[gnu::always_inline]]
+    inline bool Matches(uint32_t position, DataTag::Id id) const noexcept {
+        return position < m_count && SlotAt(position).key == id;
+    }
+
+    [[gnu::always_inline]]
+    inline bool Matches(uint32_t position, std::string_view name, uint32_t hash) const noexcept {
+        if (position >= m_count) {
+            return false;
+        }
+        const Slot& slot = SlotAt(position);
+        return slot.key == hash && std::string_view(slot.name, slot.name_size) == name;
+    }
+
+    [[gnu::always_inline]]
+    inline bool EntryAt(uint32_t position, CacheEntry& out_entry) const noexcept {
+        if (position >= m_count) {
+            return false;
+        }
+        const Slot& slot = SlotAt(position);
+        out_entry = {.type = slot.type, .value = slot.value};
+        return true;
+    }
+
+    // Visits the fields in wire order
+    template <typename Callback>
+    void ForEach(bool name_based, Callback&& callback) const {
+        for (uint32_t i = 0; i < m_count; ++i) {
+            const Slot& slot = SlotAt(i);
+            CacheEntry entry = {.type = slot.type, .value = slot.value};
+            if (name_based) {
+                callback(DataTag(std::string_view(slot.name, slot.name_size)), entry);
+            } else {
+                callback(DataTag(static_cast<DataTag::Id>(slot.key)), entry);
+            }
+        }
+    }
+
+   private:
+    [[gnu::always_inline]]
+    inline const Slot& SlotAt(uint32_t position) const noexcept {
+        return IsInline() ? m_inline_slots[position] : m_slots[position];
+    }
+
+    [[gnu::always_inline]]
+    inline uint32_t TableIndex(uint32_t key) const noexcept {
+        // Fibonacci hashing spreads sequential or clustered keys across the table
+        return static_cast<uint32_t>((key * 0x9E3779B97F4A7C15ull) >> m_shift);
+    }
+
+    template <bool name_based>
+    [[gnu::always_inline]]
+    static inline bool SlotMatches(const Slot& slot, uint32_t key, std::string_view name) noexcept {
+        if constexpr (name_based) {
+            return slot.key == key && std::string_view(slot.name, slot.name_size) == name;
+        } else {
+            return slot.key == key;
+        }
+    }
+
+    template <bool name_based>
+    [[gnu::always_inline]]
+    inline uint32_t FindInline(uint32_t key, std::string_view name) const noexcept {
+        // Compare every inline key without early exits, four keys per step when SSE2 is available
+        uint64_t matches = 0;
+#if defined(__SSE2__)
+        const __m128i needle = _mm_set1_epi32(static_cast<int>(key));
+        for (uint32_t i = 0; i < INLINE_KEY_COUNT; i += 4) {
+            __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&m_inline_keys[i]));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(keys, needle))));
+            matches |= static_cast<uint64_t>(mask) << i;
+        }
+#else
+        for (uint32_t i = 0; i < INLINE_CAPACITY; ++i) {
+            matches |= static_cast<uint64_t>(m_inline_keys[i] == key) << i;
+        }
+#endif
+
+        if constexpr (INLINE_CAPACITY == 64) {
+            matches &= m_count == 64 ? ~0ull : (1ull << m_count) - 1;
+        } else {
+            matches &= (1ull << m_count) - 1;
+        }
+
+        while (matches != 0) {
+            uint32_t position = static_cast<uint32_t>(std::countr_zero(matches));
+
+            if constexpr (name_based) {
+                const Slot& slot = m_inline_slots[position];
+                if (std::string_view(slot.name, slot.name_size) != name) [[unlikely]] {
+                    matches &= matches - 1;
+                    continue;
+                }
+            }
+
+            return position;
+        }
+
+        return NOT_FOUND;
+    }
+
+    template <bool name_based>
+    [[gnu::always_inline]]
+    inline uint32_t FindPosition(uint32_t key, std::string_view name) const noexcept {
+        if (IsInline()) {
+            return FindInline<name_based>(key, name);
+        }
+
+        const uint32_t mask = Capacity() - 1;
+        for (uint32_t i = TableIndex(key);; i = (i + 1) & mask) {
+            uint32_t position = m_table[i];
+
+            if (position == 0) {
+                return NOT_FOUND;
+            }
+
+            if (SlotMatches<name_based>(m_slots[position - 1], key, name)) [[likely]] {
+                return position - 1;
+            }
+        }
+    }
+
+    template <bool name_based>
+    bool InsertEntry(uint32_t key, std::string_view name, const CacheEntry& entry) noexcept;
+
+    void MoveToHeap(uint32_t expected_count) noexcept;
+    void RebuildTable(uint32_t capacity) noexcept;
+};
+
+template <bool name_based>
+inline bool FieldIndex::InsertEntry(uint32_t key, std::string_view name, const CacheEntry& entry) noexcept {
+    const Slot new_slot = {
+        .name = name.data(),
+        .value = entry.value,
+        .key = key,
+        .name_size = static_cast<DataTag::NameSize>(name.size()),
+        .type = entry.type,
+    };
+
+    if (IsInline()) {
+        // Duplicated tags keep their first occurrence. The keys were just written, so a scalar
+        // scan avoids the store forwarding stall of reloading them as a SIMD block.
+        for (uint32_t i = 0; i < m_count; ++i) {
+            if (m_inline_keys[i] == key && SlotMatches<name_based>(m_inline_slots[i], key, name)) [[unlikely]] {
+                return false;
+            }
+        }
+
+        if (m_count < INLINE_CAPACITY) [[likely]] {
+            m_inline_keys[m_count] = key;
+            m_inline_slots[m_count] = new_slot;
+            m_count++;
+            return true;
+        }
+
+        MoveToHeap(m_count + 1);
+    } else if ((m_count + 1) * 2 > Capacity()) [[unlikely]] {
+        RebuildTable(Capacity() * 2);
+    }
+
+    const uint32_t mask = Capacity() - 1;
+    for (uint32_t i = TableIndex(key);; i = (i + 1) & mask) {
+        uint32_t position = m_table[i];
+
+        if (position == 0) {
+            m_slots.push_back(new_slot);
+            m_table[i] = ++m_count;
+            return true;
+        }
+
+        // Duplicated tags keep their first occurrence
+        if (SlotMatches<name_based>(m_slots[position - 1], key, name)) {
+            return false;
+        }
+    }
+}
+
+}  // namespace tbf
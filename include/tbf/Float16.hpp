@@ -0,0 +1,104 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace tbf {
+
+// Float16 values are stored as the raw bits of an IEEE 754 half precision number. These helpers
+// convert them from and to float, rounding to the nearest even value like the hardware
+// instructions do. NaNs keep their sign and the high bits of their payload, and become quiet.
+
+inline constexpr float HalfToFloat(uint16_t half) noexcept {
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1F;
+    const uint32_t mantissa = half & 0x3FF;
+
+    if (exponent == 0x1F) {
+        // Infinity, or a NaN made quiet like the hardware conversions do
+        const uint32_t quiet = mantissa != 0 ? 0x00400000 : 0;
+        return std::bit_cast<float>(sign | 0x7F800000 | quiet | (mantissa << 13));
+    }
+    if (exponent == 0) {
+        // Zero or subnormal, exactly representable as mantissa * 2^-24
+        const float magnitude = static_cast<float>(mantissa) * 0x1p-24f;
+        return std::bit_cast<float>(sign | std::bit_cast<uint32_t>(magnitude));
+    }
+    return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+inline constexpr uint16_t FloatToHalf(float value) noexcept {
+    const uint32_t bits = std::bit_cast<uint32_t>(value);
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    const uint32_t magnitude = bits & 0x7FFFFFFF;
+
+    if (magnitude >= 0x7F800000) {
+        // Infinity, or a NaN with the quiet bit set
+        const uint32_t nan = magnitude > 0x7F800000 ? 0x200 | ((magnitude >> 13) & 0x3FF) : 0;
+        return static_cast<uint16_t>(sign | 0x7C00 | nan);
+    }
+    if (magnitude >= 0x477FF000) {
+        // 65520 and above round to infinity
+        return static_cast<uint16_t>(sign | 0x7C00);
+    }
+
+    uint32_t half;
+    uint32_t remainder;
+    uint32_t halfway;
+    if (magnitude >= 0x38800000) {
+        // Normal, rebias the exponent and drop 13 mantissa bits
+        half = (magnitude >> 13) - (112 << 10);
+        remainder = magnitude & 0x1FFF;
+        halfway = 0x1000;
+    } else if (magnitude > 0x33000000) {
+        // Subnormal, shift the mantissa with its implicit bit into units of 2^-24
+        const uint32_t shift = 126 - (magnitude >> 23);
+        const uint32_t mantissa = (magnitude & 0x7FFFFF) | 0x800000;
+        half = mantissa >> shift;
+        remainder = mantissa & ((1u << shift) - 1);
+        halfway = 1u << (shift - 1);
+    } else {
+        // 2^-25 and below round to zero
+        return sign;
+    }
+
+    // A carry out of the mantissa correctly moves to the next exponent
+    if (remainder > halfway || (remainder == halfway && (half & 1) != 0)) {
+        half++;
+    }
+    return static_cast<uint16_t>(sign | half);
+}
+
+// Bulk conversions between Float16 bits and float. They use AVX-512F or F16C when the processor
+// supports them, detected once at runtime, NEON on AArch64, and the scalar helpers otherwise. All
+// paths produce the same results. `src` and `dest` must not overlap and need no alignment.
+void HalfToFloatArray(const uint16_t* src, float* dest, size_t count) noexcept;
+void FloatToHalfArray(const float* src, uint16_t* dest, size_t count) noexcept;
+
+}  // namespace tbf
@@ -0,0 +1,86 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tbf {
+
+// Packed integers are stored in blocks of PACKED_BLOCK_LENGTH values, the last one possibly shorter.
+// Each block picks the encoding that packs its values into the fewest bits:
+//
+//   [Encoding: u8] [Width: u8] [References: 1 to 3 elements] [Packed slots]
+//
+// Every value has a slot of `Width` bits. The slots are split into 4 lanes, slot i going to lane
+// i % 4, and each lane is a little-endian bit stream of words of the element size. The streams are
+// interleaved word by word, so a vector register of 4 words unpacks a row of 4 slots at a time.
+// Arithmetic wraps around at the element size, any sequence can be stored in any encoding.
+
+inline constexpr uint32_t PACKED_BLOCK_LENGTH = 128;
+
+enum class BlockEncoding : uint8_t {
+    FrameOfReference,  // value[i] = min + slot[i]
+    Delta,             // value[0] = first, value[i] = value[i - 1] + min_delta + slot[i]
+    DeltaOfDelta,      // value[0] = first, delta[1] = first_delta, delta[i] = delta[i - 1] + min_delta_of_delta + slot[i]
+};
+
+// Upper bound of the bytes PackIntegers writes for `count` values of `element_size` bytes
+inline constexpr size_t MaxPackedIntegersSize(size_t count, uint32_t element_size) noexcept {
+    const size_t blocks = (count + PACKED_BLOCK_LENGTH - 1) / PACKED_BLOCK_LENGTH;
+    return blocks * (2 + 3 * element_size) + (count + 3 * blocks) * element_size;
+}
+
+// Packs `count` values into `out`, which needs room for MaxPackedIntegersSize(count, sizeof(value))
+// bytes. Returns the number of bytes written.
+size_t PackIntegers(const int32_t* values, size_t count, uint8_t* out) noexcept;
+size_t PackIntegers(const int64_t* values, size_t count, uint8_t* out) noexcept;
+size_t PackIntegers(const uint32_t* values, size_t count, uint8_t* out) noexcept;
+size_t PackIntegers(const uint64_t* values, size_t count, uint8_t* out) noexcept;
+
+// Unpacks the block at `src`, holding `count` values, 1 to PACKED_BLOCK_LENGTH. Returns the number
+// of bytes it takes, or 0 if it is malformed or larger than `size`. Signed values unpack as the
+// unsigned type of the same size.
+size_t UnpackIntegerBlock(const uint8_t* src, size_t size, uint32_t* out, uint32_t count) noexcept;
+size_t UnpackIntegerBlock(const uint8_t* src, size_t size, uint64_t* out, uint32_t count) noexcept;
+
+// Unpacks exactly `count` values, whose blocks must fill the `size` bytes at `src`. Returns false if
+// they do not or a block is malformed, in which case `out` holds partial results.
+bool UnpackIntegers(const uint8_t* src, size_t size, uint32_t* out, size_t count) noexcept;
+bool UnpackIntegers(const uint8_t* src, size_t size, uint64_t* out, size_t count) noexcept;
+
+inline bool UnpackIntegers(const uint8_t* src, size_t size, int32_t* out, size_t count) noexcept {
+    return UnpackIntegers(src, size, reinterpret_cast<uint32_t*>(out), count);
+}
+
+inline bool UnpackIntegers(const uint8_t* src, size_t size, int64_t* out, size_t count) noexcept {
+    return UnpackIntegers(src, size, reinterpret_cast<uint64_t*>(out), count);
+}
+
+// Same block checks as UnpackIntegers without unpacking the values
+bool ValidatePackedIntegers(const uint8_t* src, size_t size, size_t count, uint32_t element_size) noexcept;
+
+}  // namespace tbf
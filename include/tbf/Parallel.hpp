@@ -0,0 +1,237 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#pragma once
+
+#include "tbf/Reader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tbf {
+
+// Fixed set of worker threads that run the tasks of one job at a time. The thread calling Run works
+// on the job too, so a pool of N threads starts N - 1 workers. Runs issued from inside a task of the
+// same pool execute on the calling thread instead of waiting for workers that are busy with the
+// outer job.
+class ThreadPool {
+   public:
+    using TaskFunction = void (*)(void* context, uint32_t task) noexcept;
+
+   private:
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_run_mutex;  // Serializes jobs from different threads
+    std::mutex m_mutex;
+    std::condition_variable m_work_ready;
+    std::condition_variable m_work_done;
+
+    // Current job, guarded by m_mutex except for the task counter
+    TaskFunction m_function = nullptr;
+    void* m_context = nullptr;
+    uint32_t m_task_count = 0;
+    uint32_t m_finished_tasks = 0;
+    uint32_t m_active_workers = 0;
+    uint64_t m_generation = 0;
+    bool m_stopping = false;
+
+    std::atomic<uint32_t> m_next_task = 0;
+
+   public:
+    // A thread count of zero uses one thread per hardware thread
+    explicit ThreadPool(uint32_t thread_count = 0) noexcept;
+    ~ThreadPool() noexcept;
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Threads working on a job, counting the caller
+    inline uint32_t ThreadCount() const noexcept { return static_cast<uint32_t>(m_workers.size()) + 1; }
+
+    // Pool shared by the parallel algorithms when no pool is given
+    static ThreadPool& Shared() noexcept;
+
+    // Calls function(context, task) once for every task in [0, task_count) and returns when all of
+    // them finished. Tasks run concurrently and in no particular order.
+    void Run(uint32_t task_count, TaskFunction function, void* context) noexcept;
+
+    template <typename Func>
+        requires std::is_nothrow_invocable_v<Func&, uint32_t>
+    inline void Run(uint32_t task_count, Func& func) noexcept {
+        Run(task_count, [](void* context, uint32_t task) noexcept { (*static_cast<Func*>(context))(task); }, &func);
+    }
+
+   private:
+    void WorkerLoop() noexcept;
+    uint32_t ExecuteTasks(TaskFunction function, void* context, uint32_t task_count) noexcept;
+};
+
+// ---------------------------------
+// Parallel array algorithms
+// ---------------------------------
+
+// Elements are split into chunks of `grain_size` consecutive elements, which are the tasks handed to
+// the pool. Chunk boundaries only depend on the element count and the grain size, never on the
+// number of threads, so ordered reductions give the same result on any pool.
+//
+// Elements are reached by index, so plain arrays have their offset table built by a sequential walk
+// before the chunks are dispatched. Indexed arrays and arrays of a document indexed Reader already
+// know where every element starts and are split without any walk. The walk modifies the array
+// reader, so a reader shared by threads running parallel algorithms at the same time must be
+// prepared with PrepareRandomAccess beforehand.
+inline constexpr uint32_t DEFAULT_GRAIN_SIZE = 1024;
+
+namespace detail {
+
+template <typename Array>
+concept ParallelArray = std::is_same_v<Array, StringArrayReader> || std::is_same_v<Array, BinaryArrayReader> ||
+                        std::is_same_v<Array, ObjectArrayReader>;
+
+// Element callbacks take either the element or its index followed by the element
+template <typename Func, typename Value>
+inline decltype(auto) InvokeElement(Func& func, uint32_t index, Value&& value) noexcept {
+    if constexpr (std::is_invocable_v<Func&, uint32_t, Value>) {
+        return func(index, std::forward<Value>(value));
+    } else {
+        return func(std::forward<Value>(value));
+    }
+}
+
+template <typename Func>
+inline void ForEachInRange(const StringArrayReader& array, uint32_t begin, uint32_t end, Func& func) noexcept {
+    std::string_view value;
+    for (uint32_t i = begin; i < end; ++i) {
+        array.GetElement(i, value);
+        func(i, value);
+    }
+}
+
+template <typename Func>
+inline void ForEachInRange(const BinaryArrayReader& array, uint32_t begin, uint32_t end, Func& func) noexcept {
+    const void* data;
+    FieldSize size;
+    for (uint32_t i = begin; i < end; ++i) {
+        array.GetElement(i, data, size);
+        func(i, std::span<const uint8_t>(static_cast<const uint8_t*>(data), size));
+    }
+}
+
+// Element readers of a chunk allocate from a pool local to the chunk, since the resource of the
+// array may not be safe to share between threads
+template <typename Func>
+inline void ForEachInRange(const ObjectArrayReader& array, uint32_t begin, uint32_t end, Func& func) noexcept {
+    std::pmr::unsynchronized_pool_resource resource;
+    for (uint32_t i = begin; i < end; ++i) {
+        std::optional<ObjectReader> element = array.GetElement(i, &resource);
+        func(i, static_cast<const ObjectReader&>(*element));
+    }
+}
+
+template <typename Array, typename ChunkFunc>
+inline bool ForEachChunk(const Array& array, ThreadPool& pool, uint32_t grain_size, ChunkFunc& chunk_func) noexcept {
+    if (!array.IsValid()) [[unlikely]] {
+        return false;
+    }
+    array.PrepareRandomAccess();
+
+    const uint32_t count = array.Size();
+    const uint32_t grain = std::max<uint32_t>(grain_size, 1);
+    const uint32_t chunk_count = static_cast<uint32_t>((static_cast<uint64_t>(count) + grain - 1) / grain);
+
+    auto task = [&](uint32_t chunk) noexcept {
+        const uint32_t begin = chunk * grain;
+        const uint32_t end = begin + std::min(grain, count - begin);
+        chunk_func(chunk, begin, end);
+    };
+    pool.Run(chunk_count, task);
+    return true;
+}
+
+}  // namespace detail
+
+// Calls func(element) or func(index, element) for every element of the array, from the threads of
+// `pool`. Elements are std::string_view for string arrays, std::span<const uint8_t> for binary
+// arrays and const ObjectReader& for object arrays. Returns false if the array is invalid.
+template <typename Array, typename Func>
+    requires detail::ParallelArray<Array>
+bool ParallelForEach(const Array& array, Func&& func, ThreadPool& pool = ThreadPool::Shared(),
+                     uint32_t grain_size = DEFAULT_GRAIN_SIZE) noexcept {
+    auto chunk_func = [&](uint32_t, uint32_t begin, uint32_t end) noexcept {
+        auto element_func = [&](uint32_t index, const auto& value) noexcept { detail::InvokeElement(func, index, value); };
+        detail::ForEachInRange(array, begin, end, element_func);
+    };
+    return detail::ForEachChunk(array, pool, grain_size, chunk_func);
+}
+
+// Maps every element through transform(element) or transform(index, element) and folds the results
+// into `init` with reduce(accumulated, value). Each chunk is reduced in element order, then the chunk
+// results are folded into `init` in chunk order. reduce must be associative, but needs not be
+// commutative: the result does not depend on the pool. Returns std::nullopt if the array is invalid.
+template <typename Array, typename Result, typename Reduce, typename Transform>
+    requires detail::ParallelArray<Array>
+std::optional<Result> ParallelTransformReduce(const Array& array, Result init, Reduce&& reduce, Transform&& transform,
+                                              ThreadPool& pool = ThreadPool::Shared(), uint32_t grain_size = DEFAULT_GRAIN_SIZE) noexcept {
+    std::vector<std::optional<Result>> partials;
+
+    auto chunk_func = [&](uint32_t chunk, uint32_t begin, uint32_t end) noexcept {
+        std::optional<Result>& partial = partials[chunk];
+
+        auto element_func = [&](uint32_t index, const auto& value) noexcept {
+            if (partial.has_value()) {
+                partial = reduce(std::move(*partial), detail::InvokeElement(transform, index, value));
+            } else {
+                partial.emplace(detail::InvokeElement(transform, index, value));
+            }
+        };
+        detail::ForEachInRange(array, begin, end, element_func);
+    };
+
+    const uint32_t grain = std::max<uint32_t>(grain_size, 1);
+    partials.resize((static_cast<uint64_t>(array.Size()) + grain - 1) / grain);
+
+    if (!detail::ForEachChunk(array, pool, grain, chunk_func)) [[unlikely]] {
+        return std::nullopt;
+    }
+
+    for (std::optional<Result>& partial : partials) {
+        if (partial.has_value()) {
+            init = reduce(std::move(init), std::move(*partial));
+        }
+    }
+    return init;
+}
+
+}  // namespace tbf
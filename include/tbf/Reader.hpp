@@ -25,85 +25,283 @@
 
 #pragma once
 
+#include "tbf/BitPacking.hpp"
 #include "tbf/DataTag.hpp"
 #include "tbf/DataType.hpp"
+#include "tbf/DocumentIndex.hpp"
+#include "tbf/Endianness.hpp"
+#include "tbf/FieldIndex.hpp"
+#include "tbf/IntegerPacking.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory_resource>
 #include <optional>
 #include <span>
 #include <string_view>
-#include <unordered_map>
+#include <type_traits>
 #include <vector>
 
 namespace tbf {
 
-class Reader;
+template <TagMode Mode>
+class BasicReader;
 class ObjectReader;
 
 class ObjectArrayReader;
 class StringArrayReader;
 class BinaryArrayReader;
+class PackedBooleanArrayReader;
+class VarintArrayReader;
+class PackedIntegerArrayReader;
+class DictionaryStringArrayReader;
+
+enum class IndexMode : uint8_t {
+    Eager,  // The first lookup parses and indexes every field of the object
+    // Lookups parse fields only until the requested tag is found and resume from there. Fields
+    // before a malformed one are returned until a lookup or IsValid() reaches it, and from then on
+    // every lookup fails as in Eager mode.
+    Lazy,
+
+    // The Reader indexes the whole document in one pass and every nested reader is a view into
+    // that shared index. ObjectReaders constructed on their own behave as Eager.
+    Document,
+};
+
+// Binds a tag of the given type to a member of Struct, for ObjectReader::ReadFields
+template <DataType type, typename Struct, typename Member>
+struct FieldBinding {
+    DataTag tag;
+    Member Struct::* member;
+};
+
+namespace detail {
+
+template <typename Type>
+struct IsConstSpan : std::false_type {};
+
+template <typename Element>
+struct IsConstSpan<std::span<const Element>> : std::true_type {};
+
+// Member types a field of the given type can be stored into
+template <DataType type, typename Member>
+consteval bool CanBindField() {
+    if constexpr (type == DataType::Boolean) {
+        return std::is_same_v<Member, bool>;
+    } else if constexpr (type == DataType::UUID) {
+        return std::is_same_v<Member, const void*>;
+    } else if constexpr (type == DataType::String) {
+        return std::is_same_v<Member, std::string_view>;
+    } else if constexpr (type == DataType::Binary) {
+        return std::is_same_v<Member, std::span<const uint8_t>>;
+    } else if constexpr (type == DataType::Object) {
+        return false;
+    } else if constexpr (IsPrimitiveType(type)) {
+        return std::is_trivially_copyable_v<Member> && sizeof(Member) == DataTypeSize(type);
+    } else if constexpr (IsVarintType(type)) {
+        return std::is_trivially_copyable_v<Member> && sizeof(Member) == sizeof(int64_t);
+    } else if constexpr (IsVectorType(type)) {
+        return std::is_pointer_v<Member> && std::is_const_v<std::remove_pointer_t<Member>> &&
+               sizeof(std::remove_pointer_t<Member>) == DataTypeSize(BaseDataType(type));
+    } else if constexpr (IsArrayType(type) && IsPrimitive(type)) {
+        if constexpr (IsConstSpan<Member>::value) {
+            return sizeof(typename Member::element_type) == DataTypeSize(BaseDataType(type));
+        }
+        return false;
+    } else {
+        return false;
+    }
+}
+
+}  // namespace detail
+
+template <DataType type, typename Struct, typename Member>
+    requires(detail::CanBindField<type, Member>())
+constexpr FieldBinding<type, Struct, Member> Bind(const DataTag& tag, Member Struct::* member) noexcept {
+    return FieldBinding<type, Struct, Member>{tag, member};
+}
+
+// Outcome of ObjectReader::ReadFields. Bit i of each mask refers to the i-th binding.
+struct ReadFieldsResult {
+    uint64_t missing = 0;     // The object has no field with the tag
+    uint64_t wrong_type = 0;  // The field exists with another type or a malformed value
+    bool valid = false;       // False if the object is malformed, every binding is then missing
+
+    inline bool Complete() const noexcept { return valid && missing == 0 && wrong_type == 0; }
+};
+
+// ---------------------------------
+// Field iteration
+// ---------------------------------
+
+// A field as it is stored in the buffer, yielded by FieldIterator and ObjectReader::Visit. Views
+// point into the object buffer and are only valid while the iterator is not advanced.
+class FieldView {
+   private:
+    friend class FieldIterator;
+
+   private:
+    const uint8_t* m_begin = nullptr;  // Type byte of the field
+    const uint8_t* m_end = nullptr;    // One past the last byte of the field
+    const char* m_name = nullptr;
+    DataTag::NameSize m_name_size = 0;
+    DataTag::Id m_id = DataTag::INVALID_ID;
+    bool m_name_based = false;
+    bool m_trusted = false;
+    CacheEntry m_entry = {.type = DataType::Invalid, .value = {.ptr = nullptr}};
+
+   public:
+    inline DataType GetType() const noexcept { return m_entry.type; }
+    inline const CacheEntry& GetEntry() const noexcept { return m_entry; }
+    inline bool IsNameBased() const noexcept { return m_name_based; }
+    inline bool IsTrusted() const noexcept { return m_trusted; }
+
+    // Name of the tag in name-based mode, empty otherwise
+    inline std::string_view GetName() const noexcept { return std::string_view(m_name, m_name_size); }
+    // ID of the tag in ID-based mode, DataTag::INVALID_ID otherwise
+    inline DataTag::Id GetId() const noexcept { return m_id; }
+
+    inline DataTag GetTag() const noexcept { return m_name_based ? DataTag(GetName()) : DataTag(m_id); }
+    inline bool Matches(const DataTag& tag) const noexcept { return m_name_based ? tag.GetName() == GetName() : tag.GetId() == m_id; }
+
+    // The whole encoded field, type and tag included, for copying it to another buffer as is
+    inline std::span<const uint8_t> GetRaw() const noexcept { return std::span<const uint8_t>(m_begin, m_end); }
+
+    // Stores the value into `out_value` if the field has the given type. Member types follow the
+    // same rules as Bind. When NEEDS_BYTE_SWAP is set, arrays and vectors of multi-byte elements
+    // cannot be viewed in place and are only read through an ObjectReader.
+    template <DataType type, typename Member>
+        requires(detail::CanBindField<type, Member>())
+    bool Get(Member& out_value) const noexcept;
+
+    [[nodiscard]] std::optional<ObjectReader> AsObject(IndexMode index_mode = IndexMode::Eager,
+                                                       std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const noexcept;
+    [[nodiscard]] std::optional<StringArrayReader> AsStringArray() const noexcept;
+    [[nodiscard]] std::optional<BinaryArrayReader> AsBinaryArray() const noexcept;
+    [[nodiscard]] std::optional<ObjectArrayReader> AsObjectArray(IndexMode index_mode = IndexMode::Eager,
+                                                                 std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const noexcept;
+};
+
+// Forward iterator over the fields of an object in wire order, parsing each field as it advances.
+// It never allocates and does not index the object. Iteration ends early at a malformed field,
+// which IsMalformed reports.
+class FieldIterator {
+   public:
+    using value_type = FieldView;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const FieldView*;
+    using reference = const FieldView&;
+    using iterator_category = std::input_iterator_tag;
+
+   private:
+    const uint8_t* m_read_ptr;
+    const uint8_t* m_end_ptr;
+    FieldView m_field;
+    bool m_name_based;
+    bool m_trusted;
+    bool m_done = false;
+    bool m_malformed = false;
+
+   public:
+    FieldIterator(const void* fields, FieldSize size, bool name_based, bool trusted = false) noexcept;
+
+    inline const FieldView& operator*() const noexcept { return m_field; }
+    inline const FieldView* operator->() const noexcept { return &m_field; }
+
+    FieldIterator& operator++() noexcept {
+        Advance();
+        return *this;
+    }
+
+    void operator++(int) noexcept { Advance(); }
+
+    inline bool operator==(std::default_sentinel_t) const noexcept { return m_done; }
+    inline bool IsMalformed() const noexcept { return m_malformed; }
+
+   private:
+    void Advance() noexcept;
+};
+
+class FieldRange {
+   private:
+    const void* m_fields;
+    FieldSize m_size;
+    bool m_name_based;
+    bool m_trusted;
+
+   public:
+    FieldRange(const void* fields, FieldSize size, bool name_based, bool trusted = false) noexcept
+        : m_fields(fields), m_size(size), m_name_based(name_based), m_trusted(trusted) {}
+
+    inline FieldIterator begin() const noexcept { return FieldIterator(m_fields, m_size, m_name_based, m_trusted); }
+    inline std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+};
+
+enum class VisitAction : uint8_t {
+    Continue,  // Keep going, descending into the fields of an Object or the elements of an ObjectArray
+    Skip,      // Keep going, stepping over the contents of an Object or ObjectArray field
+    Stop,      // End the walk
+};
 
 class ObjectReader {
    private:
-    friend class Reader;
+    template <TagMode Mode>
+    friend class BasicReader;
+    friend class FieldView;
 
     friend class ObjectArrayReader;
     friend class StringArrayReader;
     friend class BinaryArrayReader;
 
    private:
-    union CacheValue {
-        const void* ptr;
-
-        int8_t v_int8;
-        int16_t v_int16;
-        int32_t v_int32;
-        int64_t v_int64;
-
-        uint8_t v_uint8;
-        uint16_t v_uint16;
-        uint32_t v_uint32;
-        uint64_t v_uint64;
-
-        bool v_bool;
-        uint16_t v_float16;
-        float v_float32;
-        double v_float64;
-    };
-
-    struct CacheEntry {
-        DataType type;
-        CacheValue value;
-    };
-
-   private:
-    static constexpr uint32_t INITIAL_CACHE_SIZE = 100;
+    static constexpr uint32_t INITIAL_CACHE_SIZE = 8;
 
    private:
     const void* m_buffer;
     FieldSize m_size;
 
     bool m_name_based;
+    IndexMode m_index_mode;
+    bool m_trusted = false;  // The buffer was validated, parsing skips bounds and type checks
 
     // Reader cache for quick tag lookup
 
     mutable bool m_cache_built = false;
     mutable bool m_is_valid = false;
 
-    union {
-        mutable std::unordered_map<DataTag::Id, CacheEntry> m_id_cache;
-        mutable std::unordered_map<std::string_view, CacheEntry> m_name_cache;
-    };
+    mutable FieldIndex m_index;
+    mutable const uint8_t* m_scan_ptr;  // First field not yet indexed
+
+    // Consumers usually read fields in the order they were written, so lookups first check the
+    // field following the last one returned, by its position in wire order
+    mutable uint32_t m_cursor = 0;
+
+    // Shared index this reader is a view into (IndexMode::Document only)
+    const DocumentIndex* m_document = nullptr;
+    uint32_t m_object = 0;
+
+    // Arrays and vectors converted to host byte order, when it differs from the buffer's, one block
+    // per field however often it is read. The buffer itself is never written to.
+    struct ConvertedBlock;
+    mutable ConvertedBlock* m_converted = nullptr;
 
     // ---------------------------------
     // Constructors & Destructor
     // ---------------------------------
 
    public:
-    ObjectReader(const void* buffer, size_t size, bool name_based) noexcept;
-    ObjectReader(const void* buffer, bool name_based) noexcept;
+    ObjectReader(const void* buffer, size_t size, bool name_based, IndexMode index_mode = IndexMode::Eager,
+                 std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept;
+    ObjectReader(const void* buffer, bool name_based, IndexMode index_mode = IndexMode::Eager,
+                 std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept;
+    ObjectReader(const DocumentIndex& document, uint32_t object) noexcept;
+
+    // A trusted reader skips bounds and type checks, `buffer` must hold an object that passed
+    // Reader::Validate
+    ObjectReader(const void* buffer, bool name_based, IndexMode index_mode, std::pmr::memory_resource* resource, bool trusted) noexcept;
 
    public:
     ObjectReader(const ObjectReader&) noexcept = delete;
@@ -116,6 +314,10 @@ class ObjectReader {
     // ---------------------------------
 
    public:
+    inline IndexMode GetIndexMode() const noexcept { return m_index_mode; }
+    inline bool IsTrusted() const noexcept { return m_trusted; }
+    inline std::pmr::memory_resource* GetMemoryResource() const noexcept { return m_index.GetResource(); }
+
     inline bool IsValid() const noexcept {
         if (!m_cache_built) {
             CreateCache();
@@ -143,6 +345,75 @@ class ObjectReader {
 
     std::vector<DataTag> GetAllTags() const noexcept;
 
+    // ---------------------------------
+    // Batch read
+    // ---------------------------------
+
+   public:
+    // Reads all the bindings into `out` with a single scan of the object in wire order, without
+    // building its index. Members whose field is missing or has another type are left untouched.
+    // The scan stops once every binding is found, so fields after the last one are not validated.
+    // Objects that are already indexed are read through the index instead.
+    template <typename Struct, DataType... types, typename... Members>
+    ReadFieldsResult ReadFields(Struct& out, const FieldBinding<types, Struct, Members>&... bindings) const noexcept;
+
+    // ---------------------------------
+    // Field iteration
+    // ---------------------------------
+
+   public:
+    // Fields of the object in wire order, duplicated tags included. Iterating does not index the
+    // object. The range is empty if the object is already known to be malformed.
+    FieldRange Fields() const noexcept;
+
+    // Walks the fields of the object and of its nested objects in wire order, depth first. The
+    // visitor is either callable as VisitAction(const FieldView&) or has a member
+    // VisitAction OnField(const FieldView&), and may also define any of:
+    //
+    //   void OnObjectEnd(const FieldView& field)  after the contents of an Object or ObjectArray
+    //   void OnElementBegin(uint32_t index)        before each element of an ObjectArray
+    //   void OnElementEnd(uint32_t index)          after each element of an ObjectArray
+    //
+    // Skipped subtrees are stepped over through their size prefix without being parsed. Nothing is
+    // allocated or indexed. Returns false if a malformed field ended the walk, which includes
+    // objects nested more than MAX_VISIT_DEPTH levels below this one.
+    template <typename Visitor>
+    bool Visit(Visitor&& visitor) const noexcept;
+
+    // The walk recurses once per nesting level, bounded like Reader::Validate
+    static constexpr uint32_t MAX_VISIT_DEPTH = 512;
+
+   private:
+    enum class VisitStatus : uint8_t { Done, Stopped, Malformed };
+
+    template <typename Visitor>
+    static VisitStatus VisitFields(const void* fields, FieldSize size, bool name_based, bool trusted, Visitor& visitor,
+                                   uint32_t depth) noexcept;
+    template <typename Visitor>
+    static VisitStatus VisitElements(const FieldView& field, Visitor& visitor, uint32_t depth) noexcept;
+
+    static bool ElementRange(const CacheEntry& entry, const uint8_t*& out_begin, const uint8_t*& out_end) noexcept;
+    static bool NextElement(const uint8_t*& read_ptr, const uint8_t* end_ptr, const void*& out_fields, FieldSize& out_size) noexcept;
+
+   private:
+    uint64_t MatchFields(const DataTag* const* tags, uint32_t count, CacheEntry* out_entries, bool& out_valid) const noexcept;
+
+    // Arrays and vectors of multi-byte elements that need a byte swap are converted into storage
+    // of `owner`, without one they cannot be decoded
+    template <DataType type, typename Member>
+    static bool DecodeField(const CacheEntry& entry, Member& out_value, const ObjectReader* owner) noexcept;
+
+    template <uint32_t element_size>
+    inline const void* HostOrderData(const void* data, size_t count) const noexcept {
+        if constexpr (NEEDS_BYTE_SWAP && element_size > 1) {
+            return ConvertToHostOrder(data, count, element_size);
+        } else {
+            return data;
+        }
+    }
+
+    const void* ConvertToHostOrder(const void* data, size_t count, uint32_t element_size) const noexcept;
+
     // ---------------------------------
     // Cache management
     // ---------------------------------
@@ -152,14 +423,21 @@ class ObjectReader {
 
    private:
     bool FindTag(const DataTag& tag, CacheEntry& out_entry) const noexcept;
+    uint32_t ScanToTag(const DataTag& tag, uint32_t max_fields = FieldIndex::NOT_FOUND) const noexcept;
+
+    // Instantiated for each parse mode, so the loops over the fields test neither flag per field.
+    // IndexFields returns false if a field is malformed.
+    template <bool trusted, bool name_based>
+    bool IndexFields() const noexcept;
+    template <bool trusted, bool name_based>
+    uint32_t ScanFieldsToTag(const DataTag& tag, uint32_t max_fields) const noexcept;
+
+    void AttachDocument(const DocumentIndex& document, uint32_t object) noexcept;
 
     void Invalidate() noexcept {
-        if (m_name_based) {
-            m_name_cache.clear();
-        } else {
-            m_id_cache.clear();
-        }
-        m_cache_built = false;
+        m_index.Clear();
+        m_cursor = 0;
+        m_cache_built = true;
         m_is_valid = false;
     }
 
@@ -183,6 +461,9 @@ class ObjectReader {
     bool ReadUInt32(const DataTag& tag, uint32_t& out_value) const noexcept;
     bool ReadUInt64(const DataTag& tag, uint64_t& out_value) const noexcept;
 
+    bool ReadVarInt64(const DataTag& tag, int64_t& out_value) const noexcept;
+    bool ReadVarUInt64(const DataTag& tag, uint64_t& out_value) const noexcept;
+
     bool ReadBoolean(const DataTag& tag, bool& out_value) const noexcept;
     bool ReadFloat16(const DataTag& tag, uint16_t& out_value) const noexcept;
     bool ReadFloat32(const DataTag& tag, float& out_value) const noexcept;
@@ -260,6 +541,18 @@ class ObjectReader {
         return ReadBoolean(tag, value) ? std::optional<bool>(value) : std::nullopt;
     }
 
+    [[nodiscard]]
+    inline std::optional<int64_t> ReadVarInt64(const DataTag& tag) const noexcept {
+        int64_t value;
+        return ReadVarInt64(tag, value) ? std::optional<int64_t>(value) : std::nullopt;
+    }
+
+    [[nodiscard]]
+    inline std::optional<uint64_t> ReadVarUInt64(const DataTag& tag) const noexcept {
+        uint64_t value;
+        return ReadVarUInt64(tag, value) ? std::optional<uint64_t>(value) : std::nullopt;
+    }
+
     [[nodiscard]]
     inline std::optional<uint16_t> ReadFloat16(const DataTag& tag) const noexcept {
         uint16_t value;
@@ -303,6 +596,21 @@ class ObjectReader {
         return std::nullopt;
     }
 
+    // ---------------------------------
+    // Compressed fields
+    // ---------------------------------
+
+   public:
+    // Type of the field wrapped by the Compressed field with the given tag
+    [[nodiscard]] std::optional<DataType> GetCompressedType(const DataTag& tag) const noexcept;
+
+    // Decompresses the field wrapped by a Compressed field into `scratch`, which is resized to fit and
+    // can be reused from one call to the next. The returned reader views `scratch` as an object
+    // holding only the wrapped field, under the same tag, which is read with the methods of its type.
+    // It is invalidated when `scratch` is modified or destroyed. Nothing is decompressed until this is
+    // called, and a field read twice is decompressed twice.
+    [[nodiscard]] std::optional<ObjectReader> ReadCompressed(const DataTag& tag, std::vector<uint8_t>& scratch) const noexcept;
+
     // ---------------------------------
     // Read arrays
     // ---------------------------------
@@ -331,6 +639,32 @@ class ObjectReader {
     [[nodiscard]] std::optional<BinaryArrayReader> ReadBinaryArray(const DataTag& tag) const noexcept;
     [[nodiscard]] std::optional<ObjectArrayReader> ReadObjectArray(const DataTag& tag) const noexcept;
 
+    [[nodiscard]] std::optional<PackedBooleanArrayReader> ReadPackedBooleanArray(const DataTag& tag) const noexcept;
+
+    // Varint arrays cannot be viewed in place, their elements are decoded into a buffer of the
+    // caller. The span overloads return the number of elements decoded, or std::nullopt if the field
+    // is missing, has another type, is malformed or does not fit in `out`.
+    [[nodiscard]] std::optional<VarintArrayReader> ReadVarInt64Array(const DataTag& tag) const noexcept;
+    [[nodiscard]] std::optional<VarintArrayReader> ReadVarUInt64Array(const DataTag& tag) const noexcept;
+    std::optional<uint32_t> ReadVarInt64Array(const DataTag& tag, std::span<int64_t> out) const noexcept;
+    std::optional<uint32_t> ReadVarUInt64Array(const DataTag& tag, std::span<uint64_t> out) const noexcept;
+
+    // Packed integer arrays are decoded like varint arrays, whole or block by block through the
+    // PackedIntegerArrayReader
+    [[nodiscard]] std::optional<PackedIntegerArrayReader> ReadPackedInt32Array(const DataTag& tag) const noexcept;
+    [[nodiscard]] std::optional<PackedIntegerArrayReader> ReadPackedInt64Array(const DataTag& tag) const noexcept;
+    [[nodiscard]] std::optional<PackedIntegerArrayReader> ReadPackedUInt32Array(const DataTag& tag) const noexcept;
+    [[nodiscard]] std::optional<PackedIntegerArrayReader> ReadPackedUInt64Array(const DataTag& tag) const noexcept;
+    std::optional<uint32_t> ReadPackedInt32Array(const DataTag& tag, std::span<int32_t> out) const noexcept;
+    std::optional<uint32_t> ReadPackedInt64Array(const DataTag& tag, std::span<int64_t> out) const noexcept;
+    std::optional<uint32_t> ReadPackedUInt32Array(const DataTag& tag, std::span<uint32_t> out) const noexcept;
+    std::optional<uint32_t> ReadPackedUInt64Array(const DataTag& tag, std::span<uint64_t> out) const noexcept;
+
+    // Dictionary string arrays are only produced by ObjectWriter::FieldDictionaryStringArray, which
+    // writes a plain string array instead when the dictionary would not make it smaller. Readers of
+    // such fields should try both.
+    [[nodiscard]] std::optional<DictionaryStringArrayReader> ReadDictionaryStringArray(const DataTag& tag) const noexcept;
+
     // ---------------------------------
     // Read array as std::span methods
     // ---------------------------------
@@ -355,8 +689,23 @@ class ObjectReader {
     [[nodiscard]] std::span<const float> ReadFloat32Array(const DataTag& tag) const noexcept;
     [[nodiscard]] std::span<const double> ReadFloat64Array(const DataTag& tag) const noexcept;
 
+    // Views returned by the methods above point into the buffer when its byte order matches the
+    // host. Otherwise they point to a converted copy owned by this ObjectReader, which lives as
+    // long as the reader does. CopyArray converts into a buffer of the caller instead: it returns
+    // the number of elements copied to `out`, or std::nullopt if the field is missing, has another
+    // type or does not fit.
+    template <DataType type, typename Element>
+        requires(IsFixedSizeArrayType(type) && type != DataType::UUIDArray && std::is_trivially_copyable_v<Element> &&
+                 sizeof(Element) == DataTypeSize(BaseDataType(type)))
+    std::optional<uint32_t> CopyArray(const DataTag& tag, std::span<Element> out) const noexcept;
+
+    // Converts a Float16Array to float into `out`, with the same results as CopyArray
+    std::optional<uint32_t> ReadFloat16Array(const DataTag& tag, std::span<float> out) const noexcept;
+
    private:
-    bool ReadStringInternal(const CacheEntry& entry, std::string_view& out_value) const noexcept;
+    static const void* EntryData(const CacheEntry& entry, FieldSize& out_size) noexcept;
+    static void ConvertFloat16(const void* data, float* out, size_t count) noexcept;
+    static bool ReadStringInternal(const CacheEntry& entry, std::string_view& out_value) noexcept;
     [[nodiscard]] std::optional<ObjectReader> ReadObjectInternal(const CacheEntry& entry) const noexcept;
 
     // ---------------------------------
@@ -368,6 +717,9 @@ class ObjectReader {
         requires std::is_arithmetic<Type>::value && (dim >= 2) && (dim <= 4)
     Type* ReadVector(const DataTag& tag, DataType type) const noexcept;
 
+    template <uint32_t dim>
+    bool ReadVectorFloat16(const DataTag& tag, DataType type, float* out_value) const noexcept;
+
    public:
     // Vector 2
 
@@ -378,6 +730,7 @@ class ObjectReader {
 
     bool* ReadVector2b(const DataTag& tag) const noexcept;
     uint16_t* ReadVector2f16(const DataTag& tag) const noexcept;
+    bool ReadVector2f16(const DataTag& tag, float* out_value) const noexcept;  // Converted to float
     float* ReadVector2f32(const DataTag& tag) const noexcept;
     double* ReadVector2f64(const DataTag& tag) const noexcept;
 
@@ -390,6 +743,7 @@ class ObjectReader {
 
     bool* ReadVector3b(const DataTag& tag) const noexcept;
     uint16_t* ReadVector3f16(const DataTag& tag) const noexcept;
+    bool ReadVector3f16(const DataTag& tag, float* out_value) const noexcept;  // Converted to float
     float* ReadVector3f32(const DataTag& tag) const noexcept;
     double* ReadVector3f64(const DataTag& tag) const noexcept;
 
@@ -402,10 +756,211 @@ class ObjectReader {
 
     bool* ReadVector4b(const DataTag& tag) const noexcept;
     uint16_t* ReadVector4f16(const DataTag& tag) const noexcept;
+    bool ReadVector4f16(const DataTag& tag, float* out_value) const noexcept;  // Converted to float
     float* ReadVector4f32(const DataTag& tag) const noexcept;
     double* ReadVector4f64(const DataTag& tag) const noexcept;
 };
 
+// ---------------------------------
+// Batch read
+// ---------------------------------
+
+template <typename Struct, DataType... types, typename... Members>
+ReadFieldsResult ObjectReader::ReadFields(Struct& out, const FieldBinding<types, Struct, Members>&... bindings) const noexcept {
+    constexpr uint32_t count = sizeof...(bindings);
+    static_assert(count > 0 && count <= 64, "ReadFields takes between 1 and 64 bindings");
+
+    const DataTag* tags[count] = {&bindings.tag...};
+    CacheEntry entries[count];
+
+    ReadFieldsResult result;
+    const uint64_t found = MatchFields(tags, count, entries, result.valid);
+
+    uint32_t index = 0;
+    auto store = [&]<DataType type, typename Member>(const FieldBinding<type, Struct, Member>& binding) {
+        const uint64_t bit = uint64_t(1) << index;
+        const CacheEntry& entry = entries[index++];
+
+        if ((found & bit) == 0) {
+            result.missing |= bit;
+        } else if (entry.type != type || !DecodeField<type>(entry, out.*binding.member, this)) {
+            result.wrong_type |= bit;
+        }
+    };
+    (store(bindings), ...);
+
+    return result;
+}
+
+template <DataType type, typename Member>
+inline bool ObjectReader::DecodeField(const CacheEntry& entry, Member& out_value, const ObjectReader* owner) noexcept {
+    constexpr bool needs_swap = NEEDS_BYTE_SWAP && (IsVectorType(type) || IsArrayType(type)) && DataTypeSize(BaseDataType(type)) > 1;
+    if constexpr (needs_swap) {
+        if (owner == nullptr) {
+            return false;
+        }
+    }
+
+    if constexpr (type == DataType::UUID) {
+        out_value = static_cast<Member>(entry.value.ptr);
+    } else if constexpr (IsVectorType(type)) {
+        constexpr uint32_t element_size = DataTypeSize(BaseDataType(type));
+        if constexpr (needs_swap) {
+            out_value = static_cast<Member>(owner->HostOrderData<element_size>(entry.value.ptr, VectorTypeDimension(type)));
+        } else {
+            out_value = static_cast<Member>(entry.value.ptr);
+        }
+    } else if constexpr (type == DataType::String) {
+        return ReadStringInternal(entry, out_value);
+    } else if constexpr (type == DataType::Binary) {
+        FieldSize size;
+        const void* data = EntryData(entry, size);
+        out_value = Member(static_cast<const uint8_t*>(data), size);
+    } else if constexpr (IsArrayType(type)) {
+        using Element = typename Member::element_type;
+
+        FieldSize size;
+        const void* data = EntryData(entry, size);
+        if (size % sizeof(Element) != 0) [[unlikely]] {
+            return false;
+        }
+        if constexpr (needs_swap) {
+            data = owner->HostOrderData<sizeof(Element)>(data, size / sizeof(Element));
+        }
+        out_value = Member(static_cast<const Element*>(data), size / sizeof(Element));
+    } else {
+        std::memcpy(&out_value, &entry.value, sizeof(Member));
+    }
+    return true;
+}
+
+// ---------------------------------
+// Array copies
+// ---------------------------------
+
+template <DataType type, typename Element>
+    requires(IsFixedSizeArrayType(type) && type != DataType::UUIDArray && std::is_trivially_copyable_v<Element> &&
+             sizeof(Element) == DataTypeSize(BaseDataType(type)))
+std::optional<uint32_t> ObjectReader::CopyArray(const DataTag& tag, std::span<Element> out) const noexcept {
+    CacheEntry entry;
+    if (!FindTag(tag, entry) || entry.type != type) {
+        return std::nullopt;
+    }
+
+    FieldSize size;
+    const void* data = EntryData(entry, size);
+    if (size % sizeof(Element) != 0 || size / sizeof(Element) > out.size()) [[unlikely]] {
+        return std::nullopt;
+    }
+
+    const uint32_t length = size / sizeof(Element);
+    CopyArrayEndianess<sizeof(Element)>(out.data(), data, length);
+    return length;
+}
+
+// ---------------------------------
+// Field iteration
+// ---------------------------------
+
+template <DataType type, typename Member>
+    requires(detail::CanBindField<type, Member>())
+inline bool FieldView::Get(Member& out_value) const noexcept {
+    return m_entry.type == type && ObjectReader::DecodeField<type>(m_entry, out_value, nullptr);
+}
+
+template <typename Visitor>
+bool ObjectReader::Visit(Visitor&& visitor) const noexcept {
+    if (m_buffer == nullptr || (m_cache_built && !m_is_valid)) [[unlikely]] {
+        return false;
+    }
+    return VisitFields(m_buffer, m_size, m_name_based, m_trusted, visitor, 0) != VisitStatus::Malformed;
+}
+
+template <typename Visitor>
+ObjectReader::VisitStatus ObjectReader::VisitFields(const void* fields, FieldSize size, bool name_based, bool trusted, Visitor& visitor,
+                                                    uint32_t depth) noexcept {
+    if (depth > MAX_VISIT_DEPTH) [[unlikely]] {
+        return VisitStatus::Malformed;
+    }
+
+    FieldIterator it(fields, size, name_based, trusted);
+
+    for (; it != std::default_sentinel; ++it) {
+        const FieldView& field = *it;
+
+        VisitAction action;
+        if constexpr (std::is_invocable_r_v<VisitAction, Visitor&, const FieldView&>) {
+            action = visitor(field);
+        } else {
+            action = visitor.OnField(field);
+        }
+
+        if (action == VisitAction::Stop) {
+            return VisitStatus::Stopped;
+        }
+
+        const DataType type = PlainArrayType(field.GetType());
+        if (action == VisitAction::Skip || (type != DataType::Object && type != DataType::ObjectArray)) {
+            continue;
+        }
+
+        VisitStatus status;
+        if (type == DataType::Object) {
+            FieldSize object_size;
+            const void* object_fields = EntryData(field.GetEntry(), object_size);
+            status = VisitFields(object_fields, object_size, name_based, trusted, visitor, depth + 1);
+        } else {
+            status = VisitElements(field, visitor, depth + 1);
+        }
+
+        if (status != VisitStatus::Done) {
+            return status;
+        }
+
+        if constexpr (requires { visitor.OnObjectEnd(field); }) {
+            visitor.OnObjectEnd(field);
+        }
+    }
+
+    return it.IsMalformed() ? VisitStatus::Malformed : VisitStatus::Done;
+}
+
+template <typename Visitor>
+ObjectReader::VisitStatus ObjectReader::VisitElements(const FieldView& field, Visitor& visitor, uint32_t depth) noexcept {
+    const uint8_t* read_ptr;
+    const uint8_t* end_ptr;
+    if (!ElementRange(field.GetEntry(), read_ptr, end_ptr)) [[unlikely]] {
+        return VisitStatus::Malformed;
+    }
+
+    uint32_t index = 0;
+    const void* element_fields;
+    FieldSize element_size;
+
+    while (read_ptr < end_ptr) {
+        if (!NextElement(read_ptr, end_ptr, element_fields, element_size)) [[unlikely]] {
+            return VisitStatus::Malformed;
+        }
+
+        if constexpr (requires { visitor.OnElementBegin(index); }) {
+            visitor.OnElementBegin(index);
+        }
+
+        VisitStatus status = VisitFields(element_fields, element_size, field.IsNameBased(), field.IsTrusted(), visitor, depth);
+        if (status != VisitStatus::Done) {
+            return status;
+        }
+
+        if constexpr (requires { visitor.OnElementEnd(index); }) {
+            visitor.OnElementEnd(index);
+        }
+
+        ++index;
+    }
+
+    return VisitStatus::Done;
+}
+
 template <typename ElementSizeType>
     requires std::is_integral<ElementSizeType>::value
 class ArrayReader {
@@ -424,7 +979,7 @@ class ArrayReader {
         uint32_t m_index;
 
        protected:
-        BaseIterator(const void* array, uint32_t index, bool at_end) noexcept;
+        BaseIterator(const uint8_t* elements, const uint8_t* elements_end, uint32_t index, bool at_end) noexcept;
 
        public:
         bool operator==(const BaseIterator& other) const noexcept {
@@ -439,13 +994,22 @@ class ArrayReader {
     };
 
    protected:
-    const void* m_array;
+    // Elements before this index are reached by walking the array, later ones through the offset
+    // table, which is built on the first access past it
+    static constexpr uint32_t LINEAR_ACCESS_LIMIT = 8;
+
+   protected:
+    const uint8_t* m_elements;
+    const uint8_t* m_elements_end;
+    const uint8_t* m_offset_table;  // Offset table stored by indexed arrays, nullptr for plain arrays
 
     uint32_t m_element_count;
     bool m_valid;
 
+    mutable std::pmr::vector<uint32_t> m_offsets;  // Element offsets from m_elements, for plain arrays
+
    protected:
-    ArrayReader(const void* array) noexcept;
+    ArrayReader(const CacheEntry& entry, bool trusted, std::pmr::memory_resource* resource) noexcept;
 
    public:
     ArrayReader(const ArrayReader&) = delete;
@@ -454,6 +1018,11 @@ class ArrayReader {
     inline uint32_t Size() const noexcept { return m_element_count; }
     inline bool IsValid() const noexcept { return m_valid; }
 
+    // Builds the offset table of a plain array up front, which GetElement would otherwise build on
+    // its first access past LINEAR_ACCESS_LIMIT. Afterwards GetElement does not modify the reader,
+    // so several threads can call it at once. Indexed arrays need no preparation.
+    void PrepareRandomAccess() const noexcept;
+
    protected:
     bool GetElement(uint32_t index, const void*& out_ptr, ElementSizeType* size = nullptr) const noexcept;
 
@@ -463,7 +1032,10 @@ class ArrayReader {
     }
 
    private:
-    void Initialize() noexcept;
+    template <bool trusted>
+    void Initialize(const CacheEntry& entry) noexcept;
+
+    void BuildOffsets() const noexcept;
 };
 
 extern template class ArrayReader<uint16_t>;
@@ -484,8 +1056,8 @@ class StringArrayReader : public ArrayReader<uint16_t> {
         using reference = std::string_view;
 
        private:
-        Iterator(const void* array, uint32_t index, bool at_end) noexcept
-            : BaseIterator(array, index, at_end) {}
+        Iterator(const uint8_t* elements, const uint8_t* elements_end, uint32_t index, bool at_end) noexcept
+            : BaseIterator(elements, elements_end, index, at_end) {}
 
        public:
         value_type operator*() const noexcept;
@@ -507,7 +1079,8 @@ class StringArrayReader : public ArrayReader<uint16_t> {
     };
 
    public:
-    StringArrayReader(const ObjectReader::CacheEntry& entry) noexcept;
+    StringArrayReader(const CacheEntry& entry, bool trusted = false,
+                      std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept;
 
     bool GetElement(uint32_t index, std::string_view& out_value) const noexcept;
 
@@ -518,11 +1091,11 @@ class StringArrayReader : public ArrayReader<uint16_t> {
     }
 
     Iterator begin() const noexcept {
-        return IsValid() ? Iterator(m_array, 0, false) : end();
+        return IsValid() ? Iterator(m_elements, m_elements_end, 0, false) : end();
     }
 
     Iterator end() const noexcept {
-        return Iterator(m_array, m_element_count, true);
+        return Iterator(m_elements, m_elements_end, m_element_count, true);
     }
 };
 
@@ -541,8 +1114,8 @@ class BinaryArrayReader : public ArrayReader<FieldSize> {
         using reference = value_type;
 
        private:
-        Iterator(const void* array, uint32_t index, bool at_end) noexcept
-            : BaseIterator(array, index, at_end) {}
+        Iterator(const uint8_t* elements, const uint8_t* elements_end, uint32_t index, bool at_end) noexcept
+            : BaseIterator(elements, elements_end, index, at_end) {}
 
        public:
         value_type operator*() const noexcept;
@@ -564,16 +1137,17 @@ class BinaryArrayReader : public ArrayReader<FieldSize> {
     };
 
    public:
-    BinaryArrayReader(const ObjectReader::CacheEntry& entry) noexcept;
+    BinaryArrayReader(const CacheEntry& entry, bool trusted = false,
+                      std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept;
 
     bool GetElement(uint32_t index, const void*& out_data, FieldSize& out_size) const noexcept;
 
     Iterator begin() const noexcept {
-        return IsValid() ? Iterator(m_array, 0, false) : end();
+        return IsValid() ? Iterator(m_elements, m_elements_end, 0, false) : end();
     }
 
     Iterator end() const noexcept {
-        return Iterator(m_array, m_element_count, true);
+        return Iterator(m_elements, m_elements_end, m_element_count, true);
     }
 };
 
@@ -583,6 +1157,12 @@ class ObjectArrayReader : public ArrayReader<FieldSize> {
 
    private:
     bool m_name_based;
+    IndexMode m_index_mode;
+    bool m_trusted;
+    std::pmr::memory_resource* m_resource;
+
+    const DocumentIndex* m_document;
+    uint32_t m_first_object;  // Document object of the first element
 
    public:
     class Iterator : public ArrayReader<FieldSize>::BaseIterator {
@@ -595,11 +1175,11 @@ class ObjectArrayReader : public ArrayReader<FieldSize> {
         using reference = ObjectReader;
 
        private:
-        bool m_name_based;
+        const ObjectArrayReader* m_owner;
 
        private:
-        Iterator(const void* array, uint32_t index, bool at_end, bool name_based) noexcept
-            : BaseIterator(array, index, at_end), m_name_based(name_based) {}
+        Iterator(const ObjectArrayReader& owner, uint32_t index, bool at_end) noexcept
+            : BaseIterator(owner.m_elements, owner.m_elements_end, index, at_end), m_owner(&owner) {}
 
        public:
         value_type operator*() const noexcept;
@@ -621,31 +1201,282 @@ class ObjectArrayReader : public ArrayReader<FieldSize> {
     };
 
    public:
-    ObjectArrayReader(const ObjectReader::CacheEntry& entry, bool name_based) noexcept;
+    ObjectArrayReader(const CacheEntry& entry, bool name_based, IndexMode index_mode = IndexMode::Eager,
+                      std::pmr::memory_resource* resource = std::pmr::get_default_resource(),
+                      const DocumentIndex* document = nullptr, bool trusted = false) noexcept;
 
     std::optional<ObjectReader> GetElement(uint32_t index) const noexcept;
 
+    // Same as GetElement, but the element reader allocates its cache from `resource` instead of the
+    // resource of the array, which lets each thread reading the array use its own.
+    std::optional<ObjectReader> GetElement(uint32_t index, std::pmr::memory_resource* resource) const noexcept;
+
+    // Elements of a document indexed array are reached through the document index
+    inline void PrepareRandomAccess() const noexcept {
+        if (!HasDocument()) {
+            ArrayReader<FieldSize>::PrepareRandomAccess();
+        }
+    }
+
     Iterator begin() const noexcept {
-        return IsValid() ? Iterator(m_array, 0, false, m_name_based) : end();
+        return IsValid() ? Iterator(*this, 0, false) : end();
     }
 
     Iterator end() const noexcept {
-        return Iterator(m_array, m_element_count, true, m_name_based);
+        return Iterator(*this, m_element_count, true);
+    }
+
+   private:
+    inline bool HasDocument() const noexcept { return m_document != nullptr && m_first_object != CacheEntry::NO_OBJECT; }
+};
+
+// Reader of a PackedBooleanArray. The queries work on the packed bits without unpacking them, see
+// BitPacking.hpp.
+class PackedBooleanArrayReader {
+   private:
+    const uint8_t* m_bits = nullptr;
+    uint32_t m_size = 0;
+    bool m_is_valid = false;
+
+   public:
+    explicit PackedBooleanArrayReader(const CacheEntry& entry) noexcept;
+
+    inline bool IsValid() const noexcept { return m_is_valid; }
+    inline uint32_t Size() const noexcept { return m_size; }
+
+    inline std::span<const uint8_t> Bits() const noexcept { return std::span<const uint8_t>(m_bits, PackedBitsSize(m_size)); }
+
+    inline std::optional<bool> GetElement(uint32_t index) const noexcept {
+        return index < m_size ? std::optional<bool>(GetPackedBit(m_bits, index)) : std::nullopt;
+    }
+
+    // Unpacks every element into `out`, returns false if it does not fit
+    inline bool Unpack(std::span<bool> out) const noexcept {
+        if (out.size() < m_size) [[unlikely]] {
+            return false;
+        }
+        UnpackBooleans(m_bits, out.data(), m_size);
+        return true;
+    }
+
+    inline uint32_t CountSet() const noexcept { return static_cast<uint32_t>(CountSetBits(m_bits, m_size)); }
+
+    inline std::optional<uint32_t> FindFirst(bool value = true, uint32_t from = 0) const noexcept {
+        size_t index = FindFirstBit(m_bits, m_size, value, from);
+        return index < m_size ? std::optional<uint32_t>(static_cast<uint32_t>(index)) : std::nullopt;
+    }
+
+    // Combines the elements of both arrays into PackedBitsSize(Size()) bytes of `out`, which can be
+    // written back with ObjectWriter::FieldPackedBits. Fails if the sizes differ or `out` is too small.
+    inline bool Combine(const PackedBooleanArrayReader& other, BitOperation operation, std::span<uint8_t> out) const noexcept {
+        if (other.m_size != m_size || out.size() < PackedBitsSize(m_size)) [[unlikely]] {
+            return false;
+        }
+        CombineBits(m_bits, other.m_bits, out.data(), m_size, operation);
+        return true;
+    }
+
+    inline std::optional<uint32_t> CountCombined(const PackedBooleanArrayReader& other, BitOperation operation) const noexcept {
+        if (other.m_size != m_size) [[unlikely]] {
+            return std::nullopt;
+        }
+        return static_cast<uint32_t>(CountCombinedBits(m_bits, other.m_bits, m_size, operation));
+    }
+};
+
+// Reader of a VarInt64Array or VarUInt64Array, see Varint.hpp
+class VarintArrayReader {
+   private:
+    DataType m_type = DataType::Invalid;
+    const uint8_t* m_encoded = nullptr;
+    FieldSize m_encoded_size = 0;
+    uint32_t m_size = 0;
+
+   public:
+    explicit VarintArrayReader(const CacheEntry& entry) noexcept;
+
+    inline bool IsValid() const noexcept { return m_type != DataType::Invalid; }
+    inline uint32_t Size() const noexcept { return m_size; }
+
+    // The varints as stored, without the element count
+    inline std::span<const uint8_t> Encoded() const noexcept { return std::span<const uint8_t>(m_encoded, m_encoded_size); }
+
+    // Decodes every element into `out`. Signed arrays decode into int64_t and unsigned ones into
+    // uint64_t, returns false for the other type, if `out` is too small or the array is malformed.
+    bool Decode(std::span<int64_t> out) const noexcept;
+    bool Decode(std::span<uint64_t> out) const noexcept;
+};
+
+// Reader of a PackedInt32Array, PackedInt64Array, PackedUInt32Array or PackedUInt64Array, see
+// IntegerPacking.hpp
+class PackedIntegerArrayReader {
+   private:
+    DataType m_type = DataType::Invalid;
+    const uint8_t* m_encoded = nullptr;
+    FieldSize m_encoded_size = 0;
+    uint32_t m_size = 0;
+
+   public:
+    explicit PackedIntegerArrayReader(const CacheEntry& entry) noexcept;
+
+    inline bool IsValid() const noexcept { return m_type != DataType::Invalid; }
+    inline uint32_t Size() const noexcept { return m_size; }
+    inline uint32_t BlockCount() const noexcept { return (m_size + PACKED_BLOCK_LENGTH - 1) / PACKED_BLOCK_LENGTH; }
+
+    // The blocks as stored, without the element count
+    inline std::span<const uint8_t> Encoded() const noexcept { return std::span<const uint8_t>(m_encoded, m_encoded_size); }
+
+    // Decodes every element into `out`, which must have the element type of the array. Returns false
+    // for any other type, if `out` is too small or the array is malformed.
+    bool Decode(std::span<int32_t> out) const noexcept;
+    bool Decode(std::span<int64_t> out) const noexcept;
+    bool Decode(std::span<uint32_t> out) const noexcept;
+    bool Decode(std::span<uint64_t> out) const noexcept;
+
+    // Decodes one block at a time into a stack buffer and calls func(first_index, values) with its
+    // up to PACKED_BLOCK_LENGTH elements. Returns false without calling func if Type is not the
+    // element type, or as soon as a block turns out to be malformed.
+    template <typename Type, typename Func>
+    bool ForEachBlock(Func&& func) const noexcept {
+        if (m_type == DataType::Invalid || BaseDataType(m_type) != IntegerType<Type>()) [[unlikely]] {
+            return false;
+        }
+
+        std::make_unsigned_t<Type> block[PACKED_BLOCK_LENGTH];
+        const uint8_t* read_ptr = m_encoded;
+        const uint8_t* end = m_encoded + m_encoded_size;
+        for (uint32_t first = 0; first < m_size; first += PACKED_BLOCK_LENGTH) {
+            const uint32_t count = std::min(PACKED_BLOCK_LENGTH, m_size - first);
+            const size_t block_size = UnpackIntegerBlock(read_ptr, static_cast<size_t>(end - read_ptr), block, count);
+            if (block_size == 0) [[unlikely]] {
+                return false;
+            }
+            read_ptr += block_size;
+            func(first, std::span<const Type>(reinterpret_cast<const Type*>(block), count));
+        }
+        return read_ptr == end;
     }
+
+   private:
+    template <typename Type>
+    bool DecodeAs(std::span<Type> out) const noexcept;
 };
 
-class Reader {
+// A table of distinct strings and one code per element indexing into it. Elements are resolved to
+// views of the table, and the codes can be read directly to group or filter elements without
+// comparing strings.
+class DictionaryStringArrayReader {
    private:
+    const uint8_t* m_offsets = nullptr;
+    const uint8_t* m_entries = nullptr;
+    const uint8_t* m_codes = nullptr;
+    FieldSize m_entries_size = 0;
+    uint32_t m_size = 0;
+    uint32_t m_entry_count = 0;
+    uint32_t m_width = 0;
+    bool m_is_valid = false;
+
+   public:
+    explicit DictionaryStringArrayReader(const CacheEntry& entry) noexcept;
+
+    inline bool IsValid() const noexcept { return m_is_valid; }
+    inline uint32_t Size() const noexcept { return m_size; }
+    inline uint32_t EntryCount() const noexcept { return m_entry_count; }
+
+    // Bits taken by each code, 0 when every element is the same string
+    inline uint32_t Width() const noexcept { return m_width; }
+
+    // The codes as stored, see GetPackedCode
+    inline std::span<const uint8_t> PackedCodes() const noexcept {
+        return std::span<const uint8_t>(m_codes, PackedCodesSize(m_size, m_width));
+    }
+
+    [[nodiscard]] std::optional<std::string_view> GetEntry(uint32_t code) const noexcept;
+    [[nodiscard]] std::optional<uint32_t> GetCode(uint32_t index) const noexcept;
+
+    [[nodiscard]] std::optional<std::string_view> GetElement(uint32_t index) const noexcept;
+    bool GetElement(uint32_t index, std::string_view& out_value) const noexcept;
+
+    // Unpacks the code of every element into `out`. Codes are not checked against EntryCount, call
+    // Validate first for untrusted input.
+    bool DecodeCodes(std::span<uint32_t> out) const noexcept;
+
+    // Code of the entry equal to `value`, std::nullopt if no element has that value
+    [[nodiscard]] std::optional<uint32_t> FindEntry(std::string_view value) const noexcept;
+
+    // Checks that every entry lies within the array and every code refers to an entry
+    bool Validate() const noexcept;
+};
+
+template <TagMode Mode>
+class BasicReader {
+   private:
+    std::pmr::monotonic_buffer_resource m_arena;
+    DocumentIndex m_document;
     ObjectReader m_root_object;
 
    public:
-    Reader(const void* buffer, size_t size, bool name_based) noexcept;
+    // Every object cache of the document is allocated from `resource`. Passing nullptr makes the
+    // Reader allocate them from an arena it owns, which is released at once when the Reader is
+    // destroyed. ObjectReaders obtained from an arena backed Reader must not outlive it. The arena
+    // never reuses memory, so streaming through very large object arrays is better served by a
+    // pool resource supplied by the caller.
+    //
+    // With IndexMode::Document the whole document is indexed during construction. The index is a
+    // few arrays proportional to the document, so a pool resource reused across documents keeps
+    // them from being returned to the system after every document.
+    BasicReader(const void* buffer, size_t size, bool name_based, IndexMode index_mode = IndexMode::Eager,
+                std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept
+        requires(Mode == TagMode::Runtime);
+    BasicReader(const void* buffer, size_t size, IndexMode index_mode = IndexMode::Eager,
+                std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept
+        requires(Mode != TagMode::Runtime);
+
+    BasicReader(const BasicReader&) = delete;
+    BasicReader& operator=(const BasicReader&) = delete;
 
-    Reader(const Reader&) = delete;
-    Reader& operator=(const Reader&) = delete;
+   protected:
+    BasicReader(const void* buffer, size_t size, bool name_based, IndexMode index_mode, std::pmr::memory_resource* resource,
+                bool trusted) noexcept;
 
+   public:
     inline const ObjectReader& RootObject() const noexcept { return m_root_object; }
     inline bool IsValid() const noexcept { return m_root_object.IsValid(); }
+    inline const DocumentIndex& GetDocumentIndex() const noexcept { return m_document; }
+
+    // Checks the whole document without indexing it: every field type, tag, size and array layout,
+    // recursively through nested objects and object arrays. Unlike IsValid, which only parses the
+    // root object, a document that passes can be read with a TrustedReader. Documents nested more
+    // than MAX_VALIDATION_DEPTH objects deep are rejected.
+    static constexpr uint32_t MAX_VALIDATION_DEPTH = ObjectReader::MAX_VISIT_DEPTH;
+
+    bool Validate() const noexcept;
+    static bool Validate(const void* buffer, size_t size, bool name_based) noexcept;
+    static bool Validate(const void* buffer, size_t size) noexcept
+        requires(Mode != TagMode::Runtime)
+    {
+        return Validate(buffer, size, Mode == TagMode::Name);
+    }
+};
+
+// Reader takes the tag mode of the document as a constructor argument, NameReader and IdReader fix
+// it at compile time. Every mode parses objects through loops specialized for their tag mode.
+using Reader = BasicReader<TagMode::Runtime>;
+using NameReader = BasicReader<TagMode::Name>;
+using IdReader = BasicReader<TagMode::Id>;
+
+extern template class BasicReader<TagMode::Runtime>;
+extern template class BasicReader<TagMode::Name>;
+extern template class BasicReader<TagMode::Id>;
+
+// Reader for documents that already passed Reader::Validate, such as a buffer that a pipeline reads
+// many times after checking it once at ingest. Parsing skips all bounds and type byte checks, so
+// reading a document that was not validated is undefined behavior.
+class TrustedReader : public Reader {
+   public:
+    TrustedReader(const void* buffer, size_t size, bool name_based, IndexMode index_mode = IndexMode::Eager,
+                  std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept
+        : Reader(buffer, size, name_based, index_mode, resource, true) {}
 };
 
 }  // namespace tbf
\ No newline at end of file
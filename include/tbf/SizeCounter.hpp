@@ -0,0 +1,445 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#pragma once
+
+#include "tbf/BitPacking.hpp"
+#include "tbf/DataTag.hpp"
+#include "tbf/DataType.hpp"
+#include "tbf/Varint.hpp"
+#include "tbf/Writer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace tbf {
+
+class ArraySizeCounter;
+
+// Sizing pass of a document. SizeCounter has the field methods of ObjectWriter and counts the bytes
+// each one would write instead of writing them, so a producer written once against either type,
+// such as a function template, measures its document exactly and then writes it through
+// Writer(const SizeCounter&) or into a buffer of its own, which never grows and is only larger
+// than the document by the few bytes of WRITE_SLACK.
+//
+// Fixed size fields and arrays are counted from their lengths alone. Varint and packed integer
+// arrays are encoded block by block on the stack to measure them, dictionary string arrays and
+// compressed fields are written to a scratch Writer, as their size depends on their content.
+class SizeCounter {
+   private:
+    friend class ArraySizeCounter;
+
+   public:
+    // Most bytes a single write reserves beyond what it stores: a name-based field header is copied
+    // as a whole pre-encoded header, a varint is given room for its largest encoding
+    static constexpr size_t WRITE_SLACK =
+        (DataTag::NAME_HEADER_SIZE - sizeof(DataType) - sizeof(DataTag::NameSize)) + (MAX_VARINT_SIZE - 1);
+
+   private:
+    // Shared by the root counter and all the counters nested in it
+    struct Totals {
+        size_t size;  // Bytes of the document
+        size_t peak;  // Most bytes the buffer holds at once, larger than size while a compressed
+                      // field is written uncompressed
+    };
+
+    Totals m_root_totals;  // Only used by the root counter
+    Totals& m_totals;
+    bool m_name_based;
+
+   private:
+    SizeCounter(Totals& totals, bool name_based) noexcept
+        : m_root_totals{0, 0},
+          m_totals(totals),
+          m_name_based(name_based) {}
+
+   public:
+    // Counts a document written in name-based or ID-based mode, starting with its root object
+    explicit SizeCounter(bool name_based = true) noexcept
+        : m_root_totals{sizeof(FieldSize), 0},
+          m_totals(m_root_totals),
+          m_name_based(name_based) {}
+
+    SizeCounter(const SizeCounter&) = delete;
+    SizeCounter& operator=(const SizeCounter&) = delete;
+
+    // Size of the whole document counted so far, the same for the root and every nested counter
+    inline size_t Size() const noexcept { return m_totals.size; }
+
+    // Size of a buffer the document is written to without growing, which Writer(const SizeCounter&)
+    // allocates. Only the first Size() bytes are used.
+    inline size_t Capacity() const noexcept { return std::max(m_totals.size, m_totals.peak) + WRITE_SLACK; }
+
+    inline bool IsNameBased() const noexcept { return m_name_based; }
+
+    // Objects need no finishing to be counted, kept so that producers can call it on either type
+    inline void Finish() noexcept {}
+    inline bool IsFinished() const noexcept { return true; }
+
+   private:
+    inline size_t HeaderSize(const DataTag& tag) const noexcept {
+        if (m_name_based) {
+            return sizeof(DataType) + sizeof(DataTag::NameSize) + tag.GetName().size();
+        }
+        return sizeof(DataType) + sizeof(DataTag::Id);
+    }
+
+    inline void Count(const DataTag& tag, size_t payload_size) noexcept { m_totals.size += HeaderSize(tag) + payload_size; }
+
+    // Size of the writes of `write`, called with the root object of a scratch Writer in the same
+    // tag mode
+    template <typename Func>
+    size_t ScratchSize(Func&& write) const noexcept {
+        Writer scratch(m_name_based, 0);
+        write(scratch.RootObject());
+        return scratch.Size() - sizeof(FieldSize);
+    }
+
+    // ---------------------------------
+    // Field methods
+    // ---------------------------------
+
+   public:
+    inline void FieldInt8(const DataTag& tag, int8_t) noexcept { Count(tag, sizeof(int8_t)); }
+    inline void FieldInt16(const DataTag& tag, int16_t) noexcept { Count(tag, sizeof(int16_t)); }
+    inline void FieldInt32(const DataTag& tag, int32_t) noexcept { Count(tag, sizeof(int32_t)); }
+    inline void FieldInt64(const DataTag& tag, int64_t) noexcept { Count(tag, sizeof(int64_t)); }
+    inline void FieldUInt8(const DataTag& tag, uint8_t) noexcept { Count(tag, sizeof(uint8_t)); }
+    inline void FieldUInt16(const DataTag& tag, uint16_t) noexcept { Count(tag, sizeof(uint16_t)); }
+    inline void FieldUInt32(const DataTag& tag, uint32_t) noexcept { Count(tag, sizeof(uint32_t)); }
+    inline void FieldUInt64(const DataTag& tag, uint64_t) noexcept { Count(tag, sizeof(uint64_t)); }
+
+    inline void FieldVarInt64(const DataTag& tag, int64_t value) noexcept { Count(tag, VarintSize(ZigZagEncode(value))); }
+    inline void FieldVarUInt64(const DataTag& tag, uint64_t value) noexcept { Count(tag, VarintSize(value)); }
+
+    inline void FieldBoolean(const DataTag& tag, bool) noexcept { Count(tag, sizeof(bool)); }
+    inline void FieldFloat16(const DataTag& tag, uint16_t) noexcept { Count(tag, sizeof(uint16_t)); }
+    inline void FieldFloat32(const DataTag& tag, float) noexcept { Count(tag, sizeof(float)); }
+    inline void FieldFloat64(const DataTag& tag, double) noexcept { Count(tag, sizeof(double)); }
+
+    inline void FieldUUID(const DataTag& tag, const void*) noexcept { Count(tag, 16); }
+
+    // Strings and binaries longer than their size field are cut the way the writer cuts them
+    inline void FieldString(const DataTag& tag, std::string_view value) noexcept {
+        Count(tag, sizeof(uint16_t) + static_cast<uint16_t>(value.size()));
+    }
+
+    inline void FieldBinary(const DataTag& tag, const void*, size_t size) noexcept {
+        Count(tag, sizeof(FieldSize) + static_cast<FieldSize>(size));
+    }
+
+    [[nodiscard]] inline SizeCounter FieldObject(const DataTag& tag) noexcept {
+        Count(tag, sizeof(FieldSize));
+        return SizeCounter(m_totals, m_name_based);
+    }
+
+    template <typename Enum>
+        requires std::is_enum<Enum>::value
+    inline void FieldEnum(const DataTag& tag, Enum) noexcept {
+        Count(tag, sizeof(typename std::underlying_type<Enum>::type));
+    }
+
+    // ---------------------------------
+    // Compressed fields
+    // ---------------------------------
+
+   public:
+    // Unlike ObjectWriter::FieldCompressed, `write` is called with the ObjectWriter of a scratch
+    // Writer, which it must accept, as a generic lambda does
+    template <typename Func>
+    void FieldCompressed(Func&& write, FieldSize threshold = ObjectWriter::DEFAULT_COMPRESSION_THRESHOLD) noexcept {
+        size_t raw_size = 0;
+        const size_t size = ScratchSize([&](ObjectWriter& obj) {
+            obj.FieldCompressed(
+                [&](ObjectWriter& field) {
+                    write(field);
+                    raw_size = field.GetWriter().Size() - sizeof(FieldSize);
+                },
+                threshold);
+        });
+
+        // The field is written uncompressed before it is compressed in place
+        m_totals.peak = std::max(m_totals.peak, m_totals.size + raw_size);
+        m_totals.size += size;
+    }
+
+    inline void FieldCompressedBinary(const DataTag& tag, const void* data, size_t size,
+                                      FieldSize threshold = ObjectWriter::DEFAULT_COMPRESSION_THRESHOLD) noexcept {
+        FieldCompressed([&](ObjectWriter& obj) { obj.FieldBinary(tag, data, size); }, threshold);
+    }
+
+    // ---------------------------------
+    // Array field methods
+    // ---------------------------------
+
+   private:
+    template <typename Type>
+    inline void FieldArray(const DataTag& tag, uint32_t length) noexcept {
+        Count(tag, sizeof(FieldSize) + sizeof(Type) * length);
+    }
+
+   public:
+    inline void FieldArrayInt8(const DataTag& tag, const int8_t*, uint32_t length) noexcept { FieldArray<int8_t>(tag, length); }
+    inline void FieldArrayInt16(const DataTag& tag, const int16_t*, uint32_t length) noexcept { FieldArray<int16_t>(tag, length); }
+    inline void FieldArrayInt32(const DataTag& tag, const int32_t*, uint32_t length) noexcept { FieldArray<int32_t>(tag, length); }
+    inline void FieldArrayInt64(const DataTag& tag, const int64_t*, uint32_t length) noexcept { FieldArray<int64_t>(tag, length); }
+
+    inline void FieldArrayUInt8(const DataTag& tag, const uint8_t*, uint32_t length) noexcept { FieldArray<uint8_t>(tag, length); }
+    inline void FieldArrayUInt16(const DataTag& tag, const uint16_t*, uint32_t length) noexcept { FieldArray<uint16_t>(tag, length); }
+    inline void FieldArrayUInt32(const DataTag& tag, const uint32_t*, uint32_t length) noexcept { FieldArray<uint32_t>(tag, length); }
+    inline void FieldArrayUInt64(const DataTag& tag, const uint64_t*, uint32_t length) noexcept { FieldArray<uint64_t>(tag, length); }
+
+    inline void FieldArrayBoolean(const DataTag& tag, const bool*, uint32_t length) noexcept { FieldArray<bool>(tag, length); }
+    inline void FieldArrayFloat16(const DataTag& tag, const uint16_t*, uint32_t length) noexcept { FieldArray<uint16_t>(tag, length); }
+    inline void FieldArrayFloat16(const DataTag& tag, const float*, uint32_t length) noexcept { FieldArray<uint16_t>(tag, length); }
+    inline void FieldArrayFloat32(const DataTag& tag, const float*, uint32_t length) noexcept { FieldArray<float>(tag, length); }
+    inline void FieldArrayFloat64(const DataTag& tag, const double*, uint32_t length) noexcept { FieldArray<double>(tag, length); }
+
+    inline void FieldPackedBooleanArray(const DataTag& tag, const bool*, uint32_t length) noexcept {
+        Count(tag, sizeof(FieldSize) + sizeof(uint32_t) + PackedBitsSize(length));
+    }
+
+    inline void FieldPackedBits(const DataTag& tag, const uint8_t*, uint32_t length) noexcept {
+        Count(tag, sizeof(FieldSize) + sizeof(uint32_t) + PackedBitsSize(length));
+    }
+
+    void FieldVarInt64Array(const DataTag& tag, const int64_t* data, uint32_t length) noexcept;
+    void FieldVarUInt64Array(const DataTag& tag, const uint64_t* data, uint32_t length) noexcept;
+
+    void FieldPackedInt32Array(const DataTag& tag, const int32_t* data, uint32_t length) noexcept;
+    void FieldPackedInt64Array(const DataTag& tag, const int64_t* data, uint32_t length) noexcept;
+    void FieldPackedUInt32Array(const DataTag& tag, const uint32_t* data, uint32_t length) noexcept;
+    void FieldPackedUInt64Array(const DataTag& tag, const uint64_t* data, uint32_t length) noexcept;
+
+    [[nodiscard]] ArraySizeCounter FieldStringArray(const DataTag& tag, ArrayLayout layout = ArrayLayout::Plain) noexcept;
+    void FieldStringArray(const DataTag& tag, const std::string_view* data, uint32_t length,
+                          ArrayLayout layout = ArrayLayout::Plain) noexcept;
+
+    void FieldDictionaryStringArray(const DataTag& tag, const std::string_view* data, uint32_t length) noexcept;
+
+    [[nodiscard]] ArraySizeCounter FieldBinaryArray(const DataTag& tag, ArrayLayout layout = ArrayLayout::Plain) noexcept;
+    void FieldBinaryArray(const DataTag& tag, const void* const* data, const uint32_t* sizes, uint32_t length,
+                          ArrayLayout layout = ArrayLayout::Plain) noexcept;
+
+    [[nodiscard]] ArraySizeCounter FieldObjectArray(const DataTag& tag, ArrayLayout layout = ArrayLayout::Plain) noexcept;
+
+    // ---------------------------------
+    // Array field with std::span
+    // ---------------------------------
+
+   public:
+    inline void FieldArrayInt8(const DataTag& tag, std::span<const int8_t> data) noexcept {
+        FieldArrayInt8(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldArrayInt16(const DataTag& tag, std::span<const int16_t> data) noexcept {
+        FieldArrayInt16(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldArrayInt32(const DataTag& tag, std::span<const int32_t> data) noexcept {
+        FieldArrayInt32(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldArrayInt64(const DataTag& tag, std::span<const int64_t> data) noexcept {
+        FieldArrayInt64(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldArrayUInt8(const DataTag& tag, std::span<const uint8_t> data) noexcept {
+        FieldArrayUInt8(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldArrayUInt16(const DataTag& tag, std::span<const uint16_t> data) noexcept {
+        FieldArrayUInt16(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldArrayUInt32(const DataTag& tag, std::span<const uint32_t> data) noexcept {
+        FieldArrayUInt32(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldArrayUInt64(const DataTag& tag, std::span<const uint64_t> data) noexcept {
+        FieldArrayUInt64(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldArrayBoolean(const DataTag& tag, std::span<const bool> data) noexcept {
+        FieldArrayBoolean(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldPackedBooleanArray(const DataTag& tag, std::span<const bool> data) noexcept {
+        FieldPackedBooleanArray(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldVarInt64Array(const DataTag& tag, std::span<const int64_t> data) noexcept {
+        FieldVarInt64Array(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldVarUInt64Array(const DataTag& tag, std::span<const uint64_t> data) noexcept {
+        FieldVarUInt64Array(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldPackedInt32Array(const DataTag& tag, std::span<const int32_t> data) noexcept {
+        FieldPackedInt32Array(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldPackedInt64Array(const DataTag& tag, std::span<const int64_t> data) noexcept {
+        FieldPackedInt64Array(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldPackedUInt32Array(const DataTag& tag, std::span<const uint32_t> data) noexcept {
+        FieldPackedUInt32Array(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldPackedUInt64Array(const DataTag& tag, std::span<const uint64_t> data) noexcept {
+        FieldPackedUInt64Array(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldDictionaryStringArray(const DataTag& tag, std::span<const std::string_view> data) noexcept {
+        FieldDictionaryStringArray(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldArrayFloat16(const DataTag& tag, std::span<const uint16_t> data) noexcept {
+        FieldArrayFloat16(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldArrayFloat16(const DataTag& tag, std::span<const float> data) noexcept {
+        FieldArrayFloat16(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldArrayFloat32(const DataTag& tag, std::span<const float> data) noexcept {
+        FieldArrayFloat32(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldArrayFloat64(const DataTag& tag, std::span<const double> data) noexcept {
+        FieldArrayFloat64(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    // ---------------------------------
+    // Field vectors
+    // ---------------------------------
+
+   private:
+    template <typename Type, uint32_t dim>
+    inline void FieldVector(const DataTag& tag) noexcept {
+        Count(tag, sizeof(Type) * dim);
+    }
+
+   public:
+    // Vector 2
+
+    inline void FieldVector2i8(const DataTag& tag, const int8_t*) noexcept { FieldVector<int8_t, 2>(tag); }
+    inline void FieldVector2i16(const DataTag& tag, const int16_t*) noexcept { FieldVector<int16_t, 2>(tag); }
+    inline void FieldVector2i32(const DataTag& tag, const int32_t*) noexcept { FieldVector<int32_t, 2>(tag); }
+    inline void FieldVector2i64(const DataTag& tag, const int64_t*) noexcept { FieldVector<int64_t, 2>(tag); }
+    inline void FieldVector2i8(const DataTag& tag, const uint8_t*) noexcept { FieldVector<uint8_t, 2>(tag); }
+    inline void FieldVector2i16(const DataTag& tag, const uint16_t*) noexcept { FieldVector<uint16_t, 2>(tag); }
+    inline void FieldVector2i32(const DataTag& tag, const uint32_t*) noexcept { FieldVector<uint32_t, 2>(tag); }
+    inline void FieldVector2i64(const DataTag& tag, const uint64_t*) noexcept { FieldVector<uint64_t, 2>(tag); }
+    inline void FieldVector2b(const DataTag& tag, const bool*) noexcept { FieldVector<bool, 2>(tag); }
+    inline void FieldVector2f16(const DataTag& tag, const uint16_t*) noexcept { FieldVector<uint16_t, 2>(tag); }
+    inline void FieldVector2f16(const DataTag& tag, const float*) noexcept { FieldVector<uint16_t, 2>(tag); }
+    inline void FieldVector2f32(const DataTag& tag, const float*) noexcept { FieldVector<float, 2>(tag); }
+    inline void FieldVector2f64(const DataTag& tag, const double*) noexcept { FieldVector<double, 2>(tag); }
+
+    // Vector 3
+
+    inline void FieldVector3i8(const DataTag& tag, const int8_t*) noexcept { FieldVector<int8_t, 3>(tag); }
+    inline void FieldVector3i16(const DataTag& tag, const int16_t*) noexcept { FieldVector<int16_t, 3>(tag); }
+    inline void FieldVector3i32(const DataTag& tag, const int32_t*) noexcept { FieldVector<int32_t, 3>(tag); }
+    inline void FieldVector3i64(const DataTag& tag, const int64_t*) noexcept { FieldVector<int64_t, 3>(tag); }
+    inline void FieldVector3i8(const DataTag& tag, const uint8_t*) noexcept { FieldVector<uint8_t, 3>(tag); }
+    inline void FieldVector3i16(const DataTag& tag, const uint16_t*) noexcept { FieldVector<uint16_t, 3>(tag); }
+    inline void FieldVector3i32(const DataTag& tag, const uint32_t*) noexcept { FieldVector<uint32_t, 3>(tag); }
+    inline void FieldVector3i64(const DataTag& tag, const uint64_t*) noexcept { FieldVector<uint64_t, 3>(tag); }
+    inline void FieldVector3b(const DataTag& tag, const bool*) noexcept { FieldVector<bool, 3>(tag); }
+    inline void FieldVector3f16(const DataTag& tag, const uint16_t*) noexcept { FieldVector<uint16_t, 3>(tag); }
+    inline void FieldVector3f16(const DataTag& tag, const float*) noexcept { FieldVector<uint16_t, 3>(tag); }
+    inline void FieldVector3f32(const DataTag& tag, const float*) noexcept { FieldVector<float, 3>(tag); }
+    inline void FieldVector3f64(const DataTag& tag, const double*) noexcept { FieldVector<double, 3>(tag); }
+
+    // Vector 4
+
+    inline void FieldVector4i8(const DataTag& tag, const int8_t*) noexcept { FieldVector<int8_t, 4>(tag); }
+    inline void FieldVector4i16(const DataTag& tag, const int16_t*) noexcept { FieldVector<int16_t, 4>(tag); }
+    inline void FieldVector4i32(const DataTag& tag, const int32_t*) noexcept { FieldVector<int32_t, 4>(tag); }
+    inline void FieldVector4i64(const DataTag& tag, const int64_t*) noexcept { FieldVector<int64_t, 4>(tag); }
+    inline void FieldVector4i8(const DataTag& tag, const uint8_t*) noexcept { FieldVector<uint8_t, 4>(tag); }
+    inline void FieldVector4i16(const DataTag& tag, const uint16_t*) noexcept { FieldVector<uint16_t, 4>(tag); }
+    inline void FieldVector4i32(const DataTag& tag, const uint32_t*) noexcept { FieldVector<uint32_t, 4>(tag); }
+    inline void FieldVector4i64(const DataTag& tag, const uint64_t*) noexcept { FieldVector<uint64_t, 4>(tag); }
+    inline void FieldVector4b(const DataTag& tag, const bool*) noexcept { FieldVector<bool, 4>(tag); }
+    inline void FieldVector4f16(const DataTag& tag, const uint16_t*) noexcept { FieldVector<uint16_t, 4>(tag); }
+    inline void FieldVector4f16(const DataTag& tag, const float*) noexcept { FieldVector<uint16_t, 4>(tag); }
+    inline void FieldVector4f32(const DataTag& tag, const float*) noexcept { FieldVector<float, 4>(tag); }
+    inline void FieldVector4f64(const DataTag& tag, const double*) noexcept { FieldVector<double, 4>(tag); }
+};
+
+// Counts the elements of a String, Binary or Object array, with the methods of the array writer of
+// each type
+class ArraySizeCounter {
+   private:
+    friend class SizeCounter;
+
+   private:
+    SizeCounter& m_obj;
+    bool m_indexed;
+
+   private:
+    ArraySizeCounter(SizeCounter& obj, ArrayLayout layout) noexcept : m_obj(obj), m_indexed(layout == ArrayLayout::Indexed) {
+        // Array size, and element count of an indexed array
+        m_obj.m_totals.size += m_indexed ? sizeof(FieldSize) + sizeof(uint32_t) : sizeof(FieldSize);
+    }
+
+    // Element offset of an indexed array
+    inline void BeginElement() noexcept { m_obj.m_totals.size += m_indexed ? sizeof(uint32_t) : 0; }
+
+   public:
+    ArraySizeCounter(const ArraySizeCounter&) = delete;
+    ArraySizeCounter& operator=(const ArraySizeCounter&) = delete;
+
+    inline void Finish() noexcept {}
+    inline bool IsFinished() const noexcept { return true; }
+
+    inline void AddElement(std::string_view element) noexcept {
+        BeginElement();
+        m_obj.m_totals.size += sizeof(uint16_t) + static_cast<uint16_t>(element.size());
+    }
+
+    inline void AddElement(const void*, FieldSize size) noexcept {
+        BeginElement();
+        m_obj.m_totals.size += sizeof(FieldSize) + size;
+    }
+
+    [[nodiscard]] inline SizeCounter CreateElement() noexcept {
+        BeginElement();
+        m_obj.m_totals.size += sizeof(FieldSize);
+        return SizeCounter(m_obj.m_totals, m_obj.m_name_based);
+    }
+};
+
+}  // namespace tbf
@@ -0,0 +1,101 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace tbf {
+
+// Varints store an integer in 7 bit groups, least significant first, with the high bit of each byte
+// set when another byte follows (LEB128). Signed values are zigzag mapped first, so small negative
+// numbers stay short: 0, -1, 1, -2, ... become 0, 1, 2, 3, ...
+
+inline constexpr uint32_t MAX_VARINT_SIZE = 10;
+
+inline constexpr uint64_t ZigZagEncode(int64_t value) noexcept {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline constexpr int64_t ZigZagDecode(uint64_t value) noexcept {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+inline constexpr uint32_t VarintSize(uint64_t value) noexcept {
+    return static_cast<uint32_t>(70 - std::countl_zero(value | 1)) / 7;
+}
+
+// Writes `value` to `out`, which needs room for VarintSize(value) bytes, and returns that size
+inline uint32_t EncodeVarint(uint64_t value, uint8_t* out) noexcept {
+    uint32_t size = 0;
+    while (value >= 0x80) {
+        out[size++] = static_cast<uint8_t>(value) | 0x80;
+        value >>= 7;
+    }
+    out[size++] = static_cast<uint8_t>(value);
+    return size;
+}
+
+// Reads one varint from [src, end). Returns the number of bytes read, or 0 if the varint is
+// truncated or does not fit in 64 bits.
+inline uint32_t DecodeVarint(const uint8_t* src, const uint8_t* end, uint64_t& out_value) noexcept {
+    uint64_t value = 0;
+    for (uint32_t i = 0; i < MAX_VARINT_SIZE && src + i < end; ++i) {
+        const uint8_t byte = src[i];
+        if (i == MAX_VARINT_SIZE - 1 && byte > 1) [[unlikely]] {
+            return 0;
+        }
+
+        value |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+        if ((byte & 0x80) == 0) {
+            out_value = value;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+// Bulk encoding of `count` values into `out`, which needs room for count * MAX_VARINT_SIZE bytes.
+// Returns the number of bytes written.
+size_t EncodeVarints(const uint64_t* values, size_t count, uint8_t* out) noexcept;
+size_t EncodeZigZagVarints(const int64_t* values, size_t count, uint8_t* out) noexcept;
+
+// Bulk decoding of exactly `count` varints that must fill the `size` bytes at `src`. Returns false
+// if they do not or a varint is malformed, in which case `out` holds partial results.
+//
+// Runs of one byte values are found with a movemask of the continuation bits and widened 16 at a
+// time with SSE2 or AVX2. With SSSE3, up to four values of at most four bytes are decoded at a time
+// with a shuffle looked up from the same mask (Masked VByte). Longer values go through
+// DecodeVarint, whose per-byte branches predict better than computing the length from a word load,
+// which puts it on the critical path.
+bool DecodeVarints(const uint8_t* src, size_t size, uint64_t* out, size_t count) noexcept;
+bool DecodeZigZagVarints(const uint8_t* src, size_t size, int64_t* out, size_t count) noexcept;
+
+// Same checks as DecodeVarints without storing the values
+bool ValidateVarints(const uint8_t* src, size_t size, size_t count) noexcept;
+
+}  // namespace tbf
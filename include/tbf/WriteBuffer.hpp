@@ -0,0 +1,165 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace tbf {
+
+using BufferOffset = size_t;
+
+// The byte buffer of a Writer, grown by chaining chunks instead of reallocating, so written bytes
+// are never moved or copied again. Each chunk is at least as large as everything written before it,
+// up to MAX_CHUNK_SIZE, so a document takes a logarithmic number of allocations. Offsets count bytes
+// from the start of the buffer regardless of the chunk they fall in.
+//
+// Every Append and Reserve is contiguous, one that does not fit in the current chunk starts the
+// next, so what a single write stored can be patched in place through Pointer. The document is read
+// back either as the list of chunks, suited to writev, or coalesced into one block by Data.
+//
+// A buffer whose final size is known, see SizeCounter, starts with a first chunk large enough for
+// it, allocated once or provided by the caller, and never adds another.
+class WriteBuffer {
+   public:
+    static constexpr size_t MAX_CHUNK_SIZE = 64 * 1024 * 1024;  // 64 MiB
+
+   private:
+    struct Chunk {
+        uint8_t* data;
+        std::unique_ptr<uint8_t[]> storage;  // Null for a chunk owned by the caller
+        size_t capacity;
+        size_t size;          // Bytes written, updated when the chunk stops being the last one
+        BufferOffset offset;  // Offset of the first byte
+    };
+
+   private:
+    // The first chunk is kept apart so that a buffer of one chunk allocates nothing else
+    Chunk m_first{nullptr, nullptr, 0, 0, 0};
+    std::vector<Chunk> m_chunks;  // Every chunk after the first
+
+    // Write position in the last chunk
+    uint8_t* m_begin = nullptr;
+    uint8_t* m_cursor = nullptr;
+    uint8_t* m_end = nullptr;
+    BufferOffset m_offset = 0;
+
+    size_t m_min_chunk_size;
+
+   public:
+    explicit WriteBuffer(size_t min_chunk_size) noexcept : m_min_chunk_size(min_chunk_size) {}
+
+    // Starts with a first chunk of exactly `capacity` bytes, allocated here or, given `data`, owned
+    // by the caller, who keeps it alive as long as the buffer. Writing past it adds chunks as usual.
+    WriteBuffer(size_t min_chunk_size, size_t capacity, void* data = nullptr) noexcept;
+
+    WriteBuffer(const WriteBuffer&) = delete;
+    WriteBuffer& operator=(const WriteBuffer&) = delete;
+
+    // Size of the first chunk and of every chunk after it, when larger than the doubling size
+    inline void SetMinChunkSize(size_t size) noexcept { m_min_chunk_size = size; }
+
+    inline size_t Size() const noexcept { return m_offset + static_cast<size_t>(m_cursor - m_begin); }
+
+    // ---------------------------------
+    // Writing
+    // ---------------------------------
+
+    // Makes room for `size` contiguous bytes and returns where they start. The caller stores up to
+    // `size` bytes there without further checks and passes the end of what it stored to Commit.
+    [[gnu::always_inline]]
+    inline uint8_t* Reserve(size_t size) noexcept {
+        if (size > static_cast<size_t>(m_end - m_cursor)) [[unlikely]] {
+            AddChunk(size);
+        }
+        return m_cursor;
+    }
+
+    [[gnu::always_inline]]
+    inline void Commit(uint8_t* end) noexcept {
+        m_cursor = end;
+    }
+
+    [[gnu::always_inline]]
+    inline void Append(const void* data, size_t size) noexcept {
+        // Empty payloads may come with a null pointer, which memcpy does not accept
+        if (size == 0) {
+            return;
+        }
+        Reserve(size);
+        std::memcpy(m_cursor, data, size);
+        m_cursor += size;
+    }
+
+    // Address of the byte at `offset`. The bytes after it are only contiguous up to the end of the
+    // write that stored it.
+    [[gnu::always_inline]]
+    inline uint8_t* Pointer(BufferOffset offset) noexcept {
+        if (offset >= m_offset) [[likely]] {
+            return m_begin + (offset - m_offset);
+        }
+        const Chunk& chunk = FindChunk(offset);
+        return chunk.data + (offset - chunk.offset);
+    }
+
+    // Copies `size` bytes starting at `offset`, which may span chunks, into `dest`
+    void Read(BufferOffset offset, void* dest, size_t size) const noexcept;
+
+    // Address of the `size` bytes starting at `offset` if they lie in one chunk, nullptr otherwise
+    const uint8_t* Contiguous(BufferOffset offset, size_t size) const noexcept;
+
+    // Drops every byte from `size` on, releasing the chunks that held them
+    void Truncate(size_t size) noexcept;
+
+    // ---------------------------------
+    // Output
+    // ---------------------------------
+
+    // The written bytes of each chunk in order, without copying them
+    std::vector<std::span<const uint8_t>> Segments() const noexcept;
+
+    // Copies the Size() bytes of the buffer into `dest`
+    void CopyTo(void* dest) const noexcept;
+
+    // The buffer as one block. A buffer of several chunks is first coalesced into a single chunk of
+    // exactly Size() bytes, writing more afterwards starts a new chunk.
+    const uint8_t* Data() noexcept;
+
+   private:
+    void AddChunk(size_t size) noexcept;
+    inline Chunk& LastChunk() noexcept { return m_chunks.empty() ? m_first : m_chunks.back(); }
+    inline const Chunk& LastChunk() const noexcept { return m_chunks.empty() ? m_first : m_chunks.back(); }
+
+    const Chunk& FindChunk(BufferOffset offset) const noexcept;
+    const Chunk* NextChunk(const Chunk* chunk) const noexcept;
+    size_t ChunkSize(const Chunk& chunk) const noexcept;
+};
+
+}  // namespace tbf
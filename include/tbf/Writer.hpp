@@ -27,6 +27,7 @@
 
 #include "tbf/DataTag.hpp"
 #include "tbf/DataType.hpp"
+#include "tbf/WriteBuffer.hpp"
 
 #include <cstddef>
 #include <cstdint>
@@ -37,40 +38,56 @@
 
 namespace tbf {
 
-class Writer;
-class ObjectWriter;
-
-class StringArrayWriter;
-class BinaryArrayWriter;
-class ObjectArrayWriter;
-
-using BufferOffset = size_t;
+class SizeCounter;
+
+template <TagMode Mode>
+class BasicWriter;
+template <TagMode Mode>
+class BasicObjectWriter;
+template <TagMode Mode>
+class BasicArrayWriter;
+
+template <TagMode Mode>
+class BasicStringArrayWriter;
+template <TagMode Mode>
+class BasicBinaryArrayWriter;
+template <TagMode Mode>
+class BasicObjectArrayWriter;
+
+// Layout of String, Binary and Object arrays. Indexed arrays store their element count and a table
+// of element offsets, which lets readers count and index the elements without walking the array,
+// at the cost of four bytes per element.
+enum class ArrayLayout : uint8_t {
+    Plain,
+    Indexed,
+};
 
-class ObjectWriter {
+template <TagMode Mode>
+class BasicObjectWriter {
    private:
-    friend class Writer;
-    friend class ArrayWriter;
-    friend class ObjectArrayWriter;
+    friend class BasicWriter<Mode>;
+    friend class BasicArrayWriter<Mode>;
+    friend class BasicObjectArrayWriter<Mode>;
 
    private:
-    Writer& m_writer;
+    BasicWriter<Mode>& m_writer;
     BufferOffset m_obj_size_pos;
 
     bool m_is_finished;
 
    private:
-    ObjectWriter(Writer& writer) noexcept;
+    BasicObjectWriter(BasicWriter<Mode>& writer) noexcept;
 
    public:
-    ObjectWriter(const ObjectWriter&) = delete;
-    ObjectWriter& operator=(const ObjectWriter&) = delete;
+    BasicObjectWriter(const BasicObjectWriter&) = delete;
+    BasicObjectWriter& operator=(const BasicObjectWriter&) = delete;
 
    public:
     void Finish() noexcept;
     inline bool IsFinished() const noexcept { return m_is_finished; }
 
-    inline Writer& GetWriter() noexcept { return m_writer; }
-    inline const Writer& GetWriter() const noexcept { return m_writer; }
+    inline BasicWriter<Mode>& GetWriter() noexcept { return m_writer; }
+    inline const BasicWriter<Mode>& GetWriter() const noexcept { return m_writer; }
 
     // ---------------------------------
     // Field methods
@@ -87,6 +104,10 @@ class ObjectWriter {
     void FieldUInt32(const DataTag& tag, uint32_t value) noexcept;
     void FieldUInt64(const DataTag& tag, uint64_t value) noexcept;
 
+    // Between 1 and 10 bytes depending on the magnitude of the value, see Varint.hpp
+    void FieldVarInt64(const DataTag& tag, int64_t value) noexcept;
+    void FieldVarUInt64(const DataTag& tag, uint64_t value) noexcept;
+
     void FieldBoolean(const DataTag& tag, bool value) noexcept;
     void FieldFloat16(const DataTag& tag, uint16_t value) noexcept;
     void FieldFloat32(const DataTag& tag, float value) noexcept;
@@ -95,12 +116,41 @@ class ObjectWriter {
     void FieldUUID(const DataTag& tag, const void* uuid) noexcept;
     void FieldString(const DataTag& tag, std::string_view value) noexcept;
     void FieldBinary(const DataTag& tag, const void* data, size_t size) noexcept;
-    [[nodiscard]] ObjectWriter FieldObject(const DataTag& tag) noexcept;
+    [[nodiscard]] BasicObjectWriter FieldObject(const DataTag& tag) noexcept;
 
     template <typename Enum>
         requires std::is_enum<Enum>::value
     inline void FieldEnum(const DataTag& tag, Enum value);
 
+    // ---------------------------------
+    // Compressed fields
+    // ---------------------------------
+
+   public:
+    // Payloads smaller than this are left uncompressed by default, the envelope and the lookups of
+    // the compressor would cost more than they could save
+    static constexpr FieldSize DEFAULT_COMPRESSION_THRESHOLD = 256;
+
+    // Calls write(*this), which must write exactly one Binary, Object or array field, and wraps that
+    // field in a Compressed field if its payload is at least `threshold` bytes and compressing it
+    // saves space. Otherwise the field is left as written. Readers access the wrapped field through
+    // ObjectReader::ReadCompressed.
+    template <typename Func>
+    void FieldCompressed(Func&& write, FieldSize threshold = DEFAULT_COMPRESSION_THRESHOLD) noexcept {
+        const BufferOffset field_pos = GetFieldOffset();
+        write(*this);
+        CompressField(field_pos, threshold);
+    }
+
+    inline void FieldCompressedBinary(const DataTag& tag, const void* data, size_t size,
+                                      FieldSize threshold = DEFAULT_COMPRESSION_THRESHOLD) noexcept {
+        FieldCompressed([&](BasicObjectWriter& obj) { obj.FieldBinary(tag, data, size); }, threshold);
+    }
+
+   private:
+    BufferOffset GetFieldOffset() const noexcept;
+    void CompressField(BufferOffset field_pos, FieldSize threshold) noexcept;
+
     // ---------------------------------
     // Array field methods
     // ---------------------------------
@@ -122,16 +172,39 @@ class ObjectWriter {
 
     void FieldArrayBoolean(const DataTag& tag, const bool* data, uint32_t length) noexcept;
     void FieldArrayFloat16(const DataTag& tag, const uint16_t* data, uint32_t length) noexcept;
+    void FieldArrayFloat16(const DataTag& tag, const float* data, uint32_t length) noexcept;  // Converted, see Float16.hpp
     void FieldArrayFloat32(const DataTag& tag, const float* data, uint32_t length) noexcept;
     void FieldArrayFloat64(const DataTag& tag, const double* data, uint32_t length) noexcept;
 
-    [[nodiscard]] StringArrayWriter FieldStringArray(const DataTag& tag) noexcept;
-    void FieldStringArray(const DataTag& tag, const std::string_view* data, uint32_t length) noexcept;
+    // One bit per element instead of one byte, see BitPacking.hpp. FieldPackedBits writes `length`
+    // elements that are already packed, such as the result of CombineBits.
+    void FieldPackedBooleanArray(const DataTag& tag, const bool* data, uint32_t length) noexcept;
+    void FieldPackedBits(const DataTag& tag, const uint8_t* bits, uint32_t length) noexcept;
 
-    [[nodiscard]] BinaryArrayWriter FieldBinaryArray(const DataTag& tag) noexcept;
-    void FieldBinaryArray(const DataTag& tag, const void* const* data, const uint32_t* sizes, uint32_t length) noexcept;
+    void FieldVarInt64Array(const DataTag& tag, const int64_t* data, uint32_t length) noexcept;
+    void FieldVarUInt64Array(const DataTag& tag, const uint64_t* data, uint32_t length) noexcept;
 
-    [[nodiscard]] ObjectArrayWriter FieldObjectArray(const DataTag& tag) noexcept;
+    // Blocks of 128 elements stored as bit-packed offsets, deltas or deltas of deltas, whichever is
+    // smallest for the block, see IntegerPacking.hpp. Suited to sorted IDs and timestamps.
+    void FieldPackedInt32Array(const DataTag& tag, const int32_t* data, uint32_t length) noexcept;
+    void FieldPackedInt64Array(const DataTag& tag, const int64_t* data, uint32_t length) noexcept;
+    void FieldPackedUInt32Array(const DataTag& tag, const uint32_t* data, uint32_t length) noexcept;
+    void FieldPackedUInt64Array(const DataTag& tag, const uint64_t* data, uint32_t length) noexcept;
+
+    [[nodiscard]] BasicStringArrayWriter<Mode> FieldStringArray(const DataTag& tag, ArrayLayout layout = ArrayLayout::Plain) noexcept;
+    void FieldStringArray(const DataTag& tag, const std::string_view* data, uint32_t length,
+                          ArrayLayout layout = ArrayLayout::Plain) noexcept;
+
+    // Stores every distinct string once, followed by a code per element packed in as few bits as the
+    // number of distinct strings needs. Falls back to a plain StringArray when that would not be
+    // smaller, as happens once most elements are distinct, so readers must accept both types.
+    void FieldDictionaryStringArray(const DataTag& tag, const std::string_view* data, uint32_t length) noexcept;
+
+    [[nodiscard]] BasicBinaryArrayWriter<Mode> FieldBinaryArray(const DataTag& tag, ArrayLayout layout = ArrayLayout::Plain) noexcept;
+    void FieldBinaryArray(const DataTag& tag, const void* const* data, const uint32_t* sizes, uint32_t length,
+                          ArrayLayout layout = ArrayLayout::Plain) noexcept;
+
+    [[nodiscard]] BasicObjectArrayWriter<Mode> FieldObjectArray(const DataTag& tag, ArrayLayout layout = ArrayLayout::Plain) noexcept;
 
     // ---------------------------------
     // Array field with std::span
@@ -174,10 +247,46 @@ class ObjectWriter {
         FieldArrayBoolean(tag, data.data(), static_cast<uint32_t>(data.size()));
     }
 
+    inline void FieldPackedBooleanArray(const DataTag& tag, std::span<const bool> data) noexcept {
+        FieldPackedBooleanArray(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldVarInt64Array(const DataTag& tag, std::span<const int64_t> data) noexcept {
+        FieldVarInt64Array(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldVarUInt64Array(const DataTag& tag, std::span<const uint64_t> data) noexcept {
+        FieldVarUInt64Array(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldPackedInt32Array(const DataTag& tag, std::span<const int32_t> data) noexcept {
+        FieldPackedInt32Array(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldPackedInt64Array(const DataTag& tag, std::span<const int64_t> data) noexcept {
+        FieldPackedInt64Array(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldPackedUInt32Array(const DataTag& tag, std::span<const uint32_t> data) noexcept {
+        FieldPackedUInt32Array(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldPackedUInt64Array(const DataTag& tag, std::span<const uint64_t> data) noexcept {
+        FieldPackedUInt64Array(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
+    inline void FieldDictionaryStringArray(const DataTag& tag, std::span<const std::string_view> data) noexcept {
+        FieldDictionaryStringArray(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
     inline void FieldArrayFloat16(const DataTag& tag, std::span<const uint16_t> data) noexcept {
         FieldArrayFloat16(tag, data.data(), static_cast<uint32_t>(data.size()));
     }
 
+    inline void FieldArrayFloat16(const DataTag& tag, std::span<const float> data) noexcept {
+        FieldArrayFloat16(tag, data.data(), static_cast<uint32_t>(data.size()));
+    }
+
     inline void FieldArrayFloat32(const DataTag& tag, std::span<const float> data) noexcept {
         FieldArrayFloat32(tag, data.data(), static_cast<uint32_t>(data.size()));
     }
@@ -186,6 +295,17 @@ class ObjectWriter {
         FieldArrayFloat64(tag, data.data(), static_cast<uint32_t>(data.size()));
     }
 
+    // ---------------------------------
+    // Varint and packed integer arrays
+    // ---------------------------------
+
+   private:
+    template <typename Type, size_t (*encode)(const Type*, size_t, uint8_t*) noexcept>
+    void FieldVarintArray(const DataTag& tag, DataType array_type, const Type* data, uint32_t length) noexcept;
+
+    template <typename Type>
+    void FieldPackedIntegerArray(const DataTag& tag, DataType array_type, const Type* data, uint32_t length) noexcept;
+
     // ---------------------------------
     // Field vectors
     // ---------------------------------
@@ -221,6 +341,7 @@ class ObjectWriter {
 
     void FieldVector2b(const DataTag& tag, const bool* data) noexcept;
     void FieldVector2f16(const DataTag& tag, const uint16_t* data) noexcept;
+    void FieldVector2f16(const DataTag& tag, const float* data) noexcept;
     void FieldVector2f32(const DataTag& tag, const float* data) noexcept;
     void FieldVector2f64(const DataTag& tag, const double* data) noexcept;
 
@@ -249,6 +370,7 @@ class ObjectWriter {
 
     void FieldVector3b(const DataTag& tag, const bool* data) noexcept;
     void FieldVector3f16(const DataTag& tag, const uint16_t* data) noexcept;
+    void FieldVector3f16(const DataTag& tag, const float* data) noexcept;
     void FieldVector3f32(const DataTag& tag, const float* data) noexcept;
     void FieldVector3f64(const DataTag& tag, const double* data) noexcept;
 
@@ -277,76 +399,88 @@ class ObjectWriter {
 
     void FieldVector4b(const DataTag& tag, const bool* data) noexcept;
     void FieldVector4f16(const DataTag& tag, const uint16_t* data) noexcept;
+    void FieldVector4f16(const DataTag& tag, const float* data) noexcept;
     void FieldVector4f32(const DataTag& tag, const float* data) noexcept;
     void FieldVector4f64(const DataTag& tag, const double* data) noexcept;
 };
 
-class ArrayWriter {
+template <TagMode Mode>
+class BasicArrayWriter {
    private:
-    friend class ObjectWriter;
+    friend class BasicObjectWriter<Mode>;
 
    protected:
-    ObjectWriter& m_obj;
+    BasicObjectWriter<Mode>& m_obj;
 
    private:
     BufferOffset m_array_size_pos;
+    BufferOffset m_elements_pos;
 
     bool m_is_finished;
+    bool m_indexed;
+
+    std::vector<uint32_t> m_offsets;  // Element offsets of an indexed array, written by Finish
 
    protected:
-    ArrayWriter(ObjectWriter& obj) noexcept;
+    BasicArrayWriter(BasicObjectWriter<Mode>& obj, ArrayLayout layout) noexcept;
+
+    void BeginElement() noexcept;
 
    public:
-    ArrayWriter(const ArrayWriter&) = delete;
-    ArrayWriter& operator=(const ArrayWriter&) = delete;
+    BasicArrayWriter(const BasicArrayWriter&) = delete;
+    BasicArrayWriter& operator=(const BasicArrayWriter&) = delete;
 
-    virtual ~ArrayWriter() { Finish(); }
+    virtual ~BasicArrayWriter() { Finish(); }
 
     void Finish() noexcept;
     inline bool IsFinished() const noexcept { return m_is_finished; }
 };
 
-class StringArrayWriter : public ArrayWriter {
+template <TagMode Mode>
+class BasicStringArrayWriter : public BasicArrayWriter<Mode> {
    private:
-    friend class ObjectWriter;
+    friend class BasicObjectWriter<Mode>;
 
    private:
-    StringArrayWriter(ObjectWriter& obj) noexcept : ArrayWriter(obj) {}
+    BasicStringArrayWriter(BasicObjectWriter<Mode>& obj, ArrayLayout layout) noexcept : BasicArrayWriter<Mode>(obj, layout) {}
 
    public:
     void AddElement(std::string_view element) noexcept;
 };
 
-class BinaryArrayWriter : public ArrayWriter {
+template <TagMode Mode>
+class BasicBinaryArrayWriter : public BasicArrayWriter<Mode> {
    private:
-    friend class ObjectWriter;
+    friend class BasicObjectWriter<Mode>;
 
    private:
-    BinaryArrayWriter(ObjectWriter& obj) noexcept : ArrayWriter(obj) {}
+    BasicBinaryArrayWriter(BasicObjectWriter<Mode>& obj, ArrayLayout layout) noexcept : BasicArrayWriter<Mode>(obj, layout) {}
 
    public:
     void AddElement(const void* element, FieldSize size) noexcept;
 };
 
-class ObjectArrayWriter : public ArrayWriter {
+template <TagMode Mode>
+class BasicObjectArrayWriter : public BasicArrayWriter<Mode> {
    private:
-    friend class ObjectWriter;
+    friend class BasicObjectWriter<Mode>;
 
    protected:
-    ObjectArrayWriter(ObjectWriter& obj) noexcept : ArrayWriter(obj) {}
+    BasicObjectArrayWriter(BasicObjectWriter<Mode>& obj, ArrayLayout layout) noexcept : BasicArrayWriter<Mode>(obj, layout) {}
 
    public:
-    ObjectWriter CreateElement() noexcept;
+    BasicObjectWriter<Mode> CreateElement() noexcept;
 };
 
-class Writer {
+template <TagMode Mode>
+class BasicWriter {
    private:
-    friend class ObjectWriter;
-    friend class ArrayWriter;
+    friend class BasicObjectWriter<Mode>;
+    friend class BasicArrayWriter<Mode>;
 
-    friend class StringArrayWriter;
-    friend class BinaryArrayWriter;
-    friend class ObjectArrayWriter;
+    friend class BasicStringArrayWriter<Mode>;
+    friend class BasicBinaryArrayWriter<Mode>;
+    friend class BasicObjectArrayWriter<Mode>;
 
    private:
     static constexpr uint32_t MIN_BUFFER_GROW_SIZE = 1024;             // 1 KiB
@@ -354,29 +488,62 @@ class Writer {
 
    private:
     uint32_t m_buffer_grow_size;
-    std::vector<uint8_t> m_buffer;
+    WriteBuffer m_buffer;
 
-    bool m_name_based = true;
+    bool m_name_based = true;  // Only read in TagMode::Runtime, the other modes fix it at compile time
 
-    ObjectWriter m_root_object;
+    BasicObjectWriter<Mode> m_root_object;
 
    public:
     // ---------------------------------
     // Constructors & Destructor
     // ---------------------------------
 
-    Writer(bool name_based = true, uint32_t buff_grow_size = DEFAULT_BUFFER_GROW_SIZE) noexcept;
+    BasicWriter(bool name_based = true, uint32_t buff_grow_size = DEFAULT_BUFFER_GROW_SIZE) noexcept
+        requires(Mode == TagMode::Runtime);
+    explicit BasicWriter(uint32_t buff_grow_size = DEFAULT_BUFFER_GROW_SIZE) noexcept
+        requires(Mode != TagMode::Runtime);
+
+    // Writes the document measured by `size` into a single allocation of size.Capacity() bytes,
+    // which it never grows past. A Writer takes the tag mode the document was counted in, NameWriter
+    // and IdWriter must be given a counter of their own mode.
+    explicit BasicWriter(const SizeCounter& size) noexcept;
+
+    // Writes the document into `buffer`, owned by the caller, without allocating if it holds the
+    // Capacity() of a SizeCounter of the document. A document that outgrows it continues in chunks
+    // the writer allocates, Data() then no longer points to `buffer`.
+    explicit BasicWriter(std::span<uint8_t> buffer, bool name_based = true) noexcept
+        requires(Mode == TagMode::Runtime);
+    explicit BasicWriter(std::span<uint8_t> buffer) noexcept
+        requires(Mode != TagMode::Runtime);
 
     // ---------------------------------
     // Methods
     // ---------------------------------
 
-    inline const void* Data() const noexcept { return m_buffer.data(); }
-    inline size_t Size() const noexcept { return m_buffer.size(); }
+    // The document as one contiguous block. A document larger than the first chunk of the buffer is
+    // copied into a single allocation on the first call, see WriteBuffer, which is why Data is not
+    // const and invalidates the spans of an earlier Segments call.
+    inline const void* Data() noexcept { return m_buffer.Data(); }
+    inline size_t Size() const noexcept { return m_buffer.Size(); }
+
+    // The document as the chunks it was written to, in order and without copying, for writev or
+    // streaming. CopyTo writes it to `dest`, which needs room for Size() bytes.
+    inline std::vector<std::span<const uint8_t>> Segments() const noexcept { return m_buffer.Segments(); }
+    inline void CopyTo(void* dest) const noexcept { m_buffer.CopyTo(dest); }
+
+    inline bool IsNameBased() const noexcept {
+        if constexpr (Mode == TagMode::Runtime) {
+            return m_name_based;
+        } else {
+            return Mode == TagMode::Name;
+        }
+    }
 
-    inline ObjectWriter& RootObject() noexcept { return m_root_object; }
+    inline BasicObjectWriter<Mode>& RootObject() noexcept { return m_root_object; }
     inline void Finish() noexcept { m_root_object.Finish(); }
 
+    // Size of the first chunk of the buffer and the least each further chunk adds
     void SetBufferGrowSize(uint32_t grow_size) noexcept;
 
     // ---------------------------------
@@ -400,14 +567,81 @@ class Writer {
 
     void WriteString(const std::string_view& str) noexcept;
     void WriteBinary(const void* data, FieldSize size) noexcept;
+
+    // Fields are written with one capacity check for their largest possible size, after which the
+    // header and the value are stored through a raw pointer and committed together
+    size_t FieldHeaderSize(const DataTag& tag) const noexcept;
+    uint8_t* StoreFieldHeader(uint8_t* dest, const DataTag& tag, DataType type) const noexcept;
+
+    template <typename Type>
+    void WriteField(const DataTag& tag, DataType type, Type value) noexcept;
 };
 
+template <TagMode Mode>
 template <typename Enum>
     requires std::is_enum<Enum>::value
-void ObjectWriter::FieldEnum(const DataTag& tag, Enum value) {
+void BasicObjectWriter<Mode>::FieldEnum(const DataTag& tag, Enum value) {
+    // Forwarded to the field method of the underlying type, the writing templates are only
+    // instantiated in Writer.cpp
     using UnderlyingType = typename std::underlying_type<Enum>::type;
-    m_writer.WriteFieldHeader(tag, IntegerType<UnderlyingType>());
-    m_writer.WriteData<UnderlyingType, true>(static_cast<UnderlyingType>(value));
+    constexpr DataType type = IntegerType<UnderlyingType>();
+    const UnderlyingType raw = static_cast<UnderlyingType>(value);
+
+    if constexpr (type == DataType::Int8) {
+        FieldInt8(tag, raw);
+    } else if constexpr (type == DataType::Int16) {
+        FieldInt16(tag, raw);
+    } else if constexpr (type == DataType::Int32) {
+        FieldInt32(tag, raw);
+    } else if constexpr (type == DataType::Int64) {
+        FieldInt64(tag, raw);
+    } else if constexpr (type == DataType::UInt8) {
+        FieldUInt8(tag, raw);
+    } else if constexpr (type == DataType::UInt16) {
+        FieldUInt16(tag, raw);
+    } else if constexpr (type == DataType::UInt32) {
+        FieldUInt32(tag, raw);
+    } else {
+        FieldUInt64(tag, raw);
+    }
 }
 
+// ---------------------------------
+// Tag modes
+// ---------------------------------
+
+// Writer and its object and array writers choose between tag names and IDs at run time, NameWriter
+// and IdWriter fix the choice at compile time so no field write tests for it
+using Writer = BasicWriter<TagMode::Runtime>;
+using ObjectWriter = BasicObjectWriter<TagMode::Runtime>;
+using ArrayWriter = BasicArrayWriter<TagMode::Runtime>;
+using StringArrayWriter = BasicStringArrayWriter<TagMode::Runtime>;
+using BinaryArrayWriter = BasicBinaryArrayWriter<TagMode::Runtime>;
+using ObjectArrayWriter = BasicObjectArrayWriter<TagMode::Runtime>;
+
+using NameWriter = BasicWriter<TagMode::Name>;
+using IdWriter = BasicWriter<TagMode::Id>;
+
+// Instantiated for every mode in Writer.cpp
+extern template class BasicWriter<TagMode::Runtime>;
+extern template class BasicObjectWriter<TagMode::Runtime>;
+extern template class BasicArrayWriter<TagMode::Runtime>;
+extern template class BasicStringArrayWriter<TagMode::Runtime>;
+extern template class BasicBinaryArrayWriter<TagMode::Runtime>;
+extern template class BasicObjectArrayWriter<TagMode::Runtime>;
+
+extern template class BasicWriter<TagMode::Name>;
+extern template class BasicObjectWriter<TagMode::Name>;
+extern template class BasicArrayWriter<TagMode::Name>;
+extern template class BasicStringArrayWriter<TagMode::Name>;
+extern template class BasicBinaryArrayWriter<TagMode::Name>;
+extern template class BasicObjectArrayWriter<TagMode::Name>;
+
+extern template class BasicWriter<TagMode::Id>;
+extern template class BasicObjectWriter<TagMode::Id>;
+extern template class BasicArrayWriter<TagMode::Id>;
+extern template class BasicStringArrayWriter<TagMode::Id>;
+extern template class BasicBinaryArrayWriter<TagMode::Id>;
+extern template class BasicObjectArrayWriter<TagMode::Id>;
+
 }  // namespace tbf
\ No newline at end of file
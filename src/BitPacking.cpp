@@ -0,0 +1,324 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#include "tbf/BitPacking.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define TBF_BITS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace tbf {
+
+// ---------------------------------
+// Word helpers
+// ---------------------------------
+
+// Loads up to 8 bytes of packed bits as a word holding element i of the block in bit i
+static inline uint64_t LoadBits(const uint8_t* bytes, size_t size) noexcept {
+    uint64_t word = 0;
+    std::memcpy(&word, bytes, size);
+    if constexpr (std::endian::native == std::endian::big) {
+        word = std::byteswap(word);
+    }
+    return word;
+}
+
+static inline void StoreBits(uint8_t* bytes, uint64_t word, size_t size) noexcept {
+    if constexpr (std::endian::native == std::endian::big) {
+        word = std::byteswap(word);
+    }
+    std::memcpy(bytes, &word, size);
+}
+
+// Calls func(byte_offset, byte_count, valid_mask) for each block of up to 64 elements, where
+// valid_mask selects the bits of the block that hold elements
+template <typename Func>
+static inline void ForEachBitBlock(size_t count, size_t first_byte, Func&& func) noexcept {
+    const size_t bytes = PackedBitsSize(count);
+    for (size_t offset = first_byte; offset < bytes; offset += 8) {
+        const size_t remaining = count - offset * 8;
+        const uint64_t mask = remaining >= 64 ? ~uint64_t(0) : (uint64_t(1) << remaining) - 1;
+        if (!func(offset, std::min<size_t>(8, bytes - offset), mask)) {
+            return;
+        }
+    }
+}
+
+template <BitOperation operation>
+static inline uint64_t ApplyBits(uint64_t a, uint64_t b) noexcept {
+    if constexpr (operation == BitOperation::And) {
+        return a & b;
+    } else if constexpr (operation == BitOperation::Or) {
+        return a | b;
+    } else if constexpr (operation == BitOperation::Xor) {
+        return a ^ b;
+    } else {
+        return a & ~b;
+    }
+}
+
+// Eight bools for every byte of packed bits
+static constexpr std::array<std::array<uint8_t, 8>, 256> UNPACK_TABLE = [] {
+    std::array<std::array<uint8_t, 8>, 256> table{};
+    for (uint32_t byte = 0; byte < 256; ++byte) {
+        for (uint32_t bit = 0; bit < 8; ++bit) {
+            table[byte][bit] = (byte >> bit) & 1;
+        }
+    }
+    return table;
+}();
+
+// ---------------------------------
+// Pack & Unpack
+// ---------------------------------
+
+void PackBooleans(const bool* src, uint8_t* dest, size_t count) noexcept {
+    const uint8_t* in = reinterpret_cast<const uint8_t*>(src);
+    size_t i = 0;
+
+    // Compare against zero and gather the byte sign bits, 32 or 16 elements at a time
+#if defined(__AVX2__)
+    for (; i + 32 <= count; i += 32) {
+        __m256i zero = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), _mm256_setzero_si256());
+        uint32_t bits = ~static_cast<uint32_t>(_mm256_movemask_epi8(zero));
+        std::memcpy(dest + i / 8, &bits, sizeof(bits));
+    }
+#endif
+#if defined(__SSE2__)
+    for (; i + 16 <= count; i += 16) {
+        __m128i zero = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), _mm_setzero_si128());
+        uint16_t bits = static_cast<uint16_t>(~_mm_movemask_epi8(zero));
+        std::memcpy(dest + i / 8, &bits, sizeof(bits));
+    }
+#elif defined(TBF_BITS_NEON)
+    const uint8x16_t weights = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    for (; i + 16 <= count; i += 16) {
+        uint8x16_t values = vld1q_u8(in + i);
+        uint8x16_t weighted = vandq_u8(vtstq_u8(values, values), weights);
+        dest[i / 8] = vaddv_u8(vget_low_u8(weighted));
+        dest[i / 8 + 1] = vaddv_u8(vget_high_u8(weighted));
+    }
+#endif
+
+    for (; i < count; i += 8) {
+        const size_t length = std::min<size_t>(8, count - i);
+        uint8_t byte = 0;
+        for (size_t bit = 0; bit < length; ++bit) {
+            byte |= static_cast<uint8_t>((in[i + bit] != 0) << bit);
+        }
+        dest[i / 8] = byte;
+    }
+}
+
+void UnpackBooleans(const uint8_t* src, bool* dest, size_t count) noexcept {
+    uint8_t* out = reinterpret_cast<uint8_t*>(dest);
+    size_t i = 0;
+
+    // Spread each byte of bits over 8 lanes, then test one bit per lane
+#if defined(__AVX2__)
+    const __m256i spread_256 = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,  //
+                                                2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+    const __m256i select_256 = _mm256_set1_epi64x(static_cast<int64_t>(0x8040201008040201));
+    for (; i + 32 <= count; i += 32) {
+        uint32_t bits;
+        std::memcpy(&bits, src + i / 8, sizeof(bits));
+        __m256i spread = _mm256_shuffle_epi8(_mm256_set1_epi32(static_cast<int32_t>(bits)), spread_256);
+        __m256i set = _mm256_cmpeq_epi8(_mm256_and_si256(spread, select_256), select_256);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_and_si256(set, _mm256_set1_epi8(1)));
+    }
+#endif
+#if defined(__SSSE3__)
+    const __m128i spread_128 = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1);
+    const __m128i select_128 = _mm_set1_epi64x(static_cast<int64_t>(0x8040201008040201));
+    for (; i + 16 <= count; i += 16) {
+        uint16_t bits;
+        std::memcpy(&bits, src + i / 8, sizeof(bits));
+        __m128i spread = _mm_shuffle_epi8(_mm_set1_epi16(static_cast<int16_t>(bits)), spread_128);
+        __m128i set = _mm_cmpeq_epi8(_mm_and_si128(spread, select_128), select_128);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_and_si128(set, _mm_set1_epi8(1)));
+    }
+#elif defined(TBF_BITS_NEON)
+    const uint8x16_t select = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    for (; i + 16 <= count; i += 16) {
+        uint8x16_t spread = vcombine_u8(vdup_n_u8(src[i / 8]), vdup_n_u8(src[i / 8 + 1]));
+        vst1q_u8(out + i, vandq_u8(vtstq_u8(spread, select), vdupq_n_u8(1)));
+    }
+#endif
+
+    for (; i + 8 <= count; i += 8) {
+        std::memcpy(out + i, UNPACK_TABLE[src[i / 8]].data(), 8);
+    }
+    if (i < count) {
+        std::memcpy(out + i, UNPACK_TABLE[src[i / 8]].data(), count - i);
+    }
+}
+
+// ---------------------------------
+// Queries
+// ---------------------------------
+
+size_t CountSetBits(const uint8_t* bits, size_t count) noexcept {
+    size_t set = 0;
+    ForEachBitBlock(count, 0, [&](size_t offset, size_t size, uint64_t mask) {
+        set += std::popcount(LoadBits(bits + offset, size) & mask);
+        return true;
+    });
+    return set;
+}
+
+size_t FindFirstBit(const uint8_t* bits, size_t count, bool value, size_t from) noexcept {
+    if (from >= count) {
+        return count;
+    }
+
+    const size_t first_byte = from / 64 * 8;
+    uint64_t skip = ~uint64_t(0) << (from % 64);
+    size_t found = count;
+
+    ForEachBitBlock(count, first_byte, [&](size_t offset, size_t size, uint64_t mask) {
+        uint64_t word = LoadBits(bits + offset, size);
+        word = (value ? word : ~word) & mask & skip;
+        skip = ~uint64_t(0);
+
+        if (word != 0) {
+            found = offset * 8 + static_cast<size_t>(std::countr_zero(word));
+            return false;
+        }
+        return true;
+    });
+    return found;
+}
+
+// ---------------------------------
+// Bitwise operations
+// ---------------------------------
+
+template <BitOperation operation>
+static void CombineBitsImpl(const uint8_t* a, const uint8_t* b, uint8_t* dest, size_t count) noexcept {
+    ForEachBitBlock(count, 0, [&](size_t offset, size_t size, uint64_t mask) {
+        uint64_t word = ApplyBits<operation>(LoadBits(a + offset, size), LoadBits(b + offset, size)) & mask;
+        StoreBits(dest + offset, word, size);
+        return true;
+    });
+}
+
+template <BitOperation operation>
+static size_t CountCombinedBitsImpl(const uint8_t* a, const uint8_t* b, size_t count) noexcept {
+    size_t set = 0;
+    ForEachBitBlock(count, 0, [&](size_t offset, size_t size, uint64_t mask) {
+        set += std::popcount(ApplyBits<operation>(LoadBits(a + offset, size), LoadBits(b + offset, size)) & mask);
+        return true;
+    });
+    return set;
+}
+
+void CombineBits(const uint8_t* a, const uint8_t* b, uint8_t* dest, size_t count, BitOperation operation) noexcept {
+    switch (operation) {
+        case BitOperation::And:
+            CombineBitsImpl<BitOperation::And>(a, b, dest, count);
+            break;
+        case BitOperation::Or:
+            CombineBitsImpl<BitOperation::Or>(a, b, dest, count);
+            break;
+        case BitOperation::Xor:
+            CombineBitsImpl<BitOperation::Xor>(a, b, dest, count);
+            break;
+        case BitOperation::AndNot:
+            CombineBitsImpl<BitOperation::AndNot>(a, b, dest, count);
+            break;
+    }
+}
+
+size_t CountCombinedBits(const uint8_t* a, const uint8_t* b, size_t count, BitOperation operation) noexcept {
+    switch (operation) {
+        case BitOperation::And:
+            return CountCombinedBitsImpl<BitOperation::And>(a, b, count);
+        case BitOperation::Or:
+            return CountCombinedBitsImpl<BitOperation::Or>(a, b, count);
+        case BitOperation::Xor:
+            return CountCombinedBitsImpl<BitOperation::Xor>(a, b, count);
+        case BitOperation::AndNot:
+            return CountCombinedBitsImpl<BitOperation::AndNot>(a, b, count);
+    }
+    return 0;
+}
+
+// ---------------------------------
+// Codes
+// ---------------------------------
+
+void PackCodes(const uint32_t* src, uint8_t* dest, size_t count, uint32_t width) noexcept {
+    if (width == 0) {
+        return;
+    }
+
+    // Codes gather in a word that is flushed 32 bits at a time, so it never holds more than 63
+    uint64_t word = 0;
+    uint32_t bits = 0;
+    for (size_t i = 0; i < count; ++i) {
+        word |= static_cast<uint64_t>(src[i]) << bits;
+        bits += width;
+        if (bits >= 32) {
+            StoreBits(dest, word, 4);
+            dest += 4;
+            word >>= 32;
+            bits -= 32;
+        }
+    }
+    StoreBits(dest, word, (bits + 7) / 8);
+}
+
+void UnpackCodes(const uint8_t* src, uint32_t* dest, size_t count, uint32_t width) noexcept {
+    if (width == 0) {
+        std::fill_n(dest, count, 0u);
+        return;
+    }
+
+    // A code and its bit offset within its first byte span at most 39 bits, so one 8 byte load
+    // holds it while 8 bytes remain. The last codes are loaded with the bytes that are left.
+    const size_t bytes = PackedCodesSize(count, width);
+    const uint64_t mask = (uint64_t(1) << width) - 1;
+    size_t i = 0;
+    for (; i < count && (i * width) / 8 + 8 <= bytes; ++i) {
+        const size_t bit = i * width;
+        dest[i] = static_cast<uint32_t>((LoadBits(src + bit / 8, 8) >> (bit % 8)) & mask);
+    }
+    for (; i < count; ++i) {
+        const size_t bit = i * width;
+        dest[i] = static_cast<uint32_t>((LoadBits(src + bit / 8, bytes - bit / 8) >> (bit % 8)) & mask);
+    }
+}
+
+}  // namespace tbf
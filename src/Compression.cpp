@@ -0,0 +1,299 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#include "tbf/Compression.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace tbf {
+
+// ---------------------------------
+// Helpers
+// ---------------------------------
+
+// Match lengths are never counted into the last LAST_LITERALS bytes, and no match starts in the last
+// MATCH_SEARCH_LIMIT bytes, so inputs shorter than MIN_INPUT_SIZE are stored as literals
+constexpr size_t LAST_LITERALS = 5;
+constexpr size_t MATCH_SEARCH_LIMIT = 12;
+constexpr size_t MIN_INPUT_SIZE = MATCH_SEARCH_LIMIT + 1;
+
+// 4096 positions of 4 byte sequences, 16 KiB that stay in L1
+constexpr uint32_t HASH_BITS = 12;
+
+// Every 64 positions without a match the search moves one more byte at a time, so incompressible
+// data is skipped over quickly
+constexpr uint32_t SKIP_SHIFT = 6;
+
+constexpr uint32_t TOKEN_LENGTH_MASK = 15;
+
+[[gnu::always_inline]]
+static inline uint32_t Load32(const uint8_t* ptr) noexcept {
+    uint32_t value;
+    std::memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+[[gnu::always_inline]]
+static inline uint64_t Load64(const uint8_t* ptr) noexcept {
+    uint64_t value;
+    std::memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+[[gnu::always_inline]]
+static inline uint32_t HashSequence(uint32_t sequence) noexcept {
+    return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// Number of equal bytes at `a` and `b`, counting no further than `limit` from `a`. `b` comes before
+// `a`, so it never passes the limit either.
+[[gnu::always_inline]]
+static inline size_t CommonLength(const uint8_t* a, const uint8_t* b, const uint8_t* limit) noexcept {
+    const uint8_t* start = a;
+    while (a + sizeof(uint64_t) <= limit) {
+        const uint64_t diff = Load64(a) ^ Load64(b);
+        if (diff != 0) {
+            if constexpr (std::endian::native == std::endian::little) {
+                return static_cast<size_t>(a - start) + std::countr_zero(diff) / 8;
+            } else {
+                return static_cast<size_t>(a - start) + std::countl_zero(diff) / 8;
+            }
+        }
+        a += sizeof(uint64_t);
+        b += sizeof(uint64_t);
+    }
+    while (a < limit && *a == *b) {
+        ++a;
+        ++b;
+    }
+    return static_cast<size_t>(a - start);
+}
+
+// Bytes following a token nibble of 15, `length` being what remains after the nibble
+[[gnu::always_inline]]
+static inline uint8_t* WriteLength(uint8_t* out, size_t length) noexcept {
+    while (length >= 255) {
+        *out++ = 255;
+        length -= 255;
+    }
+    *out++ = static_cast<uint8_t>(length);
+    return out;
+}
+
+[[gnu::always_inline]]
+static inline bool ReadLength(const uint8_t*& read_ptr, const uint8_t* end, size_t& length) noexcept {
+    uint8_t byte;
+    do {
+        if (read_ptr == end) [[unlikely]] {
+            return false;
+        }
+        byte = *read_ptr++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+static inline uint8_t* WriteLiterals(uint8_t* out, uint8_t token, const uint8_t* literals, size_t length) noexcept {
+    if (length >= TOKEN_LENGTH_MASK) {
+        *out++ = token | (TOKEN_LENGTH_MASK << 4);
+        out = WriteLength(out, length - TOKEN_LENGTH_MASK);
+    } else {
+        *out++ = token | static_cast<uint8_t>(length << 4);
+    }
+    std::memcpy(out, literals, length);
+    return out + length;
+}
+
+// ---------------------------------
+// Compression
+// ---------------------------------
+
+size_t CompressBlock(const uint8_t* src, size_t size, uint8_t* dest) noexcept {
+    // An empty block is one token without literals, `src` may be null
+    if (size == 0) {
+        *dest = 0;
+        return 1;
+    }
+
+    const uint8_t* const end = src + size;
+    const uint8_t* anchor = src;  // First byte not yet written
+    uint8_t* out = dest;
+
+    if (size >= MIN_INPUT_SIZE) {
+        const uint8_t* const match_limit = end - LAST_LITERALS;
+        const uint8_t* const search_limit = end - MATCH_SEARCH_LIMIT;
+
+        // Position of the last sequence seen with each hash. Unset entries point at the first byte,
+        // which is checked like any other candidate.
+        uint32_t table[1 << HASH_BITS] = {};
+
+        const uint8_t* read_ptr = src + 1;
+        while (true) {
+            const uint8_t* match = nullptr;
+            uint32_t attempts = 1 << SKIP_SHIFT;
+            while (read_ptr <= search_limit) {
+                const uint32_t sequence = Load32(read_ptr);
+                const uint32_t hash = HashSequence(sequence);
+                match = src + table[hash];
+                table[hash] = static_cast<uint32_t>(read_ptr - src);
+
+                if (match < read_ptr && read_ptr - match <= MAX_MATCH_OFFSET && Load32(match) == sequence) {
+                    break;
+                }
+                match = nullptr;
+                read_ptr += attempts++ >> SKIP_SHIFT;
+            }
+            if (match == nullptr) {
+                break;
+            }
+
+            // The match may also cover some of the literals before it
+            while (read_ptr > anchor && match > src && read_ptr[-1] == match[-1]) {
+                --read_ptr;
+                --match;
+            }
+
+            const size_t length = MIN_MATCH_LENGTH + CommonLength(read_ptr + MIN_MATCH_LENGTH, match + MIN_MATCH_LENGTH, match_limit);
+            const size_t offset = static_cast<size_t>(read_ptr - match);
+
+            uint8_t* token = out;
+            out = WriteLiterals(out, 0, anchor, static_cast<size_t>(read_ptr - anchor));
+            *out++ = static_cast<uint8_t>(offset);
+            *out++ = static_cast<uint8_t>(offset >> 8);
+
+            const size_t extra_length = length - MIN_MATCH_LENGTH;
+            if (extra_length >= TOKEN_LENGTH_MASK) {
+                *token |= TOKEN_LENGTH_MASK;
+                out = WriteLength(out, extra_length - TOKEN_LENGTH_MASK);
+            } else {
+                *token |= static_cast<uint8_t>(extra_length);
+            }
+
+            read_ptr += length;
+            anchor = read_ptr;
+            if (read_ptr > search_limit) {
+                break;
+            }
+
+            // A position inside the match, for data repeating right after it
+            table[HashSequence(Load32(read_ptr - 2))] = static_cast<uint32_t>(read_ptr - 2 - src);
+        }
+    }
+
+    out = WriteLiterals(out, 0, anchor, static_cast<size_t>(end - anchor));
+    return static_cast<size_t>(out - dest);
+}
+
+// ---------------------------------
+// Decompression
+// ---------------------------------
+
+bool DecompressBlock(const uint8_t* src, size_t size, uint8_t* dest, size_t raw_size) noexcept {
+    // Only the single empty token decompresses to nothing, `dest` may be null
+    if (raw_size == 0) {
+        return size == 1 && src[0] == 0;
+    }
+
+    const uint8_t* read_ptr = src;
+    const uint8_t* const end = src + size;
+    uint8_t* out = dest;
+    uint8_t* const out_end = dest + raw_size;
+
+    while (true) {
+        if (read_ptr == end) [[unlikely]] {
+            return false;
+        }
+        const uint8_t token = *read_ptr++;
+
+        // Literals, copied 16 bytes at a time while both buffers have room for it
+        size_t literal_length = token >> 4;
+        if (literal_length == TOKEN_LENGTH_MASK && !ReadLength(read_ptr, end, literal_length)) [[unlikely]] {
+            return false;
+        }
+        const size_t src_left = static_cast<size_t>(end - read_ptr);
+        const size_t dest_left = static_cast<size_t>(out_end - out);
+        if (literal_length > src_left || literal_length > dest_left) [[unlikely]] {
+            return false;
+        }
+        if (literal_length <= 16 && src_left >= 16 && dest_left >= 16) {
+            std::memcpy(out, read_ptr, 16);
+        } else {
+            std::memcpy(out, read_ptr, literal_length);
+        }
+        read_ptr += literal_length;
+        out += literal_length;
+
+        if (read_ptr == end) {
+            return out == out_end;
+        }
+
+        // Match
+        if (end - read_ptr < 2) [[unlikely]] {
+            return false;
+        }
+        const size_t offset = read_ptr[0] | (static_cast<size_t>(read_ptr[1]) << 8);
+        read_ptr += 2;
+
+        size_t match_length = token & TOKEN_LENGTH_MASK;
+        if (match_length == TOKEN_LENGTH_MASK && !ReadLength(read_ptr, end, match_length)) [[unlikely]] {
+            return false;
+        }
+        match_length += MIN_MATCH_LENGTH;
+
+        const size_t out_left = static_cast<size_t>(out_end - out);
+        if (offset == 0 || offset > static_cast<size_t>(out - dest) || match_length > out_left) [[unlikely]] {
+            return false;
+        }
+
+        // Chunked copies may write past the match, into output that later sequences overwrite
+        const uint8_t* match = out - offset;
+        if (offset >= 16 && out_left >= match_length + 15) {
+            for (size_t i = 0; i < match_length; i += 16) {
+                std::memcpy(out + i, match + i, 16);
+            }
+        } else if (out_left >= match_length + 7) {
+            // A short offset repeats a pattern of `offset` bytes. Once 8 bytes are written byte by
+            // byte, chunks of 8 are copied from a whole number of patterns back.
+            size_t i = 0;
+            for (; i < 8; ++i) {
+                out[i] = match[i];
+            }
+            const size_t step = offset >= 8 ? offset : offset * ((8 + offset - 1) / offset);
+            for (; i < match_length; i += 8) {
+                std::memcpy(out + i, out + i - step, 8);
+            }
+        } else {
+            for (size_t i = 0; i < match_length; ++i) {
+                out[i] = match[i];
+            }
+        }
+        out += match_length;
+    }
+}
+
+}  // namespace tbf
@@ -0,0 +1,72 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#include "tbf/FieldIndex.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <memory_resource>
+
+namespace tbf {
+
+void FieldIndex::Reset(uint32_t expected_count) noexcept {
+    Clear();
+
+    if (expected_count > INLINE_CAPACITY) {
+        MoveToHeap(expected_count);
+    }
+}
+
+void FieldIndex::Clear() noexcept {
+    m_slots.clear();
+    m_table.clear();
+    m_count = 0;
+    m_shift = 64;
+}
+
+void FieldIndex::MoveToHeap(uint32_t expected_count) noexcept {
+    m_slots.reserve(expected_count);
+    m_slots.assign(m_inline_slots.begin(), m_inline_slots.begin() + m_count);
+
+    RebuildTable(std::max(MIN_CAPACITY, std::bit_ceil(expected_count * 2)));
+}
+
+void FieldIndex::RebuildTable(uint32_t capacity) noexcept {
+    m_table.assign(capacity, 0);
+    m_shift = 64 - std::countr_zero(capacity);
+
+    // Keys are already unique, so the first free slot in the probe sequence is the right one
+    const uint32_t mask = capacity - 1;
+    for (uint32_t position = 0; position < m_count; ++position) {
+        uint32_t i = TableIndex(m_slots[position].key);
+        while (m_table[i] != 0) {
+            i = (i + 1) & mask;
+        }
+        m_table[i] = position + 1;
+    }
+}
+
+}  // namespace tbf
@@ -0,0 +1,174 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#include "tbf/Float16.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define TBF_FLOAT16_X86
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define TBF_FLOAT16_NEON
+#include <arm_neon.h>
+#endif
+
+namespace tbf {
+
+// ---------------------------------
+// Scalar kernels
+// ---------------------------------
+
+static void HalfToFloatScalar(const uint16_t* src, float* dest, size_t count) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        dest[i] = HalfToFloat(src[i]);
+    }
+}
+
+static void FloatToHalfScalar(const float* src, uint16_t* dest, size_t count) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        dest[i] = FloatToHalf(src[i]);
+    }
+}
+
+// ---------------------------------
+// x86 kernels
+// ---------------------------------
+
+#ifdef TBF_FLOAT16_X86
+
+// Compiled for their instruction sets regardless of the build flags, and only called after the
+// processor reported support for them
+
+[[gnu::target("avx,f16c")]]
+static void HalfToFloatF16C(const uint16_t* src, float* dest, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i halves = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm256_storeu_ps(dest + i, _mm256_cvtph_ps(halves));
+    }
+    HalfToFloatScalar(src + i, dest + i, count - i);
+}
+
+[[gnu::target("avx,f16c")]]
+static void FloatToHalfF16C(const float* src, uint16_t* dest, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i halves = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), halves);
+    }
+    FloatToHalfScalar(src + i, dest + i, count - i);
+}
+
+[[gnu::target("avx512f")]]
+static void HalfToFloatAVX512(const uint16_t* src, float* dest, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i halves = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        // The zero-masked forms, the unmasked ones trip a GCC false positive on their undefined
+        // source operand
+        _mm512_storeu_ps(dest + i, _mm512_maskz_cvtph_ps(0xFFFF, halves));
+    }
+    HalfToFloatScalar(src + i, dest + i, count - i);
+}
+
+[[gnu::target("avx512f")]]
+static void FloatToHalfAVX512(const float* src, uint16_t* dest, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i halves = _mm512_maskz_cvtps_ph(0xFFFF, _mm512_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), halves);
+    }
+    FloatToHalfScalar(src + i, dest + i, count - i);
+}
+
+#endif
+
+// ---------------------------------
+// NEON kernels
+// ---------------------------------
+
+#ifdef TBF_FLOAT16_NEON
+
+static void HalfToFloatNEON(const uint16_t* src, float* dest, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(dest + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+    }
+    HalfToFloatScalar(src + i, dest + i, count - i);
+}
+
+static void FloatToHalfNEON(const float* src, uint16_t* dest, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        vst1_u16(dest + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+    }
+    FloatToHalfScalar(src + i, dest + i, count - i);
+}
+
+#endif
+
+// ---------------------------------
+// Dispatch
+// ---------------------------------
+
+using HalfToFloatKernel = void (*)(const uint16_t*, float*, size_t) noexcept;
+using FloatToHalfKernel = void (*)(const float*, uint16_t*, size_t) noexcept;
+
+struct Float16Kernels {
+    HalfToFloatKernel to_float;
+    FloatToHalfKernel to_half;
+};
+
+static Float16Kernels SelectKernels() noexcept {
+#if defined(TBF_FLOAT16_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return {HalfToFloatAVX512, FloatToHalfAVX512};
+    }
+    if (__builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c")) {
+        return {HalfToFloatF16C, FloatToHalfF16C};
+    }
+#elif defined(TBF_FLOAT16_NEON)
+    return {HalfToFloatNEON, FloatToHalfNEON};
+#endif
+    return {HalfToFloatScalar, FloatToHalfScalar};
+}
+
+static const Float16Kernels& Kernels() noexcept {
+    static const Float16Kernels kernels = SelectKernels();
+    return kernels;
+}
+
+void HalfToFloatArray(const uint16_t* src, float* dest, size_t count) noexcept {
+    Kernels().to_float(src, dest, count);
+}
+
+void FloatToHalfArray(const float* src, uint16_t* dest, size_t count) noexcept {
+    Kernels().to_half(src, dest, count);
+}
+
+}  // namespace tbf
@@ -0,0 +1,479 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#include "tbf/IntegerPacking.hpp"
+
+#include "tbf/Endianness.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace tbf {
+
+// ---------------------------------
+// Block layout
+// ---------------------------------
+
+constexpr uint32_t LANES = 4;
+
+template <typename Word>
+constexpr uint32_t WORD_BITS = sizeof(Word) * 8;
+
+// Words every lane takes for `count` slots of `width` bits
+template <typename Word>
+static inline uint32_t LaneWords(uint32_t count, uint32_t width) noexcept {
+    const uint32_t lane_slots = (count + LANES - 1) / LANES;
+    return (lane_slots * width + WORD_BITS<Word> - 1) / WORD_BITS<Word>;
+}
+
+template <typename Word>
+static inline size_t BlockSize(BlockEncoding encoding, uint32_t count, uint32_t width) noexcept {
+    const size_t references = static_cast<size_t>(encoding) + 1;
+    return 2 + (references + LANES * LaneWords<Word>(count, width)) * sizeof(Word);
+}
+
+struct BlockHeader {
+    BlockEncoding encoding;
+    uint32_t width;
+    size_t size;  // Whole block, 0 if malformed
+};
+
+template <typename Word>
+static inline BlockHeader ReadBlockHeader(const uint8_t* src, size_t size, uint32_t count) noexcept {
+    BlockHeader header{BlockEncoding::FrameOfReference, 0, 0};
+    if (size < 2 || src[0] > static_cast<uint8_t>(BlockEncoding::DeltaOfDelta) || src[1] > WORD_BITS<Word>) [[unlikely]] {
+        return header;
+    }
+
+    header.encoding = static_cast<BlockEncoding>(src[0]);
+    header.width = src[1];
+    const size_t block_size = BlockSize<Word>(header.encoding, count, header.width);
+    if (block_size <= size) [[likely]] {
+        header.size = block_size;
+    }
+    return header;
+}
+
+// ---------------------------------
+// Packing
+// ---------------------------------
+
+template <typename Word>
+static inline uint32_t RangeWidth(Word min, Word max) noexcept {
+    return static_cast<uint32_t>(std::bit_width(static_cast<Word>(max - min)));
+}
+
+template <typename Type>
+static size_t PackBlock(const Type* values, uint32_t count, uint8_t* out) noexcept {
+    using Word = std::make_unsigned_t<Type>;
+    using Signed = std::make_signed_t<Type>;
+
+    // Ranges of the values in their own signedness, and of the deltas and deltas of deltas as
+    // signed differences, which keeps small decreasing steps small
+    Type min = values[0];
+    Type max = values[0];
+    Signed min_delta = 0, max_delta = 0;
+    Signed min_delta2 = 0, max_delta2 = 0;
+    const Word first_delta = count > 1 ? static_cast<Word>(values[1]) - static_cast<Word>(values[0]) : 0;
+
+    for (uint32_t i = 1; i < count; ++i) {
+        min = std::min(min, values[i]);
+        max = std::max(max, values[i]);
+
+        const Signed delta = static_cast<Signed>(static_cast<Word>(values[i]) - static_cast<Word>(values[i - 1]));
+        min_delta = i == 1 ? delta : std::min(min_delta, delta);
+        max_delta = i == 1 ? delta : std::max(max_delta, delta);
+
+        if (i >= 2) {
+            const Word previous = static_cast<Word>(values[i - 1]) - static_cast<Word>(values[i - 2]);
+            const Signed delta2 = static_cast<Signed>(static_cast<Word>(delta) - previous);
+            min_delta2 = i == 2 ? delta2 : std::min(min_delta2, delta2);
+            max_delta2 = i == 2 ? delta2 : std::max(max_delta2, delta2);
+        }
+    }
+
+    const uint32_t widths[3] = {
+        RangeWidth<Word>(static_cast<Word>(min), static_cast<Word>(max)),
+        RangeWidth<Word>(static_cast<Word>(min_delta), static_cast<Word>(max_delta)),
+        RangeWidth<Word>(static_cast<Word>(min_delta2), static_cast<Word>(max_delta2)),
+    };
+
+    // The smallest block wins, ties go to the cheaper decoding
+    BlockEncoding encoding = BlockEncoding::FrameOfReference;
+    size_t size = BlockSize<Word>(encoding, count, widths[0]);
+    for (BlockEncoding candidate : {BlockEncoding::Delta, BlockEncoding::DeltaOfDelta}) {
+        const size_t candidate_size = BlockSize<Word>(candidate, count, widths[static_cast<uint32_t>(candidate)]);
+        if (candidate_size < size) {
+            encoding = candidate;
+            size = candidate_size;
+        }
+    }
+    const uint32_t width = widths[static_cast<uint32_t>(encoding)];
+
+    Word references[3];
+    Word slots[PACKED_BLOCK_LENGTH] = {};
+    switch (encoding) {
+        case BlockEncoding::FrameOfReference:
+            references[0] = static_cast<Word>(min);
+            for (uint32_t i = 0; i < count; ++i) {
+                slots[i] = static_cast<Word>(values[i]) - references[0];
+            }
+            break;
+        case BlockEncoding::Delta:
+            references[0] = static_cast<Word>(values[0]);
+            references[1] = static_cast<Word>(min_delta);
+            for (uint32_t i = 1; i < count; ++i) {
+                slots[i] = static_cast<Word>(values[i]) - static_cast<Word>(values[i - 1]) - references[1];
+            }
+            break;
+        case BlockEncoding::DeltaOfDelta:
+            references[0] = static_cast<Word>(values[0]);
+            references[1] = first_delta;
+            references[2] = static_cast<Word>(min_delta2);
+            for (uint32_t i = 2; i < count; ++i) {
+                const Word delta = static_cast<Word>(values[i]) - static_cast<Word>(values[i - 1]);
+                const Word previous = static_cast<Word>(values[i - 1]) - static_cast<Word>(values[i - 2]);
+                slots[i] = delta - previous - references[2];
+            }
+            break;
+    }
+
+    const uint32_t reference_count = static_cast<uint32_t>(encoding) + 1;
+    out[0] = static_cast<uint8_t>(encoding);
+    out[1] = static_cast<uint8_t>(width);
+    CopyArrayEndianess<sizeof(Word)>(out + 2, references, reference_count);
+
+    const uint32_t lane_words = LaneWords<Word>(count, width);
+    Word words[LANES * WORD_BITS<Word>] = {};
+    if (width > 0) {
+        for (uint32_t i = 0; i < count; ++i) {
+            const uint32_t lane = i % LANES;
+            const uint32_t bit = (i / LANES) * width;
+            const uint32_t word = bit / WORD_BITS<Word>;
+            const uint32_t shift = bit % WORD_BITS<Word>;
+
+            words[word * LANES + lane] |= slots[i] << shift;
+            if (shift + width > WORD_BITS<Word>) {
+                words[(word + 1) * LANES + lane] |= slots[i] >> (WORD_BITS<Word> - shift);
+            }
+        }
+    }
+    CopyArrayEndianess<sizeof(Word)>(out + 2 + reference_count * sizeof(Word), words, LANES * lane_words);
+
+    return size;
+}
+
+template <typename Type>
+static size_t PackAll(const Type* values, size_t count, uint8_t* out) noexcept {
+    uint8_t* write_ptr = out;
+    for (size_t i = 0; i < count; i += PACKED_BLOCK_LENGTH) {
+        const uint32_t length = static_cast<uint32_t>(std::min<size_t>(PACKED_BLOCK_LENGTH, count - i));
+        write_ptr += PackBlock(values + i, length, write_ptr);
+    }
+    return static_cast<size_t>(write_ptr - out);
+}
+
+size_t PackIntegers(const int32_t* values, size_t count, uint8_t* out) noexcept {
+    return PackAll(values, count, out);
+}
+
+size_t PackIntegers(const int64_t* values, size_t count, uint8_t* out) noexcept {
+    return PackAll(values, count, out);
+}
+
+size_t PackIntegers(const uint32_t* values, size_t count, uint8_t* out) noexcept {
+    return PackAll(values, count, out);
+}
+
+size_t PackIntegers(const uint64_t* values, size_t count, uint8_t* out) noexcept {
+    return PackAll(values, count, out);
+}
+
+// ---------------------------------
+// Unpacking
+// ---------------------------------
+
+// Unpacks row `row` of a full block, the 4 slots that share their bit offset within each lane. The
+// offsets are constants, so a row is one or two vector loads, shifts by immediates and a mask.
+template <typename Word, uint32_t width, uint32_t row>
+[[gnu::always_inline]]
+static inline void UnpackRow(const Word* in, Word* out) noexcept {
+    constexpr uint32_t BITS = WORD_BITS<Word>;
+    constexpr Word MASK = width == BITS ? ~Word(0) : (Word(1) << width) - 1;
+    constexpr uint32_t bit = row * width;
+    constexpr uint32_t word = bit / BITS;
+    constexpr uint32_t shift = bit % BITS;
+    constexpr bool SPLIT = shift + width > BITS;
+
+    const Word* low = in + word * LANES;
+    const Word* high = low + LANES;
+    Word* target = out + row * LANES;
+
+#if defined(__SSE2__)
+    if constexpr (sizeof(Word) == 4) {
+        __m128i value = _mm_srli_epi32(_mm_load_si128(reinterpret_cast<const __m128i*>(low)), shift);
+        if constexpr (SPLIT) {
+            value = _mm_or_si128(value, _mm_slli_epi32(_mm_load_si128(reinterpret_cast<const __m128i*>(high)), BITS - shift));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(target), _mm_and_si128(value, _mm_set1_epi32(static_cast<int32_t>(MASK))));
+        return;
+    }
+#if defined(__AVX2__)
+    if constexpr (sizeof(Word) == 8) {
+        __m256i value = _mm256_srli_epi64(_mm256_load_si256(reinterpret_cast<const __m256i*>(low)), shift);
+        if constexpr (SPLIT) {
+            value = _mm256_or_si256(value, _mm256_slli_epi64(_mm256_load_si256(reinterpret_cast<const __m256i*>(high)), BITS - shift));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(target), _mm256_and_si256(value, _mm256_set1_epi64x(static_cast<int64_t>(MASK))));
+        return;
+    }
+#else
+    if constexpr (sizeof(Word) == 8) {
+        for (uint32_t half = 0; half < LANES; half += 2) {
+            __m128i value = _mm_srli_epi64(_mm_load_si128(reinterpret_cast<const __m128i*>(low + half)), shift);
+            if constexpr (SPLIT) {
+                value = _mm_or_si128(value, _mm_slli_epi64(_mm_load_si128(reinterpret_cast<const __m128i*>(high + half)), BITS - shift));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(target + half),
+                             _mm_and_si128(value, _mm_set1_epi64x(static_cast<int64_t>(MASK))));
+        }
+        return;
+    }
+#endif
+#endif
+
+    for (uint32_t lane = 0; lane < LANES; ++lane) {
+        Word value = low[lane] >> shift;
+        if constexpr (SPLIT) {
+            value |= high[lane] << (BITS - shift);
+        }
+        target[lane] = value & MASK;
+    }
+}
+
+template <typename Word, uint32_t width>
+static void UnpackFullBlock(const Word* in, Word* out) noexcept {
+    if constexpr (width == 0) {
+        std::fill_n(out, PACKED_BLOCK_LENGTH, Word(0));
+    } else {
+        [&]<uint32_t... rows>(std::integer_sequence<uint32_t, rows...>) {
+            (UnpackRow<Word, width, rows>(in, out), ...);
+        }(std::make_integer_sequence<uint32_t, PACKED_BLOCK_LENGTH / LANES>{});
+    }
+}
+
+template <typename Word>
+using UnpackFullBlockFunc = void (*)(const Word*, Word*) noexcept;
+
+template <typename Word, uint32_t... widths>
+static constexpr std::array<UnpackFullBlockFunc<Word>, sizeof...(widths)> MakeUnpackTable(std::integer_sequence<uint32_t, widths...>) {
+    return {&UnpackFullBlock<Word, widths>...};
+}
+
+// Indexed by width, 0 to the bits of the word
+template <typename Word>
+static constexpr auto UNPACK_FULL_BLOCK = MakeUnpackTable<Word>(std::make_integer_sequence<uint32_t, WORD_BITS<Word> + 1>{});
+
+// Unpacks the rows of a short block, writing a multiple of 4 slots
+template <typename Word>
+static void UnpackPartialBlock(const Word* in, Word* out, uint32_t count, uint32_t width) noexcept {
+    constexpr uint32_t BITS = WORD_BITS<Word>;
+    const Word mask = width == BITS ? ~Word(0) : (Word(1) << width) - 1;
+    const uint32_t rows = (count + LANES - 1) / LANES;
+
+    for (uint32_t row = 0; row < rows; ++row) {
+        const uint32_t bit = row * width;
+        const uint32_t word = bit / BITS;
+        const uint32_t shift = bit % BITS;
+        for (uint32_t lane = 0; lane < LANES; ++lane) {
+            Word value = width == 0 ? 0 : in[word * LANES + lane] >> shift;
+            if (shift + width > BITS) {
+                value |= in[(word + 1) * LANES + lane] << (BITS - shift);
+            }
+            out[row * LANES + lane] = value & mask;
+        }
+    }
+}
+
+// Replaces data[i] with start + data[0] + ... + data[i]. With SSE2, 32 bit words are summed 4 at a
+// time in register by two shifted adds, carrying the last one into the next vector, so the serial
+// dependency is one add and one shuffle per 4 words. Two 64 bit words per vector gain nothing over
+// the scalar loop.
+template <typename Word>
+static inline void PrefixSum(Word* data, uint32_t count, Word start) noexcept {
+    uint32_t i = 0;
+
+#if defined(__SSE2__)
+    if constexpr (sizeof(Word) == 4) {
+        __m128i carry = _mm_set1_epi32(static_cast<int32_t>(start));
+        for (; i + 4 <= count; i += 4) {
+            __m128i* target = reinterpret_cast<__m128i*>(data + i);
+            __m128i sum = _mm_loadu_si128(target);
+            sum = _mm_add_epi32(sum, _mm_slli_si128(sum, 4));
+            sum = _mm_add_epi32(sum, _mm_slli_si128(sum, 8));
+            sum = _mm_add_epi32(sum, carry);
+            carry = _mm_shuffle_epi32(sum, _MM_SHUFFLE(3, 3, 3, 3));
+            _mm_storeu_si128(target, sum);
+        }
+        if (i > 0) {
+            start = data[i - 1];
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        start += data[i];
+        data[i] = start;
+    }
+}
+
+template <typename Word>
+static size_t UnpackBlock(const uint8_t* src, size_t size, Word* out, uint32_t count) noexcept {
+    if (count == 0 || count > PACKED_BLOCK_LENGTH) [[unlikely]] {
+        return 0;
+    }
+
+    const BlockHeader header = ReadBlockHeader<Word>(src, size, count);
+    if (header.size == 0) [[unlikely]] {
+        return 0;
+    }
+
+    const uint32_t reference_count = static_cast<uint32_t>(header.encoding) + 1;
+    Word references[3];
+    CopyArrayEndianess<sizeof(Word)>(references, src + 2, reference_count);
+
+    // The slots are copied out of the buffer first, which aligns them for the vector loads and puts
+    // them in host order
+    alignas(32) Word words[LANES * WORD_BITS<Word>];
+    CopyArrayEndianess<sizeof(Word)>(words, src + 2 + reference_count * sizeof(Word), LANES * LaneWords<Word>(count, header.width));
+
+    Word* slots = out;
+    alignas(32) Word partial[PACKED_BLOCK_LENGTH];
+    if (count == PACKED_BLOCK_LENGTH) [[likely]] {
+        UNPACK_FULL_BLOCK<Word>[header.width](words, slots);
+    } else {
+        slots = partial;
+        UnpackPartialBlock(words, slots, count, header.width);
+    }
+
+    // The deltas are rebuilt as prefix sums of the slots offset by their minimum, and the values as
+    // prefix sums of the deltas. Slots before the first delta hold no data.
+    switch (header.encoding) {
+        case BlockEncoding::FrameOfReference:
+            for (uint32_t i = 0; i < count; ++i) {
+                out[i] = references[0] + slots[i];
+            }
+            break;
+        case BlockEncoding::Delta:
+            out[0] = 0;
+            for (uint32_t i = 1; i < count; ++i) {
+                out[i] = references[1] + slots[i];
+            }
+            PrefixSum(out, count, references[0]);
+            break;
+        case BlockEncoding::DeltaOfDelta:
+            out[0] = 0;
+            if (count > 1) {
+                out[1] = references[1];
+            }
+            for (uint32_t i = 2; i < count; ++i) {
+                out[i] = references[2] + slots[i];
+            }
+            PrefixSum(out, count, Word(0));
+            PrefixSum(out, count, references[0]);
+            break;
+    }
+
+    return header.size;
+}
+
+template <typename Word>
+static bool UnpackAll(const uint8_t* src, size_t size, Word* out, size_t count) noexcept {
+    const uint8_t* read_ptr = src;
+    const uint8_t* end = src + size;
+    for (size_t i = 0; i < count; i += PACKED_BLOCK_LENGTH) {
+        const uint32_t length = static_cast<uint32_t>(std::min<size_t>(PACKED_BLOCK_LENGTH, count - i));
+        const size_t block_size = UnpackBlock(read_ptr, static_cast<size_t>(end - read_ptr), out + i, length);
+        if (block_size == 0) [[unlikely]] {
+            return false;
+        }
+        read_ptr += block_size;
+    }
+    return read_ptr == end;
+}
+
+size_t UnpackIntegerBlock(const uint8_t* src, size_t size, uint32_t* out, uint32_t count) noexcept {
+    return UnpackBlock(src, size, out, count);
+}
+
+size_t UnpackIntegerBlock(const uint8_t* src, size_t size, uint64_t* out, uint32_t count) noexcept {
+    return UnpackBlock(src, size, out, count);
+}
+
+bool UnpackIntegers(const uint8_t* src, size_t size, uint32_t* out, size_t count) noexcept {
+    return UnpackAll(src, size, out, count);
+}
+
+bool UnpackIntegers(const uint8_t* src, size_t size, uint64_t* out, size_t count) noexcept {
+    return UnpackAll(src, size, out, count);
+}
+
+// ---------------------------------
+// Validation
+// ---------------------------------
+
+template <typename Word>
+static bool ValidateBlocks(const uint8_t* src, size_t size, size_t count) noexcept {
+    const uint8_t* read_ptr = src;
+    const uint8_t* end = src + size;
+    for (size_t i = 0; i < count; i += PACKED_BLOCK_LENGTH) {
+        const uint32_t length = static_cast<uint32_t>(std::min<size_t>(PACKED_BLOCK_LENGTH, count - i));
+        const BlockHeader header = ReadBlockHeader<Word>(read_ptr, static_cast<size_t>(end - read_ptr), length);
+        if (header.size == 0) [[unlikely]] {
+            return false;
+        }
+        read_ptr += header.size;
+    }
+    return read_ptr == end;
+}
+
+bool ValidatePackedIntegers(const uint8_t* src, size_t size, size_t count, uint32_t element_size) noexcept {
+    switch (element_size) {
+        case sizeof(uint32_t): return ValidateBlocks<uint32_t>(src, size, count);
+        case sizeof(uint64_t): return ValidateBlocks<uint64_t>(src, size, count);
+        default: return false;
+    }
+}
+
+}  // namespace tbf
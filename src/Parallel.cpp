@@ -0,0 +1,161 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#include "tbf/Parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+namespace tbf {
+
+// Pool whose job the current thread is working on, used to run nested jobs inline
+static thread_local const ThreadPool* t_current_pool = nullptr;
+
+// ---------------------------------
+// Constructors & Destructor
+// ---------------------------------
+
+ThreadPool::ThreadPool(uint32_t thread_count) noexcept {
+    if (thread_count == 0) {
+        thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    // A pool that could not start all of its workers runs with the ones it got
+    m_workers.reserve(thread_count - 1);
+    for (uint32_t i = 1; i < thread_count; ++i) {
+        try {
+            m_workers.emplace_back([this] { WorkerLoop(); });
+        } catch (const std::system_error&) {
+            break;
+        }
+    }
+}
+
+ThreadPool::~ThreadPool() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_work_ready.notify_all();
+
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::Shared() noexcept {
+    static ThreadPool pool;
+    return pool;
+}
+
+// ---------------------------------
+// Jobs
+// ---------------------------------
+
+void ThreadPool::Run(uint32_t task_count, TaskFunction function, void* context) noexcept {
+    if (task_count == 0) {
+        return;
+    }
+
+    if (m_workers.empty() || task_count == 1 || t_current_pool == this) {
+        for (uint32_t task = 0; task < task_count; ++task) {
+            function(context, task);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> run_lock(m_run_mutex);
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        // Workers that joined the previous job late may still be holding its task counter
+        m_work_done.wait(lock, [this] { return m_active_workers == 0; });
+
+        m_function = function;
+        m_context = context;
+        m_task_count = task_count;
+        m_finished_tasks = 0;
+        m_next_task.store(0, std::memory_order_relaxed);
+        ++m_generation;
+    }
+    m_work_ready.notify_all();
+
+    const ThreadPool* previous_pool = t_current_pool;
+    t_current_pool = this;
+    const uint32_t finished = ExecuteTasks(function, context, task_count);
+    t_current_pool = previous_pool;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_finished_tasks += finished;
+    m_work_done.wait(lock, [this] { return m_finished_tasks == m_task_count; });
+}
+
+void ThreadPool::WorkerLoop() noexcept {
+    t_current_pool = this;
+    uint64_t generation = 0;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_work_ready.wait(lock, [&] { return m_stopping || m_generation != generation; });
+        if (m_stopping) {
+            return;
+        }
+
+        generation = m_generation;
+        TaskFunction function = m_function;
+        void* context = m_context;
+        const uint32_t task_count = m_task_count;
+        ++m_active_workers;
+
+        lock.unlock();
+        const uint32_t finished = ExecuteTasks(function, context, task_count);
+        lock.lock();
+
+        m_finished_tasks += finished;
+        --m_active_workers;
+        m_work_done.notify_all();
+    }
+}
+
+uint32_t ThreadPool::ExecuteTasks(TaskFunction function, void* context, uint32_t task_count) noexcept {
+    uint32_t finished = 0;
+
+    uint32_t task = m_next_task.fetch_add(1, std::memory_order_relaxed);
+    while (task < task_count) {
+        function(context, task);
+        ++finished;
+        task = m_next_task.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return finished;
+}
+
+}  // namespace tbf
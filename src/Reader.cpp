@@ -25,12 +25,20 @@
 
 #include "tbf/Reader.hpp"
 
+#include "tbf/Compression.hpp"
 #include "tbf/DataTag.hpp"
 #include "tbf/DataType.hpp"
 #include "tbf/Endianness.hpp"
+#include "tbf/Float16.hpp"
+#include "tbf/IntegerPacking.hpp"
+#include "tbf/Varint.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <memory_resource>
 #include <optional>
 #include <span>
 #include <string_view>
@@ -42,25 +50,55 @@ namespace tbf {
 // Reader
 // ---------------------------------
 
-Reader::Reader(const void* buffer, size_t size, bool name_based) noexcept
-    : m_root_object(buffer, size, name_based) {}
+template <TagMode Mode>
+BasicReader<Mode>::BasicReader(const void* buffer, size_t size, bool name_based, IndexMode index_mode,
+                               std::pmr::memory_resource* resource) noexcept
+    requires(Mode == TagMode::Runtime)
+    : BasicReader(buffer, size, name_based, index_mode, resource, false) {}
+
+template <TagMode Mode>
+BasicReader<Mode>::BasicReader(const void* buffer, size_t size, IndexMode index_mode, std::pmr::memory_resource* resource) noexcept
+    requires(Mode != TagMode::Runtime)
+    : BasicReader(buffer, size, Mode == TagMode::Name, index_mode, resource, false) {}
+
+template <TagMode Mode>
+BasicReader<Mode>::BasicReader(const void* buffer, size_t size, bool name_based, IndexMode index_mode, std::pmr::memory_resource* resource,
+                               bool trusted) noexcept
+    : m_arena(),
+      m_document(resource != nullptr ? resource : &m_arena),
+      m_root_object(buffer, size, name_based, index_mode, m_document.GetResource()) {
+    m_root_object.m_trusted = trusted;
+
+    if (index_mode == IndexMode::Document) {
+        m_document.Build(buffer, size, name_based, trusted);
+        m_root_object.AttachDocument(m_document, 0);
+    }
+}
 
 // ---------------------------------
 // Constructors & Destructor
 // ---------------------------------
 
-ObjectReader::ObjectReader(const void* buffer, size_t size, bool name_based) noexcept
-    : ObjectReader(buffer, name_based) {
+ObjectReader::ObjectReader(const void* buffer, size_t size, bool name_based, IndexMode index_mode, std::pmr::memory_resource* resource) noexcept
+    : ObjectReader(buffer, name_based, index_mode, resource) {
     if (m_size + sizeof(FieldSize) > size) {
         Invalidate();
     }
 }
 
-ObjectReader::ObjectReader(const void* buffer, bool name_based) noexcept
-    : m_size(0),
+ObjectReader::ObjectReader(const void* buffer, bool name_based, IndexMode index_mode, std::pmr::memory_resource* resource) noexcept
+    : ObjectReader(buffer, name_based, index_mode, resource, false) {}
+
+ObjectReader::ObjectReader(const void* buffer, bool name_based, IndexMode index_mode, std::pmr::memory_resource* resource, bool trusted) noexcept
+    : m_buffer(nullptr),
+      m_size(0),
       m_name_based(name_based),
+      m_index_mode(index_mode),
+      m_trusted(trusted),
       m_cache_built(false),
-      m_is_valid(false) {
+      m_is_valid(false),
+      m_index(resource),
+      m_scan_ptr(nullptr) {
     if (buffer == nullptr) {
         Invalidate();
         return;
@@ -69,22 +107,52 @@ ObjectReader::ObjectReader(const void* buffer, bool name_based) noexcept
     std::memcpy(&m_size, buffer, sizeof(FieldSize));
     AdjustEndianess(m_size);
     m_buffer = static_cast<const uint8_t*>(buffer) + sizeof(FieldSize);
+    m_scan_ptr = static_cast<const uint8_t*>(m_buffer);
 
-    if (name_based) {
-        new (&m_name_cache) std::unordered_map<std::string_view, CacheEntry>();
-    } else {
-        new (&m_id_cache) std::unordered_map<DataTag::Id, CacheEntry>();
+    if (m_size == 0) [[unlikely]] {
+        Invalidate();
     }
 }
 
+ObjectReader::ObjectReader(const DocumentIndex& document, uint32_t object) noexcept
+    : m_buffer(nullptr),
+      m_size(0),
+      m_name_based(document.IsNameBased()),
+      m_index_mode(IndexMode::Document),
+      m_index(document.GetResource()),
+      m_scan_ptr(nullptr) {
+    AttachDocument(document, object);
+}
+
+struct alignas(std::max_align_t) ObjectReader::ConvertedBlock {
+    ConvertedBlock* next;
+    const void* source;  // Data in the buffer the block is a conversion of
+    size_t size;         // Of the whole allocation, data included
+};
+
 ObjectReader::~ObjectReader() noexcept {
-    if (m_name_based) {
-        m_name_cache.~unordered_map();
-    } else {
-        m_id_cache.~unordered_map();
+    while (m_converted != nullptr) {
+        ConvertedBlock* block = m_converted;
+        m_converted = block->next;
+        GetMemoryResource()->deallocate(block, block->size, alignof(ConvertedBlock));
     }
 }
 
+void ObjectReader::AttachDocument(const DocumentIndex& document, uint32_t object) noexcept {
+    const DocumentIndex::Object& range = document.GetObject(object);
+
+    m_buffer = document.ObjectData(object);
+    m_size = range.size;
+    m_document = &document;
+    m_object = object;
+    m_cursor = 0;
+
+    m_index.Clear();
+    m_scan_ptr = nullptr;
+    m_cache_built = true;
+    m_is_valid = range.valid;
+}
+
 // ---------------------------------
 // Memory checking helpers
 // ---------------------------------
@@ -94,10 +162,21 @@ static inline bool CanAccessBuffer(const void* beg, const void* end, size_t size
     return static_cast<size_t>(static_cast<const uint8_t*>(end) - static_cast<const uint8_t*>(beg)) >= size;
 }
 
-template <typename Type, bool swap_endianess = true>
+// Buffers of trusted readers were validated beforehand, so their bounds checks always pass
+template <bool trusted>
+[[gnu::always_inline]]
+static inline bool CanAccessBuffer(const void* beg, const void* end, size_t size) noexcept {
+    if constexpr (trusted) {
+        return true;
+    } else {
+        return CanAccessBuffer(beg, end, size);
+    }
+}
+
+template <typename Type, bool swap_endianess = true, bool trusted = false>
 [[gnu::always_inline]]
 static inline bool ReadData(const uint8_t*& read_ptr, const uint8_t* end_ptr, Type& out_value) noexcept {
-    if (CanAccessBuffer(read_ptr, end_ptr, sizeof(Type))) [[likely]] {
+    if (CanAccessBuffer<trusted>(read_ptr, end_ptr, sizeof(Type))) [[likely]] {
         std::memcpy(&out_value, read_ptr, sizeof(Type));
 
         if constexpr (swap_endianess) {
@@ -112,251 +191,789 @@ static inline bool ReadData(const uint8_t*& read_ptr, const uint8_t* end_ptr, Ty
 }
 
 // ---------------------------------
-// Cache management
+// Array layout helpers
 // ---------------------------------
 
-void ObjectReader::CreateCache(uint32_t initial_size) const noexcept {
-    if (m_cache_built) [[likely]] {
-        return;
+// Locates the elements of a String, Binary or Object array. An indexed array stores its element
+// count before the elements and its offset table after them, so both are left out of the range and
+// out_count receives the count. Plain arrays do not store it and set out_count to zero.
+static bool LocateElements(DataType type, const void* array, const uint8_t*& out_begin, const uint8_t*& out_end, uint32_t& out_count) noexcept {
+    const uint8_t* read_ptr = static_cast<const uint8_t*>(array);
+
+    FieldSize array_size;
+    std::memcpy(&array_size, read_ptr, sizeof(array_size));
+    AdjustEndianess(array_size);
+    read_ptr += sizeof(array_size);
+
+    const uint8_t* end_ptr = read_ptr + array_size;
+    out_count = 0;
+
+    if (IsIndexedArrayType(type)) {
+        if (!ReadData<uint32_t>(read_ptr, end_ptr, out_count)) [[unlikely]] {
+            return false;
+        }
+        if (out_count > static_cast<size_t>(end_ptr - read_ptr) / sizeof(uint32_t)) [[unlikely]] {
+            return false;
+        }
+        end_ptr -= out_count * sizeof(uint32_t);
     }
 
-    if (m_buffer == nullptr || m_size == 0) [[unlikely]] {
-        m_is_valid = false;
-        m_cache_built = true;
-        return;
+    out_begin = read_ptr;
+    out_end = end_ptr;
+    return true;
+}
+
+// Checks that the offset table stored after the elements of an indexed array describes consecutive
+// elements filling the range exactly. Unlike walking the size prefixes, each check only needs its
+// own pair of table entries, so the loads do not depend on each other.
+template <typename ElementSizeType>
+static bool ValidateOffsetTable(const uint8_t* elements, const uint8_t* elements_end, uint32_t count) noexcept {
+    const uint64_t elements_size = static_cast<uint64_t>(elements_end - elements);
+    if (count == 0) {
+        return elements_size == 0;
     }
 
-    if (m_name_based) {
-        m_name_cache.clear();
-        m_name_cache.reserve(initial_size);
+    uint32_t offset;
+    std::memcpy(&offset, elements_end, sizeof(offset));
+    AdjustEndianess(offset);
+    if (offset != 0) [[unlikely]] {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        std::memcpy(&offset, elements_end + i * sizeof(uint32_t), sizeof(offset));
+        AdjustEndianess(offset);
+
+        uint64_t next = elements_size;
+        if (i + 1 < count) {
+            uint32_t next_offset;
+            std::memcpy(&next_offset, elements_end + (i + 1) * sizeof(uint32_t), sizeof(next_offset));
+            AdjustEndianess(next_offset);
+            next = next_offset;
+        }
+
+        if (next > elements_size || static_cast<uint64_t>(offset) + sizeof(ElementSizeType) > next) [[unlikely]] {
+            return false;
+        }
+
+        ElementSizeType element_size;
+        std::memcpy(&element_size, elements + offset, sizeof(element_size));
+        AdjustEndianess(element_size);
+
+        if (static_cast<uint64_t>(offset) + sizeof(ElementSizeType) + element_size != next) [[unlikely]] {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// ---------------------------------
+// Field parsing
+// ---------------------------------
+
+struct ParsedField {
+    const uint8_t* tag_ptr;
+    DataTag::NameSize tag_size;
+    CacheEntry entry;
+};
+
+// Parses the field at read_ptr and advances read_ptr past it. Returns false if the field is malformed
+// or does not fit before buff_end. Trusted parsing skips the bounds and type checks. Inlined into
+// each loop over the fields of an object, which picks the instantiation once, see IndexFields.
+template <bool trusted, bool name_based>
+[[gnu::always_inline]]
+static inline bool ParseFieldImpl(const uint8_t*& read_ptr, const uint8_t* buff_end, ParsedField& out_field) noexcept {
+    // Read register
+
+    DataType type;
+    if (!ReadData<DataType, true, trusted>(read_ptr, buff_end, type) || (!trusted && !IsValidDataType(type))) [[unlikely]] {
+        return false;
+    }
+
+    const uint8_t* tag_ptr = nullptr;
+    DataTag::NameSize tag_size = 0;
+
+    // Read tag based on the mode (name-based or id-based)
+
+    if constexpr (name_based) {
+        if (
+            !ReadData<DataTag::NameSize, true, trusted>(read_ptr, buff_end, tag_size) ||
+            !CanAccessBuffer<trusted>(read_ptr, buff_end, tag_size)) [[unlikely]] {
+            return false;
+        }
+
+        tag_ptr = read_ptr;
+        read_ptr += tag_size;
     } else {
-        m_id_cache.clear();
-        m_id_cache.reserve(initial_size);
+        if (!CanAccessBuffer<trusted>(read_ptr, buff_end, sizeof(DataTag::Id))) [[unlikely]] {
+            return false;
+        }
+
+        tag_ptr = read_ptr;
+        read_ptr += sizeof(DataTag::Id);
     }
 
-    const uint8_t* read_ptr = static_cast<const uint8_t*>(m_buffer);
-    const uint8_t* buff_end = static_cast<const uint8_t*>(m_buffer) + m_size;
+    // Read the corresponding entry
 
-    // bool terminated = false;
-    bool errors = false;
+    CacheEntry entry = {.type = type, .value = {.ptr = nullptr}};
 
-    while (read_ptr < buff_end) {
-        // Read register
+    if (IsArrayType(type) || IsEncodedArrayType(type) || IsCompressedType(type)) {
+        entry.value.ptr = read_ptr;
 
-        DataType type;
-        if (!ReadData<DataType>(read_ptr, buff_end, type) || !IsValidDataType(type)) [[unlikely]] {
-            errors = true;
-            break;
+        // Array and vector elements are left in buffer byte order, the buffer is never written to.
+        // Readers convert them when they are read.
+        FieldSize array_size;
+        if (!ReadData<FieldSize, true, trusted>(read_ptr, buff_end, array_size)) [[unlikely]] {
+            return false;
         }
+        read_ptr += array_size;
+    } else if (IsVectorType(type)) {
+        entry.value.ptr = read_ptr;
 
-        const uint8_t* tag_ptr = nullptr;
-        uint8_t tag_size;
+        uint32_t vector_size = VectorTypeDimension(type) * DataTypeSize(BaseDataType(type));
 
-        // Read tag based on the mode (name-based or id-based)
+        if (!CanAccessBuffer<trusted>(read_ptr, buff_end, vector_size)) [[unlikely]] {
+            return false;
+        }
+        read_ptr += vector_size;
+    } else if (IsVarintType(type)) {
+        // Decoded here, so reads of the field cost the same as fixed size integers
+        uint64_t value;
+        const uint32_t length = DecodeVarint(read_ptr, buff_end, value);
+        if (length == 0) [[unlikely]] {
+            return false;
+        }
+        read_ptr += length;
+
+        if (type == DataType::VarInt64) {
+            entry.value.v_int64 = ZigZagDecode(value);
+        } else {
+            entry.value.v_uint64 = value;
+        }
+    } else if (IsPrimitiveType(type)) {
+        switch (type) {
+            // Primitives
+            case DataType::Boolean:
+            case DataType::UInt8:
+            case DataType::Int8:
+                if (!ReadData<int8_t, true, trusted>(read_ptr, buff_end, entry.value.v_int8)) [[unlikely]] {
+                    return false;
+                }
+                break;
+            case DataType::Float16:
+            case DataType::UInt16:
+            case DataType::Int16:
+                if (!ReadData<int16_t, true, trusted>(read_ptr, buff_end, entry.value.v_int16)) [[unlikely]] {
+                    return false;
+                }
+                break;
+            case DataType::Float32:
+            case DataType::UInt32:
+            case DataType::Int32:
+                if (!ReadData<int32_t, true, trusted>(read_ptr, buff_end, entry.value.v_int32)) [[unlikely]] {
+                    return false;
+                }
+                break;
+            case DataType::Float64:
+            case DataType::UInt64:
+            case DataType::Int64:
+                if (!ReadData<int64_t, true, trusted>(read_ptr, buff_end, entry.value.v_int64)) [[unlikely]] {
+                    return false;
+                }
+                break;
+            case DataType::UUID:
+                entry.value.ptr = read_ptr;
+
+                if (!CanAccessBuffer<trusted>(read_ptr, buff_end, 16)) [[unlikely]] {
+                    return false;
+                } else {
+                    read_ptr += 16;
+                }
+                break;
+            case DataType::String: {
+                entry.value.ptr = read_ptr;
+
+                uint16_t length;
+                if (!ReadData<uint16_t, true, trusted>(read_ptr, buff_end, length)) [[unlikely]] {
+                    return false;
+                } else {
+                    read_ptr += length;
+                }
 
-        if (m_name_based) {
-            if (
-                !ReadData<uint8_t>(read_ptr, buff_end, tag_size) ||
-                !CanAccessBuffer(read_ptr, buff_end, tag_size)) [[unlikely]] {
-                errors = true;
                 break;
             }
+            case DataType::Object:
+            case DataType::Binary: {
+                entry.value.ptr = read_ptr;
+
+                FieldSize size;
+                if (!ReadData<FieldSize, true, trusted>(read_ptr, buff_end, size)) [[unlikely]] {
+                    return false;
+                } else {
+                    read_ptr += size;
+                }
 
-            tag_ptr = read_ptr;
-            read_ptr += tag_size;
-        } else {
-            if (!CanAccessBuffer(read_ptr, buff_end, sizeof(DataTag::Id))) [[unlikely]] {
-                errors = true;
                 break;
             }
+            default:
+                return false;
+        }
+    } else {
+        return false;
+    }
+
+    out_field.tag_ptr = tag_ptr;
+    out_field.tag_size = tag_size;
+    out_field.entry = entry;
+
+    return trusted || read_ptr <= buff_end;
+}
+
+// Chooses the instantiation for every field, for callers that parse fields one at a time
+[[gnu::always_inline]]
+static inline bool ParseField(const uint8_t*& read_ptr, const uint8_t* buff_end, bool name_based, bool trusted, ParsedField& out_field) noexcept {
+    if (name_based) {
+        return trusted ? ParseFieldImpl<true, true>(read_ptr, buff_end, out_field) : ParseFieldImpl<false, true>(read_ptr, buff_end, out_field);
+    }
+    return trusted ? ParseFieldImpl<true, false>(read_ptr, buff_end, out_field) : ParseFieldImpl<false, false>(read_ptr, buff_end, out_field);
+}
 
-            tag_ptr = read_ptr;
-            read_ptr += sizeof(DataTag::Id);
+[[gnu::always_inline]]
+static inline std::string_view ParsedTagName(const ParsedField& field) noexcept {
+    return std::string_view(reinterpret_cast<const char*>(field.tag_ptr), field.tag_size);
+}
+
+[[gnu::always_inline]]
+static inline DataTag::Id ParsedTagId(const ParsedField& field) noexcept {
+    DataTag::Id tag_id;
+    std::memcpy(&tag_id, field.tag_ptr, sizeof(tag_id));
+    AdjustEndianess(tag_id);
+    return tag_id;
+}
+
+template <bool name_based>
+[[gnu::always_inline]]
+static inline bool IndexField(FieldIndex& index, const ParsedField& field) noexcept {
+    if constexpr (name_based) {
+        std::string_view name = ParsedTagName(field);
+        return index.Insert(name, TagLookupHash(name), field.entry);
+    } else {
+        return index.Insert(ParsedTagId(field), field.entry);
+    }
+}
+
+// ---------------------------------
+// Compressed fields
+// ---------------------------------
+
+// The payload of a Compressed field, [Size] [Type] [Raw size] [Compressed data]
+struct CompressedPayload {
+    DataType type;
+    FieldSize raw_size;
+    const uint8_t* data;
+    FieldSize size;
+};
+
+static bool LocateCompressed(const CacheEntry& entry, CompressedPayload& out_payload) noexcept {
+    if (entry.type != DataType::Compressed || entry.value.ptr == nullptr) [[unlikely]] {
+        return false;
+    }
+
+    // ParseField already checked that the size prefix fits in the buffer
+    const uint8_t* read_ptr = static_cast<const uint8_t*>(entry.value.ptr);
+    FieldSize size;
+    std::memcpy(&size, read_ptr, sizeof(size));
+    AdjustEndianess(size);
+    read_ptr += sizeof(size);
+
+    constexpr FieldSize HEADER_SIZE = sizeof(DataType) + sizeof(FieldSize);
+    if (size < HEADER_SIZE) [[unlikely]] {
+        return false;
+    }
+
+    const DataType type = static_cast<DataType>(read_ptr[0]);
+    FieldSize raw_size;
+    std::memcpy(&raw_size, read_ptr + sizeof(DataType), sizeof(raw_size));
+    AdjustEndianess(raw_size);
+
+    // Compressed fields do not nest, and the raw size is bounded so that a corrupt one cannot make
+    // readers allocate far more than the data can produce
+    const FieldSize data_size = size - HEADER_SIZE;
+    if (!IsValidDataType(type) || !IsCompressibleType(type) || raw_size > MaxDecompressedSize(data_size) ||
+        raw_size > UINT32_MAX - 256) [[unlikely]] {
+        return false;
+    }
+
+    out_payload = {.type = type, .raw_size = raw_size, .data = read_ptr + HEADER_SIZE, .size = data_size};
+    return true;
+}
+
+// Writes the wrapped payload, its size followed by the decompressed data, to `out`, which needs
+// room for sizeof(FieldSize) + raw_size bytes
+static bool DecompressPayload(const CompressedPayload& payload, uint8_t* out) noexcept {
+    FieldSize raw_size = payload.raw_size;
+    AdjustEndianess(raw_size);
+    std::memcpy(out, &raw_size, sizeof(raw_size));
+    return DecompressBlock(payload.data, payload.size, out + sizeof(raw_size), payload.raw_size);
+}
+
+// ---------------------------------
+// Validation
+// ---------------------------------
+
+template <bool name_based>
+static bool ValidateFields(const uint8_t* read_ptr, const uint8_t* buff_end, uint32_t depth) noexcept;
+
+// Size prefixed elements of a String, Binary or Object array, which must fill the array exactly
+template <typename ElementSizeType, bool name_based>
+static bool ValidateElements(const uint8_t* read_ptr, const uint8_t* buff_end, bool objects, uint32_t depth) noexcept {
+    while (read_ptr < buff_end) {
+        ElementSizeType element_size;
+        if (!ReadData<ElementSizeType>(read_ptr, buff_end, element_size) || !CanAccessBuffer(read_ptr, buff_end, element_size)) [[unlikely]] {
+            return false;
         }
 
-        // Read the corresponding entry
+        if (objects && !ValidateFields<name_based>(read_ptr, read_ptr + element_size, depth + 1)) [[unlikely]] {
+            return false;
+        }
 
-        CacheEntry entry = {.type = type, .value = {.ptr = nullptr}};
+        read_ptr += element_size;
+    }
+    return true;
+}
 
-        if (IsArrayType(type)) {
-            entry.value.ptr = read_ptr;
+template <typename ElementSizeType, bool name_based>
+static bool ValidateArray(DataType type, const void* array, bool objects, uint32_t depth) noexcept {
+    const uint8_t* elements;
+    const uint8_t* elements_end;
+    uint32_t count;
+    if (!LocateElements(type, array, elements, elements_end, count)) [[unlikely]] {
+        return false;
+    }
 
-            FieldSize array_size;
-            if (!ReadData<FieldSize>(read_ptr, buff_end, array_size)) [[unlikely]] {
-                errors = true;
-                break;
-            } else {
-                // Adjust endianness for array elements during cache creation
-                uint32_t element_size = DataTypeSize(BaseDataType(type));
-
-                if (element_size > 1) {
-                    uint32_t array_length = array_size / element_size;
-
-                    // Verify array size is consistent
-                    if (array_length * element_size == array_size) [[likely]] {
-                        void* mutable_ptr = const_cast<void*>(static_cast<const void*>(read_ptr));
-                        switch (element_size) {
-                            case 2:
-                                AdjustArrayEndianess<2>(mutable_ptr, array_length);
-                                break;
-                            case 4:
-                                AdjustArrayEndianess<4>(mutable_ptr, array_length);
-                                break;
-                            case 8:
-                                AdjustArrayEndianess<8>(mutable_ptr, array_length);
-                                break;
-                        }
-                    }
-                }
+    if (IsIndexedArrayType(type) && !ValidateOffsetTable<ElementSizeType>(elements, elements_end, count)) [[unlikely]] {
+        return false;
+    }
+
+    return ValidateElements<ElementSizeType, name_based>(elements, elements_end, objects, depth);
+}
+
+// Contents of a Compressed field or any field it can wrap, whose size prefix ParseField already
+// checked against the buffer
+template <bool name_based>
+static bool ValidateValue(const CacheEntry& entry, uint32_t depth) noexcept {
+    const DataType type = entry.type;
+    const uint8_t* data_ptr = static_cast<const uint8_t*>(entry.value.ptr);
+    FieldSize data_size;
+    std::memcpy(&data_size, data_ptr, sizeof(data_size));
+    AdjustEndianess(data_size);
+    data_ptr += sizeof(data_size);
 
-                read_ptr += array_size;
+    switch (PlainArrayType(type)) {
+        case DataType::Object:
+            return ValidateFields<name_based>(data_ptr, data_ptr + data_size, depth + 1);
+        case DataType::Binary:
+            return true;
+        case DataType::ObjectArray:
+            return ValidateArray<FieldSize, name_based>(type, entry.value.ptr, true, depth);
+        case DataType::BinaryArray:
+            return ValidateArray<FieldSize, name_based>(type, entry.value.ptr, false, depth);
+        case DataType::StringArray:
+            return ValidateArray<uint16_t, name_based>(type, entry.value.ptr, false, depth);
+        case DataType::PackedBooleanArray:
+            return PackedBooleanArrayReader(entry).IsValid();
+        case DataType::VarInt64Array:
+        case DataType::VarUInt64Array: {
+            VarintArrayReader array(entry);
+            return array.IsValid() && ValidateVarints(array.Encoded().data(), array.Encoded().size(), array.Size());
+        }
+        case DataType::PackedInt32Array:
+        case DataType::PackedInt64Array:
+        case DataType::PackedUInt32Array:
+        case DataType::PackedUInt64Array: {
+            PackedIntegerArrayReader array(entry);
+            return array.IsValid() &&
+                   ValidatePackedIntegers(array.Encoded().data(), array.Encoded().size(), array.Size(), DataTypeSize(BaseDataType(type)));
+        }
+        case DataType::DictionaryStringArray:
+            return DictionaryStringArrayReader(entry).Validate();
+        case DataType::Compressed: {
+            // The wrapped field is decompressed and validated like any other
+            CompressedPayload payload;
+            if (!LocateCompressed(entry, payload)) [[unlikely]] {
+                return false;
             }
-        } else if (IsVectorType(type)) {
-            entry.value.ptr = read_ptr;
-
-            uint32_t vector_length = VectorTypeDimension(type);
-            uint32_t element_size = DataTypeSize(BaseDataType(type));
-
-            uint32_t vector_size = vector_length * element_size;
-
-            if (!CanAccessBuffer(read_ptr, buff_end, vector_size)) [[unlikely]] {
-                errors = true;
-            } else {
-                // Adjust endianness for vector elements during cache creation
-                if (element_size > 1) {
-                    void* mutable_ptr = const_cast<void*>(static_cast<const void*>(read_ptr));
-                    switch (element_size) {
-                        case 2:
-                            AdjustArrayEndianess<2>(mutable_ptr, vector_length);
-                            break;
-                        case 4:
-                            AdjustArrayEndianess<4>(mutable_ptr, vector_length);
-                            break;
-                        case 8:
-                            AdjustArrayEndianess<8>(mutable_ptr, vector_length);
-                            break;
-                    }
-                }
-                read_ptr += vector_size;
+            std::vector<uint8_t> decompressed(sizeof(FieldSize) + payload.raw_size);
+            if (!DecompressPayload(payload, decompressed.data())) [[unlikely]] {
+                return false;
             }
-        } else if (IsPrimitiveType(type)) {
-            switch (type) {
-                // Primitives
-                case DataType::Boolean:
-                case DataType::UInt8:
-                case DataType::Int8:
-                    if (!ReadData<int8_t>(read_ptr, buff_end, entry.value.v_int8)) [[unlikely]] {
-                        errors = true;
-                    }
-                    break;
-                case DataType::Float16:
-                case DataType::UInt16:
-                case DataType::Int16:
-                    if (!ReadData<int16_t>(read_ptr, buff_end, entry.value.v_int16)) [[unlikely]] {
-                        errors = true;
-                    }
-                    break;
-                case DataType::Float32:
-                case DataType::UInt32:
-                case DataType::Int32:
-                    if (!ReadData<int32_t>(read_ptr, buff_end, entry.value.v_int32)) [[unlikely]] {
-                        errors = true;
-                    }
-                    break;
-                case DataType::Float64:
-                case DataType::UInt64:
-                case DataType::Int64:
-                    if (!ReadData<int64_t>(read_ptr, buff_end, entry.value.v_int64)) [[unlikely]] {
-                        errors = true;
-                    }
-                    break;
-                case DataType::UUID:
-                    entry.value.ptr = read_ptr;
-
-                    if (!CanAccessBuffer(read_ptr, buff_end, 16)) [[unlikely]] {
-                        errors = true;
-                    } else {
-                        read_ptr += 16;
-                    }
-                    break;
-                case DataType::String: {
-                    entry.value.ptr = read_ptr;
+            return ValidateValue<name_based>(CacheEntry{.type = payload.type, .value = {.ptr = decompressed.data()}}, depth);
+        }
+        default:
+            return data_size % DataTypeSize(BaseDataType(type)) == 0;
+    }
+}
 
-                    uint16_t length;
-                    if (!ReadData<uint16_t>(read_ptr, buff_end, length)) [[unlikely]] {
-                        errors = true;
-                    } else {
-                        read_ptr += length;
-                    }
+template <bool name_based>
+static bool ValidateFields(const uint8_t* read_ptr, const uint8_t* buff_end, uint32_t depth) noexcept {
+    if (depth > Reader::MAX_VALIDATION_DEPTH) [[unlikely]] {
+        return false;
+    }
 
-                    break;
-                }
-                case DataType::Object:
-                case DataType::Binary: {
-                    entry.value.ptr = read_ptr;
+    ParsedField field;
+    while (read_ptr < buff_end) {
+        if (!ParseFieldImpl<false, name_based>(read_ptr, buff_end, field)) [[unlikely]] {
+            return false;
+        }
+
+        const DataType type = field.entry.type;
+        if (type != DataType::Object && !IsArrayType(type) && !IsEncodedArrayType(type) && !IsCompressedType(type)) {
+            continue;
+        }
+
+        if (!ValidateValue<name_based>(field.entry, depth)) [[unlikely]] {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <TagMode Mode>
+bool BasicReader<Mode>::Validate() const noexcept {
+    const ObjectReader& root = m_root_object;
+    if (root.m_buffer == nullptr || (root.m_cache_built && !root.m_is_valid)) [[unlikely]] {
+        return false;
+    }
+
+    const uint8_t* read_ptr = static_cast<const uint8_t*>(root.m_buffer);
+    return root.m_name_based ? ValidateFields<true>(read_ptr, read_ptr + root.m_size, 0) : ValidateFields<false>(read_ptr, read_ptr + root.m_size, 0);
+}
+
+template <TagMode Mode>
+bool BasicReader<Mode>::Validate(const void* buffer, size_t size, bool name_based) noexcept {
+    if (buffer == nullptr || size < sizeof(FieldSize)) [[unlikely]] {
+        return false;
+    }
+
+    FieldSize root_size;
+    std::memcpy(&root_size, buffer, sizeof(root_size));
+    AdjustEndianess(root_size);
+
+    // Same rules as the root ObjectReader, which treats an empty root as invalid
+    if (root_size == 0 || root_size > size - sizeof(FieldSize)) [[unlikely]] {
+        return false;
+    }
+
+    const uint8_t* read_ptr = static_cast<const uint8_t*>(buffer) + sizeof(FieldSize);
+    return name_based ? ValidateFields<true>(read_ptr, read_ptr + root_size, 0) : ValidateFields<false>(read_ptr, read_ptr + root_size, 0);
+}
+
+// ---------------------------------
+// Document index
+// ---------------------------------
+
+void DocumentIndex::Clear() noexcept {
+    m_objects.clear();
+    m_fields.clear();
+    m_table.clear();
+}
+
+bool DocumentIndex::Build(const void* buffer, size_t size, bool name_based, bool trusted) noexcept {
+    Clear();
+    m_base = static_cast<const uint8_t*>(buffer);
+    m_name_based = name_based;
+    m_trusted = trusted;
+
+    if (buffer == nullptr || size < sizeof(FieldSize)) [[unlikely]] {
+        m_objects.push_back({.offset = 0, .size = 0, .first_field = 0, .field_count = 0, .table_offset = 0, .table_mask = 0, .valid = false});
+        return false;
+    }
+
+    // Sized for typical field and object sizes up to a small cap, past which the arrays grow
+    // geometrically. The byte size says little about the field count of a document holding large
+    // blobs, and a monotonic resource never gets an overestimate back.
+    m_fields.reserve(std::min<size_t>(size / 16, INITIAL_FIELD_CAPACITY));
+    m_objects.reserve(std::min<size_t>(size / 64, INITIAL_OBJECT_CAPACITY));
+
+    AddObject(buffer);
+    if (m_objects[0].size + sizeof(FieldSize) > size) [[unlikely]] {
+        return false;
+    }
+
+    if (name_based) {
+        trusted ? IndexObjects<true, true>() : IndexObjects<false, true>();
+    } else {
+        trusted ? IndexObjects<true, false>() : IndexObjects<false, false>();
+    }
+
+    return m_objects[0].valid;
+}
+
+template <bool trusted, bool name_based>
+void DocumentIndex::IndexObjects() noexcept {
+    // Indexing an object appends its nested objects, so the object list doubles as a breadth
+    // first work queue and nesting depth is not limited by the stack
+    for (uint32_t object = 0; object < ObjectCount(); ++object) {
+        IndexObject<trusted, name_based>(object);
+    }
+}
+
+uint32_t DocumentIndex::AddObject(const void* object_ptr) noexcept {
+    FieldSize object_size;
+    std::memcpy(&object_size, object_ptr, sizeof(FieldSize));
+    AdjustEndianess(object_size);
+
+    m_objects.push_back({
+        .offset = static_cast<uint32_t>(static_cast<const uint8_t*>(object_ptr) + sizeof(FieldSize) - m_base),
+        .size = object_size,
+        .first_field = 0,
+        .field_count = 0,
+        .table_offset = 0,
+        .table_mask = 0,
+        .valid = false,
+    });
+
+    return static_cast<uint32_t>(m_objects.size() - 1);
+}
 
-                    FieldSize size;
-                    if (!ReadData<FieldSize>(read_ptr, buff_end, size)) [[unlikely]] {
-                        errors = true;
-                    } else {
-                        read_ptr += size;
-                    }
+uint32_t DocumentIndex::AddArrayElements(const void* array_ptr, DataType array_type) noexcept {
+    const uint32_t first_object = ObjectCount();
 
+    const uint8_t* read_ptr;
+    const uint8_t* buff_end;
+    uint32_t count;
+    if (!LocateElements(array_type, array_ptr, read_ptr, buff_end, count)) [[unlikely]] {
+        return CacheEntry::NO_OBJECT;
+    }
+
+    while (read_ptr < buff_end) {
+        const uint8_t* element_ptr = read_ptr;
+
+        FieldSize element_size;
+        if (!ReadData<FieldSize>(read_ptr, buff_end, element_size) || !CanAccessBuffer(read_ptr, buff_end, element_size)) [[unlikely]] {
+            // Malformed arrays are left to ObjectArrayReader, which reports them as invalid
+            m_objects.resize(first_object);
+            return CacheEntry::NO_OBJECT;
+        }
+
+        read_ptr += element_size;
+        AddObject(element_ptr);
+    }
+
+    return first_object;
+}
+
+template <bool trusted, bool name_based>
+void DocumentIndex::IndexObject(uint32_t object) noexcept {
+    const uint8_t* read_ptr = ObjectData(object);
+    const uint8_t* buff_end = read_ptr + m_objects[object].size;
+
+    if (read_ptr == buff_end) [[unlikely]] {
+        return;
+    }
+
+    const uint32_t first_field = FieldCount();
+    const uint32_t first_nested_object = ObjectCount();
+
+    ParsedField parsed;
+    while (read_ptr < buff_end) {
+        if (!ParseFieldImpl<trusted, name_based>(read_ptr, buff_end, parsed)) [[unlikely]] {
+            m_fields.resize(first_field);
+            m_objects.resize(first_nested_object);
+            return;
+        }
+
+        Field field = {
+            .value = parsed.entry.value,
+            .key = name_based ? TagLookupHash(ParsedTagName(parsed)) : ParsedTagId(parsed),
+            .object = CacheEntry::NO_OBJECT,
+            .name_offset = static_cast<uint32_t>(parsed.tag_ptr - m_base),
+            .type = parsed.entry.type,
+            .name_size = parsed.tag_size,
+            .duplicate = false,
+        };
+
+        // Nested objects are queued here and indexed after the objects already in the list
+        if (field.type == DataType::Object) {
+            field.object = AddObject(field.value.ptr);
+        } else if (PlainArrayType(field.type) == DataType::ObjectArray) {
+            field.object = AddArrayElements(field.value.ptr, field.type);
+        }
+
+        m_fields.push_back(field);
+    }
+
+    Object& range = m_objects[object];
+    range.first_field = first_field;
+    range.field_count = FieldCount() - first_field;
+    range.valid = true;
+    BuildLookup(range);
+}
+
+void DocumentIndex::BuildLookup(Object& object) noexcept {
+    Field* fields = m_fields.data() + object.first_field;
+
+    if (object.field_count <= LINEAR_SCAN_LIMIT) {
+        for (uint32_t i = 1; i < object.field_count; ++i) {
+            for (uint32_t j = 0; j < i; ++j) {
+                if (fields[j].key == fields[i].key && FieldName(fields[j]) == FieldName(fields[i])) {
+                    fields[i].duplicate = true;
                     break;
                 }
-                default:
-                    errors = true;
-                    break;
             }
-        } else {
-            errors = true;
         }
+        return;
+    }
 
-        // If there is an error stop parsing
+    const uint32_t capacity = std::bit_ceil(object.field_count * 2);
+    object.table_offset = static_cast<uint32_t>(m_table.size());
+    object.table_mask = capacity - 1;
+    m_table.resize(m_table.size() + capacity, 0);
 
-        if (errors || read_ptr > buff_end) [[unlikely]] {
-            errors = true;
-            break;
-        }
+    uint32_t* table = m_table.data() + object.table_offset;
+    for (uint32_t position = 0; position < object.field_count; ++position) {
+        const Field& field = fields[position];
 
-        // Add tag to cache
+        for (uint32_t i = SlotIndex(field.key, object.table_mask);; i = (i + 1) & object.table_mask) {
+            if (table[i] == 0) {
+                table[i] = position + 1;
+                break;
+            }
 
-        if (m_name_based) {
-            std::string_view tag_name(reinterpret_cast<const char*>(tag_ptr), tag_size);
-            m_name_cache.emplace(tag_name, entry);
-        } else {
-            DataTag::Id tag_id;
-            std::memcpy(&tag_id, tag_ptr, sizeof(tag_id));
-            AdjustEndianess(tag_id);
-            m_id_cache.emplace(tag_id, entry);
+            // Duplicated tags keep their first occurrence
+            const Field& other = fields[table[i] - 1];
+            if (other.key == field.key && FieldName(other) == FieldName(field)) {
+                fields[position].duplicate = true;
+                break;
+            }
         }
     }
+}
+
+// ---------------------------------
+// Cache management
+// ---------------------------------
+
+void ObjectReader::CreateCache(uint32_t initial_size) const noexcept {
+    if (m_cache_built) [[likely]] {
+        return;
+    }
+
+    if (m_scan_ptr == m_buffer) {
+        m_index.Reset(initial_size);
+    }
 
+    if (m_name_based) {
+        m_is_valid = m_trusted ? IndexFields<true, true>() : IndexFields<false, true>();
+    } else {
+        m_is_valid = m_trusted ? IndexFields<true, false>() : IndexFields<false, false>();
+    }
     m_cache_built = true;
-    m_is_valid = !errors && read_ptr == buff_end;
 }
 
-[[gnu::always_inline]]
-inline bool ObjectReader::FindTag(const DataTag& tag, CacheEntry& out_entry) const noexcept {
-    if (!IsValid()) [[unlikely]] {
-        return false;
+template <bool trusted, bool name_based>
+bool ObjectReader::IndexFields() const noexcept {
+    const uint8_t* buff_end = static_cast<const uint8_t*>(m_buffer) + m_size;
+
+    ParsedField field;
+    while (m_scan_ptr < buff_end) {
+        if (!ParseFieldImpl<trusted, name_based>(m_scan_ptr, buff_end, field)) [[unlikely]] {
+            return false;
+        }
+
+        IndexField<name_based>(m_index, field);
     }
 
+    return true;
+}
+
+uint32_t ObjectReader::ScanToTag(const DataTag& tag, uint32_t max_fields) const noexcept {
     if (m_name_based) {
-        auto it = m_name_cache.find(tag.GetName());
-        if (it != m_name_cache.end()) [[likely]] {
-            out_entry = it->second;
-            return true;
+        return m_trusted ? ScanFieldsToTag<true, true>(tag, max_fields) : ScanFieldsToTag<false, true>(tag, max_fields);
+    }
+    return m_trusted ? ScanFieldsToTag<true, false>(tag, max_fields) : ScanFieldsToTag<false, false>(tag, max_fields);
+}
+
+template <bool trusted, bool name_based>
+uint32_t ObjectReader::ScanFieldsToTag(const DataTag& tag, uint32_t max_fields) const noexcept {
+    const uint8_t* buff_end = static_cast<const uint8_t*>(m_buffer) + m_size;
+
+    ParsedField field;
+    for (; m_scan_ptr < buff_end && max_fields > 0; --max_fields) {
+        if (!ParseFieldImpl<trusted, name_based>(m_scan_ptr, buff_end, field)) [[unlikely]] {
+            m_cache_built = true;
+            m_is_valid = false;
+            return FieldIndex::NOT_FOUND;
         }
-    } else {
-        auto it = m_id_cache.find(tag.GetId());
-        if (it != m_id_cache.end()) [[likely]] {
-            out_entry = it->second;
-            return true;
+
+        // The requested tag already carries its hash, so only other names are hashed here
+        bool matches;
+        bool inserted;
+        if constexpr (name_based) {
+            std::string_view name = ParsedTagName(field);
+            matches = name == tag.GetName();
+            inserted = m_index.Insert(name, matches ? tag.GetHash() : TagLookupHash(name), field.entry);
+        } else {
+            DataTag::Id id = ParsedTagId(field);
+            matches = id == tag.GetId();
+            inserted = m_index.Insert(id, field.entry);
+        }
+
+        // Duplicated tags are not inserted, their first occurrence is already indexed
+        if (matches && inserted) {
+            return m_index.Size() - 1;
         }
     }
 
-    return false;
+    if (m_scan_ptr >= buff_end) {
+        m_cache_built = true;
+        m_is_valid = true;
+    }
+
+    return FieldIndex::NOT_FOUND;
+}
+
+bool ObjectReader::FindTag(const DataTag& tag, CacheEntry& out_entry) const noexcept {
+    if (m_document != nullptr) {
+        return m_document->Find(m_object, tag, m_cursor, out_entry);
+    }
+
+    // A lazy reader only knows the object is malformed once a scan has reached the bad field
+    if ((m_index_mode != IndexMode::Lazy || m_cache_built) && !IsValid()) [[unlikely]] {
+        return false;
+    }
+
+    const bool cursor_matches = m_name_based ? m_index.Matches(m_cursor, tag.GetName(), tag.GetHash()) : m_index.Matches(m_cursor, tag.GetId());
+    if (cursor_matches) [[likely]] {
+        return m_index.EntryAt(m_cursor++, out_entry);
+    }
+
+    uint32_t position = FieldIndex::NOT_FOUND;
+
+    // At the lazy scan frontier the next field in wire order has not been parsed yet
+    if (m_cursor == m_index.Size() && !m_cache_built) {
+        position = ScanToTag(tag, 1);
+    }
+
+    if (position == FieldIndex::NOT_FOUND) {
+        if (m_cache_built && !m_is_valid) [[unlikely]] {
+            return false;
+        }
+        position = m_name_based ? m_index.Find(tag.GetName(), tag.GetHash()) : m_index.Find(tag.GetId());
+    }
+
+    if (position == FieldIndex::NOT_FOUND && !m_cache_built) {
+        position = ScanToTag(tag);
+    }
+
+    if (position == FieldIndex::NOT_FOUND) {
+        return false;
+    }
+
+    m_cursor = position + 1;
+    return m_index.EntryAt(position, out_entry);
 }
 
 // ---------------------------------
@@ -370,17 +987,180 @@ std::vector<DataTag> ObjectReader::GetAllTags() const noexcept {
         return tags;
     }
 
+    auto add_tag = [&tags](const DataTag& tag, const CacheEntry&) {
+        tags.push_back(tag);
+    };
+
+    if (m_document != nullptr) {
+        tags.reserve(m_document->GetObject(m_object).field_count);
+        m_document->ForEach(m_object, add_tag);
+    } else {
+        tags.reserve(m_index.Size());
+        m_index.ForEach(m_name_based, add_tag);
+    }
+
+    return tags;
+}
+
+// ---------------------------------
+// Field iteration
+// ---------------------------------
+
+FieldIterator::FieldIterator(const void* fields, FieldSize size, bool name_based, bool trusted) noexcept
+    : m_read_ptr(static_cast<const uint8_t*>(fields)),
+      m_end_ptr(static_cast<const uint8_t*>(fields) + size),
+      m_name_based(name_based),
+      m_trusted(trusted) {
+    m_field.m_name_based = name_based;
+    m_field.m_trusted = trusted;
+    Advance();
+}
+
+void FieldIterator::Advance() noexcept {
+    if (m_done) [[unlikely]] {
+        return;
+    }
+
+    if (m_read_ptr >= m_end_ptr) {
+        m_done = true;
+        return;
+    }
+
+    const uint8_t* field_begin = m_read_ptr;
+
+    ParsedField field;
+    if (!ParseField(m_read_ptr, m_end_ptr, m_name_based, m_trusted, field)) [[unlikely]] {
+        m_done = true;
+        m_malformed = true;
+        return;
+    }
+
+    m_field.m_begin = field_begin;
+    m_field.m_end = m_read_ptr;
+    m_field.m_entry = field.entry;
+
     if (m_name_based) {
-        for (const auto& [key, entry] : m_name_cache) {
-            tags.emplace_back(key);
-        }
+        m_field.m_name = reinterpret_cast<const char*>(field.tag_ptr);
+        m_field.m_name_size = field.tag_size;
     } else {
-        for (const auto& [key, entry] : m_id_cache) {
-            tags.emplace_back(key);
+        m_field.m_id = ParsedTagId(field);
+    }
+}
+
+std::optional<ObjectReader> FieldView::AsObject(IndexMode index_mode, std::pmr::memory_resource* resource) const noexcept {
+    if (m_entry.type != DataType::Object) {
+        return std::nullopt;
+    }
+    return std::make_optional<ObjectReader>(m_entry.value.ptr, m_name_based, index_mode, resource, m_trusted);
+}
+
+std::optional<StringArrayReader> FieldView::AsStringArray() const noexcept {
+    if (PlainArrayType(m_entry.type) != DataType::StringArray) {
+        return std::nullopt;
+    }
+    return std::make_optional<StringArrayReader>(m_entry, m_trusted);
+}
+
+std::optional<BinaryArrayReader> FieldView::AsBinaryArray() const noexcept {
+    if (PlainArrayType(m_entry.type) != DataType::BinaryArray) {
+        return std::nullopt;
+    }
+    return std::make_optional<BinaryArrayReader>(m_entry, m_trusted);
+}
+
+std::optional<ObjectArrayReader> FieldView::AsObjectArray(IndexMode index_mode, std::pmr::memory_resource* resource) const noexcept {
+    if (PlainArrayType(m_entry.type) != DataType::ObjectArray) {
+        return std::nullopt;
+    }
+    return std::make_optional<ObjectArrayReader>(m_entry, m_name_based, index_mode, resource, nullptr, m_trusted);
+}
+
+FieldRange ObjectReader::Fields() const noexcept {
+    if (m_buffer == nullptr || (m_cache_built && !m_is_valid)) [[unlikely]] {
+        return FieldRange(nullptr, 0, m_name_based);
+    }
+    return FieldRange(m_buffer, m_size, m_name_based, m_trusted);
+}
+
+bool ObjectReader::ElementRange(const CacheEntry& entry, const uint8_t*& out_begin, const uint8_t*& out_end) noexcept {
+    uint32_t count;
+    return LocateElements(entry.type, entry.value.ptr, out_begin, out_end, count);
+}
+
+bool ObjectReader::NextElement(const uint8_t*& read_ptr, const uint8_t* end_ptr, const void*& out_fields, FieldSize& out_size) noexcept {
+    if (!ReadData<FieldSize>(read_ptr, end_ptr, out_size) || !CanAccessBuffer(read_ptr, end_ptr, out_size)) [[unlikely]] {
+        return false;
+    }
+
+    out_fields = read_ptr;
+    read_ptr += out_size;
+
+    return true;
+}
+
+// ---------------------------------
+// Batch read
+// ---------------------------------
+
+uint64_t ObjectReader::MatchFields(const DataTag* const* tags, uint32_t count, CacheEntry* out_entries, bool& out_valid) const noexcept {
+    uint64_t found = 0;
+
+    // An index that is already built answers every lookup without parsing the object again
+    if (m_document != nullptr || m_cache_built) {
+        out_valid = IsValid();
+        if (out_valid) {
+            for (uint32_t i = 0; i < count; ++i) {
+                if (FindTag(*tags[i], out_entries[i])) {
+                    found |= uint64_t(1) << i;
+                }
+            }
         }
+        return found;
     }
 
-    return tags;
+    const uint64_t all = count == 64 ? ~uint64_t(0) : (uint64_t(1) << count) - 1;
+
+    const uint8_t* read_ptr = static_cast<const uint8_t*>(m_buffer);
+    const uint8_t* buff_end = read_ptr + m_size;
+
+    // Bindings usually follow the wire order, so the search starts after the last match
+    uint32_t next = 0;
+
+    ParsedField field;
+    while (read_ptr < buff_end && found != all) {
+        if (!ParseField(read_ptr, buff_end, m_name_based, m_trusted, field)) [[unlikely]] {
+            out_valid = false;
+            return 0;
+        }
+
+        std::string_view name;
+        DataTag::Id id = DataTag::INVALID_ID;
+        if (m_name_based) {
+            name = ParsedTagName(field);
+        } else {
+            id = ParsedTagId(field);
+        }
+
+        uint32_t i = next;
+        for (uint32_t n = 0; n < count; ++n, i = (i + 1 == count) ? 0 : i + 1) {
+            const uint64_t bit = uint64_t(1) << i;
+
+            // Duplicated tags keep their first occurrence
+            if ((found & bit) != 0) {
+                continue;
+            }
+
+            if (m_name_based ? tags[i]->GetName() == name : tags[i]->GetId() == id) {
+                out_entries[i] = field.entry;
+                found |= bit;
+                next = (i + 1 == count) ? 0 : i + 1;
+                break;
+            }
+        }
+    }
+
+    out_valid = true;
+    return found;
 }
 
 // ---------------------------------
@@ -406,6 +1186,24 @@ inline const void* ObjectReader::ReadPointerData(const DataTag& tag, DataType ex
         return nullptr;
     }
 
+    return EntryData(entry, out_size);
+}
+
+void ObjectReader::ConvertFloat16(const void* data, float* out, size_t count) noexcept {
+    if constexpr (NEEDS_BYTE_SWAP) {
+        constexpr size_t BLOCK_LENGTH = 512;
+        uint16_t block[BLOCK_LENGTH];
+        for (size_t i = 0; i < count; i += BLOCK_LENGTH) {
+            size_t length = std::min(BLOCK_LENGTH, count - i);
+            CopyArrayEndianess<sizeof(uint16_t)>(block, static_cast<const uint16_t*>(data) + i, length);
+            HalfToFloatArray(block, out + i, length);
+        }
+    } else {
+        HalfToFloatArray(static_cast<const uint16_t*>(data), out, count);
+    }
+}
+
+const void* ObjectReader::EntryData(const CacheEntry& entry, FieldSize& out_size) noexcept {
     const uint8_t* value_ptr = static_cast<const uint8_t*>(entry.value.ptr);
 
     std::memcpy(&out_size, value_ptr, sizeof(out_size));
@@ -447,6 +1245,14 @@ bool ObjectReader::ReadUInt64(const DataTag& tag, uint64_t& out_value) const noe
     return ReadPrimitive<uint64_t, DataType::UInt64>(tag, out_value);
 }
 
+bool ObjectReader::ReadVarInt64(const DataTag& tag, int64_t& out_value) const noexcept {
+    return ReadPrimitive<int64_t, DataType::VarInt64>(tag, out_value);
+}
+
+bool ObjectReader::ReadVarUInt64(const DataTag& tag, uint64_t& out_value) const noexcept {
+    return ReadPrimitive<uint64_t, DataType::VarUInt64>(tag, out_value);
+}
+
 bool ObjectReader::ReadBoolean(const DataTag& tag, bool& out_value) const noexcept {
     return ReadPrimitive<bool, DataType::Boolean>(tag, out_value);
 }
@@ -491,7 +1297,54 @@ std::optional<ObjectReader> ObjectReader::ReadObject(const DataTag& tag) const n
     return ReadObjectInternal(entry);
 }
 
-bool ObjectReader::ReadStringInternal(const CacheEntry& entry, std::string_view& out_value) const noexcept {
+std::optional<DataType> ObjectReader::GetCompressedType(const DataTag& tag) const noexcept {
+    CacheEntry entry;
+    CompressedPayload payload;
+    if (!FindTag(tag, entry) || !LocateCompressed(entry, payload)) {
+        return std::nullopt;
+    }
+    return payload.type;
+}
+
+std::optional<ObjectReader> ObjectReader::ReadCompressed(const DataTag& tag, std::vector<uint8_t>& scratch) const noexcept {
+    CacheEntry entry;
+    CompressedPayload payload;
+    if (!FindTag(tag, entry) || !LocateCompressed(entry, payload)) {
+        return std::nullopt;
+    }
+
+    // [Object size] [Type] [Tag] [Size] [Decompressed data]
+    const size_t tag_size = m_name_based ? sizeof(DataTag::NameSize) + tag.GetName().size() : sizeof(DataTag::Id);
+    const size_t field_size = sizeof(DataType) + tag_size + sizeof(FieldSize) + payload.raw_size;
+    scratch.resize(sizeof(FieldSize) + field_size);
+
+    uint8_t* write_ptr = scratch.data();
+    FieldSize object_size = static_cast<FieldSize>(field_size);
+    AdjustEndianess(object_size);
+    std::memcpy(write_ptr, &object_size, sizeof(object_size));
+    write_ptr += sizeof(object_size);
+
+    *write_ptr++ = static_cast<uint8_t>(payload.type);
+    if (m_name_based) {
+        *write_ptr++ = static_cast<DataTag::NameSize>(tag.GetName().size());
+        std::memcpy(write_ptr, tag.GetName().data(), tag.GetName().size());
+    } else {
+        DataTag::Id id = tag.GetId();
+        AdjustEndianess(id);
+        std::memcpy(write_ptr, &id, sizeof(id));
+    }
+    write_ptr = scratch.data() + sizeof(FieldSize) + sizeof(DataType) + tag_size;
+
+    if (!DecompressPayload(payload, write_ptr)) [[unlikely]] {
+        return std::nullopt;
+    }
+
+    // A validated buffer had the wrapped field validated too
+    const IndexMode index_mode = m_index_mode == IndexMode::Document ? IndexMode::Eager : m_index_mode;
+    return std::make_optional<ObjectReader>(scratch.data(), m_name_based, index_mode, GetMemoryResource(), m_trusted);
+}
+
+bool ObjectReader::ReadStringInternal(const CacheEntry& entry, std::string_view& out_value) noexcept {
     if (entry.type != DataType::String) [[unlikely]] {
         return false;
     }
@@ -512,7 +1365,48 @@ std::optional<ObjectReader> ObjectReader::ReadObjectInternal(const CacheEntry& e
     if (entry.type != DataType::Object) [[unlikely]] {
         return std::nullopt;
     }
-    return std::make_optional<ObjectReader>(entry.value.ptr, m_name_based);
+    if (m_document != nullptr && entry.object != CacheEntry::NO_OBJECT) {
+        return std::make_optional<ObjectReader>(*m_document, entry.object);
+    }
+
+    return std::make_optional<ObjectReader>(entry.value.ptr, m_name_based, m_index_mode, GetMemoryResource(), m_trusted);
+}
+
+// ---------------------------------
+// Byte order conversion
+// ---------------------------------
+
+// Each field is converted once per reader, reading it again returns the same block
+const void* ObjectReader::ConvertToHostOrder(const void* data, size_t count, uint32_t element_size) const noexcept {
+    const size_t size = sizeof(ConvertedBlock) + count * element_size;
+    for (ConvertedBlock* block = m_converted; block != nullptr; block = block->next) {
+        if (block->source == data && block->size == size) {
+            return block + 1;
+        }
+    }
+
+    ConvertedBlock* block = static_cast<ConvertedBlock*>(GetMemoryResource()->allocate(size, alignof(ConvertedBlock)));
+    block->next = m_converted;
+    block->source = data;
+    block->size = size;
+    m_converted = block;
+
+    void* converted = block + 1;
+    switch (element_size) {
+        case 2:
+            CopyArrayEndianess<2>(converted, data, count);
+            break;
+        case 4:
+            CopyArrayEndianess<4>(converted, data, count);
+            break;
+        case 8:
+            CopyArrayEndianess<8>(converted, data, count);
+            break;
+        default:
+            std::memcpy(converted, data, count * element_size);
+            break;
+    }
+    return converted;
 }
 
 // ---------------------------------
@@ -535,7 +1429,7 @@ inline const Type* ObjectReader::ReadArray(const DataTag& tag, uint32_t& out_len
         }
 
         out_length = array_length;
-        return reinterpret_cast<const Type*>(value_ptr);
+        return static_cast<const Type*>(HostOrderData<sizeof(Type)>(value_ptr, array_length));
     }
 
     out_length = 0;
@@ -592,26 +1486,138 @@ const double* ObjectReader::ReadFloat64Array(const DataTag& tag, uint32_t& out_l
 
 std::optional<StringArrayReader> ObjectReader::ReadStringArray(const DataTag& tag) const noexcept {
     CacheEntry entry;
-    if (!FindTag(tag, entry) || entry.type != DataType::StringArray) {
+    if (!FindTag(tag, entry) || PlainArrayType(entry.type) != DataType::StringArray) {
+        return std::nullopt;
+    }
+    return std::make_optional<StringArrayReader>(entry, m_trusted, GetMemoryResource());
+}
+
+std::optional<PackedBooleanArrayReader> ObjectReader::ReadPackedBooleanArray(const DataTag& tag) const noexcept {
+    CacheEntry entry;
+    if (!FindTag(tag, entry) || entry.type != DataType::PackedBooleanArray) {
+        return std::nullopt;
+    }
+    return std::make_optional<PackedBooleanArrayReader>(entry);
+}
+
+std::optional<VarintArrayReader> ObjectReader::ReadVarInt64Array(const DataTag& tag) const noexcept {
+    CacheEntry entry;
+    if (!FindTag(tag, entry) || entry.type != DataType::VarInt64Array) {
+        return std::nullopt;
+    }
+    return std::make_optional<VarintArrayReader>(entry);
+}
+
+std::optional<VarintArrayReader> ObjectReader::ReadVarUInt64Array(const DataTag& tag) const noexcept {
+    CacheEntry entry;
+    if (!FindTag(tag, entry) || entry.type != DataType::VarUInt64Array) {
+        return std::nullopt;
+    }
+    return std::make_optional<VarintArrayReader>(entry);
+}
+
+std::optional<uint32_t> ObjectReader::ReadVarInt64Array(const DataTag& tag, std::span<int64_t> out) const noexcept {
+    std::optional<VarintArrayReader> array = ReadVarInt64Array(tag);
+    if (!array || !array->Decode(out)) {
+        return std::nullopt;
+    }
+    return array->Size();
+}
+
+std::optional<uint32_t> ObjectReader::ReadVarUInt64Array(const DataTag& tag, std::span<uint64_t> out) const noexcept {
+    std::optional<VarintArrayReader> array = ReadVarUInt64Array(tag);
+    if (!array || !array->Decode(out)) {
+        return std::nullopt;
+    }
+    return array->Size();
+}
+
+std::optional<PackedIntegerArrayReader> ObjectReader::ReadPackedInt32Array(const DataTag& tag) const noexcept {
+    CacheEntry entry;
+    if (!FindTag(tag, entry) || entry.type != DataType::PackedInt32Array) {
+        return std::nullopt;
+    }
+    return std::make_optional<PackedIntegerArrayReader>(entry);
+}
+
+std::optional<PackedIntegerArrayReader> ObjectReader::ReadPackedInt64Array(const DataTag& tag) const noexcept {
+    CacheEntry entry;
+    if (!FindTag(tag, entry) || entry.type != DataType::PackedInt64Array) {
+        return std::nullopt;
+    }
+    return std::make_optional<PackedIntegerArrayReader>(entry);
+}
+
+std::optional<PackedIntegerArrayReader> ObjectReader::ReadPackedUInt32Array(const DataTag& tag) const noexcept {
+    CacheEntry entry;
+    if (!FindTag(tag, entry) || entry.type != DataType::PackedUInt32Array) {
+        return std::nullopt;
+    }
+    return std::make_optional<PackedIntegerArrayReader>(entry);
+}
+
+std::optional<PackedIntegerArrayReader> ObjectReader::ReadPackedUInt64Array(const DataTag& tag) const noexcept {
+    CacheEntry entry;
+    if (!FindTag(tag, entry) || entry.type != DataType::PackedUInt64Array) {
+        return std::nullopt;
+    }
+    return std::make_optional<PackedIntegerArrayReader>(entry);
+}
+
+std::optional<uint32_t> ObjectReader::ReadPackedInt32Array(const DataTag& tag, std::span<int32_t> out) const noexcept {
+    std::optional<PackedIntegerArrayReader> array = ReadPackedInt32Array(tag);
+    if (!array || !array->Decode(out)) {
+        return std::nullopt;
+    }
+    return array->Size();
+}
+
+std::optional<uint32_t> ObjectReader::ReadPackedInt64Array(const DataTag& tag, std::span<int64_t> out) const noexcept {
+    std::optional<PackedIntegerArrayReader> array = ReadPackedInt64Array(tag);
+    if (!array || !array->Decode(out)) {
+        return std::nullopt;
+    }
+    return array->Size();
+}
+
+std::optional<uint32_t> ObjectReader::ReadPackedUInt32Array(const DataTag& tag, std::span<uint32_t> out) const noexcept {
+    std::optional<PackedIntegerArrayReader> array = ReadPackedUInt32Array(tag);
+    if (!array || !array->Decode(out)) {
+        return std::nullopt;
+    }
+    return array->Size();
+}
+
+std::optional<uint32_t> ObjectReader::ReadPackedUInt64Array(const DataTag& tag, std::span<uint64_t> out) const noexcept {
+    std::optional<PackedIntegerArrayReader> array = ReadPackedUInt64Array(tag);
+    if (!array || !array->Decode(out)) {
+        return std::nullopt;
+    }
+    return array->Size();
+}
+
+std::optional<DictionaryStringArrayReader> ObjectReader::ReadDictionaryStringArray(const DataTag& tag) const noexcept {
+    CacheEntry entry;
+    if (!FindTag(tag, entry) || entry.type != DataType::DictionaryStringArray) {
         return std::nullopt;
     }
-    return std::make_optional<StringArrayReader>(entry);
+    return std::make_optional<DictionaryStringArrayReader>(entry);
 }
 
 std::optional<BinaryArrayReader> ObjectReader::ReadBinaryArray(const DataTag& tag) const noexcept {
     CacheEntry entry;
-    if (!FindTag(tag, entry) || entry.type != DataType::BinaryArray) {
+    if (!FindTag(tag, entry) || PlainArrayType(entry.type) != DataType::BinaryArray) {
         return std::nullopt;
     }
-    return std::make_optional<BinaryArrayReader>(entry);
+    return std::make_optional<BinaryArrayReader>(entry, m_trusted, GetMemoryResource());
 }
 
 std::optional<ObjectArrayReader> ObjectReader::ReadObjectArray(const DataTag& tag) const noexcept {
     CacheEntry entry;
-    if (!FindTag(tag, entry) || entry.type != DataType::ObjectArray) {
+    if (!FindTag(tag, entry) || PlainArrayType(entry.type) != DataType::ObjectArray) {
         return std::nullopt;
     }
-    return std::make_optional<ObjectArrayReader>(entry, m_name_based);
+    return std::make_optional<ObjectArrayReader>(entry, m_name_based, m_index_mode, GetMemoryResource(), m_document, m_trusted);
 }
 
 // ---------------------------------
@@ -666,6 +1672,23 @@ std::span<const uint16_t> ObjectReader::ReadFloat16Array(const DataTag& tag) con
     return ReadArray<uint16_t, DataType::Float16Array>(tag);
 }
 
+std::optional<uint32_t> ObjectReader::ReadFloat16Array(const DataTag& tag, std::span<float> out) const noexcept {
+    CacheEntry entry;
+    if (!FindTag(tag, entry) || entry.type != DataType::Float16Array) {
+        return std::nullopt;
+    }
+
+    FieldSize size;
+    const void* data = EntryData(entry, size);
+    if (size % sizeof(uint16_t) != 0 || size / sizeof(uint16_t) > out.size()) [[unlikely]] {
+        return std::nullopt;
+    }
+
+    const uint32_t length = size / sizeof(uint16_t);
+    ConvertFloat16(data, out.data(), length);
+    return length;
+}
+
 std::span<const float> ObjectReader::ReadFloat32Array(const DataTag& tag) const noexcept {
     return ReadArray<float, DataType::Float32Array>(tag);
 }
@@ -686,7 +1709,17 @@ inline Type* ObjectReader::ReadVector(const DataTag& tag, DataType type) const n
     if (!FindTag(tag, entry) || entry.type != type) {
         return nullptr;
     }
-    return reinterpret_cast<Type*>(const_cast<void*>(entry.value.ptr));
+    return static_cast<Type*>(const_cast<void*>(HostOrderData<sizeof(Type)>(entry.value.ptr, dim)));
+}
+
+template <uint32_t dim>
+bool ObjectReader::ReadVectorFloat16(const DataTag& tag, DataType type, float* out_value) const noexcept {
+    CacheEntry entry;
+    if (!FindTag(tag, entry) || entry.type != type) {
+        return false;
+    }
+    ConvertFloat16(entry.value.ptr, out_value, dim);
+    return true;
 }
 
 // Vector 2
@@ -715,6 +1748,10 @@ uint16_t* ObjectReader::ReadVector2f16(const DataTag& tag) const noexcept {
     return ReadVector<uint16_t, 2>(tag, DataType::Vector2f16);
 }
 
+bool ObjectReader::ReadVector2f16(const DataTag& tag, float* out_value) const noexcept {
+    return ReadVectorFloat16<2>(tag, DataType::Vector2f16, out_value);
+}
+
 float* ObjectReader::ReadVector2f32(const DataTag& tag) const noexcept {
     return ReadVector<float, 2>(tag, DataType::Vector2f32);
 }
@@ -749,6 +1786,10 @@ uint16_t* ObjectReader::ReadVector3f16(const DataTag& tag) const noexcept {
     return ReadVector<uint16_t, 3>(tag, DataType::Vector3f16);
 }
 
+bool ObjectReader::ReadVector3f16(const DataTag& tag, float* out_value) const noexcept {
+    return ReadVectorFloat16<3>(tag, DataType::Vector3f16, out_value);
+}
+
 float* ObjectReader::ReadVector3f32(const DataTag& tag) const noexcept {
     return ReadVector<float, 3>(tag, DataType::Vector3f32);
 }
@@ -783,6 +1824,10 @@ uint16_t* ObjectReader::ReadVector4f16(const DataTag& tag) const noexcept {
     return ReadVector<uint16_t, 4>(tag, DataType::Vector4f16);
 }
 
+bool ObjectReader::ReadVector4f16(const DataTag& tag, float* out_value) const noexcept {
+    return ReadVectorFloat16<4>(tag, DataType::Vector4f16, out_value);
+}
+
 float* ObjectReader::ReadVector4f32(const DataTag& tag) const noexcept {
     return ReadVector<float, 4>(tag, DataType::Vector4f32);
 }
@@ -797,9 +1842,13 @@ double* ObjectReader::ReadVector4f64(const DataTag& tag) const noexcept {
 
 template <typename ElementSizeType>
     requires std::is_integral<ElementSizeType>::value
-ArrayReader<ElementSizeType>::ArrayReader(const void* array) noexcept
-    : m_array(array) {
-    Initialize();
+ArrayReader<ElementSizeType>::ArrayReader(const CacheEntry& entry, bool trusted, std::pmr::memory_resource* resource) noexcept
+    : m_elements(nullptr), m_elements_end(nullptr), m_offset_table(nullptr), m_offsets(resource) {
+    if (trusted) {
+        Initialize<true>(entry);
+    } else {
+        Initialize<false>(entry);
+    }
 }
 
 template <typename ElementSizeType>
@@ -809,34 +1858,93 @@ bool ArrayReader<ElementSizeType>::GetElement(uint32_t index, const void*& out_p
         return false;
     }
 
-    BaseIterator it(m_array, index, false);
-    out_ptr = it.CurrentElement(size);
+    const uint8_t* element_ptr;
+    if (m_offset_table != nullptr) {
+        uint32_t offset;
+        std::memcpy(&offset, m_offset_table + index * sizeof(uint32_t), sizeof(offset));
+        AdjustEndianess(offset);
+        element_ptr = m_elements + offset;
+    } else if (index < LINEAR_ACCESS_LIMIT && m_offsets.empty()) {
+        BaseIterator it(m_elements, m_elements_end, index, false);
+        out_ptr = it.CurrentElement(size);
+        return true;
+    } else {
+        if (m_offsets.empty()) [[unlikely]] {
+            BuildOffsets();
+        }
+        element_ptr = m_elements + m_offsets[index];
+    }
+
+    if (size) {
+        std::memcpy(size, element_ptr, sizeof(ElementSizeType));
+        AdjustEndianess(*size);
+    }
+
+    out_ptr = element_ptr;
     return true;
 }
 
-static inline FieldSize GetArraySize(const void* array) noexcept {
-    const uint8_t* read_ptr = reinterpret_cast<const uint8_t*>(array);
+template <typename ElementSizeType>
+    requires std::is_integral<ElementSizeType>::value
+void ArrayReader<ElementSizeType>::PrepareRandomAccess() const noexcept {
+    if (IsValid() && m_offset_table == nullptr && m_offsets.empty() && m_element_count > 0) {
+        BuildOffsets();
+    }
+}
 
-    FieldSize array_size;
-    std::memcpy(&array_size, read_ptr, sizeof(array_size));
-    AdjustEndianess(array_size);
+// Each offset depends on the size prefix found at the previous one, so the table is built by a
+// single sequential walk. The array was validated by Initialize, so the walk needs no checks.
+template <typename ElementSizeType>
+    requires std::is_integral<ElementSizeType>::value
+void ArrayReader<ElementSizeType>::BuildOffsets() const noexcept {
+    m_offsets.resize(m_element_count);
+
+    const uint8_t* data_ptr = m_elements;
+    uint32_t* offsets = m_offsets.data();
+
+    uint32_t offset = 0;
+    for (uint32_t i = 0; i < m_element_count; ++i) {
+        offsets[i] = offset;
 
-    return array_size;
+        ElementSizeType element_size;
+        std::memcpy(&element_size, data_ptr + offset, sizeof(element_size));
+        AdjustEndianess(element_size);
+        offset += sizeof(element_size) + element_size;
+    }
 }
 
 template <typename ElementSizeType>
     requires std::is_integral<ElementSizeType>::value
-void ArrayReader<ElementSizeType>::Initialize() noexcept {
+template <bool trusted>
+void ArrayReader<ElementSizeType>::Initialize(const CacheEntry& entry) noexcept {
     m_element_count = 0;
     m_valid = false;
 
-    const uint8_t* read_ptr = static_cast<const uint8_t*>(m_array);
-    FieldSize array_size = GetArraySize(m_array);
-    read_ptr += sizeof(FieldSize);
-    const uint8_t* buff_end = read_ptr + array_size;
+    uint32_t indexed_count;
+    if (!LocateElements(entry.type, entry.value.ptr, m_elements, m_elements_end, indexed_count)) [[unlikely]] {
+        m_elements_end = m_elements;
+        Invalidate();
+        return;
+    }
+
+    // Indexed arrays store their count and offsets, so only untrusted ones are looked at further
+    if (IsIndexedArrayType(entry.type)) {
+        if (!trusted && !ValidateOffsetTable<ElementSizeType>(m_elements, m_elements_end, indexed_count)) [[unlikely]] {
+            Invalidate();
+            return;
+        }
+
+        m_offset_table = m_elements_end;
+        m_element_count = indexed_count;
+        m_valid = true;
+        return;
+    }
+
+    const uint8_t* read_ptr = m_elements;
+    const uint8_t* buff_end = m_elements_end;
 
     while (read_ptr < buff_end) {
-        if (!CanAccessBuffer(read_ptr, buff_end, sizeof(FieldSize))) {
+        if (!CanAccessBuffer<trusted>(read_ptr, buff_end, sizeof(ElementSizeType))) {
             Invalidate();
             return;
         }
@@ -846,9 +1954,9 @@ void ArrayReader<ElementSizeType>::Initialize() noexcept {
         AdjustEndianess(object_size);
         read_ptr += sizeof(object_size);
 
-        if (!CanAccessBuffer(read_ptr, buff_end, object_size)) {
+        if (!CanAccessBuffer<trusted>(read_ptr, buff_end, object_size)) {
             Invalidate();
-            break;
+            return;
         }
 
         read_ptr += object_size;
@@ -866,25 +1974,46 @@ void ArrayReader<ElementSizeType>::Initialize() noexcept {
 template class ArrayReader<uint16_t>;
 template class ArrayReader<FieldSize>;
 
-ObjectArrayReader::ObjectArrayReader(const ObjectReader::CacheEntry& entry, bool name_based) noexcept
-    : ArrayReader<FieldSize>(entry.value.ptr),
-      m_name_based(name_based) {
-    if (entry.type != DataType::ObjectArray) {
+template class BasicReader<TagMode::Runtime>;
+template class BasicReader<TagMode::Name>;
+template class BasicReader<TagMode::Id>;
+
+ObjectArrayReader::ObjectArrayReader(const CacheEntry& entry, bool name_based, IndexMode index_mode, std::pmr::memory_resource* resource,
+                                     const DocumentIndex* document, bool trusted) noexcept
+    : ArrayReader<FieldSize>(entry, trusted, resource),
+      m_name_based(name_based),
+      m_index_mode(index_mode),
+      m_trusted(trusted),
+      m_resource(resource),
+      m_document(document),
+      m_first_object(entry.object) {
+    if (PlainArrayType(entry.type) != DataType::ObjectArray) {
         Invalidate();
     }
 }
 
 std::optional<ObjectReader> ObjectArrayReader::GetElement(uint32_t index) const noexcept {
+    return GetElement(index, m_resource);
+}
+
+std::optional<ObjectReader> ObjectArrayReader::GetElement(uint32_t index, std::pmr::memory_resource* resource) const noexcept {
+    if (HasDocument()) {
+        if (!IsValid() || index >= m_element_count) {
+            return std::nullopt;
+        }
+        return std::make_optional<ObjectReader>(*m_document, m_first_object + index);
+    }
+
     const void* element_ptr;
     if (!ArrayReader<FieldSize>::GetElement(index, element_ptr)) {
         return std::nullopt;
     }
-    return std::make_optional<ObjectReader>(element_ptr, m_name_based);
+    return std::make_optional<ObjectReader>(element_ptr, m_name_based, m_index_mode, resource, m_trusted);
 }
 
-StringArrayReader::StringArrayReader(const ObjectReader::CacheEntry& entry) noexcept
-    : ArrayReader<uint16_t>(entry.value.ptr) {
-    if (entry.type != DataType::StringArray) {
+StringArrayReader::StringArrayReader(const CacheEntry& entry, bool trusted, std::pmr::memory_resource* resource) noexcept
+    : ArrayReader<uint16_t>(entry, trusted, resource) {
+    if (PlainArrayType(entry.type) != DataType::StringArray) {
         Invalidate();
     }
 }
@@ -902,9 +2031,9 @@ bool StringArrayReader::GetElement(uint32_t index, std::string_view& out_value)
     return true;
 }
 
-BinaryArrayReader::BinaryArrayReader(const ObjectReader::CacheEntry& entry) noexcept
-    : ArrayReader<FieldSize>(entry.value.ptr) {
-    if (entry.type != DataType::BinaryArray) {
+BinaryArrayReader::BinaryArrayReader(const CacheEntry& entry, bool trusted, std::pmr::memory_resource* resource) noexcept
+    : ArrayReader<FieldSize>(entry, trusted, resource) {
+    if (PlainArrayType(entry.type) != DataType::BinaryArray) {
         Invalidate();
     }
 }
@@ -913,26 +2042,290 @@ bool BinaryArrayReader::GetElement(uint32_t index, const void*& out_ptr, FieldSi
     return ArrayReader<FieldSize>::GetElement(index, out_ptr, &out_size);
 }
 
+VarintArrayReader::VarintArrayReader(const CacheEntry& entry) noexcept {
+    if (!IsVarintArrayType(entry.type) || entry.value.ptr == nullptr) {
+        return;
+    }
+
+    const uint8_t* read_ptr = static_cast<const uint8_t*>(entry.value.ptr);
+
+    FieldSize size;
+    std::memcpy(&size, read_ptr, sizeof(size));
+    AdjustEndianess(size);
+    read_ptr += sizeof(size);
+
+    uint32_t count;
+    if (size < sizeof(count)) [[unlikely]] {
+        return;
+    }
+    std::memcpy(&count, read_ptr, sizeof(count));
+    AdjustEndianess(count);
+
+    // Each element takes between 1 and MAX_VARINT_SIZE bytes, the elements themselves are checked
+    // when decoded
+    const uint64_t encoded_size = size - sizeof(count);
+    if (count > encoded_size || encoded_size > static_cast<uint64_t>(count) * MAX_VARINT_SIZE) [[unlikely]] {
+        return;
+    }
+
+    m_type = entry.type;
+    m_encoded = read_ptr + sizeof(count);
+    m_encoded_size = static_cast<FieldSize>(encoded_size);
+    m_size = count;
+}
+
+bool VarintArrayReader::Decode(std::span<int64_t> out) const noexcept {
+    if (m_type != DataType::VarInt64Array || out.size() < m_size) [[unlikely]] {
+        return false;
+    }
+    return DecodeZigZagVarints(m_encoded, m_encoded_size, out.data(), m_size);
+}
+
+bool VarintArrayReader::Decode(std::span<uint64_t> out) const noexcept {
+    if (m_type != DataType::VarUInt64Array || out.size() < m_size) [[unlikely]] {
+        return false;
+    }
+    return DecodeVarints(m_encoded, m_encoded_size, out.data(), m_size);
+}
+
+PackedIntegerArrayReader::PackedIntegerArrayReader(const CacheEntry& entry) noexcept {
+    if (!IsPackedArrayType(entry.type) || entry.type == DataType::PackedBooleanArray || entry.type == DataType::DictionaryStringArray ||
+        entry.value.ptr == nullptr) {
+        return;
+    }
+
+    const uint8_t* read_ptr = static_cast<const uint8_t*>(entry.value.ptr);
+
+    FieldSize size;
+    std::memcpy(&size, read_ptr, sizeof(size));
+    AdjustEndianess(size);
+    read_ptr += sizeof(size);
+
+    uint32_t count;
+    if (size < sizeof(count)) [[unlikely]] {
+        return;
+    }
+    std::memcpy(&count, read_ptr, sizeof(count));
+    AdjustEndianess(count);
+
+    // Each block takes at least its encoding, width and one reference, the blocks themselves are
+    // checked when decoded
+    const uint32_t element_size = DataTypeSize(BaseDataType(entry.type));
+    const uint64_t encoded_size = size - sizeof(count);
+    const uint64_t blocks = (static_cast<uint64_t>(count) + PACKED_BLOCK_LENGTH - 1) / PACKED_BLOCK_LENGTH;
+    if (encoded_size < blocks * (2 + element_size) || encoded_size > MaxPackedIntegersSize(count, element_size)) [[unlikely]] {
+        return;
+    }
+
+    m_type = entry.type;
+    m_encoded = read_ptr + sizeof(count);
+    m_encoded_size = static_cast<FieldSize>(encoded_size);
+    m_size = count;
+}
+
+template <typename Type>
+bool PackedIntegerArrayReader::DecodeAs(std::span<Type> out) const noexcept {
+    if (m_type == DataType::Invalid || BaseDataType(m_type) != IntegerType<Type>() || out.size() < m_size) [[unlikely]] {
+        return false;
+    }
+    return UnpackIntegers(m_encoded, m_encoded_size, out.data(), m_size);
+}
+
+bool PackedIntegerArrayReader::Decode(std::span<int32_t> out) const noexcept {
+    return DecodeAs(out);
+}
+
+bool PackedIntegerArrayReader::Decode(std::span<int64_t> out) const noexcept {
+    return DecodeAs(out);
+}
+
+bool PackedIntegerArrayReader::Decode(std::span<uint32_t> out) const noexcept {
+    return DecodeAs(out);
+}
+
+bool PackedIntegerArrayReader::Decode(std::span<uint64_t> out) const noexcept {
+    return DecodeAs(out);
+}
+
+DictionaryStringArrayReader::DictionaryStringArrayReader(const CacheEntry& entry) noexcept {
+    if (entry.type != DataType::DictionaryStringArray || entry.value.ptr == nullptr) {
+        return;
+    }
+
+    const uint8_t* read_ptr = static_cast<const uint8_t*>(entry.value.ptr);
+
+    FieldSize size;
+    std::memcpy(&size, read_ptr, sizeof(size));
+    AdjustEndianess(size);
+    read_ptr += sizeof(size);
+
+    uint32_t count;
+    uint32_t entry_count;
+    uint8_t width;
+    constexpr size_t HEADER_SIZE = sizeof(count) + sizeof(entry_count) + sizeof(width);
+    if (size < HEADER_SIZE) [[unlikely]] {
+        return;
+    }
+    std::memcpy(&count, read_ptr, sizeof(count));
+    std::memcpy(&entry_count, read_ptr + sizeof(count), sizeof(entry_count));
+    std::memcpy(&width, read_ptr + sizeof(count) + sizeof(entry_count), sizeof(width));
+    AdjustEndianess(count);
+    AdjustEndianess(entry_count);
+
+    // Every entry is referred to by some element and takes at least its length prefix. The entries
+    // fill whatever the header, offsets and codes leave of the array, they are checked when read.
+    const uint64_t offsets_size = static_cast<uint64_t>(entry_count) * sizeof(uint32_t);
+    const uint64_t codes_size = PackedCodesSize(count, width);
+    if (width > 32 || entry_count > count || (count > 0 && entry_count == 0) ||
+        HEADER_SIZE + offsets_size + codes_size + entry_count * sizeof(uint16_t) > size) [[unlikely]] {
+        return;
+    }
+
+    m_offsets = read_ptr + HEADER_SIZE;
+    m_entries = m_offsets + offsets_size;
+    m_entries_size = static_cast<FieldSize>(size - HEADER_SIZE - offsets_size - codes_size);
+    m_codes = m_entries + m_entries_size;
+    m_size = count;
+    m_entry_count = entry_count;
+    m_width = width;
+    m_is_valid = true;
+}
+
+std::optional<std::string_view> DictionaryStringArrayReader::GetEntry(uint32_t code) const noexcept {
+    if (!m_is_valid || code >= m_entry_count) [[unlikely]] {
+        return std::nullopt;
+    }
+
+    uint32_t offset;
+    std::memcpy(&offset, m_offsets + static_cast<size_t>(code) * sizeof(offset), sizeof(offset));
+    AdjustEndianess(offset);
+
+    uint16_t length;
+    if (static_cast<uint64_t>(offset) + sizeof(length) > m_entries_size) [[unlikely]] {
+        return std::nullopt;
+    }
+    std::memcpy(&length, m_entries + offset, sizeof(length));
+    AdjustEndianess(length);
+
+    if (static_cast<uint64_t>(offset) + sizeof(length) + length > m_entries_size) [[unlikely]] {
+        return std::nullopt;
+    }
+    return std::string_view(reinterpret_cast<const char*>(m_entries + offset + sizeof(length)), length);
+}
+
+std::optional<uint32_t> DictionaryStringArrayReader::GetCode(uint32_t index) const noexcept {
+    if (!m_is_valid || index >= m_size) [[unlikely]] {
+        return std::nullopt;
+    }
+    return GetPackedCode(m_codes, index, m_width);
+}
+
+std::optional<std::string_view> DictionaryStringArrayReader::GetElement(uint32_t index) const noexcept {
+    std::optional<uint32_t> code = GetCode(index);
+    if (!code) {
+        return std::nullopt;
+    }
+    return GetEntry(*code);
+}
+
+bool DictionaryStringArrayReader::GetElement(uint32_t index, std::string_view& out_value) const noexcept {
+    std::optional<std::string_view> element = GetElement(index);
+    if (!element) {
+        return false;
+    }
+    out_value = *element;
+    return true;
+}
+
+bool DictionaryStringArrayReader::DecodeCodes(std::span<uint32_t> out) const noexcept {
+    if (!m_is_valid || out.size() < m_size) [[unlikely]] {
+        return false;
+    }
+    UnpackCodes(m_codes, out.data(), m_size, m_width);
+    return true;
+}
+
+std::optional<uint32_t> DictionaryStringArrayReader::FindEntry(std::string_view value) const noexcept {
+    for (uint32_t code = 0; code < m_entry_count; ++code) {
+        if (GetEntry(code) == value) {
+            return code;
+        }
+    }
+    return std::nullopt;
+}
+
+bool DictionaryStringArrayReader::Validate() const noexcept {
+    if (!m_is_valid) {
+        return false;
+    }
+
+    for (uint32_t code = 0; code < m_entry_count; ++code) {
+        if (!GetEntry(code)) [[unlikely]] {
+            return false;
+        }
+    }
+
+    // Codes that fit in the width may still exceed the entry count unless it is a power of two
+    if (m_width >= 32 || m_entry_count >= (uint64_t(1) << m_width)) {
+        return true;
+    }
+
+    // Blocks are a multiple of 8 codes long so that each one starts on a byte boundary
+    constexpr uint32_t BLOCK_LENGTH = 512;
+    uint32_t block[BLOCK_LENGTH];
+    for (uint32_t first = 0; first < m_size; first += BLOCK_LENGTH) {
+        const uint32_t count = std::min(BLOCK_LENGTH, m_size - first);
+        UnpackCodes(m_codes + PackedCodesSize(first, m_width), block, count, m_width);
+        if (*std::max_element(block, block + count) >= m_entry_count) [[unlikely]] {
+            return false;
+        }
+    }
+    return true;
+}
+
+PackedBooleanArrayReader::PackedBooleanArrayReader(const CacheEntry& entry) noexcept {
+    if (entry.type != DataType::PackedBooleanArray || entry.value.ptr == nullptr) {
+        return;
+    }
+
+    const uint8_t* read_ptr = static_cast<const uint8_t*>(entry.value.ptr);
+
+    FieldSize size;
+    std::memcpy(&size, read_ptr, sizeof(size));
+    AdjustEndianess(size);
+    read_ptr += sizeof(size);
+
+    // The element count is followed by exactly the bytes its bits take
+    uint32_t count;
+    if (size < sizeof(count)) [[unlikely]] {
+        return;
+    }
+    std::memcpy(&count, read_ptr, sizeof(count));
+    AdjustEndianess(count);
+
+    if (size - sizeof(count) != PackedBitsSize(count)) [[unlikely]] {
+        return;
+    }
+
+    m_bits = read_ptr + sizeof(count);
+    m_size = count;
+    m_is_valid = true;
+}
+
 // ---------------------------------
 // Array reader iterators
 // ---------------------------------
 
 template <typename ElementSizeType>
     requires std::is_integral<ElementSizeType>::value
-ArrayReader<ElementSizeType>::BaseIterator::BaseIterator(const void* array, uint32_t index, bool at_end) noexcept
-    : m_index(index) {
-    const uint8_t* read_ptr = static_cast<const uint8_t*>(array);
-
-    FieldSize array_size = GetArraySize(array);
-    read_ptr += sizeof(FieldSize);
-    m_end_ptr = read_ptr + array_size;
-
+ArrayReader<ElementSizeType>::BaseIterator::BaseIterator(const uint8_t* elements, const uint8_t* elements_end, uint32_t index, bool at_end) noexcept
+    : m_end_ptr(elements_end), m_index(index) {
     if (at_end) {
         m_current_ptr = m_end_ptr;
         return;
     }
 
-    m_current_ptr = read_ptr;
+    m_current_ptr = elements;
 
     // Advance to the correct index
     for (uint32_t i = 0; i < index; ++i) {
@@ -979,8 +2372,12 @@ std::span<const uint8_t> BinaryArrayReader::Iterator::operator*() const noexcept
 }
 
 ObjectReader ObjectArrayReader::Iterator::operator*() const noexcept {
+    if (m_owner->HasDocument()) {
+        return ObjectReader(*m_owner->m_document, m_owner->m_first_object + this->Index());
+    }
+
     const void* ptr = this->CurrentElement();
-    return ObjectReader(ptr, m_name_based);
+    return ObjectReader(ptr, m_owner->m_name_based, m_owner->m_index_mode, m_owner->m_resource, m_owner->m_trusted);
 }
 
 }  // namespace tbf
\ No newline at end of file
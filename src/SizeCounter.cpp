@@ -0,0 +1,122 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#include "tbf/SizeCounter.hpp"
+
+#include "tbf/IntegerPacking.hpp"
+#include "tbf/Varint.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+
+namespace tbf {
+
+// ---------------------------------
+// Array field methods
+// ---------------------------------
+
+void SizeCounter::FieldVarInt64Array(const DataTag& tag, const int64_t* data, uint32_t length) noexcept {
+    size_t size = sizeof(FieldSize) + sizeof(uint32_t);
+    for (uint32_t i = 0; i < length; ++i) {
+        size += VarintSize(ZigZagEncode(data[i]));
+    }
+    Count(tag, size);
+}
+
+void SizeCounter::FieldVarUInt64Array(const DataTag& tag, const uint64_t* data, uint32_t length) noexcept {
+    size_t size = sizeof(FieldSize) + sizeof(uint32_t);
+    for (uint32_t i = 0; i < length; ++i) {
+        size += VarintSize(data[i]);
+    }
+    Count(tag, size);
+}
+
+// The size of a packed block depends on the encoding chosen for it, so the blocks are packed into
+// a stack block the same way the writer packs them and only their sizes are kept
+template <typename Type>
+static size_t PackedIntegersSize(const Type* data, uint32_t length) noexcept {
+    constexpr uint32_t BLOCK_LENGTH = 4 * PACKED_BLOCK_LENGTH;
+    uint8_t block[MaxPackedIntegersSize(BLOCK_LENGTH, sizeof(Type))];
+
+    size_t size = 0;
+    for (uint32_t i = 0; i < length; i += BLOCK_LENGTH) {
+        size += PackIntegers(data + i, std::min(BLOCK_LENGTH, length - i), block);
+    }
+    return size;
+}
+
+void SizeCounter::FieldPackedInt32Array(const DataTag& tag, const int32_t* data, uint32_t length) noexcept {
+    Count(tag, sizeof(FieldSize) + sizeof(uint32_t) + PackedIntegersSize(data, length));
+}
+
+void SizeCounter::FieldPackedInt64Array(const DataTag& tag, const int64_t* data, uint32_t length) noexcept {
+    Count(tag, sizeof(FieldSize) + sizeof(uint32_t) + PackedIntegersSize(data, length));
+}
+
+void SizeCounter::FieldPackedUInt32Array(const DataTag& tag, const uint32_t* data, uint32_t length) noexcept {
+    Count(tag, sizeof(FieldSize) + sizeof(uint32_t) + PackedIntegersSize(data, length));
+}
+
+void SizeCounter::FieldPackedUInt64Array(const DataTag& tag, const uint64_t* data, uint32_t length) noexcept {
+    Count(tag, sizeof(FieldSize) + sizeof(uint32_t) + PackedIntegersSize(data, length));
+}
+
+ArraySizeCounter SizeCounter::FieldStringArray(const DataTag& tag, ArrayLayout layout) noexcept {
+    Count(tag, 0);
+    return ArraySizeCounter(*this, layout);
+}
+
+void SizeCounter::FieldStringArray(const DataTag& tag, const std::string_view* data, uint32_t length, ArrayLayout layout) noexcept {
+    ArraySizeCounter array = FieldStringArray(tag, layout);
+    for (uint32_t i = 0; i < length; ++i) {
+        array.AddElement(data[i]);
+    }
+}
+
+// Whether the dictionary is kept depends on how many strings are distinct
+void SizeCounter::FieldDictionaryStringArray(const DataTag& tag, const std::string_view* data, uint32_t length) noexcept {
+    m_totals.size += ScratchSize([&](ObjectWriter& obj) { obj.FieldDictionaryStringArray(tag, data, length); });
+}
+
+ArraySizeCounter SizeCounter::FieldBinaryArray(const DataTag& tag, ArrayLayout layout) noexcept {
+    Count(tag, 0);
+    return ArraySizeCounter(*this, layout);
+}
+
+void SizeCounter::FieldBinaryArray(const DataTag& tag, const void* const* data, const uint32_t* sizes, uint32_t length,
+                                   ArrayLayout layout) noexcept {
+    ArraySizeCounter array = FieldBinaryArray(tag, layout);
+    for (uint32_t i = 0; i < length; ++i) {
+        array.AddElement(data[i], sizes[i]);
+    }
+}
+
+ArraySizeCounter SizeCounter::FieldObjectArray(const DataTag& tag, ArrayLayout layout) noexcept {
+    Count(tag, 0);
+    return ArraySizeCounter(*this, layout);
+}
+
+}  // namespace tbf
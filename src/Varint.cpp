@@ -0,0 +1,242 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#include "tbf/Varint.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace tbf {
+
+// ---------------------------------
+// Encoding
+// ---------------------------------
+
+size_t EncodeVarints(const uint64_t* values, size_t count, uint8_t* out) noexcept {
+    uint8_t* write_ptr = out;
+    for (size_t i = 0; i < count; ++i) {
+        if (values[i] < 0x80) {
+            *write_ptr++ = static_cast<uint8_t>(values[i]);
+        } else {
+            write_ptr += EncodeVarint(values[i], write_ptr);
+        }
+    }
+    return static_cast<size_t>(write_ptr - out);
+}
+
+size_t EncodeZigZagVarints(const int64_t* values, size_t count, uint8_t* out) noexcept {
+    uint8_t* write_ptr = out;
+    for (size_t i = 0; i < count; ++i) {
+        const uint64_t value = ZigZagEncode(values[i]);
+        if (value < 0x80) {
+            *write_ptr++ = static_cast<uint8_t>(value);
+        } else {
+            write_ptr += EncodeVarint(value, write_ptr);
+        }
+    }
+    return static_cast<size_t>(write_ptr - out);
+}
+
+// ---------------------------------
+// Decoding
+// ---------------------------------
+
+#if defined(__SSE2__)
+
+// Zero extends 16 bytes to 16 values
+[[gnu::always_inline]]
+static inline void WidenBytes(__m128i bytes, uint64_t* out) noexcept {
+#if defined(__AVX2__)
+    for (int i = 0; i < 4; ++i) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 4 * i), _mm256_cvtepu8_epi64(bytes));
+        bytes = _mm_srli_si128(bytes, 4);
+    }
+#else
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i words[2] = {_mm_unpacklo_epi8(bytes, zero), _mm_unpackhi_epi8(bytes, zero)};
+    for (int i = 0; i < 2; ++i) {
+        const __m128i dwords[2] = {_mm_unpacklo_epi16(words[i], zero), _mm_unpackhi_epi16(words[i], zero)};
+        for (int j = 0; j < 2; ++j) {
+            __m128i* target = reinterpret_cast<__m128i*>(out + 8 * i + 4 * j);
+            _mm_storeu_si128(target, _mm_unpacklo_epi32(dwords[j], zero));
+            _mm_storeu_si128(target + 1, _mm_unpackhi_epi32(dwords[j], zero));
+        }
+    }
+#endif
+}
+
+#endif
+
+#if defined(__SSSE3__)
+
+// Masked VByte: the continuation bits of the next 12 bytes select a shuffle that moves up to four
+// values of one to four bytes into their own 32 bit lanes, whose 7 bit groups are then packed with
+// shifts. Only complete values are taken, so a value that does not fit in the window, or is longer
+// than four bytes, is left to DecodeVarint.
+
+constexpr uint32_t SHUFFLE_WINDOW = 12;
+
+struct VarintShuffle {
+    uint8_t bytes[16];  // Source byte of each lane byte, 0x80 zeroes it
+    uint8_t count;      // Values decoded, 0 when the first one does not fit
+    uint8_t consumed;   // Bytes they take
+};
+
+static constexpr std::array<VarintShuffle, 1 << SHUFFLE_WINDOW> BuildShuffleTable() noexcept {
+    std::array<VarintShuffle, 1 << SHUFFLE_WINDOW> table{};
+    for (uint32_t mask = 0; mask < table.size(); ++mask) {
+        VarintShuffle& entry = table[mask];
+        for (uint8_t& byte : entry.bytes) {
+            byte = 0x80;
+        }
+
+        uint32_t start = 0;
+        while (entry.count < 4) {
+            uint32_t length = 1;
+            while (start + length <= SHUFFLE_WINDOW && (mask >> (start + length - 1) & 1) != 0) {
+                ++length;
+            }
+            if (length > 4 || start + length > SHUFFLE_WINDOW) {
+                break;
+            }
+
+            for (uint32_t j = 0; j < length; ++j) {
+                entry.bytes[4 * entry.count + j] = static_cast<uint8_t>(start + j);
+            }
+            ++entry.count;
+            start += length;
+        }
+        entry.consumed = static_cast<uint8_t>(start);
+    }
+    return table;
+}
+
+static constexpr std::array<VarintShuffle, 1 << SHUFFLE_WINDOW> SHUFFLE_TABLE = BuildShuffleTable();
+
+// Decodes the values selected by `shuffle` from `bytes` into four slots of `out`
+[[gnu::always_inline]]
+static inline void DecodeShuffled(__m128i bytes, const VarintShuffle& shuffle, uint64_t* out) noexcept {
+    const __m128i lanes = _mm_shuffle_epi8(bytes, _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle.bytes)));
+    const __m128i groups = _mm_and_si128(lanes, _mm_set1_epi32(0x7F7F7F7F));
+
+    // Byte n of a lane holds bits 7n to 7n + 6 of the value
+    __m128i values = _mm_and_si128(groups, _mm_set1_epi32(0x7F));
+    values = _mm_or_si128(values, _mm_and_si128(_mm_srli_epi32(groups, 1), _mm_set1_epi32(0x3F80)));
+    values = _mm_or_si128(values, _mm_and_si128(_mm_srli_epi32(groups, 2), _mm_set1_epi32(0x1FC000)));
+    values = _mm_or_si128(values, _mm_and_si128(_mm_srli_epi32(groups, 3), _mm_set1_epi32(0xFE00000)));
+
+#if defined(__AVX2__)
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_cvtepu32_epi64(values));
+#else
+    const __m128i zero = _mm_setzero_si128();
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi32(values, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2), _mm_unpackhi_epi32(values, zero));
+#endif
+}
+
+#endif
+
+bool DecodeVarints(const uint8_t* src, size_t size, uint64_t* out, size_t count) noexcept {
+    const uint8_t* read_ptr = src;
+    const uint8_t* end = src + size;
+    size_t i = 0;
+
+    while (i < count) {
+#if defined(__SSE2__)
+        if (i + 16 <= count && end - read_ptr >= 16) {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(read_ptr));
+            const uint32_t continuation = static_cast<uint32_t>(_mm_movemask_epi8(bytes));
+            const uint32_t singles = continuation == 0 ? 16 : static_cast<uint32_t>(std::countr_zero(continuation));
+
+            // A run of single byte values is widened 16 bytes at a time, keeping the values before
+            // the first continuation bit
+            if (singles != 0) {
+                WidenBytes(bytes, out + i);
+                i += singles;
+                read_ptr += singles;
+                continue;
+            }
+
+#if defined(__SSSE3__)
+            // Values of up to four bytes go through the shuffle table
+            const VarintShuffle& shuffle = SHUFFLE_TABLE[continuation & ((1 << SHUFFLE_WINDOW) - 1)];
+            if (shuffle.count != 0) {
+                DecodeShuffled(bytes, shuffle, out + i);
+                i += shuffle.count;
+                read_ptr += shuffle.consumed;
+                continue;
+            }
+#endif
+        }
+#endif
+        const uint32_t length = DecodeVarint(read_ptr, end, out[i]);
+        if (length == 0) [[unlikely]] {
+            return false;
+        }
+        read_ptr += length;
+        ++i;
+    }
+
+    return read_ptr == end;
+}
+
+bool DecodeZigZagVarints(const uint8_t* src, size_t size, int64_t* out, size_t count) noexcept {
+    uint64_t* values = reinterpret_cast<uint64_t*>(out);
+    if (!DecodeVarints(src, size, values, count)) [[unlikely]] {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = ZigZagDecode(values[i]);
+    }
+    return true;
+}
+
+bool ValidateVarints(const uint8_t* src, size_t size, size_t count) noexcept {
+    // Every value takes at least one byte and at most MAX_VARINT_SIZE
+    if (count > size || size > count * MAX_VARINT_SIZE) {
+        return false;
+    }
+
+    const uint8_t* read_ptr = src;
+    const uint8_t* end = src + size;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t value;
+        const uint32_t length = DecodeVarint(read_ptr, end, value);
+        if (length == 0) [[unlikely]] {
+            return false;
+        }
+        read_ptr += length;
+    }
+    return read_ptr == end;
+}
+
+}  // namespace tbf
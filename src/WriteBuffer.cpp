@@ -0,0 +1,191 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#include "tbf/WriteBuffer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+namespace tbf {
+
+// ---------------------------------
+// Chunks
+// ---------------------------------
+
+WriteBuffer::WriteBuffer(size_t min_chunk_size, size_t capacity, void* data) noexcept : m_min_chunk_size(min_chunk_size) {
+    std::unique_ptr<uint8_t[]> storage;
+    if (data == nullptr) {
+        storage = std::make_unique_for_overwrite<uint8_t[]>(capacity);
+        data = storage.get();
+    }
+
+    m_first = Chunk{static_cast<uint8_t*>(data), std::move(storage), capacity, 0, 0};
+    m_begin = m_first.data;
+    m_cursor = m_begin;
+    m_end = m_begin + capacity;
+}
+
+void WriteBuffer::AddChunk(size_t size) noexcept {
+    Chunk& last = LastChunk();
+    last.size = static_cast<size_t>(m_cursor - m_begin);
+
+    const size_t written = Size();
+    const size_t capacity = std::max(size, std::clamp(written, m_min_chunk_size, std::max(m_min_chunk_size, MAX_CHUNK_SIZE)));
+
+    std::unique_ptr<uint8_t[]> storage = std::make_unique_for_overwrite<uint8_t[]>(capacity);
+    Chunk chunk{storage.get(), std::move(storage), capacity, 0, written};
+
+    // A chunk left empty, by Truncate or a write larger than it, is replaced, as is the first chunk
+    // of a buffer nothing was written to yet
+    if (last.size == 0) {
+        last = std::move(chunk);
+    } else {
+        m_chunks.push_back(std::move(chunk));
+    }
+
+    const Chunk& current = LastChunk();
+    m_begin = current.data;
+    m_cursor = m_begin;
+    m_end = m_begin + capacity;
+    m_offset = written;
+}
+
+const WriteBuffer::Chunk& WriteBuffer::FindChunk(BufferOffset offset) const noexcept {
+    if (m_chunks.empty() || offset < m_chunks.front().offset) {
+        return m_first;
+    }
+
+    // The last chunk whose first byte is at or before `offset`
+    auto it = std::upper_bound(m_chunks.begin(), m_chunks.end(), offset,
+                               [](BufferOffset value, const Chunk& chunk) { return value < chunk.offset; });
+    return *(it - 1);
+}
+
+const WriteBuffer::Chunk* WriteBuffer::NextChunk(const Chunk* chunk) const noexcept {
+    return chunk == &m_first ? m_chunks.data() : chunk + 1;
+}
+
+size_t WriteBuffer::ChunkSize(const Chunk& chunk) const noexcept {
+    return &chunk == &LastChunk() ? static_cast<size_t>(m_cursor - m_begin) : chunk.size;
+}
+
+// ---------------------------------
+// Writing
+// ---------------------------------
+
+void WriteBuffer::Read(BufferOffset offset, void* dest, size_t size) const noexcept {
+    uint8_t* out = static_cast<uint8_t*>(dest);
+    const Chunk* chunk = size > 0 ? &FindChunk(offset) : nullptr;
+
+    while (size > 0) {
+        const size_t start = offset - chunk->offset;
+        const size_t count = std::min(size, ChunkSize(*chunk) - start);
+        std::memcpy(out, chunk->data + start, count);
+
+        out += count;
+        offset += count;
+        size -= count;
+        chunk = NextChunk(chunk);
+    }
+}
+
+const uint8_t* WriteBuffer::Contiguous(BufferOffset offset, size_t size) const noexcept {
+    if (m_first.data == nullptr) {
+        return nullptr;
+    }
+
+    const Chunk& chunk = FindChunk(offset);
+    const size_t start = offset - chunk.offset;
+    if (start + size > ChunkSize(chunk)) {
+        return nullptr;
+    }
+    return chunk.data + start;
+}
+
+void WriteBuffer::Truncate(size_t size) noexcept {
+    if (size >= Size()) {
+        return;
+    }
+
+    while (size < m_offset) {
+        m_chunks.pop_back();
+
+        const Chunk& last = LastChunk();
+        m_begin = last.data;
+        m_end = m_begin + last.capacity;
+        m_offset = last.offset;
+    }
+    m_cursor = m_begin + (size - m_offset);
+}
+
+// ---------------------------------
+// Output
+// ---------------------------------
+
+std::vector<std::span<const uint8_t>> WriteBuffer::Segments() const noexcept {
+    std::vector<std::span<const uint8_t>> segments;
+    segments.reserve(1 + m_chunks.size());
+
+    for (const Chunk* chunk = &m_first; chunk != m_chunks.data() + m_chunks.size(); chunk = NextChunk(chunk)) {
+        const size_t size = ChunkSize(*chunk);
+        if (size > 0) {
+            segments.emplace_back(chunk->data, size);
+        }
+    }
+    return segments;
+}
+
+void WriteBuffer::CopyTo(void* dest) const noexcept {
+    uint8_t* out = static_cast<uint8_t*>(dest);
+    for (const Chunk* chunk = &m_first; chunk != m_chunks.data() + m_chunks.size(); chunk = NextChunk(chunk)) {
+        const size_t size = ChunkSize(*chunk);
+        std::memcpy(out, chunk->data, size);
+        out += size;
+    }
+}
+
+const uint8_t* WriteBuffer::Data() noexcept {
+    if (!m_chunks.empty()) {
+        const size_t size = Size();
+        std::unique_ptr<uint8_t[]> storage = std::make_unique_for_overwrite<uint8_t[]>(size);
+        Chunk coalesced{storage.get(), std::move(storage), size, size, 0};
+        CopyTo(coalesced.data);
+
+        m_first = std::move(coalesced);
+        m_chunks.clear();
+
+        m_begin = m_first.data;
+        m_cursor = m_begin + size;
+        m_end = m_cursor;
+        m_offset = 0;
+    }
+    return m_begin;
+}
+
+}  // namespace tbf
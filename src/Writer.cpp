@@ -25,9 +25,18 @@
 
 #include "tbf/Writer.hpp"
 
+#include "tbf/BitPacking.hpp"
+#include "tbf/Compression.hpp"
 #include "tbf/DataTag.hpp"
 #include "tbf/DataType.hpp"
 #include "tbf/Endianness.hpp"
+#include "tbf/Float16.hpp"
+#include "tbf/IntegerPacking.hpp"
+#include "tbf/SizeCounter.hpp"
+#include "tbf/Varint.hpp"
+
+#include <algorithm>
+#include <bit>
 
 #include <cstdint>
 #include <string_view>
@@ -38,123 +47,210 @@ namespace tbf {
 // Constructors & Destructor
 // ---------------------------------
 
-Writer::Writer(bool name_based, uint32_t buff_grow_size) noexcept
-    : m_name_based(name_based),
-      m_root_object(*this) {
-    SetBufferGrowSize(buff_grow_size);
-    m_buffer.reserve(m_buffer_grow_size);
-}
-
-void Writer::SetBufferGrowSize(uint32_t grow_size) noexcept {
+template <TagMode Mode>
+BasicWriter<Mode>::BasicWriter(bool name_based, uint32_t buff_grow_size) noexcept
+    requires(Mode == TagMode::Runtime)
+    : m_buffer_grow_size(std::max(buff_grow_size, MIN_BUFFER_GROW_SIZE)),
+      m_buffer(m_buffer_grow_size),
+      m_name_based(name_based),
+      m_root_object(*this) {}
+
+template <TagMode Mode>
+BasicWriter<Mode>::BasicWriter(uint32_t buff_grow_size) noexcept
+    requires(Mode != TagMode::Runtime)
+    : m_buffer_grow_size(std::max(buff_grow_size, MIN_BUFFER_GROW_SIZE)),
+      m_buffer(m_buffer_grow_size),
+      m_name_based(Mode == TagMode::Name),
+      m_root_object(*this) {}
+
+// An exactly sized buffer only grows if the document is larger than measured, by small chunks
+template <TagMode Mode>
+BasicWriter<Mode>::BasicWriter(const SizeCounter& size) noexcept
+    : m_buffer_grow_size(MIN_BUFFER_GROW_SIZE),
+      m_buffer(m_buffer_grow_size, size.Capacity()),
+      m_name_based(Mode == TagMode::Runtime ? size.IsNameBased() : Mode == TagMode::Name),
+      m_root_object(*this) {}
+
+template <TagMode Mode>
+BasicWriter<Mode>::BasicWriter(std::span<uint8_t> buffer, bool name_based) noexcept
+    requires(Mode == TagMode::Runtime)
+    : m_buffer_grow_size(MIN_BUFFER_GROW_SIZE),
+      m_buffer(m_buffer_grow_size, buffer.size(), buffer.data()),
+      m_name_based(name_based),
+      m_root_object(*this) {}
+
+template <TagMode Mode>
+BasicWriter<Mode>::BasicWriter(std::span<uint8_t> buffer) noexcept
+    requires(Mode != TagMode::Runtime)
+    : m_buffer_grow_size(MIN_BUFFER_GROW_SIZE),
+      m_buffer(m_buffer_grow_size, buffer.size(), buffer.data()),
+      m_name_based(Mode == TagMode::Name),
+      m_root_object(*this) {}
+
+template <TagMode Mode>
+void BasicWriter<Mode>::SetBufferGrowSize(uint32_t grow_size) noexcept {
     if (grow_size > MIN_BUFFER_GROW_SIZE) {
         m_buffer_grow_size = grow_size;
     } else {
         m_buffer_grow_size = MIN_BUFFER_GROW_SIZE;
     }
+    m_buffer.SetMinChunkSize(m_buffer_grow_size);
 }
 
 // ---------------------------------
 // Writing methods
 // ---------------------------------
 
+// Stores `value` at `dest` in the byte order of the buffer and returns the end of it
+template <typename Type>
 [[gnu::always_inline]]
-inline void Writer::ReserveBuffer(size_t size) noexcept {
-    if (m_buffer.capacity() - m_buffer.size() < size) [[unlikely]] {
-        size_t reserve_space = m_buffer_grow_size;
-
-        if (size > reserve_space) [[unlikely]] {
-            reserve_space = size + m_buffer_grow_size;
-        }
+static inline uint8_t* Store(uint8_t* dest, Type value) noexcept {
+    if constexpr (sizeof(Type) > 1) {
+        AdjustEndianess(value);
+    }
+    std::memcpy(dest, &value, sizeof(Type));
+    return dest + sizeof(Type);
+}
 
-        m_buffer.reserve(m_buffer.capacity() + reserve_space);
+// Copies `size` bytes of payload to `dest` and returns the end of them. Empty payloads may come
+// with a null pointer, which memcpy does not accept
+[[gnu::always_inline]]
+static inline uint8_t* StoreBytes(uint8_t* dest, const void* data, size_t size) noexcept {
+    if (size != 0) {
+        std::memcpy(dest, data, size);
     }
+    return dest + size;
 }
 
+template <TagMode Mode>
 [[gnu::always_inline]]
-inline BufferOffset Writer::WriteData(const void* data, size_t size) noexcept {
-    const uint8_t* byte_data = static_cast<const uint8_t*>(data);
-    BufferOffset offset = m_buffer.size();
-    ReserveBuffer(size);
-    m_buffer.insert(m_buffer.end(), byte_data, byte_data + size);
+inline void BasicWriter<Mode>::ReserveBuffer(size_t size) noexcept {
+    m_buffer.Reserve(size);
+}
+
+template <TagMode Mode>
+[[gnu::always_inline]]
+inline BufferOffset BasicWriter<Mode>::WriteData(const void* data, size_t size) noexcept {
+    BufferOffset offset = m_buffer.Size();
+    m_buffer.Append(data, size);
     return offset;
 }
 
+template <TagMode Mode>
 template <typename Type, bool swap_endianess>
-inline void Writer::WriteData(Type value) noexcept {
-    if constexpr (sizeof(Type) > 1) {
-        if constexpr (swap_endianess) {
-            AdjustEndianess(value);
-        }
-        const uint8_t* byte_data = reinterpret_cast<const uint8_t*>(&value);
-        ReserveBuffer(sizeof(Type));
-        m_buffer.insert(m_buffer.end(), byte_data, byte_data + sizeof(Type));
-    } else {
-        ReserveBuffer(1);
-        m_buffer.push_back(static_cast<uint8_t>(value));
+inline void BasicWriter<Mode>::WriteData(Type value) noexcept {
+    if constexpr (swap_endianess && sizeof(Type) > 1) {
+        AdjustEndianess(value);
     }
+    m_buffer.Append(&value, sizeof(Type));
 }
 
-inline void Writer::WriteFieldHeader(const DataTag& tag, DataType type) noexcept {
-    // Write type
-    WriteData<DataType>(type);
-
-    if (m_name_based) {
-        // Write tag name
-        WriteData<DataTag::NameSize>(static_cast<DataTag::NameSize>(tag.GetName().size()));
-        ReserveBuffer(tag.GetName().size());
-        m_buffer.insert(m_buffer.end(), tag.GetName().begin(), tag.GetName().end());
-    } else {
-        // Write tag ID
-        WriteData<DataTag::Id>(tag.GetId());
-    }
+template <TagMode Mode>
+inline void BasicWriter<Mode>::WriteFieldHeader(const DataTag& tag, DataType type) noexcept {
+    uint8_t* dest = m_buffer.Reserve(FieldHeaderSize(tag));
+    m_buffer.Commit(StoreFieldHeader(dest, tag, type));
 }
 
+template <TagMode Mode>
 [[gnu::always_inline]]
-inline BufferOffset Writer::ReserveDataSizeField() noexcept {
-    BufferOffset offset = m_buffer.size();
-    ReserveBuffer(sizeof(FieldSize));
-    m_buffer.insert(m_buffer.end(), sizeof(FieldSize), 0);
-    return offset;
+inline BufferOffset BasicWriter<Mode>::ReserveDataSizeField() noexcept {
+    const FieldSize size = 0;
+    return WriteData(&size, sizeof(size));
 }
 
+// The size field is written by a single Append and so lies in one chunk, even when the data it
+// measures spans several
+template <TagMode Mode>
 [[gnu::always_inline]]
-inline void Writer::WriteDataSizeField(BufferOffset offset) noexcept {
-    FieldSize size = static_cast<FieldSize>(m_buffer.size() - offset - sizeof(FieldSize));
+inline void BasicWriter<Mode>::WriteDataSizeField(BufferOffset offset) noexcept {
+    FieldSize size = static_cast<FieldSize>(m_buffer.Size() - offset - sizeof(FieldSize));
 
     AdjustEndianess(size);
 
-    std::memcpy(m_buffer.data() + offset, &size, sizeof(size));
+    std::memcpy(m_buffer.Pointer(offset), &size, sizeof(size));
 }
 
+template <TagMode Mode>
 [[gnu::always_inline]]
-inline void* Writer::GetBufferPointer(BufferOffset offset) noexcept {
-    return m_buffer.data() + offset;
+inline void* BasicWriter<Mode>::GetBufferPointer(BufferOffset offset) noexcept {
+    return m_buffer.Pointer(offset);
 }
 
+template <TagMode Mode>
 [[gnu::always_inline]]
-inline void Writer::WriteString(const std::string_view& str) noexcept {
+inline void BasicWriter<Mode>::WriteString(const std::string_view& str) noexcept {
     const uint16_t length = static_cast<uint16_t>(str.size());
-    WriteData<uint16_t>(length);
-    WriteData(str.data(), length);
+    uint8_t* dest = Store<uint16_t>(m_buffer.Reserve(sizeof(length) + length), length);
+    m_buffer.Commit(StoreBytes(dest, str.data(), length));
 }
 
+template <TagMode Mode>
 [[gnu::always_inline]]
-inline void Writer::WriteBinary(const void* data, FieldSize size) noexcept {
-    WriteData<FieldSize>(size);
-    WriteData(data, size);
+inline void BasicWriter<Mode>::WriteBinary(const void* data, FieldSize size) noexcept {
+    uint8_t* dest = Store<FieldSize>(m_buffer.Reserve(sizeof(size) + size), size);
+    m_buffer.Commit(StoreBytes(dest, data, size));
+}
+
+// Room StoreFieldHeader needs, which in name-based mode covers the whole pre-encoded header even
+// when the name is shorter
+template <TagMode Mode>
+[[gnu::always_inline]]
+inline size_t BasicWriter<Mode>::FieldHeaderSize(const DataTag& tag) const noexcept {
+    if (IsNameBased()) {
+        return DataTag::NAME_HEADER_SIZE + tag.GetName().size();
+    }
+    return sizeof(DataType) + sizeof(DataTag::Id);
+}
+
+template <TagMode Mode>
+[[gnu::always_inline]]
+inline uint8_t* BasicWriter<Mode>::StoreFieldHeader(uint8_t* dest, const DataTag& tag, DataType type) const noexcept {
+    const std::string_view name = tag.GetName();
+
+    if (!IsNameBased()) {
+        // Write type and tag ID
+        *dest = static_cast<uint8_t>(type);
+        const DataTag::Id id = tag.GetWireId();
+        std::memcpy(dest + sizeof(DataType), &id, sizeof(id));
+        return dest + sizeof(DataType) + sizeof(id);
+    }
+
+    if (tag.HasNameHeader()) [[likely]] {
+        // One fixed size copy of the pre-encoded header, then the type
+        std::memcpy(dest, tag.GetNameHeader(), DataTag::NAME_HEADER_SIZE);
+        *dest = static_cast<uint8_t>(type);
+        return dest + sizeof(DataType) + sizeof(DataTag::NameSize) + name.size();
+    }
+
+    // Write type and tag name
+    dest = Store<DataType>(dest, type);
+    dest = Store<DataTag::NameSize>(dest, static_cast<DataTag::NameSize>(name.size()));
+    // The name of an ID or runtime tag written in name mode is empty, with no data
+    return StoreBytes(dest, name.data(), name.size());
+}
+
+template <TagMode Mode>
+template <typename Type>
+[[gnu::always_inline]]
+inline void BasicWriter<Mode>::WriteField(const DataTag& tag, DataType type, Type value) noexcept {
+    uint8_t* dest = m_buffer.Reserve(FieldHeaderSize(tag) + sizeof(Type));
+    dest = StoreFieldHeader(dest, tag, type);
+    m_buffer.Commit(Store<Type>(dest, value));
 }
 
 // ---------------------------------
 // ObjectWriter
 // ---------------------------------
 
-ObjectWriter::ObjectWriter(Writer& writer) noexcept
+template <TagMode Mode>
+BasicObjectWriter<Mode>::BasicObjectWriter(BasicWriter<Mode>& writer) noexcept
     : m_writer(writer),
       m_is_finished(false) {
     m_obj_size_pos = writer.ReserveDataSizeField();
 }
 
-void ObjectWriter::Finish() noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::Finish() noexcept {
     if (!IsFinished()) {
         m_writer.WriteDataSizeField(m_obj_size_pos);
         m_is_finished = true;
@@ -165,157 +261,391 @@ void ObjectWriter::Finish() noexcept {
 // Field methods
 // ---------------------------------
 
-void ObjectWriter::FieldInt8(const DataTag& tag, int8_t value) noexcept {
-    m_writer.WriteFieldHeader(tag, DataType::Int8);
-    m_writer.WriteData<int8_t>(value);
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldInt8(const DataTag& tag, int8_t value) noexcept {
+    m_writer.template WriteField<int8_t>(tag, DataType::Int8, value);
+}
+
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldInt16(const DataTag& tag, int16_t value) noexcept {
+    m_writer.template WriteField<int16_t>(tag, DataType::Int16, value);
+}
+
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldInt32(const DataTag& tag, int32_t value) noexcept {
+    m_writer.template WriteField<int32_t>(tag, DataType::Int32, value);
 }
 
-void ObjectWriter::FieldInt16(const DataTag& tag, int16_t value) noexcept {
-    m_writer.WriteFieldHeader(tag, DataType::Int16);
-    m_writer.WriteData<int16_t>(value);
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldInt64(const DataTag& tag, int64_t value) noexcept {
+    m_writer.template WriteField<int64_t>(tag, DataType::Int64, value);
 }
 
-void ObjectWriter::FieldInt32(const DataTag& tag, int32_t value) noexcept {
-    m_writer.WriteFieldHeader(tag, DataType::Int32);
-    m_writer.WriteData<int32_t>(value);
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldUInt8(const DataTag& tag, uint8_t value) noexcept {
+    m_writer.template WriteField<uint8_t>(tag, DataType::UInt8, value);
 }
 
-void ObjectWriter::FieldInt64(const DataTag& tag, int64_t value) noexcept {
-    m_writer.WriteFieldHeader(tag, DataType::Int64);
-    m_writer.WriteData<int64_t>(value);
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldUInt16(const DataTag& tag, uint16_t value) noexcept {
+    m_writer.template WriteField<uint16_t>(tag, DataType::UInt16, value);
 }
 
-void ObjectWriter::FieldUInt8(const DataTag& tag, uint8_t value) noexcept {
-    m_writer.WriteFieldHeader(tag, DataType::UInt8);
-    m_writer.WriteData<uint8_t>(value);
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldUInt32(const DataTag& tag, uint32_t value) noexcept {
+    m_writer.template WriteField<uint32_t>(tag, DataType::UInt32, value);
 }
 
-void ObjectWriter::FieldUInt16(const DataTag& tag, uint16_t value) noexcept {
-    m_writer.WriteFieldHeader(tag, DataType::UInt16);
-    m_writer.WriteData<uint16_t>(value);
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldUInt64(const DataTag& tag, uint64_t value) noexcept {
+    m_writer.template WriteField<uint64_t>(tag, DataType::UInt64, value);
 }
 
-void ObjectWriter::FieldUInt32(const DataTag& tag, uint32_t value) noexcept {
-    m_writer.WriteFieldHeader(tag, DataType::UInt32);
-    m_writer.WriteData<uint32_t>(value);
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVarInt64(const DataTag& tag, int64_t value) noexcept {
+    uint8_t* dest = m_writer.m_buffer.Reserve(m_writer.FieldHeaderSize(tag) + MAX_VARINT_SIZE);
+    dest = m_writer.StoreFieldHeader(dest, tag, DataType::VarInt64);
+    m_writer.m_buffer.Commit(dest + EncodeVarint(ZigZagEncode(value), dest));
 }
 
-void ObjectWriter::FieldUInt64(const DataTag& tag, uint64_t value) noexcept {
-    m_writer.WriteFieldHeader(tag, DataType::UInt64);
-    m_writer.WriteData<uint64_t>(value);
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVarUInt64(const DataTag& tag, uint64_t value) noexcept {
+    uint8_t* dest = m_writer.m_buffer.Reserve(m_writer.FieldHeaderSize(tag) + MAX_VARINT_SIZE);
+    dest = m_writer.StoreFieldHeader(dest, tag, DataType::VarUInt64);
+    m_writer.m_buffer.Commit(dest + EncodeVarint(value, dest));
 }
 
-void ObjectWriter::FieldBoolean(const DataTag& tag, bool value) noexcept {
-    m_writer.WriteFieldHeader(tag, DataType::Boolean);
-    m_writer.WriteData<bool>(value);
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldBoolean(const DataTag& tag, bool value) noexcept {
+    m_writer.template WriteField<bool>(tag, DataType::Boolean, value);
 }
 
-void ObjectWriter::FieldFloat16(const DataTag& tag, uint16_t value) noexcept {
-    m_writer.WriteFieldHeader(tag, DataType::Float16);
-    m_writer.WriteData<uint16_t>(value);
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldFloat16(const DataTag& tag, uint16_t value) noexcept {
+    m_writer.template WriteField<uint16_t>(tag, DataType::Float16, value);
 }
 
-void ObjectWriter::FieldFloat32(const DataTag& tag, float value) noexcept {
-    m_writer.WriteFieldHeader(tag, DataType::Float32);
-    m_writer.WriteData<uint32_t>(std::bit_cast<uint32_t>(value));
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldFloat32(const DataTag& tag, float value) noexcept {
+    m_writer.template WriteField<uint32_t>(tag, DataType::Float32, std::bit_cast<uint32_t>(value));
 }
 
-void ObjectWriter::FieldFloat64(const DataTag& tag, double value) noexcept {
-    m_writer.WriteFieldHeader(tag, DataType::Float64);
-    m_writer.WriteData<uint64_t>(std::bit_cast<uint64_t>(value));
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldFloat64(const DataTag& tag, double value) noexcept {
+    m_writer.template WriteField<uint64_t>(tag, DataType::Float64, std::bit_cast<uint64_t>(value));
 }
 
-void ObjectWriter::FieldUUID(const DataTag& tag, const void* uuid) noexcept {
-    m_writer.WriteFieldHeader(tag, DataType::UUID);
-    m_writer.WriteData(uuid, 16);
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldUUID(const DataTag& tag, const void* uuid) noexcept {
+    uint8_t* dest = m_writer.m_buffer.Reserve(m_writer.FieldHeaderSize(tag) + 16);
+    dest = m_writer.StoreFieldHeader(dest, tag, DataType::UUID);
+    std::memcpy(dest, uuid, 16);
+    m_writer.m_buffer.Commit(dest + 16);
 }
 
-void ObjectWriter::FieldString(const DataTag& tag, std::string_view value) noexcept {
-    m_writer.WriteFieldHeader(tag, DataType::String);
-    m_writer.WriteString(value);
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldString(const DataTag& tag, std::string_view value) noexcept {
+    const uint16_t length = static_cast<uint16_t>(value.size());
+    uint8_t* dest = m_writer.m_buffer.Reserve(m_writer.FieldHeaderSize(tag) + sizeof(length) + length);
+    dest = Store<uint16_t>(m_writer.StoreFieldHeader(dest, tag, DataType::String), length);
+    m_writer.m_buffer.Commit(StoreBytes(dest, value.data(), length));
 }
 
-void ObjectWriter::FieldBinary(const DataTag& tag, const void* data, size_t size) noexcept {
-    m_writer.WriteFieldHeader(tag, DataType::Binary);
-    m_writer.WriteBinary(data, size);
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldBinary(const DataTag& tag, const void* data, size_t size) noexcept {
+    const FieldSize length = static_cast<FieldSize>(size);
+    uint8_t* dest = m_writer.m_buffer.Reserve(m_writer.FieldHeaderSize(tag) + sizeof(length) + length);
+    dest = Store<FieldSize>(m_writer.StoreFieldHeader(dest, tag, DataType::Binary), length);
+    m_writer.m_buffer.Commit(StoreBytes(dest, data, length));
 }
 
-ObjectWriter ObjectWriter::FieldObject(const DataTag& tag) noexcept {
+template <TagMode Mode>
+BasicObjectWriter<Mode> BasicObjectWriter<Mode>::FieldObject(const DataTag& tag) noexcept {
     m_writer.WriteFieldHeader(tag, DataType::Object);
-    return ObjectWriter(m_writer);
+    return BasicObjectWriter<Mode>(m_writer);
+}
+
+// ---------------------------------
+// Compressed fields
+// ---------------------------------
+
+template <TagMode Mode>
+BufferOffset BasicObjectWriter<Mode>::GetFieldOffset() const noexcept {
+    return m_writer.m_buffer.Size();
+}
+
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::CompressField(BufferOffset field_pos, FieldSize threshold) noexcept {
+    WriteBuffer& buffer = m_writer.m_buffer;
+    const BufferOffset end = buffer.Size();
+
+    // The field must be the only one written since field_pos, with its size already patched
+    BufferOffset size_pos = field_pos + sizeof(DataType);
+    if (m_writer.IsNameBased()) {
+        if (size_pos >= end) [[unlikely]] {
+            return;
+        }
+        size_pos += sizeof(DataTag::NameSize) + *buffer.Pointer(size_pos);
+    } else {
+        size_pos += sizeof(DataTag::Id);
+    }
+
+    const BufferOffset data_pos = size_pos + sizeof(FieldSize);
+    if (data_pos > end) [[unlikely]] {
+        return;
+    }
+
+    const DataType type = static_cast<DataType>(*buffer.Pointer(field_pos));
+    FieldSize size;
+    buffer.Read(size_pos, &size, sizeof(size));
+    AdjustEndianess(size);
+    if (!IsCompressibleType(type) || data_pos + size != end || size < threshold) {
+        return;
+    }
+
+    // A payload spanning chunks is compressed from a copy
+    std::vector<uint8_t> payload;
+    const uint8_t* data = buffer.Contiguous(data_pos, size);
+    if (data == nullptr) {
+        payload.resize(size);
+        buffer.Read(data_pos, payload.data(), size);
+        data = payload.data();
+    }
+
+    std::vector<uint8_t> compressed(MaxCompressedSize(size));
+    const size_t compressed_size = CompressBlock(data, size, compressed.data());
+    if (compressed_size + sizeof(DataType) + sizeof(FieldSize) >= size) {
+        return;
+    }
+
+    // The header keeps its tag, the payload becomes [Size] [Type] [Raw size] [Compressed data]
+    *buffer.Pointer(field_pos) = static_cast<uint8_t>(DataType::Compressed);
+    buffer.Truncate(size_pos);
+
+    BufferOffset envelope_size_pos = m_writer.ReserveDataSizeField();
+    m_writer.template WriteData<DataType>(type);
+    m_writer.template WriteData<FieldSize>(size);
+    m_writer.WriteData(compressed.data(), compressed_size);
+    m_writer.WriteDataSizeField(envelope_size_pos);
 }
 
 // ---------------------------------
 // Array field methods
 // ---------------------------------
 
+template <TagMode Mode>
 template <typename Type>
 [[gnu::always_inline]]
-inline void ObjectWriter::FieldArray(const DataTag& tag, DataType array_type, const Type* data, uint32_t length) noexcept {
-    m_writer.WriteFieldHeader(tag, array_type);
-
+inline void BasicObjectWriter<Mode>::FieldArray(const DataTag& tag, DataType array_type, const Type* data, uint32_t length) noexcept {
     // Write array length and array data
-    FieldSize size = length * sizeof(Type);
-    m_writer.WriteData<FieldSize>(size);
-    BufferOffset offset = m_writer.WriteData(data, size);
-
-    AdjustArrayEndianess<sizeof(Type)>(m_writer.GetBufferPointer(offset), length);
+    const FieldSize size = length * sizeof(Type);
+    uint8_t* dest = m_writer.m_buffer.Reserve(m_writer.FieldHeaderSize(tag) + sizeof(size) + size);
+    dest = Store<FieldSize>(m_writer.StoreFieldHeader(dest, tag, array_type), size);
+    StoreBytes(dest, data, size);
+    AdjustArrayEndianess<sizeof(Type)>(dest, length);
+    m_writer.m_buffer.Commit(dest + size);
 }
 
-void ObjectWriter::FieldArrayInt8(const DataTag& tag, const int8_t* data, uint32_t length) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldArrayInt8(const DataTag& tag, const int8_t* data, uint32_t length) noexcept {
     FieldArray<int8_t>(tag, DataType::Int8Array, data, length);
 }
 
-void ObjectWriter::FieldArrayInt16(const DataTag& tag, const int16_t* data, uint32_t length) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldArrayInt16(const DataTag& tag, const int16_t* data, uint32_t length) noexcept {
     FieldArray<int16_t>(tag, DataType::Int16Array, data, length);
 }
 
-void ObjectWriter::FieldArrayInt32(const DataTag& tag, const int32_t* data, uint32_t length) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldArrayInt32(const DataTag& tag, const int32_t* data, uint32_t length) noexcept {
     FieldArray<int32_t>(tag, DataType::Int32Array, data, length);
 }
 
-void ObjectWriter::FieldArrayInt64(const DataTag& tag, const int64_t* data, uint32_t length) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldArrayInt64(const DataTag& tag, const int64_t* data, uint32_t length) noexcept {
     FieldArray<int64_t>(tag, DataType::Int64Array, data, length);
 }
 
-void ObjectWriter::FieldArrayUInt8(const DataTag& tag, const uint8_t* data, uint32_t length) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldArrayUInt8(const DataTag& tag, const uint8_t* data, uint32_t length) noexcept {
     FieldArray<uint8_t>(tag, DataType::UInt8Array, data, length);
 }
 
-void ObjectWriter::FieldArrayUInt16(const DataTag& tag, const uint16_t* data, uint32_t length) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldArrayUInt16(const DataTag& tag, const uint16_t* data, uint32_t length) noexcept {
     FieldArray<uint16_t>(tag, DataType::UInt16Array, data, length);
 }
 
-void ObjectWriter::FieldArrayUInt32(const DataTag& tag, const uint32_t* data, uint32_t length) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldArrayUInt32(const DataTag& tag, const uint32_t* data, uint32_t length) noexcept {
     FieldArray<uint32_t>(tag, DataType::UInt32Array, data, length);
 }
 
-void ObjectWriter::FieldArrayUInt64(const DataTag& tag, const uint64_t* data, uint32_t length) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldArrayUInt64(const DataTag& tag, const uint64_t* data, uint32_t length) noexcept {
     FieldArray<uint64_t>(tag, DataType::UInt64Array, data, length);
 }
 
-void ObjectWriter::FieldArrayBoolean(const DataTag& tag, const bool* data, uint32_t length) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldArrayBoolean(const DataTag& tag, const bool* data, uint32_t length) noexcept {
     FieldArray<bool>(tag, DataType::BooleanArray, data, length);
 }
 
-void ObjectWriter::FieldArrayFloat16(const DataTag& tag, const uint16_t* data, uint32_t length) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldPackedBooleanArray(const DataTag& tag, const bool* data, uint32_t length) noexcept {
+    m_writer.WriteFieldHeader(tag, DataType::PackedBooleanArray);
+
+    const FieldSize bits_size = static_cast<FieldSize>(PackedBitsSize(length));
+    m_writer.template WriteData<FieldSize>(sizeof(uint32_t) + bits_size);
+    m_writer.template WriteData<uint32_t>(length);
+    m_writer.ReserveBuffer(bits_size);
+
+    // Packed through a stack block, 4096 elements at a time
+    constexpr uint32_t BLOCK_LENGTH = 4096;
+    uint8_t block[BLOCK_LENGTH / 8];
+    for (uint32_t i = 0; i < length; i += BLOCK_LENGTH) {
+        uint32_t count = std::min(BLOCK_LENGTH, length - i);
+        PackBooleans(data + i, block, count);
+        m_writer.WriteData(block, PackedBitsSize(count));
+    }
+}
+
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldPackedBits(const DataTag& tag, const uint8_t* bits, uint32_t length) noexcept {
+    m_writer.WriteFieldHeader(tag, DataType::PackedBooleanArray);
+
+    const FieldSize bits_size = static_cast<FieldSize>(PackedBitsSize(length));
+    m_writer.template WriteData<FieldSize>(sizeof(uint32_t) + bits_size);
+    m_writer.template WriteData<uint32_t>(length);
+
+    if (bits_size > 0) {
+        BufferOffset offset = m_writer.WriteData(bits, bits_size);
+
+        // Unused bits of the last byte are always written as zero
+        if (length % 8 != 0) {
+            static_cast<uint8_t*>(m_writer.GetBufferPointer(offset))[bits_size - 1] &= static_cast<uint8_t>((1u << (length % 8)) - 1);
+        }
+    }
+}
+
+template <TagMode Mode>
+template <typename Type, size_t (*encode)(const Type*, size_t, uint8_t*) noexcept>
+void BasicObjectWriter<Mode>::FieldVarintArray(const DataTag& tag, DataType array_type, const Type* data, uint32_t length) noexcept {
+    m_writer.WriteFieldHeader(tag, array_type);
+
+    // The encoded size is only known once every element is written
+    BufferOffset size_pos = m_writer.ReserveDataSizeField();
+    m_writer.template WriteData<uint32_t>(length);
+
+    constexpr uint32_t BLOCK_LENGTH = 256;
+    uint8_t block[BLOCK_LENGTH * MAX_VARINT_SIZE];
+    for (uint32_t i = 0; i < length; i += BLOCK_LENGTH) {
+        uint32_t count = std::min(BLOCK_LENGTH, length - i);
+        m_writer.WriteData(block, encode(data + i, count, block));
+    }
+
+    m_writer.WriteDataSizeField(size_pos);
+}
+
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVarInt64Array(const DataTag& tag, const int64_t* data, uint32_t length) noexcept {
+    FieldVarintArray<int64_t, EncodeZigZagVarints>(tag, DataType::VarInt64Array, data, length);
+}
+
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVarUInt64Array(const DataTag& tag, const uint64_t* data, uint32_t length) noexcept {
+    FieldVarintArray<uint64_t, EncodeVarints>(tag, DataType::VarUInt64Array, data, length);
+}
+
+template <TagMode Mode>
+template <typename Type>
+void BasicObjectWriter<Mode>::FieldPackedIntegerArray(const DataTag& tag, DataType array_type, const Type* data, uint32_t length) noexcept {
+    m_writer.WriteFieldHeader(tag, array_type);
+
+    // The packed size is only known once every block is written
+    BufferOffset size_pos = m_writer.ReserveDataSizeField();
+    m_writer.template WriteData<uint32_t>(length);
+
+    constexpr uint32_t BLOCK_LENGTH = 4 * PACKED_BLOCK_LENGTH;
+    uint8_t block[MaxPackedIntegersSize(BLOCK_LENGTH, sizeof(Type))];
+    for (uint32_t i = 0; i < length; i += BLOCK_LENGTH) {
+        uint32_t count = std::min(BLOCK_LENGTH, length - i);
+        m_writer.WriteData(block, PackIntegers(data + i, count, block));
+    }
+
+    m_writer.WriteDataSizeField(size_pos);
+}
+
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldPackedInt32Array(const DataTag& tag, const int32_t* data, uint32_t length) noexcept {
+    FieldPackedIntegerArray<int32_t>(tag, DataType::PackedInt32Array, data, length);
+}
+
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldPackedInt64Array(const DataTag& tag, const int64_t* data, uint32_t length) noexcept {
+    FieldPackedIntegerArray<int64_t>(tag, DataType::PackedInt64Array, data, length);
+}
+
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldPackedUInt32Array(const DataTag& tag, const uint32_t* data, uint32_t length) noexcept {
+    FieldPackedIntegerArray<uint32_t>(tag, DataType::PackedUInt32Array, data, length);
+}
+
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldPackedUInt64Array(const DataTag& tag, const uint64_t* data, uint32_t length) noexcept {
+    FieldPackedIntegerArray<uint64_t>(tag, DataType::PackedUInt64Array, data, length);
+}
+
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldArrayFloat16(const DataTag& tag, const uint16_t* data, uint32_t length) noexcept {
     FieldArray<uint16_t>(tag, DataType::Float16Array, data, length);
 }
 
-void ObjectWriter::FieldArrayFloat32(const DataTag& tag, const float* data, uint32_t length) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldArrayFloat16(const DataTag& tag, const float* data, uint32_t length) noexcept {
+    m_writer.WriteFieldHeader(tag, DataType::Float16Array);
+
+    FieldSize size = length * sizeof(uint16_t);
+    m_writer.template WriteData<FieldSize>(size);
+    m_writer.ReserveBuffer(size);
+
+    // Converted through a stack block that stays in L1, the buffer is appended to block by block
+    constexpr uint32_t BLOCK_LENGTH = 512;
+    uint16_t block[BLOCK_LENGTH];
+    for (uint32_t i = 0; i < length; i += BLOCK_LENGTH) {
+        uint32_t count = std::min(BLOCK_LENGTH, length - i);
+        FloatToHalfArray(data + i, block, count);
+        AdjustArrayEndianess<sizeof(uint16_t)>(block, count);
+        m_writer.WriteData(block, count * sizeof(uint16_t));
+    }
+}
+
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldArrayFloat32(const DataTag& tag, const float* data, uint32_t length) noexcept {
     FieldArray<uint32_t>(tag, DataType::Float32Array, reinterpret_cast<const uint32_t*>(data), length);
 }
 
-void ObjectWriter::FieldArrayFloat64(const DataTag& tag, const double* data, uint32_t length) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldArrayFloat64(const DataTag& tag, const double* data, uint32_t length) noexcept {
     FieldArray<uint64_t>(tag, DataType::Float64Array, reinterpret_cast<const uint64_t*>(data), length);
 }
 
-StringArrayWriter ObjectWriter::FieldStringArray(const DataTag& tag) noexcept {
-    m_writer.WriteFieldHeader(tag, DataType::StringArray);
-    return StringArrayWriter(*this);
+template <TagMode Mode>
+BasicStringArrayWriter<Mode> BasicObjectWriter<Mode>::FieldStringArray(const DataTag& tag, ArrayLayout layout) noexcept {
+    m_writer.WriteFieldHeader(tag, layout == ArrayLayout::Indexed ? DataType::IndexedStringArray : DataType::StringArray);
+    return BasicStringArrayWriter<Mode>(*this, layout);
 }
 
-void ObjectWriter::FieldStringArray(const DataTag& tag, const std::string_view* data, uint32_t length) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldStringArray(const DataTag& tag, const std::string_view* data, uint32_t length, ArrayLayout layout) noexcept {
+    if (layout == ArrayLayout::Indexed) {
+        BasicStringArrayWriter<Mode> array = FieldStringArray(tag, layout);
+        for (uint32_t i = 0; i < length; ++i) {
+            array.AddElement(data[i]);
+        }
+        return;
+    }
+
     m_writer.WriteFieldHeader(tag, DataType::StringArray);
 
     // Write array size
@@ -329,12 +659,106 @@ void ObjectWriter::FieldStringArray(const DataTag& tag, const std::string_view*
     m_writer.WriteDataSizeField(offset);
 }
 
-BinaryArrayWriter ObjectWriter::FieldBinaryArray(const DataTag& tag) noexcept {
-    m_writer.WriteFieldHeader(tag, DataType::BinaryArray);
-    return BinaryArrayWriter(*this);
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldDictionaryStringArray(const DataTag& tag, const std::string_view* data, uint32_t length) noexcept {
+    // Distinct strings in order of first appearance, looked up through an open addressing table
+    // of entry + 1 that is kept at most half full
+    std::vector<std::string_view> entries;
+    std::vector<uint32_t> codes(length);
+    std::vector<uint32_t> table(16, 0);
+    size_t entries_size = 0;
+    size_t plain_size = 0;
+
+    for (uint32_t i = 0; i < length; ++i) {
+        // Cut the same way WriteString cuts its length prefix, so both encodings read back alike
+        const std::string_view value = data[i].substr(0, static_cast<uint16_t>(data[i].size()));
+        plain_size += sizeof(uint16_t) + value.size();
+
+        const size_t mask = table.size() - 1;
+        size_t slot = TagLookupHash(value) & mask;
+        while (table[slot] != 0 && entries[table[slot] - 1] != value) {
+            slot = (slot + 1) & mask;
+        }
+
+        if (table[slot] != 0) {
+            codes[i] = table[slot] - 1;
+        } else {
+            codes[i] = static_cast<uint32_t>(entries.size());
+            entries.push_back(value);
+            entries_size += sizeof(uint16_t) + value.size();
+            table[slot] = static_cast<uint32_t>(entries.size());
+
+            if (entries.size() * 2 > table.size()) {
+                std::vector<uint32_t> grown(table.size() * 2, 0);
+                for (uint32_t entry = 0; entry < entries.size(); ++entry) {
+                    size_t grown_slot = TagLookupHash(entries[entry]) & (grown.size() - 1);
+                    while (grown[grown_slot] != 0) {
+                        grown_slot = (grown_slot + 1) & (grown.size() - 1);
+                    }
+                    grown[grown_slot] = entry + 1;
+                }
+                table = std::move(grown);
+            }
+        }
+    }
+
+    const uint32_t entry_count = static_cast<uint32_t>(entries.size());
+    const uint32_t width = entry_count > 1 ? static_cast<uint32_t>(std::bit_width(entry_count - 1)) : 0;
+    const size_t dictionary_size = sizeof(uint32_t) * 2 + sizeof(uint8_t) + sizeof(uint32_t) * entry_count + entries_size +
+                                   PackedCodesSize(length, width);
+
+    // High cardinality data gains nothing from the dictionary, it is written as a plain string array
+    if (dictionary_size >= plain_size) {
+        FieldStringArray(tag, data, length, ArrayLayout::Plain);
+        return;
+    }
+
+    m_writer.WriteFieldHeader(tag, DataType::DictionaryStringArray);
+
+    BufferOffset size_pos = m_writer.ReserveDataSizeField();
+    m_writer.template WriteData<uint32_t>(length);
+    m_writer.template WriteData<uint32_t>(entry_count);
+    m_writer.template WriteData<uint8_t>(static_cast<uint8_t>(width));
+
+    uint32_t entry_offset = 0;
+    for (const std::string_view& entry : entries) {
+        m_writer.template WriteData<uint32_t>(entry_offset);
+        entry_offset += static_cast<uint32_t>(sizeof(uint16_t) + entry.size());
+    }
+
+    for (const std::string_view& entry : entries) {
+        m_writer.WriteString(entry);
+    }
+
+    // Blocks are a multiple of 8 codes long so that each one ends on a byte boundary
+    constexpr uint32_t BLOCK_LENGTH = 512;
+    uint8_t block[PackedCodesSize(BLOCK_LENGTH, 32)];
+    for (uint32_t i = 0; i < length; i += BLOCK_LENGTH) {
+        uint32_t count = std::min(BLOCK_LENGTH, length - i);
+        PackCodes(codes.data() + i, block, count, width);
+        m_writer.WriteData(block, PackedCodesSize(count, width));
+    }
+
+    m_writer.WriteDataSizeField(size_pos);
 }
 
-void ObjectWriter::FieldBinaryArray(const DataTag& tag, const void* const* data, const uint32_t* sizes, uint32_t length) noexcept {
+template <TagMode Mode>
+BasicBinaryArrayWriter<Mode> BasicObjectWriter<Mode>::FieldBinaryArray(const DataTag& tag, ArrayLayout layout) noexcept {
+    m_writer.WriteFieldHeader(tag, layout == ArrayLayout::Indexed ? DataType::IndexedBinaryArray : DataType::BinaryArray);
+    return BasicBinaryArrayWriter<Mode>(*this, layout);
+}
+
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldBinaryArray(const DataTag& tag, const void* const* data, const uint32_t* sizes, uint32_t length,
+                                    ArrayLayout layout) noexcept {
+    if (layout == ArrayLayout::Indexed) {
+        BasicBinaryArrayWriter<Mode> array = FieldBinaryArray(tag, layout);
+        for (uint32_t i = 0; i < length; ++i) {
+            array.AddElement(data[i], sizes[i]);
+        }
+        return;
+    }
+
     m_writer.WriteFieldHeader(tag, DataType::BinaryArray);
 
     // Write array size
@@ -348,122 +772,171 @@ void ObjectWriter::FieldBinaryArray(const DataTag& tag, const void* const* data,
     m_writer.WriteDataSizeField(offset);
 }
 
-ObjectArrayWriter ObjectWriter::FieldObjectArray(const DataTag& tag) noexcept {
-    m_writer.WriteFieldHeader(tag, DataType::ObjectArray);
-    return ObjectArrayWriter(*this);
+template <TagMode Mode>
+BasicObjectArrayWriter<Mode> BasicObjectWriter<Mode>::FieldObjectArray(const DataTag& tag, ArrayLayout layout) noexcept {
+    m_writer.WriteFieldHeader(tag, layout == ArrayLayout::Indexed ? DataType::IndexedObjectArray : DataType::ObjectArray);
+    return BasicObjectArrayWriter<Mode>(*this, layout);
 }
 
 // ---------------------------------
 // Field vectors
 // ---------------------------------
 
+template <TagMode Mode>
 template <typename Type, uint32_t dim>
     requires std::is_arithmetic<Type>::value && (dim >= 2) && (dim <= 4)
-void ObjectWriter::FieldVector(const DataTag& tag, DataType vector_type, const Type* data) noexcept {
-    m_writer.WriteFieldHeader(tag, vector_type);
-    BufferOffset offset = m_writer.WriteData(data, sizeof(Type) * dim);
-    AdjustArrayEndianess<sizeof(Type)>(m_writer.GetBufferPointer(offset), dim);
+void BasicObjectWriter<Mode>::FieldVector(const DataTag& tag, DataType vector_type, const Type* data) noexcept {
+    uint8_t* dest = m_writer.m_buffer.Reserve(m_writer.FieldHeaderSize(tag) + sizeof(Type) * dim);
+    dest = m_writer.StoreFieldHeader(dest, tag, vector_type);
+    std::memcpy(dest, data, sizeof(Type) * dim);
+    AdjustArrayEndianess<sizeof(Type)>(dest, dim);
+    m_writer.m_buffer.Commit(dest + sizeof(Type) * dim);
 }
 
 // Vector 2
 
-void ObjectWriter::FieldVector2i8(const DataTag& tag, const int8_t* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector2i8(const DataTag& tag, const int8_t* data) noexcept {
     FieldVector<int8_t, 2>(tag, DataType::Vector2i8, data);
 }
 
-void ObjectWriter::FieldVector2i16(const DataTag& tag, const int16_t* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector2i16(const DataTag& tag, const int16_t* data) noexcept {
     FieldVector<int16_t, 2>(tag, DataType::Vector2i16, data);
 }
 
-void ObjectWriter::FieldVector2i32(const DataTag& tag, const int32_t* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector2i32(const DataTag& tag, const int32_t* data) noexcept {
     FieldVector<int32_t, 2>(tag, DataType::Vector2i32, data);
 }
 
-void ObjectWriter::FieldVector2i64(const DataTag& tag, const int64_t* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector2i64(const DataTag& tag, const int64_t* data) noexcept {
     FieldVector<int64_t, 2>(tag, DataType::Vector2i64, data);
 }
 
-void ObjectWriter::FieldVector2b(const DataTag& tag, const bool* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector2b(const DataTag& tag, const bool* data) noexcept {
     FieldVector<bool, 2>(tag, DataType::Vector2b, data);
 }
 
-void ObjectWriter::FieldVector2f16(const DataTag& tag, const uint16_t* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector2f16(const DataTag& tag, const uint16_t* data) noexcept {
     FieldVector<uint16_t, 2>(tag, DataType::Vector2f16, data);
 }
 
-void ObjectWriter::FieldVector2f32(const DataTag& tag, const float* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector2f16(const DataTag& tag, const float* data) noexcept {
+    uint16_t halves[2];
+    FloatToHalfArray(data, halves, 2);
+    FieldVector<uint16_t, 2>(tag, DataType::Vector2f16, halves);
+}
+
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector2f32(const DataTag& tag, const float* data) noexcept {
     FieldVector<uint32_t, 2>(tag, DataType::Vector2f32, reinterpret_cast<const uint32_t*>(data));
 }
 
-void ObjectWriter::FieldVector2f64(const DataTag& tag, const double* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector2f64(const DataTag& tag, const double* data) noexcept {
     FieldVector<uint64_t, 2>(tag, DataType::Vector2f64, reinterpret_cast<const uint64_t*>(data));
 }
 
 // Vector 3
 
-void ObjectWriter::FieldVector3i8(const DataTag& tag, const int8_t* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector3i8(const DataTag& tag, const int8_t* data) noexcept {
     FieldVector<int8_t, 3>(tag, DataType::Vector3i8, data);
 }
 
-void ObjectWriter::FieldVector3i16(const DataTag& tag, const int16_t* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector3i16(const DataTag& tag, const int16_t* data) noexcept {
     FieldVector<int16_t, 3>(tag, DataType::Vector3i16, data);
 }
 
-void ObjectWriter::FieldVector3i32(const DataTag& tag, const int32_t* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector3i32(const DataTag& tag, const int32_t* data) noexcept {
     FieldVector<int32_t, 3>(tag, DataType::Vector3i32, data);
 }
 
-void ObjectWriter::FieldVector3i64(const DataTag& tag, const int64_t* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector3i64(const DataTag& tag, const int64_t* data) noexcept {
     FieldVector<int64_t, 3>(tag, DataType::Vector3i64, data);
 }
 
-void ObjectWriter::FieldVector3b(const DataTag& tag, const bool* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector3b(const DataTag& tag, const bool* data) noexcept {
     FieldVector<bool, 3>(tag, DataType::Vector3b, data);
 }
 
-void ObjectWriter::FieldVector3f16(const DataTag& tag, const uint16_t* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector3f16(const DataTag& tag, const uint16_t* data) noexcept {
     FieldVector<uint16_t, 3>(tag, DataType::Vector3f16, data);
 }
 
-void ObjectWriter::FieldVector3f32(const DataTag& tag, const float* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector3f16(const DataTag& tag, const float* data) noexcept {
+    uint16_t halves[3];
+    FloatToHalfArray(data, halves, 3);
+    FieldVector<uint16_t, 3>(tag, DataType::Vector3f16, halves);
+}
+
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector3f32(const DataTag& tag, const float* data) noexcept {
     FieldVector<uint32_t, 3>(tag, DataType::Vector3f32, reinterpret_cast<const uint32_t*>(data));
 }
 
-void ObjectWriter::FieldVector3f64(const DataTag& tag, const double* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector3f64(const DataTag& tag, const double* data) noexcept {
     FieldVector<uint64_t, 3>(tag, DataType::Vector3f64, reinterpret_cast<const uint64_t*>(data));
 }
 
 // Vector 4
 
-void ObjectWriter::FieldVector4i8(const DataTag& tag, const int8_t* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector4i8(const DataTag& tag, const int8_t* data) noexcept {
     FieldVector<int8_t, 4>(tag, DataType::Vector4i8, data);
 }
 
-void ObjectWriter::FieldVector4i16(const DataTag& tag, const int16_t* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector4i16(const DataTag& tag, const int16_t* data) noexcept {
     FieldVector<int16_t, 4>(tag, DataType::Vector4i16, data);
 }
 
-void ObjectWriter::FieldVector4i32(const DataTag& tag, const int32_t* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector4i32(const DataTag& tag, const int32_t* data) noexcept {
     FieldVector<int32_t, 4>(tag, DataType::Vector4i32, data);
 }
 
-void ObjectWriter::FieldVector4i64(const DataTag& tag, const int64_t* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector4i64(const DataTag& tag, const int64_t* data) noexcept {
     FieldVector<int64_t, 4>(tag, DataType::Vector4i64, data);
 }
 
-void ObjectWriter::FieldVector4b(const DataTag& tag, const bool* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector4b(const DataTag& tag, const bool* data) noexcept {
     FieldVector<bool, 4>(tag, DataType::Vector4b, data);
 }
 
-void ObjectWriter::FieldVector4f16(const DataTag& tag, const uint16_t* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector4f16(const DataTag& tag, const uint16_t* data) noexcept {
     FieldVector<uint16_t, 4>(tag, DataType::Vector4f16, data);
 }
 
-void ObjectWriter::FieldVector4f32(const DataTag& tag, const float* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector4f16(const DataTag& tag, const float* data) noexcept {
+    uint16_t halves[4];
+    FloatToHalfArray(data, halves, 4);
+    FieldVector<uint16_t, 4>(tag, DataType::Vector4f16, halves);
+}
+
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector4f32(const DataTag& tag, const float* data) noexcept {
     FieldVector<uint32_t, 4>(tag, DataType::Vector4f32, reinterpret_cast<const uint32_t*>(data));
 }
 
-void ObjectWriter::FieldVector4f64(const DataTag& tag, const double* data) noexcept {
+template <TagMode Mode>
+void BasicObjectWriter<Mode>::FieldVector4f64(const DataTag& tag, const double* data) noexcept {
     FieldVector<uint64_t, 4>(tag, DataType::Vector4f64, reinterpret_cast<const uint64_t*>(data));
 }
 
@@ -471,29 +944,90 @@ void ObjectWriter::FieldVector4f64(const DataTag& tag, const double* data) noexc
 // ArrayWriter
 // ---------------------------------
 
-ArrayWriter::ArrayWriter(ObjectWriter& obj) noexcept
+template <TagMode Mode>
+BasicArrayWriter<Mode>::BasicArrayWriter(BasicObjectWriter<Mode>& obj, ArrayLayout layout) noexcept
     : m_obj(obj),
-      m_is_finished(false) {
-    m_array_size_pos = obj.GetWriter().ReserveDataSizeField();
+      m_is_finished(false),
+      m_indexed(layout == ArrayLayout::Indexed) {
+    BasicWriter<Mode>& writer = obj.GetWriter();
+    m_array_size_pos = writer.ReserveDataSizeField();
+
+    // The element count of an indexed array is only known once the array is finished
+    if (m_indexed) {
+        writer.ReserveDataSizeField();
+    }
+    m_elements_pos = writer.m_buffer.Size();
 }
 
-void ArrayWriter::Finish() noexcept {
+template <TagMode Mode>
+void BasicArrayWriter<Mode>::BeginElement() noexcept {
+    if (m_indexed) {
+        m_offsets.push_back(static_cast<uint32_t>(m_obj.GetWriter().m_buffer.Size() - m_elements_pos));
+    }
+}
+
+template <TagMode Mode>
+void BasicArrayWriter<Mode>::Finish() noexcept {
     if (!IsFinished()) [[unlikely]] {
-        m_obj.GetWriter().WriteDataSizeField(m_array_size_pos);
+        BasicWriter<Mode>& writer = m_obj.GetWriter();
+
+        if (m_indexed) {
+            uint32_t count = static_cast<uint32_t>(m_offsets.size());
+            AdjustEndianess(count);
+            std::memcpy(writer.GetBufferPointer(m_elements_pos - sizeof(FieldSize)), &count, sizeof(count));
+
+            writer.ReserveBuffer(m_offsets.size() * sizeof(uint32_t));
+            for (uint32_t offset : m_offsets) {
+                writer.template WriteData<uint32_t>(offset);
+            }
+        }
+
+        writer.WriteDataSizeField(m_array_size_pos);
         m_is_finished = true;
     }
 }
 
-void StringArrayWriter::AddElement(std::string_view element) noexcept {
-    m_obj.GetWriter().WriteString(element);
+template <TagMode Mode>
+void BasicStringArrayWriter<Mode>::AddElement(std::string_view element) noexcept {
+    this->BeginElement();
+    this->m_obj.GetWriter().WriteString(element);
 }
 
-void BinaryArrayWriter::AddElement(const void* element, FieldSize size) noexcept {
-    m_obj.GetWriter().WriteBinary(element, size);
+template <TagMode Mode>
+void BasicBinaryArrayWriter<Mode>::AddElement(const void* element, FieldSize size) noexcept {
+    this->BeginElement();
+    this->m_obj.GetWriter().WriteBinary(element, size);
 }
 
-ObjectWriter ObjectArrayWriter::CreateElement() noexcept {
-    return ObjectWriter(m_obj.GetWriter());
+template <TagMode Mode>
+BasicObjectWriter<Mode> BasicObjectArrayWriter<Mode>::CreateElement() noexcept {
+    this->BeginElement();
+    return BasicObjectWriter<Mode>(this->m_obj.GetWriter());
 }
 
-}  // namespace tbf
\ No newline at end of file
+// ---------------------------------
+// Tag modes
+// ---------------------------------
+
+template class BasicWriter<TagMode::Runtime>;
+template class BasicObjectWriter<TagMode::Runtime>;
+template class BasicArrayWriter<TagMode::Runtime>;
+template class BasicStringArrayWriter<TagMode::Runtime>;
+template class BasicBinaryArrayWriter<TagMode::Runtime>;
+template class BasicObjectArrayWriter<TagMode::Runtime>;
+
+template class BasicWriter<TagMode::Name>;
+template class BasicObjectWriter<TagMode::Name>;
+template class BasicArrayWriter<TagMode::Name>;
+template class BasicStringArrayWriter<TagMode::Name>;
+template class BasicBinaryArrayWriter<TagMode::Name>;
+template class BasicObjectArrayWriter<TagMode::Name>;
+
+template class BasicWriter<TagMode::Id>;
+template class BasicObjectWriter<TagMode::Id>;
+template class BasicArrayWriter<TagMode::Id>;
+template class BasicStringArrayWriter<TagMode::Id>;
+template class BasicBinaryArrayWriter<TagMode::Id>;
+template class BasicObjectArrayWriter<TagMode::Id>;
+
+}  // namespace tbf
@@ -0,0 +1,413 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#include "tbf/DataTag.hpp"
+#include "tbf/Endianness.hpp"
+#include "tbf/FieldIndex.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/SizeCounter.hpp"
+#include "tbf/Writer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <vector>
+
+using namespace tbf;
+
+// Global allocation counter, shared by every test in the binary, including the multithreaded ones
+static std::atomic<size_t> g_allocation_count = 0;
+
+// Kept out of line, otherwise GCC inlines the frees into delete expressions of memory obtained
+// from operator new and reports them with -Wmismatched-new-delete
+[[gnu::noinline]]
+static void Deallocate(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void* operator new(std::size_t size) {
+    g_allocation_count++;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    Deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    Deallocate(ptr);
+}
+
+// std::pmr::new_delete_resource allocates through the aligned overloads
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    g_allocation_count++;
+    size_t align = static_cast<size_t>(alignment);
+    if (void* ptr = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    Deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    Deallocate(ptr);
+}
+
+// The array forms are replaced too, WriteBuffer chunks are allocated through them and sanitizers
+// do not forward them to the replacements above
+void* operator new[](std::size_t size) {
+    g_allocation_count++;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    g_allocation_count++;
+    size_t align = static_cast<size_t>(alignment);
+    if (void* ptr = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete[](void* ptr) noexcept {
+    Deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    Deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    Deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+    Deallocate(ptr);
+}
+
+namespace {
+
+constexpr DataTag TAG_TIMESTAMP = "timestamp";
+constexpr DataTag TAG_VALUE = "value";
+constexpr DataTag TAG_SENSOR = "sensor";
+constexpr DataTag TAG_SAMPLES = "samples";
+
+// A small telemetry document, written through an ObjectWriter or counted through a SizeCounter
+template <typename Object>
+void WriteTelemetryFields(Object& root) {
+    root.FieldInt64(TAG_TIMESTAMP, 1700000000);
+
+    auto sensor = root.FieldObject(TAG_SENSOR);
+    sensor.FieldFloat32(TAG_VALUE, 21.5f);
+    sensor.Finish();
+
+    auto samples = root.FieldObjectArray(TAG_SAMPLES);
+    for (int i = 0; i < 4; i++) {
+        auto sample = samples.CreateElement();
+        sample.FieldInt64(TAG_TIMESTAMP, i);
+        sample.FieldFloat32(TAG_VALUE, static_cast<float>(i));
+        sample.Finish();
+    }
+    samples.Finish();
+
+    root.Finish();
+}
+
+void WriteTelemetry(Writer& writer) {
+    WriteTelemetryFields(writer.RootObject());
+}
+
+// Forwards to the default resource and counts the allocations it serves
+class CountingResource : public std::pmr::memory_resource {
+   public:
+    size_t allocation_count = 0;
+    size_t allocated_bytes = 0;
+
+   private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        allocation_count++;
+        allocated_bytes += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// Array of objects that are all too large for the inline field storage
+void WriteLargeObjectArray(Writer& writer, uint32_t element_count) {
+    constexpr uint32_t FIELD_COUNT = FieldIndex::INLINE_CAPACITY + 4;
+
+    auto samples = writer.RootObject().FieldObjectArray(TAG_SAMPLES);
+    for (uint32_t i = 0; i < element_count; i++) {
+        auto sample = samples.CreateElement();
+        for (uint32_t field = 1; field <= FIELD_COUNT; field++) {
+            sample.FieldInt32(DataTag(static_cast<DataTag::Id>(field)), static_cast<int32_t>(i));
+        }
+        sample.Finish();
+    }
+    samples.Finish();
+
+    writer.Finish();
+}
+
+int64_t SumLargeObjectArray(const Reader& reader) {
+    auto samples = reader.RootObject().ReadObjectArray(TAG_SAMPLES);
+    if (!samples.has_value()) {
+        return -1;
+    }
+
+    int64_t sum = 0;
+    for (const auto& sample : *samples) {
+        sum += sample.ReadInt32(DataTag(static_cast<DataTag::Id>(2))).value_or(0);
+    }
+    return sum;
+}
+
+}  // namespace
+
+TEST(AllocationsTest, SmallObjectsAreReadWithoutAllocating) {
+    if constexpr (FieldIndex::INLINE_CAPACITY < 3) {
+        GTEST_SKIP() << "Inline field storage is disabled";
+    }
+
+    for (bool name_based : {true, false}) {
+        for (IndexMode mode : {IndexMode::Eager, IndexMode::Lazy}) {
+            Writer writer(name_based);
+            WriteTelemetry(writer);
+
+            size_t allocations_before = g_allocation_count;
+
+            Reader reader(writer.Data(), writer.Size(), name_based, mode);
+            const auto& root = reader.RootObject();
+
+            ASSERT_TRUE(root.IsValid());
+            EXPECT_EQ(root.ReadInt64(TAG_TIMESTAMP).value_or(0), 1700000000);
+
+            auto sensor = root.ReadObject(TAG_SENSOR);
+            ASSERT_TRUE(sensor.has_value());
+            EXPECT_EQ(sensor->ReadFloat32(TAG_VALUE).value_or(0.0f), 21.5f);
+
+            auto samples = root.ReadObjectArray(TAG_SAMPLES);
+            ASSERT_TRUE(samples.has_value());
+
+            int64_t expected = 0;
+            for (const auto& sample : *samples) {
+                EXPECT_EQ(sample.ReadInt64(TAG_TIMESTAMP).value_or(-1), expected++);
+            }
+
+            EXPECT_EQ(g_allocation_count, allocations_before);
+        }
+    }
+}
+
+TEST(AllocationsTest, LargeObjectsFallBackToHeapIndex) {
+    constexpr uint32_t FIELD_COUNT = FieldIndex::INLINE_CAPACITY + 5;
+
+    for (IndexMode mode : {IndexMode::Eager, IndexMode::Lazy}) {
+        Writer writer(false);
+        for (uint32_t i = 1; i <= FIELD_COUNT; i++) {
+            writer.RootObject().FieldInt32(DataTag(static_cast<DataTag::Id>(i)), static_cast<int32_t>(i));
+        }
+        writer.RootObject().FieldInt32(DataTag(static_cast<DataTag::Id>(1)), -1);
+        writer.Finish();
+
+        Reader reader(writer.Data(), writer.Size(), false, mode);
+        const auto& root = reader.RootObject();
+
+        // Read backwards so lazy mode moves from inline storage to the heap table mid-scan
+        for (uint32_t i = FIELD_COUNT; i >= 1; i--) {
+            EXPECT_EQ(root.ReadInt32(DataTag(static_cast<DataTag::Id>(i))).value_or(0), static_cast<int32_t>(i));
+        }
+
+        EXPECT_TRUE(root.IsValid());
+        EXPECT_EQ(root.GetAllTags().size(), FIELD_COUNT);
+    }
+}
+
+TEST(AllocationsTest, CustomResourceServesNestedIndexes) {
+    constexpr uint32_t ELEMENT_COUNT = 16;
+
+    Writer writer(false);
+    WriteLargeObjectArray(writer, ELEMENT_COUNT);
+
+    CountingResource resource;
+    size_t allocations_before = g_allocation_count;
+
+    {
+        Reader reader(writer.Data(), writer.Size(), false, IndexMode::Eager, &resource);
+        EXPECT_EQ(reader.RootObject().GetMemoryResource(), &resource);
+        EXPECT_EQ(SumLargeObjectArray(reader), ELEMENT_COUNT * (ELEMENT_COUNT - 1) / 2);
+    }
+
+    // Every index allocation went through the resource
+    EXPECT_GE(resource.allocation_count, ELEMENT_COUNT);
+    EXPECT_EQ(g_allocation_count - allocations_before, resource.allocation_count);
+}
+
+TEST(AllocationsTest, ReaderArenaBatchesAllocations) {
+    constexpr uint32_t ELEMENT_COUNT = 256;
+
+    Writer writer(false);
+    WriteLargeObjectArray(writer, ELEMENT_COUNT);
+
+    size_t allocations_before = g_allocation_count;
+
+    Reader reader(writer.Data(), writer.Size(), false, IndexMode::Eager, nullptr);
+    EXPECT_EQ(SumLargeObjectArray(reader), ELEMENT_COUNT * (ELEMENT_COUNT - 1) / 2);
+
+    // The arena grows geometrically, so the element indexes share a handful of blocks
+    EXPECT_LT(g_allocation_count - allocations_before, ELEMENT_COUNT / 8);
+}
+
+TEST(AllocationsTest, VisitingLargeObjectsDoesNotAllocate) {
+    for (bool name_based : {true, false}) {
+        Writer writer(name_based);
+        WriteLargeObjectArray(writer, 16);
+
+        size_t allocations_before = g_allocation_count;
+
+        Reader reader(writer.Data(), writer.Size(), name_based, IndexMode::Lazy, std::pmr::null_memory_resource());
+
+        int64_t sum = 0;
+        bool complete = reader.RootObject().Visit([&sum](const FieldView& field) {
+            int32_t value;
+            if (field.Get<DataType::Int32>(value)) {
+                sum += value;
+            }
+            return VisitAction::Continue;
+        });
+
+        uint32_t root_fields = 0;
+        for (const FieldView& field : reader.RootObject().Fields()) {
+            root_fields += field.GetType() == DataType::ObjectArray ? 1 : 0;
+        }
+
+        EXPECT_TRUE(complete);
+        EXPECT_EQ(root_fields, 1u);
+        EXPECT_EQ(sum, int64_t(FieldIndex::INLINE_CAPACITY + 4) * (15 * 16 / 2));
+        EXPECT_EQ(g_allocation_count, allocations_before);
+    }
+}
+
+TEST(AllocationsTest, DocumentIndexIsNotSizedFromBlobs) {
+    constexpr DataTag TAG_BLOB = "blob";
+    const std::vector<uint8_t> blob(16 << 20, 0xAB);
+
+    Writer writer(true);
+    writer.RootObject().FieldInt64(TAG_TIMESTAMP, 1700000000);
+    writer.RootObject().FieldBinary(TAG_BLOB, blob.data(), blob.size());
+    writer.Finish();
+
+    CountingResource resource;
+    Reader reader(writer.Data(), writer.Size(), true, IndexMode::Document, &resource);
+    EXPECT_EQ(reader.RootObject().ReadInt64(TAG_TIMESTAMP), 1700000000);
+
+    // Two fields need a few hundred bytes of index, not an amount proportional to the document
+    EXPECT_LT(resource.allocated_bytes, size_t{1} << 16);
+}
+
+TEST(AllocationsTest, SizedDocumentsAreWrittenWithOneAllocation) {
+    for (bool name_based : {true, false}) {
+        size_t allocations_before = g_allocation_count;
+        SizeCounter counter(name_based);
+        WriteTelemetryFields(counter);
+        EXPECT_EQ(g_allocation_count, allocations_before);
+
+        // One buffer of the counted capacity
+        allocations_before = g_allocation_count;
+        {
+            Writer writer(counter);
+            WriteTelemetryFields(writer.RootObject());
+            EXPECT_EQ(writer.Size(), counter.Size());
+            EXPECT_NE(writer.Data(), nullptr);
+        }
+        EXPECT_EQ(g_allocation_count, allocations_before + 1);
+
+        // None at all in a buffer of the caller
+        std::vector<uint8_t> buffer(counter.Capacity());
+        allocations_before = g_allocation_count;
+        {
+            Writer writer(std::span<uint8_t>(buffer), name_based);
+            WriteTelemetryFields(writer.RootObject());
+            EXPECT_EQ(writer.Data(), buffer.data());
+        }
+        EXPECT_EQ(g_allocation_count, allocations_before);
+    }
+}
+
+TEST(AllocationsTest, RepeatedArrayReadsConvertOnce) {
+    constexpr DataTag TAG_COUNT = "count";
+    constexpr DataTag TAG_VALUES = "values";
+    std::vector<int32_t> values(250000);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int32_t>(i);
+    }
+
+    Writer writer(true);
+    writer.RootObject().FieldInt32(TAG_COUNT, static_cast<int32_t>(values.size()));
+    writer.RootObject().FieldArrayInt32(TAG_VALUES, std::span<const int32_t>(values));
+    writer.Finish();
+
+    CountingResource resource;
+    Reader reader(writer.Data(), writer.Size(), true, IndexMode::Eager, &resource);
+    const ObjectReader& root = reader.RootObject();
+
+    // Builds the index, whatever its inline capacity
+    EXPECT_EQ(root.ReadInt32(TAG_COUNT), static_cast<int32_t>(values.size()));
+    const size_t index_allocations = resource.allocation_count;
+
+    std::span<const int32_t> first = root.ReadInt32Array(TAG_VALUES);
+    ASSERT_EQ(first.size(), values.size());
+    EXPECT_EQ(first[12345], 12345);
+
+    // A buffer in the other byte order is converted on the first read only
+    const size_t allocations_after_first = resource.allocation_count;
+    EXPECT_EQ(allocations_after_first, index_allocations + (NEEDS_BYTE_SWAP ? 1 : 0));
+
+    for (int i = 0; i < 8; i++) {
+        std::span<const int32_t> again = root.ReadInt32Array(TAG_VALUES);
+        EXPECT_EQ(again.data(), first.data());
+    }
+    EXPECT_EQ(resource.allocation_count, allocations_after_first);
+}
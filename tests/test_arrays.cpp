@@ -29,7 +29,12 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <bit>
+#include <span>
 #include <cstdint>
+#include <string>
+#include <string_view>
 #include <vector>
 
 using namespace tbf;
@@ -40,6 +45,8 @@ constexpr DataTag TAG_INT_ARRAY = "int_array";
 constexpr DataTag TAG_STRING_ARRAY = "string_array";
 constexpr DataTag TAG_FLOAT_ARRAY = "float_array";
 constexpr DataTag TAG_BINARY_ARRAY = "binary_array";
+constexpr DataTag TAG_OBJECT_ARRAY = "object_array";
+constexpr DataTag TAG_INDEX = "index";
 
 }  // namespace
 
@@ -67,6 +74,65 @@ TEST(ArraysTest, Int32ArrayReadWrite) {
     }
 }
 
+TEST(ArraysTest, CopyArrayIntoCallerBuffer) {
+    Writer writer(true);
+    auto& root = writer.RootObject();
+
+    int64_t int_data[] = {-1, 1ll << 40, 7};
+    root.FieldArrayInt64(TAG_INT_ARRAY, int_data, 3);
+    root.FieldString(TAG_STRING_ARRAY, "not an array");
+
+    writer.Finish();
+
+    const uint8_t* begin = static_cast<const uint8_t*>(writer.Data());
+    const std::vector<uint8_t> original(begin, begin + writer.Size());
+
+    Reader reader(writer.Data(), writer.Size(), true);
+    const auto& read_root = reader.RootObject();
+
+    int64_t copied[4] = {};
+    auto length = read_root.CopyArray<DataType::Int64Array>(TAG_INT_ARRAY, std::span<int64_t>(copied));
+    ASSERT_TRUE(length.has_value());
+    ASSERT_EQ(*length, 3u);
+    for (size_t i = 0; i < 3; i++) {
+        EXPECT_EQ(copied[i], int_data[i]);
+    }
+
+    // Views match the copy whatever the byte order, and reading never writes to the buffer
+    auto view = read_root.ReadInt64Array(TAG_INT_ARRAY);
+    ASSERT_EQ(view.size(), 3u);
+    EXPECT_TRUE(std::equal(view.begin(), view.end(), copied));
+    EXPECT_TRUE(std::equal(original.begin(), original.end(), begin));
+
+    int64_t too_small[2];
+    EXPECT_FALSE(read_root.CopyArray<DataType::Int64Array>(TAG_INT_ARRAY, std::span<int64_t>(too_small)).has_value());
+    EXPECT_FALSE(read_root.CopyArray<DataType::Int64Array>(TAG_STRING_ARRAY, std::span<int64_t>(copied)).has_value());
+    EXPECT_FALSE(read_root.CopyArray<DataType::UInt64Array>(TAG_INT_ARRAY, std::span<uint64_t>()).has_value());
+}
+
+TEST(ArraysTest, ByteSwapArrayMatchesScalar) {
+    // Odd lengths leave a tail after the last whole vector block
+    std::vector<uint8_t> source(8 * 37);
+    for (size_t i = 0; i < source.size(); i++) {
+        source[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+
+    auto check = [&]<uint32_t size>() {
+        const size_t count = source.size() / size;
+        std::vector<uint8_t> expected(source.size());
+        std::vector<uint8_t> swapped(source.size());
+        detail::ByteSwapScalar<size>(expected.data(), source.data(), count);
+        ByteSwapArray<size>(swapped.data(), source.data(), count);
+        EXPECT_EQ(swapped, expected) << size << " byte elements";
+
+        ByteSwapArray<size>(swapped.data(), swapped.data(), count);
+        EXPECT_EQ(swapped, source) << size << " byte elements, in place";
+    };
+    check.template operator()<2>();
+    check.template operator()<4>();
+    check.template operator()<8>();
+}
+
 TEST(ArraysTest, StringArrayReadWrite) {
     Writer writer(true);
     auto& root = writer.RootObject();
@@ -260,6 +326,58 @@ TEST(ArraysTest, EmptyArrays) {
     EXPECT_EQ(count, 0);
 }
 
+TEST(ArraysTest, EmptyPayloadsWithNullData) {
+    constexpr DataTag TAG_STRING = "string";
+    constexpr DataTag TAG_BINARY = "binary";
+
+    for (bool name_based : {true, false}) {
+        Writer writer(name_based);
+        auto& root = writer.RootObject();
+
+        // Empty payloads commonly come with a null pointer
+        root.FieldArrayInt32(TAG_INT_ARRAY, std::span<const int32_t>());
+        root.FieldBinary(TAG_BINARY, nullptr, 0);
+        root.FieldString(TAG_STRING, std::string_view());
+
+        auto string_array = root.FieldStringArray(TAG_STRING_ARRAY);
+        string_array.AddElement(std::string_view());
+        string_array.AddElement("after");
+        string_array.Finish();
+
+        auto binary_array = root.FieldBinaryArray(TAG_BINARY_ARRAY);
+        binary_array.AddElement(nullptr, 0);
+        binary_array.Finish();
+
+        writer.Finish();
+
+        Reader reader(writer.Data(), writer.Size(), name_based);
+        const auto& read_root = reader.RootObject();
+
+        ASSERT_TRUE(read_root.IsValid());
+        EXPECT_TRUE(read_root.ContainsTag(TAG_INT_ARRAY));
+        EXPECT_TRUE(read_root.ReadInt32Array(TAG_INT_ARRAY).empty());
+        EXPECT_EQ(read_root.ReadBinary(TAG_BINARY).size(), 0u);
+
+        auto str = read_root.ReadString(TAG_STRING);
+        ASSERT_TRUE(str.has_value());
+        EXPECT_TRUE(str->empty());
+
+        auto str_array = read_root.ReadStringArray(TAG_STRING_ARRAY);
+        ASSERT_TRUE(str_array.has_value());
+        ASSERT_EQ(str_array->Size(), 2u);
+        EXPECT_EQ(str_array->GetElement(0).value_or("missing"), "");
+        EXPECT_EQ(str_array->GetElement(1).value_or(""), "after");
+
+        auto bin_array = read_root.ReadBinaryArray(TAG_BINARY_ARRAY);
+        ASSERT_TRUE(bin_array.has_value());
+        ASSERT_EQ(bin_array->Size(), 1u);
+        const void* element = nullptr;
+        FieldSize element_size = 1;
+        EXPECT_TRUE(bin_array->GetElement(0, element, element_size));
+        EXPECT_EQ(element_size, 0u);
+    }
+}
+
 TEST(ArraysTest, NonExistentArray) {
     Writer writer(true);
     auto& root = writer.RootObject();
@@ -284,3 +402,197 @@ TEST(ArraysTest, NonExistentArray) {
     auto str_array = read_root.ReadStringArray(TAG_STRING_ARRAY);
     EXPECT_FALSE(str_array.has_value());
 }
+
+TEST(ArraysTest, RandomAccessMatchesIteration) {
+    constexpr uint32_t ELEMENT_COUNT = 1000;
+
+    Writer writer(true);
+    auto& root = writer.RootObject();
+
+    std::vector<std::string> strings;
+    auto string_array = root.FieldStringArray(TAG_STRING_ARRAY);
+    for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+        strings.push_back(std::string(i % 7, 'a') + std::to_string(i));
+        string_array.AddElement(strings.back());
+    }
+    string_array.Finish();
+
+    auto object_array = root.FieldObjectArray(TAG_OBJECT_ARRAY);
+    for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+        auto element = object_array.CreateElement();
+        element.FieldUInt32(TAG_INDEX, i);
+        if (i % 3 == 0) {
+            element.FieldString(TAG_STRING_ARRAY, strings[i]);
+        }
+        element.Finish();
+    }
+    object_array.Finish();
+
+    writer.Finish();
+
+    Reader reader(writer.Data(), writer.Size(), true);
+    const auto& read_root = reader.RootObject();
+
+    auto read_strings = read_root.ReadStringArray(TAG_STRING_ARRAY);
+    auto read_objects = read_root.ReadObjectArray(TAG_OBJECT_ARRAY);
+    ASSERT_TRUE(read_strings.has_value());
+    ASSERT_TRUE(read_objects.has_value());
+    ASSERT_EQ(read_strings->Size(), ELEMENT_COUNT);
+    ASSERT_EQ(read_objects->Size(), ELEMENT_COUNT);
+
+    // Backwards, so the first access is past the linear access range, then the first elements
+    for (uint32_t i = ELEMENT_COUNT; i-- > 0;) {
+        EXPECT_EQ(read_strings->GetElement(i).value_or(""), strings[i]);
+
+        auto element = read_objects->GetElement(i);
+        ASSERT_TRUE(element.has_value());
+        EXPECT_EQ(element->ReadUInt32(TAG_INDEX).value_or(ELEMENT_COUNT), i);
+    }
+
+    EXPECT_FALSE(read_strings->GetElement(ELEMENT_COUNT).has_value());
+    EXPECT_FALSE(read_objects->GetElement(ELEMENT_COUNT).has_value());
+
+    // Small indexes on a fresh reader are served without the offset table
+    auto fresh_strings = read_root.ReadStringArray(TAG_STRING_ARRAY);
+    EXPECT_EQ(fresh_strings->GetElement(3).value_or(""), strings[3]);
+}
+
+TEST(ArraysTest, IndexedArraysReadWrite) {
+    constexpr uint32_t ELEMENT_COUNT = 100;
+
+    Writer writer(true);
+    auto& root = writer.RootObject();
+
+    std::vector<std::string> strings;
+    for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+        strings.push_back(std::string(i % 5, 'x') + std::to_string(i));
+    }
+    std::vector<std::string_view> views(strings.begin(), strings.end());
+    root.FieldStringArray(TAG_STRING_ARRAY, views.data(), ELEMENT_COUNT, ArrayLayout::Indexed);
+
+    const uint8_t blob[] = {1, 2, 3, 4};
+    {
+        auto binary_array = root.FieldBinaryArray(TAG_BINARY_ARRAY, ArrayLayout::Indexed);
+        for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+            binary_array.AddElement(blob, i % 5);
+        }
+    }
+
+    auto object_array = root.FieldObjectArray(TAG_OBJECT_ARRAY, ArrayLayout::Indexed);
+    for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+        auto element = object_array.CreateElement();
+        element.FieldUInt32(TAG_INDEX, i);
+        element.Finish();
+    }
+    object_array.Finish();
+
+    { auto empty = root.FieldStringArray(TAG_INT_ARRAY, ArrayLayout::Indexed); }
+
+    writer.Finish();
+
+    ASSERT_TRUE(Reader::Validate(writer.Data(), writer.Size(), true));
+
+    for (IndexMode mode : {IndexMode::Eager, IndexMode::Document}) {
+        Reader reader(writer.Data(), writer.Size(), true, mode);
+        const auto& read_root = reader.RootObject();
+
+        EXPECT_EQ(read_root.GetTagType(TAG_STRING_ARRAY), DataType::IndexedStringArray);
+
+        auto read_strings = read_root.ReadStringArray(TAG_STRING_ARRAY);
+        auto read_binaries = read_root.ReadBinaryArray(TAG_BINARY_ARRAY);
+        auto read_objects = read_root.ReadObjectArray(TAG_OBJECT_ARRAY);
+        auto read_empty = read_root.ReadStringArray(TAG_INT_ARRAY);
+        ASSERT_TRUE(read_strings.has_value() && read_strings->IsValid());
+        ASSERT_TRUE(read_binaries.has_value() && read_binaries->IsValid());
+        ASSERT_TRUE(read_objects.has_value() && read_objects->IsValid());
+        ASSERT_TRUE(read_empty.has_value() && read_empty->IsValid());
+
+        ASSERT_EQ(read_strings->Size(), ELEMENT_COUNT);
+        ASSERT_EQ(read_binaries->Size(), ELEMENT_COUNT);
+        ASSERT_EQ(read_objects->Size(), ELEMENT_COUNT);
+        EXPECT_EQ(read_empty->Size(), 0u);
+        EXPECT_EQ(read_empty->begin(), read_empty->end());
+
+        for (uint32_t i = ELEMENT_COUNT; i-- > 0;) {
+            EXPECT_EQ(read_strings->GetElement(i).value_or(""), strings[i]);
+
+            const void* data;
+            FieldSize size;
+            ASSERT_TRUE(read_binaries->GetElement(i, data, size));
+            EXPECT_EQ(size, i % 5);
+
+            auto element = read_objects->GetElement(i);
+            ASSERT_TRUE(element.has_value());
+            EXPECT_EQ(element->ReadUInt32(TAG_INDEX).value_or(ELEMENT_COUNT), i);
+        }
+        EXPECT_FALSE(read_strings->GetElement(ELEMENT_COUNT).has_value());
+
+        // Iteration stops at the offset table
+        uint32_t index = 0;
+        for (std::string_view value : *read_strings) {
+            EXPECT_EQ(value, strings[index++]);
+        }
+        EXPECT_EQ(index, ELEMENT_COUNT);
+
+        index = 0;
+        for (auto element : *read_objects) {
+            EXPECT_EQ(element.ReadUInt32(TAG_INDEX).value_or(ELEMENT_COUNT), index++);
+        }
+        EXPECT_EQ(index, ELEMENT_COUNT);
+    }
+}
+
+TEST(ArraysTest, IndexedArrayWithCorruptOffsetTable) {
+    Writer writer(true);
+    auto& root = writer.RootObject();
+    {
+        auto string_array = root.FieldStringArray(TAG_STRING_ARRAY, ArrayLayout::Indexed);
+        string_array.AddElement("first");
+        string_array.AddElement("second");
+    }
+    writer.Finish();
+
+    const uint8_t* begin = static_cast<const uint8_t*>(writer.Data());
+    std::vector<uint8_t> data(begin, begin + writer.Size());
+
+    // The array is the last field, so its offset table ends the buffer: {0, 7}
+    const size_t last_offset = TBF_ENDIANESS == std::endian::little ? data.size() - 4 : data.size() - 1;
+    ASSERT_EQ(data[last_offset], 7u);
+    data[last_offset] = 6;
+
+    EXPECT_FALSE(Reader::Validate(data.data(), data.size(), true));
+
+    Reader reader(data.data(), data.size(), true);
+    auto strings = reader.RootObject().ReadStringArray(TAG_STRING_ARRAY);
+    ASSERT_TRUE(strings.has_value());
+    EXPECT_FALSE(strings->IsValid());
+    EXPECT_EQ(strings->Size(), 0u);
+}
+
+TEST(ArraysTest, PlainArrayWithTruncatedElementSize) {
+    Writer writer(true);
+    auto& root = writer.RootObject();
+    {
+        auto string_array = root.FieldStringArray(TAG_STRING_ARRAY);
+        string_array.AddElement("first");
+        string_array.AddElement("");
+    }
+    writer.Finish();
+
+    const uint8_t* begin = static_cast<const uint8_t*>(writer.Data());
+    std::vector<uint8_t> data(begin, begin + writer.Size());
+
+    // The array is the last field, so the size prefix of its empty element ends the buffer
+    const size_t low_byte = TBF_ENDIANESS == std::endian::little ? data.size() - 2 : data.size() - 1;
+    ASSERT_EQ(data[low_byte], 0u);
+    data[low_byte] = 5;
+
+    EXPECT_FALSE(Reader::Validate(data.data(), data.size(), true));
+
+    Reader reader(data.data(), data.size(), true);
+    auto strings = reader.RootObject().ReadStringArray(TAG_STRING_ARRAY);
+    ASSERT_TRUE(strings.has_value());
+    EXPECT_FALSE(strings->IsValid());
+    EXPECT_EQ(strings->Size(), 0u);
+    EXPECT_TRUE(strings->begin() == strings->end());
+}
@@ -0,0 +1,200 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#include "tbf/BitPacking.hpp"
+#include "tbf/DataTag.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+constexpr DataTag TAG_VISIBLE = "visible";
+constexpr DataTag TAG_SELECTED = "selected";
+constexpr DataTag TAG_COMBINED = "combined";
+
+std::vector<bool> RandomBools(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<bool> values(count);
+    for (size_t i = 0; i < count; i++) {
+        values[i] = (rng() & 3) == 0;
+    }
+    return values;
+}
+
+// std::vector<bool> is itself packed, the kernels take plain arrays
+std::unique_ptr<bool[]> ToArray(const std::vector<bool>& values) {
+    auto array = std::make_unique<bool[]>(values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        array[i] = values[i];
+    }
+    return array;
+}
+
+}  // namespace
+
+TEST(BitPackingTest, PackAndUnpackRoundTrip) {
+    // Lengths around the 16 and 32 element vector blocks and the 8 element bytes
+    for (size_t count : {0, 1, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000}) {
+        const std::vector<bool> values = RandomBools(count, static_cast<uint32_t>(count));
+        auto bools = ToArray(values);
+
+        std::vector<uint8_t> bits(PackedBitsSize(count), 0xFF);
+        PackBooleans(bools.get(), bits.data(), count);
+
+        for (size_t i = 0; i < count; i++) {
+            ASSERT_EQ(GetPackedBit(bits.data(), i), values[i]) << count << " elements, index " << i;
+        }
+        if (count % 8 != 0) {
+            EXPECT_EQ(bits.back() >> (count % 8), 0) << "unused bits must be zero";
+        }
+
+        auto unpacked = std::make_unique<bool[]>(count + 1);
+        unpacked[count] = true;
+        UnpackBooleans(bits.data(), unpacked.get(), count);
+        for (size_t i = 0; i < count; i++) {
+            ASSERT_EQ(unpacked[i], values[i]) << count << " elements, index " << i;
+        }
+        EXPECT_TRUE(unpacked[count]) << "wrote past the end";
+    }
+}
+
+TEST(BitPackingTest, QueriesIgnoreUnusedBits) {
+    // 12 elements, set bits 3 and 10, with garbage in the unused high bits of the last byte
+    const uint8_t bits[2] = {0b00001000, 0b11110100};
+
+    EXPECT_EQ(CountSetBits(bits, 12), 2u);
+    EXPECT_EQ(FindFirstBit(bits, 12, true), 3u);
+    EXPECT_EQ(FindFirstBit(bits, 12, true, 4), 10u);
+    EXPECT_EQ(FindFirstBit(bits, 12, true, 11), 12u);
+    EXPECT_EQ(FindFirstBit(bits, 12, false), 0u);
+    EXPECT_EQ(FindFirstBit(bits, 12, false, 10), 11u);
+
+    const uint8_t ones[2] = {0xFF, 0xFF};
+    EXPECT_EQ(CountCombinedBits(bits, ones, 12, BitOperation::Xor), 10u);
+
+    uint8_t combined[2];
+    CombineBits(bits, ones, combined, 12, BitOperation::Or);
+    EXPECT_EQ(combined[0], 0xFF);
+    EXPECT_EQ(combined[1], 0x0F);
+}
+
+TEST(BitPackingTest, PackedBooleanArrayReadWrite) {
+    constexpr size_t COUNT = 1000;
+    const std::vector<bool> visible = RandomBools(COUNT, 1);
+    const std::vector<bool> selected = RandomBools(COUNT, 2);
+    auto visible_array = ToArray(visible);
+
+    std::vector<uint8_t> selected_bits(PackedBitsSize(COUNT));
+    PackBooleans(ToArray(selected).get(), selected_bits.data(), COUNT);
+
+    Writer writer(true);
+    auto& root = writer.RootObject();
+    root.FieldPackedBooleanArray(TAG_VISIBLE, std::span<const bool>(visible_array.get(), COUNT));
+    root.FieldPackedBits(TAG_SELECTED, selected_bits.data(), COUNT);
+    writer.Finish();
+
+    // 4 byte count and 125 bytes of bits instead of 1000 bytes
+    EXPECT_LT(writer.Size(), 2 * (4 + 4 + 125) + 64);
+    EXPECT_TRUE(Reader::Validate(writer.Data(), writer.Size(), true));
+
+    Reader reader(writer.Data(), writer.Size(), true);
+    const auto& read_root = reader.RootObject();
+    EXPECT_TRUE(read_root.ReadBooleanArray(TAG_VISIBLE).empty());
+
+    auto read_visible = read_root.ReadPackedBooleanArray(TAG_VISIBLE);
+    auto read_selected = read_root.ReadPackedBooleanArray(TAG_SELECTED);
+    ASSERT_TRUE(read_visible.has_value() && read_visible->IsValid());
+    ASSERT_TRUE(read_selected.has_value() && read_selected->IsValid());
+    ASSERT_EQ(read_visible->Size(), COUNT);
+
+    size_t expected_set = 0;
+    size_t expected_both = 0;
+    size_t first_set = COUNT;
+    for (size_t i = 0; i < COUNT; i++) {
+        EXPECT_EQ(read_visible->GetElement(static_cast<uint32_t>(i)), visible[i]);
+        expected_set += visible[i];
+        expected_both += visible[i] && selected[i];
+        if (visible[i] && first_set == COUNT) {
+            first_set = i;
+        }
+    }
+    EXPECT_FALSE(read_visible->GetElement(COUNT).has_value());
+    EXPECT_EQ(read_visible->CountSet(), expected_set);
+    EXPECT_EQ(read_visible->FindFirst(), first_set);
+    EXPECT_EQ(read_visible->CountCombined(*read_selected, BitOperation::And), expected_both);
+
+    auto unpacked = std::make_unique<bool[]>(COUNT);
+    ASSERT_TRUE(read_visible->Unpack(std::span<bool>(unpacked.get(), COUNT)));
+    for (size_t i = 0; i < COUNT; i++) {
+        EXPECT_EQ(unpacked[i], visible[i]);
+    }
+
+    // The combined bits can be written back as a new array
+    std::vector<uint8_t> both(PackedBitsSize(COUNT));
+    ASSERT_TRUE(read_visible->Combine(*read_selected, BitOperation::And, both));
+
+    Writer combined_writer(true);
+    combined_writer.RootObject().FieldPackedBits(TAG_COMBINED, both.data(), COUNT);
+    combined_writer.Finish();
+
+    Reader combined_reader(combined_writer.Data(), combined_writer.Size(), true);
+    auto combined = combined_reader.RootObject().ReadPackedBooleanArray(TAG_COMBINED);
+    ASSERT_TRUE(combined.has_value());
+    EXPECT_EQ(combined->CountSet(), expected_both);
+}
+
+TEST(BitPackingTest, PackedBooleanArrayWithWrongCountIsInvalid) {
+    const bool values[10] = {true, false, true};
+
+    Writer writer(false);
+    writer.RootObject().FieldPackedBooleanArray(TAG_VISIBLE, values, 10);
+    writer.Finish();
+
+    const uint8_t* begin = static_cast<const uint8_t*>(writer.Data());
+    std::vector<uint8_t> data(begin, begin + writer.Size());
+
+    // Root size, type byte, tag ID and array size come before the count
+    const size_t count_low_byte = 4 + 1 + 2 + 4 + (TBF_ENDIANESS == std::endian::little ? 0 : 3);
+    ASSERT_EQ(data[count_low_byte], 10u);
+    data[count_low_byte] = 17;
+
+    EXPECT_FALSE(Reader::Validate(data.data(), data.size(), false));
+
+    Reader reader(data.data(), data.size(), false);
+    auto array = reader.RootObject().ReadPackedBooleanArray(TAG_VISIBLE);
+    ASSERT_TRUE(array.has_value());
+    EXPECT_FALSE(array->IsValid());
+    EXPECT_EQ(array->Size(), 0u);
+}
@@ -0,0 +1,305 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#include "tbf/Compression.hpp"
+#include "tbf/DataTag.hpp"
+#include "tbf/Endianness.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+constexpr DataTag TAG_BLOB = "blob";
+constexpr DataTag TAG_SAMPLES = "samples";
+constexpr DataTag TAG_CONFIG = "config";
+constexpr DataTag TAG_NAME = "name";
+constexpr DataTag TAG_VALUE = "value";
+
+// Log lines repeating a few words and numbers, compressible like most text
+std::vector<uint8_t> TextPayload(size_t size) {
+    static const char* const WORDS[] = {"GET", "POST", "/api/v1/users", "/api/v1/orders", "200", "404", "user-agent", "ms\n"};
+    std::mt19937 rng(static_cast<uint32_t>(size));
+    std::string text;
+    while (text.size() < size) {
+        text += WORDS[rng() % std::size(WORDS)];
+        text += ' ';
+        text += std::to_string(rng() % 1000);
+        text += ' ';
+    }
+    return std::vector<uint8_t>(text.begin(), text.begin() + static_cast<std::ptrdiff_t>(size));
+}
+
+std::vector<uint8_t> RandomPayload(size_t size) {
+    std::mt19937 rng(static_cast<uint32_t>(size));
+    std::vector<uint8_t> data(size);
+    for (uint8_t& byte : data) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    return data;
+}
+
+void ExpectRoundTrip(const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> compressed(MaxCompressedSize(data.size()));
+    const size_t size = CompressBlock(data.data(), data.size(), compressed.data());
+    ASSERT_LE(size, compressed.size()) << data.size();
+
+    std::vector<uint8_t> decompressed(data.size());
+    ASSERT_TRUE(DecompressBlock(compressed.data(), size, decompressed.data(), data.size())) << data.size();
+    EXPECT_EQ(decompressed, data) << data.size();
+
+    // The raw size must be exact and the data must end with the last sequence
+    decompressed.resize(data.size() + 1);
+    EXPECT_FALSE(DecompressBlock(compressed.data(), size, decompressed.data(), data.size() + 1)) << data.size();
+    if (!data.empty()) {
+        EXPECT_FALSE(DecompressBlock(compressed.data(), size, decompressed.data(), data.size() - 1)) << data.size();
+    }
+    EXPECT_FALSE(DecompressBlock(compressed.data(), size - 1, decompressed.data(), data.size())) << data.size();
+}
+
+}  // namespace
+
+TEST(CompressionTest, CompressAndDecompressBlocks) {
+    for (size_t size : {0, 1, 5, 12, 13, 14, 100, 4096, 70000, 300000}) {
+        ExpectRoundTrip(TextPayload(size));
+        ExpectRoundTrip(RandomPayload(size));
+        ExpectRoundTrip(std::vector<uint8_t>(size, 0));
+    }
+
+    // Repeated patterns of every short period, copied through overlapping matches
+    for (size_t period = 1; period <= 20; period++) {
+        std::vector<uint8_t> data(1000);
+        for (size_t i = 0; i < data.size(); i++) {
+            data[i] = static_cast<uint8_t>(i % period * 37);
+        }
+        ExpectRoundTrip(data);
+    }
+
+    // Repeats further back than MAX_MATCH_OFFSET cannot be referenced, but nearer ones still are
+    std::vector<uint8_t> data = RandomPayload(100000);
+    std::memcpy(data.data() + 80000, data.data(), 20000);
+    std::memcpy(data.data() + 40000, data.data() + 30000, 1000);
+    ExpectRoundTrip(data);
+
+    // Zeros take about one byte per 255, and incompressible data grows by less than 1%
+    std::vector<uint8_t> compressed(MaxCompressedSize(300000));
+    const std::vector<uint8_t> zeros(300000, 0);
+    EXPECT_LT(CompressBlock(zeros.data(), zeros.size(), compressed.data()), 300000u / 200);
+    const std::vector<uint8_t> random = RandomPayload(300000);
+    EXPECT_LT(CompressBlock(random.data(), random.size(), compressed.data()), 300000u + 300000u / 100);
+}
+
+TEST(CompressionTest, EmptyBlocksRoundTrip) {
+    // Empty input needs no buffer on either side
+    uint8_t compressed[MaxCompressedSize(0)];
+    const size_t size = CompressBlock(nullptr, 0, compressed);
+    ASSERT_EQ(size, 1u);
+    EXPECT_TRUE(DecompressBlock(compressed, size, nullptr, 0));
+    EXPECT_FALSE(DecompressBlock(compressed, 0, nullptr, 0));
+
+    // Writers never compress an empty payload, so the field is put together by hand:
+    // [Object size] [Compressed] [Tag ID] [Size] [Binary] [Raw size] [Compressed data]
+    constexpr FieldSize ENVELOPE_SIZE = sizeof(DataType) + sizeof(FieldSize) + 1;
+    constexpr FieldSize FIELD_SIZE = sizeof(DataType) + sizeof(DataTag::Id) + sizeof(FieldSize) + ENVELOPE_SIZE;
+    std::vector<uint8_t> data(sizeof(FieldSize) + FIELD_SIZE);
+    uint8_t* dest = data.data();
+
+    FieldSize root_size = FIELD_SIZE;
+    FieldSize envelope_size = ENVELOPE_SIZE;
+    FieldSize raw_size = 0;
+    const DataTag::Id id = TAG_BLOB.GetWireId();
+    AdjustEndianess(root_size);
+    AdjustEndianess(envelope_size);
+
+    std::memcpy(dest, &root_size, sizeof(root_size));
+    dest += sizeof(root_size);
+    *dest++ = static_cast<uint8_t>(DataType::Compressed);
+    std::memcpy(dest, &id, sizeof(id));
+    dest += sizeof(id);
+    std::memcpy(dest, &envelope_size, sizeof(envelope_size));
+    dest += sizeof(envelope_size);
+    *dest++ = static_cast<uint8_t>(DataType::Binary);
+    std::memcpy(dest, &raw_size, sizeof(raw_size));
+    dest += sizeof(raw_size);
+    *dest = compressed[0];
+
+    ASSERT_TRUE(Reader::Validate(data.data(), data.size(), false));
+    Reader reader(data.data(), data.size(), false);
+    std::vector<uint8_t> scratch;
+    auto blob = reader.RootObject().ReadCompressed(TAG_BLOB, scratch);
+    ASSERT_TRUE(blob.has_value() && blob->IsValid());
+    EXPECT_EQ(blob->GetTagType(TAG_BLOB), DataType::Binary);
+    EXPECT_TRUE(blob->ReadBinary(TAG_BLOB).empty());
+}
+
+TEST(CompressionTest, MalformedBlocksAreRejected) {
+    const std::vector<uint8_t> data = TextPayload(5000);
+    std::vector<uint8_t> compressed(MaxCompressedSize(data.size()));
+    compressed.resize(CompressBlock(data.data(), data.size(), compressed.data()));
+    std::vector<uint8_t> out(data.size());
+
+    // A match before the start of the output
+    const uint8_t back_reference[] = {0x10, 'a', 0x05, 0x00};
+    EXPECT_FALSE(DecompressBlock(back_reference, sizeof(back_reference), out.data(), 5));
+    const uint8_t zero_offset[] = {0x10, 'a', 0x00, 0x00, 0x00};
+    EXPECT_FALSE(DecompressBlock(zero_offset, sizeof(zero_offset), out.data(), 5));
+    const uint8_t valid[] = {0x11, 'a', 0x01, 0x00, 0x00};
+    EXPECT_TRUE(DecompressBlock(valid, sizeof(valid), out.data(), 6));
+    EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(out.data()), 6), "aaaaaa");
+
+    // Corrupt bytes anywhere must fail or produce some output, never access out of the buffers
+    std::mt19937 rng(20);
+    for (int i = 0; i < 2000; i++) {
+        std::vector<uint8_t> corrupt = compressed;
+        corrupt[rng() % corrupt.size()] = static_cast<uint8_t>(rng());
+        corrupt.resize(corrupt.size() - rng() % 3);
+        DecompressBlock(corrupt.data(), corrupt.size(), out.data(), out.size());
+    }
+    EXPECT_FALSE(DecompressBlock(compressed.data(), 0, out.data(), 0));
+}
+
+TEST(CompressionTest, CompressedFieldsReadWrite) {
+    const std::vector<uint8_t> text = TextPayload(20000);
+    const std::vector<uint8_t> random = RandomPayload(20000);
+    const std::vector<uint8_t> small = TextPayload(100);
+
+    std::vector<uint32_t> samples(5000);
+    for (size_t i = 0; i < samples.size(); i++) {
+        samples[i] = static_cast<uint32_t>(1000 + i % 16);
+    }
+
+    for (bool name_based : {true, false}) {
+        Writer writer(name_based);
+        auto& root = writer.RootObject();
+        root.FieldCompressedBinary(TAG_BLOB, text.data(), text.size());
+        root.FieldCompressedBinary(TAG_NAME, random.data(), random.size());
+        root.FieldCompressedBinary(TAG_VALUE, small.data(), small.size());
+        root.FieldCompressed([&](ObjectWriter& obj) { obj.FieldArrayUInt32(TAG_SAMPLES, samples.data(), static_cast<uint32_t>(samples.size())); });
+        root.FieldCompressed([&](ObjectWriter& obj) {
+            ObjectWriter config = obj.FieldObject(TAG_CONFIG);
+            for (int i = 0; i < 50; i++) {
+                const std::string key = "key-" + std::to_string(i);
+                config.FieldString(name_based ? DataTag(std::string_view(key)) : DataTag(static_cast<DataTag::Id>(100 + i)),
+                                   "a value repeated in every field");
+            }
+            config.Finish();
+        });
+        writer.Finish();
+
+        ASSERT_TRUE(Reader::Validate(writer.Data(), writer.Size(), name_based));
+        EXPECT_LT(writer.Size(), text.size() / 2 + random.size() + small.size() + samples.size());
+
+        Reader reader(writer.Data(), writer.Size(), name_based);
+        const auto& read_root = reader.RootObject();
+
+        // Incompressible and small payloads stay as written
+        EXPECT_EQ(read_root.GetTagType(TAG_NAME), DataType::Binary);
+        EXPECT_EQ(read_root.GetTagType(TAG_VALUE), DataType::Binary);
+        EXPECT_EQ(read_root.ReadBinary(TAG_NAME).size(), random.size());
+
+        EXPECT_EQ(read_root.GetTagType(TAG_BLOB), DataType::Compressed);
+        EXPECT_EQ(read_root.GetCompressedType(TAG_BLOB), DataType::Binary);
+        EXPECT_EQ(read_root.GetCompressedType(TAG_SAMPLES), DataType::UInt32Array);
+        EXPECT_EQ(read_root.GetCompressedType(TAG_CONFIG), DataType::Object);
+        EXPECT_TRUE(read_root.ReadBinary(TAG_BLOB).empty());
+
+        // One scratch buffer serves every field in turn
+        std::vector<uint8_t> scratch;
+        {
+            auto blob = read_root.ReadCompressed(TAG_BLOB, scratch);
+            ASSERT_TRUE(blob.has_value() && blob->IsValid());
+            std::span<const uint8_t> value = blob->ReadBinary(TAG_BLOB);
+            EXPECT_TRUE(std::equal(value.begin(), value.end(), text.begin(), text.end()));
+        }
+        {
+            auto array = read_root.ReadCompressed(TAG_SAMPLES, scratch);
+            ASSERT_TRUE(array.has_value());
+            uint32_t length;
+            const uint32_t* values = array->ReadUInt32Array(TAG_SAMPLES, length);
+            ASSERT_NE(values, nullptr);
+            EXPECT_EQ(std::vector<uint32_t>(values, values + length), samples);
+        }
+        {
+            auto wrapper = read_root.ReadCompressed(TAG_CONFIG, scratch);
+            ASSERT_TRUE(wrapper.has_value());
+            auto config = wrapper->ReadObject(TAG_CONFIG);
+            ASSERT_TRUE(config.has_value());
+            const DataTag last = name_based ? DataTag(std::string_view("key-49")) : DataTag(static_cast<DataTag::Id>(149));
+            EXPECT_EQ(config->ReadString(last), "a value repeated in every field");
+        }
+
+        EXPECT_FALSE(read_root.ReadCompressed(TAG_NAME, scratch).has_value());
+        EXPECT_FALSE(read_root.GetCompressedType(TAG_NAME).has_value());
+    }
+}
+
+TEST(CompressionTest, MalformedCompressedFieldsFail) {
+    const std::vector<uint8_t> text = TextPayload(5000);
+
+    Writer writer(false);
+    writer.RootObject().FieldCompressedBinary(TAG_BLOB, text.data(), text.size());
+    writer.Finish();
+
+    const uint8_t* data = static_cast<const uint8_t*>(writer.Data());
+    const std::vector<uint8_t> buffer(data, data + writer.Size());
+    ASSERT_TRUE(Reader::Validate(buffer.data(), buffer.size(), false));
+
+    // [Object size] [0xE0] [Tag ID] [Size] [Type] [Raw size] [Compressed data]
+    constexpr size_t TYPE_POS = sizeof(FieldSize) + 1 + sizeof(DataTag::Id) + sizeof(FieldSize);
+    ASSERT_EQ(buffer[TYPE_POS], static_cast<uint8_t>(DataType::Binary));
+
+    std::vector<uint8_t> scratch;
+    auto expect_invalid = [&](const std::vector<uint8_t>& corrupt) {
+        EXPECT_FALSE(Reader::Validate(corrupt.data(), corrupt.size(), false));
+        Reader reader(corrupt.data(), corrupt.size(), false);
+        EXPECT_FALSE(reader.RootObject().ReadCompressed(TAG_BLOB, scratch).has_value());
+    };
+
+    std::vector<uint8_t> corrupt = buffer;
+    corrupt[TYPE_POS] = static_cast<uint8_t>(DataType::Compressed);  // Nested envelope
+    expect_invalid(corrupt);
+
+    corrupt = buffer;
+    corrupt[TYPE_POS] = static_cast<uint8_t>(DataType::Int32);  // Not size prefixed
+    expect_invalid(corrupt);
+
+    corrupt = buffer;
+    corrupt[TYPE_POS + 1] ^= 1;  // Raw size off by one
+    expect_invalid(corrupt);
+
+    corrupt = buffer;
+    corrupt[TYPE_POS + 4] = 0xFF;  // Raw size beyond what the data can produce
+    expect_invalid(corrupt);
+}
@@ -0,0 +1,275 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#include "tbf/BitPacking.hpp"
+#include "tbf/DataTag.hpp"
+#include "tbf/Endianness.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+constexpr DataTag TAG_COUNTRIES = "countries";
+constexpr DataTag TAG_NAMES = "names";
+
+const std::string_view COUNTRIES[] = {"Spain", "France", "Germany", "Italy", "Portugal", "Norway", "Japan"};
+
+std::vector<std::string_view> Countries(size_t count) {
+    std::mt19937 rng(static_cast<uint32_t>(count));
+    std::vector<std::string_view> values(count);
+    for (std::string_view& value : values) {
+        value = COUNTRIES[rng() % std::size(COUNTRIES)];
+    }
+    return values;
+}
+
+}  // namespace
+
+TEST(DictionaryTest, PackAndUnpackCodes) {
+    std::mt19937_64 rng(7);
+
+    for (uint32_t width = 0; width <= 32; width++) {
+        for (size_t count : {0, 1, 7, 8, 9, 63, 64, 65, 1000}) {
+            const uint64_t limit = uint64_t(1) << width;
+            std::vector<uint32_t> codes(count);
+            for (uint32_t& code : codes) {
+                code = static_cast<uint32_t>(rng() % limit);
+            }
+
+            // One guard byte after the packed codes must be left untouched
+            std::vector<uint8_t> packed(PackedCodesSize(count, width) + 1, 0xA5);
+            PackCodes(codes.data(), packed.data(), count, width);
+            EXPECT_EQ(packed.back(), 0xA5) << width << " " << count;
+
+            std::vector<uint32_t> unpacked(count + 1, 0xDEADBEEF);
+            UnpackCodes(packed.data(), unpacked.data(), count, width);
+            EXPECT_EQ(unpacked.back(), 0xDEADBEEF) << width << " " << count;
+            unpacked.pop_back();
+            EXPECT_EQ(unpacked, codes) << width << " " << count;
+
+            for (size_t i = 0; i < count; i++) {
+                ASSERT_EQ(GetPackedCode(packed.data(), i, width), codes[i]) << width << " " << i;
+            }
+        }
+    }
+
+    // Codes of width 1 are laid out like packed booleans
+    const uint32_t bits[] = {1, 0, 1, 1, 0, 0, 0, 1, 1};
+    uint8_t packed[2];
+    PackCodes(bits, packed, 9, 1);
+    EXPECT_EQ(packed[0], 0b10001101);
+    EXPECT_EQ(packed[1], 0b1);
+}
+
+TEST(DictionaryTest, LowCardinalityReadWrite) {
+    const std::vector<std::string_view> countries = Countries(1000);
+
+    for (bool name_based : {true, false}) {
+        Writer plain_writer(name_based);
+        plain_writer.RootObject().FieldStringArray(TAG_COUNTRIES, countries.data(), static_cast<uint32_t>(countries.size()));
+        plain_writer.Finish();
+
+        Writer writer(name_based);
+        writer.RootObject().FieldDictionaryStringArray(TAG_COUNTRIES, countries);
+        writer.Finish();
+
+        ASSERT_TRUE(Reader::Validate(writer.Data(), writer.Size(), name_based));
+
+        // 7 entries take 3 bits per element instead of a length prefix and the string
+        EXPECT_LT(writer.Size() * 10, plain_writer.Size());
+
+        Reader reader(writer.Data(), writer.Size(), name_based);
+        const auto& root = reader.RootObject();
+        EXPECT_FALSE(root.ReadStringArray(TAG_COUNTRIES).has_value());
+
+        auto array = root.ReadDictionaryStringArray(TAG_COUNTRIES);
+        ASSERT_TRUE(array.has_value() && array->IsValid());
+        EXPECT_EQ(array->Size(), countries.size());
+        EXPECT_EQ(array->EntryCount(), std::size(COUNTRIES));
+        EXPECT_EQ(array->Width(), 3u);
+        EXPECT_EQ(array->PackedCodes().size(), PackedCodesSize(countries.size(), 3));
+
+        for (uint32_t i = 0; i < countries.size(); i++) {
+            ASSERT_EQ(array->GetElement(i), countries[i]) << i;
+        }
+
+        // Entries are numbered in order of first appearance
+        EXPECT_EQ(array->GetCode(0), 0u);
+        EXPECT_EQ(array->GetEntry(0), countries[0]);
+
+        std::string_view value;
+        EXPECT_FALSE(array->GetElement(static_cast<uint32_t>(countries.size()), value));
+        EXPECT_FALSE(array->GetCode(static_cast<uint32_t>(countries.size())).has_value());
+        EXPECT_FALSE(array->GetEntry(array->EntryCount()).has_value());
+    }
+}
+
+TEST(DictionaryTest, HighCardinalityFallsBackToPlainArray) {
+    std::vector<std::string> storage;
+    for (int i = 0; i < 500; i++) {
+        storage.push_back("name-" + std::to_string(i));
+    }
+    std::vector<std::string_view> names(storage.begin(), storage.end());
+
+    Writer writer(true);
+    writer.RootObject().FieldDictionaryStringArray(TAG_NAMES, names.data(), static_cast<uint32_t>(names.size()));
+    writer.RootObject().FieldDictionaryStringArray(TAG_COUNTRIES, nullptr, 0);
+    writer.Finish();
+
+    ASSERT_TRUE(Reader::Validate(writer.Data(), writer.Size(), true));
+
+    Reader reader(writer.Data(), writer.Size(), true);
+    const auto& root = reader.RootObject();
+    EXPECT_FALSE(root.ReadDictionaryStringArray(TAG_NAMES).has_value());
+
+    auto array = root.ReadStringArray(TAG_NAMES);
+    ASSERT_TRUE(array.has_value());
+    ASSERT_EQ(array->Size(), names.size());
+    for (uint32_t i = 0; i < names.size(); i++) {
+        std::string_view value;
+        ASSERT_TRUE(array->GetElement(i, value));
+        EXPECT_EQ(value, names[i]);
+    }
+
+    auto empty = root.ReadStringArray(TAG_COUNTRIES);
+    ASSERT_TRUE(empty.has_value());
+    EXPECT_EQ(empty->Size(), 0u);
+}
+
+TEST(DictionaryTest, OversizedElementTruncatesLikePlainArray) {
+    const std::string oversized(70000, 'x');
+    const size_t expected_size = static_cast<uint16_t>(oversized.size());
+
+    // Low cardinality data is written with the dictionary, a lone string as a plain array
+    std::vector<std::string_view> repeated = Countries(1000);
+    repeated.push_back(oversized);
+    repeated.push_back(oversized);
+    const std::string_view single[] = {oversized};
+
+    Writer writer(true);
+    writer.RootObject().FieldDictionaryStringArray(TAG_COUNTRIES, repeated);
+    writer.RootObject().FieldDictionaryStringArray(TAG_NAMES, single);
+    writer.Finish();
+
+    ASSERT_TRUE(Reader::Validate(writer.Data(), writer.Size(), true));
+
+    Reader reader(writer.Data(), writer.Size(), true);
+    const auto& root = reader.RootObject();
+
+    auto dictionary = root.ReadDictionaryStringArray(TAG_COUNTRIES);
+    ASSERT_TRUE(dictionary.has_value() && dictionary->IsValid());
+    ASSERT_EQ(dictionary->Size(), repeated.size());
+    EXPECT_EQ(dictionary->GetElement(1000).value_or("").size(), expected_size);
+
+    auto plain = root.ReadStringArray(TAG_NAMES);
+    ASSERT_TRUE(plain.has_value());
+    std::string_view value;
+    ASSERT_TRUE(plain->GetElement(0, value));
+    EXPECT_EQ(value.size(), expected_size);
+}
+
+TEST(DictionaryTest, GroupAndFilterByCode) {
+    const std::vector<std::string_view> countries = Countries(5000);
+
+    Writer writer(false);
+    writer.RootObject().FieldDictionaryStringArray(TAG_COUNTRIES, countries);
+    writer.Finish();
+
+    Reader reader(writer.Data(), writer.Size(), false);
+    auto array = reader.RootObject().ReadDictionaryStringArray(TAG_COUNTRIES);
+    ASSERT_TRUE(array.has_value() && array->IsValid());
+
+    std::vector<uint32_t> codes(array->Size());
+    ASSERT_TRUE(array->DecodeCodes(codes));
+    EXPECT_FALSE(array->DecodeCodes(std::span<uint32_t>(codes).first(codes.size() - 1)));
+
+    // Group by: one counter per entry
+    std::vector<uint32_t> counts(array->EntryCount());
+    for (uint32_t code : codes) {
+        counts[code]++;
+    }
+    for (uint32_t code = 0; code < array->EntryCount(); code++) {
+        const std::string_view entry = *array->GetEntry(code);
+        EXPECT_EQ(counts[code], std::count(countries.begin(), countries.end(), entry)) << entry;
+    }
+
+    // Equality filter: a single string lookup, then integer compares
+    std::optional<uint32_t> japan = array->FindEntry("Japan");
+    ASSERT_TRUE(japan.has_value());
+    EXPECT_EQ(std::count(codes.begin(), codes.end(), *japan), std::count(countries.begin(), countries.end(), "Japan"));
+    EXPECT_FALSE(array->FindEntry("Atlantis").has_value());
+}
+
+TEST(DictionaryTest, MalformedArraysAreRejected) {
+    const std::string_view values[] = {"a", "b", "c", "a", "b", "c", "a", "b", "c", "a", "b", "c"};
+
+    Writer writer(false);
+    writer.RootObject().FieldDictionaryStringArray(TAG_COUNTRIES, values);
+    writer.Finish();
+
+    const uint8_t* data = static_cast<const uint8_t*>(writer.Data());
+    std::vector<uint8_t> buffer(data, data + writer.Size());
+    ASSERT_TRUE(Reader::Validate(buffer.data(), buffer.size(), false));
+    {
+        Reader reader(buffer.data(), buffer.size(), false);
+        auto array = reader.RootObject().ReadDictionaryStringArray(TAG_COUNTRIES);
+        ASSERT_TRUE(array.has_value() && array->Validate());
+        ASSERT_EQ(array->Width(), 2u);
+    }
+
+    // The codes are the last bytes of the document, 12 codes of 2 bits. Code 3 has no entry.
+    std::vector<uint8_t> corrupt = buffer;
+    corrupt[corrupt.size() - 1] |= 0b11000000;
+    EXPECT_FALSE(Reader::Validate(corrupt.data(), corrupt.size(), false));
+    {
+        Reader reader(corrupt.data(), corrupt.size(), false);
+        auto array = reader.RootObject().ReadDictionaryStringArray(TAG_COUNTRIES);
+        ASSERT_TRUE(array.has_value() && array->IsValid());
+        EXPECT_FALSE(array->Validate());
+        EXPECT_FALSE(array->GetElement(11).has_value());
+        EXPECT_EQ(array->GetElement(10), "b");
+    }
+
+    // An entry offset past the entries. The offsets of "a", "b" and "c" are 0, 3 and 6.
+    uint32_t offsets[] = {0, 3, 6};
+    AdjustArrayEndianess<sizeof(uint32_t)>(offsets, 3);
+    const uint8_t* offset_bytes = reinterpret_cast<const uint8_t*>(offsets);
+    auto offsets_pos = std::search(buffer.begin(), buffer.end(), offset_bytes, offset_bytes + sizeof(offsets));
+    ASSERT_NE(offsets_pos, buffer.end());
+    corrupt = buffer;
+    std::fill_n(corrupt.begin() + (offsets_pos - buffer.begin()) + sizeof(uint32_t), sizeof(uint32_t), 0xFF);
+    EXPECT_FALSE(Reader::Validate(corrupt.data(), corrupt.size(), false));
+}
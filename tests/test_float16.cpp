@@ -0,0 +1,148 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#include "tbf/DataTag.hpp"
+#include "tbf/Float16.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+constexpr DataTag TAG_HALVES = "halves";
+constexpr DataTag TAG_VEC3_F16 = "vec3_f16";
+
+// Random floats spread over every exponent, plus the values where rounding changes behavior
+std::vector<float> TestFloats() {
+    std::vector<float> values = {0.0f, -0.0f, 1.0f, -2.5f, 65504.0f, 65519.99f, 65520.0f, -65520.0f, 1e9f,
+                                 0x1p-14f, 0x1p-24f, 0x1p-25f, 0x1.000002p-25f, 0x1.8p-24f, 0x1.004p0f, 0x1.006p0f,
+                                 std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                                 std::numeric_limits<float>::denorm_min()};
+
+    std::mt19937 rng(16);
+    for (int i = 0; i < 4096; i++) {
+        values.push_back(std::bit_cast<float>(static_cast<uint32_t>(rng())));
+    }
+    return values;
+}
+
+}  // namespace
+
+TEST(Float16Test, ScalarConversionIsExact) {
+    EXPECT_EQ(FloatToHalf(1.0f), 0x3C00);
+    EXPECT_EQ(FloatToHalf(-2.0f), 0xC000);
+    EXPECT_EQ(FloatToHalf(65504.0f), 0x7BFF);
+    EXPECT_EQ(FloatToHalf(65520.0f), 0x7C00);
+    EXPECT_EQ(FloatToHalf(0x1p-24f), 0x0001);
+    EXPECT_EQ(FloatToHalf(0x1p-25f), 0x0000);  // Ties to even
+    EXPECT_EQ(FloatToHalf(0x1.8p-24f), 0x0002);
+    EXPECT_EQ(FloatToHalf(0x1.006p0f), 0x3C02);
+    EXPECT_EQ(FloatToHalf(std::numeric_limits<float>::quiet_NaN()) & 0x7E00, 0x7E00);
+
+    // Every half survives a round trip through float, NaNs become quiet
+    for (uint32_t bits = 0; bits <= 0xFFFF; bits++) {
+        const uint16_t half = static_cast<uint16_t>(bits);
+        const bool nan = (half & 0x7C00) == 0x7C00 && (half & 0x3FF) != 0;
+        EXPECT_EQ(FloatToHalf(HalfToFloat(half)), nan ? half | 0x200 : half) << std::hex << bits;
+    }
+
+#ifdef __FLT16_MAX__
+    // Compiler conversions as reference for rounding
+    for (float value : TestFloats()) {
+        if (!std::isnan(value)) {
+            EXPECT_EQ(FloatToHalf(value), std::bit_cast<uint16_t>(static_cast<_Float16>(value))) << value;
+        }
+    }
+#endif
+}
+
+TEST(Float16Test, BulkConversionMatchesScalar) {
+    const std::vector<float> values = TestFloats();
+
+    std::vector<uint16_t> halves(values.size());
+    FloatToHalfArray(values.data(), halves.data(), values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        EXPECT_EQ(halves[i], FloatToHalf(values[i])) << values[i];
+    }
+
+    // Every half, including the signaling NaNs FloatToHalf never produces
+    std::vector<uint16_t> all_halves(65536);
+    for (uint32_t half = 0; half < all_halves.size(); half++) {
+        all_halves[half] = static_cast<uint16_t>(half);
+    }
+
+    std::vector<float> floats(all_halves.size());
+    HalfToFloatArray(all_halves.data(), floats.data(), all_halves.size());
+    for (size_t i = 0; i < all_halves.size(); i++) {
+        EXPECT_EQ(std::bit_cast<uint32_t>(floats[i]), std::bit_cast<uint32_t>(HalfToFloat(all_halves[i]))) << i;
+    }
+}
+
+TEST(Float16Test, FloatArraysAndVectorsReadWrite) {
+    const std::vector<float> values = {0.5f, -1.25f, 3.0f, 1024.0f, 0.1f, -0.0f, 7.75f, 2.0f, 9.5f, 100.0f};
+    const float vector[3] = {1.5f, -2.0f, 0.25f};
+
+    Writer writer(true);
+    auto& root = writer.RootObject();
+    root.FieldArrayFloat16(TAG_HALVES, std::span<const float>(values));
+    root.FieldVector3f16(TAG_VEC3_F16, vector);
+    writer.Finish();
+
+    Reader reader(writer.Data(), writer.Size(), true);
+    const auto& read_root = reader.RootObject();
+
+    // The raw bits are still available
+    auto raw = read_root.ReadFloat16Array(TAG_HALVES);
+    ASSERT_EQ(raw.size(), values.size());
+    EXPECT_EQ(raw[0], FloatToHalf(0.5f));
+
+    std::vector<float> floats(values.size());
+    auto length = read_root.ReadFloat16Array(TAG_HALVES, std::span<float>(floats));
+    ASSERT_TRUE(length.has_value());
+    ASSERT_EQ(*length, values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        EXPECT_EQ(floats[i], HalfToFloat(FloatToHalf(values[i])));
+    }
+
+    std::vector<float> too_small(values.size() - 1);
+    EXPECT_FALSE(read_root.ReadFloat16Array(TAG_HALVES, std::span<float>(too_small)).has_value());
+
+    float read_vector[3];
+    ASSERT_TRUE(read_root.ReadVector3f16(TAG_VEC3_F16, read_vector));
+    EXPECT_EQ(read_vector[0], 1.5f);
+    EXPECT_EQ(read_vector[1], -2.0f);
+    EXPECT_EQ(read_vector[2], 0.25f);
+    EXPECT_FALSE(read_root.ReadVector2f16(TAG_VEC3_F16, read_vector));
+}
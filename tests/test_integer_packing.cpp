@@ -0,0 +1,243 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#include "tbf/DataTag.hpp"
+#include "tbf/IntegerPacking.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+constexpr DataTag TAG_IDS = "ids";
+constexpr DataTag TAG_TIMESTAMPS = "timestamps";
+
+// Sequences covering each block encoding, in the element type
+template <typename Type>
+std::vector<std::vector<Type>> Sequences(size_t count) {
+    std::mt19937_64 rng(count);
+    std::vector<std::vector<Type>> sequences(6, std::vector<Type>(count));
+
+    Type id = 1000;
+    Type timestamp = static_cast<Type>(1700000000);
+    for (size_t i = 0; i < count; i++) {
+        id += static_cast<Type>(1 + rng() % 50);
+        timestamp += static_cast<Type>(60 + (rng() % 5 == 0 ? rng() % 3 : 0));
+
+        sequences[0][i] = id;                                        // Sorted IDs, delta
+        sequences[1][i] = timestamp;                                 // Steady timestamps, delta of delta
+        sequences[2][i] = static_cast<Type>(5000 + rng() % 300);     // Clustered values, frame of reference
+        sequences[3][i] = static_cast<Type>(rng());                  // Full width
+        sequences[4][i] = static_cast<Type>(7);                      // Constant
+        sequences[5][i] = static_cast<Type>(3 - static_cast<Type>(i)); // Decreasing, negative deltas
+    }
+    return sequences;
+}
+
+template <typename Type>
+void ExpectRoundTrip() {
+    using Word = std::make_unsigned_t<Type>;
+
+    for (size_t count : {1, 2, 3, 5, 127, 128, 129, 1000}) {
+        for (const std::vector<Type>& values : Sequences<Type>(count)) {
+            std::vector<uint8_t> packed(MaxPackedIntegersSize(count, sizeof(Type)));
+            packed.resize(PackIntegers(values.data(), count, packed.data()));
+            EXPECT_TRUE(ValidatePackedIntegers(packed.data(), packed.size(), count, sizeof(Type)));
+
+            std::vector<Type> unpacked(count);
+            ASSERT_TRUE(UnpackIntegers(packed.data(), packed.size(), unpacked.data(), count)) << count;
+            EXPECT_EQ(unpacked, values) << count;
+
+            // The blocks must fill the data exactly
+            EXPECT_FALSE(UnpackIntegers(packed.data(), packed.size() - 1, unpacked.data(), count));
+            packed.push_back(0);
+            EXPECT_FALSE(UnpackIntegers(packed.data(), packed.size(), unpacked.data(), count));
+            EXPECT_FALSE(ValidatePackedIntegers(packed.data(), packed.size(), count, sizeof(Type)));
+
+            // A single block unpacks on its own
+            Word block[PACKED_BLOCK_LENGTH];
+            const uint32_t first_length = static_cast<uint32_t>(std::min<size_t>(count, PACKED_BLOCK_LENGTH));
+            ASSERT_GT(UnpackIntegerBlock(packed.data(), packed.size(), block, first_length), 0u);
+            EXPECT_EQ(static_cast<Type>(block[first_length - 1]), values[first_length - 1]);
+        }
+    }
+}
+
+}  // namespace
+
+TEST(IntegerPackingTest, PackAndUnpackEveryType) {
+    ExpectRoundTrip<int32_t>();
+    ExpectRoundTrip<int64_t>();
+    ExpectRoundTrip<uint32_t>();
+    ExpectRoundTrip<uint64_t>();
+}
+
+TEST(IntegerPackingTest, BlocksPickTheSmallestEncoding) {
+    // A timestamp every 10 seconds is a constant delta, while positions of a body accelerating at a
+    // constant rate have a constant delta of delta. Neither needs any slot bits.
+    std::vector<int64_t> timestamps(PACKED_BLOCK_LENGTH);
+    std::vector<int64_t> positions(PACKED_BLOCK_LENGTH);
+    for (size_t i = 0; i < timestamps.size(); i++) {
+        timestamps[i] = 1700000000000 + static_cast<int64_t>(i) * 10000;
+        positions[i] = -500 + static_cast<int64_t>(i * i) * 3;
+    }
+    std::vector<uint8_t> packed(MaxPackedIntegersSize(PACKED_BLOCK_LENGTH, sizeof(int64_t)));
+    EXPECT_EQ(PackIntegers(timestamps.data(), timestamps.size(), packed.data()), 2 + 2 * sizeof(int64_t));
+    EXPECT_EQ(packed[0], static_cast<uint8_t>(BlockEncoding::Delta));
+    EXPECT_EQ(packed[1], 0);
+
+    EXPECT_EQ(PackIntegers(positions.data(), positions.size(), packed.data()), 2 + 3 * sizeof(int64_t));
+    EXPECT_EQ(packed[0], static_cast<uint8_t>(BlockEncoding::DeltaOfDelta));
+    EXPECT_EQ(packed[1], 0);
+
+    std::vector<int64_t> unpacked(PACKED_BLOCK_LENGTH);
+    ASSERT_TRUE(UnpackIntegers(packed.data(), 2 + 3 * sizeof(int64_t), unpacked.data(), unpacked.size()));
+    EXPECT_EQ(unpacked, positions);
+
+    // Sorted IDs with gaps below 16 take 4 bits per delta
+    std::vector<uint32_t> ids(PACKED_BLOCK_LENGTH);
+    for (size_t i = 1; i < ids.size(); i++) {
+        ids[i] = ids[i - 1] + 1 + static_cast<uint32_t>(i * 7 % 15);
+    }
+    EXPECT_EQ(PackIntegers(ids.data(), ids.size(), packed.data()), 2 + 2 * sizeof(uint32_t) + PACKED_BLOCK_LENGTH * 4 / 8);
+    EXPECT_EQ(packed[0], static_cast<uint8_t>(BlockEncoding::Delta));
+    EXPECT_EQ(packed[1], 4);
+
+    // Small signed values around zero are offsets from the minimum, not full width
+    const int32_t mixed[] = {-3, 2, -1, 0, 1, -2, 3, 1};
+    PackIntegers(mixed, 8, packed.data());
+    EXPECT_EQ(packed[0], static_cast<uint8_t>(BlockEncoding::FrameOfReference));
+    EXPECT_EQ(packed[1], 3);
+}
+
+TEST(IntegerPackingTest, MalformedBlocksAreRejected) {
+    const uint32_t values[] = {10, 20, 30, 40, 50};
+    uint8_t packed[MaxPackedIntegersSize(5, sizeof(uint32_t))];
+    const size_t size = PackIntegers(values, 5, packed);
+    uint32_t out[PACKED_BLOCK_LENGTH];
+
+    ASSERT_GT(UnpackIntegerBlock(packed, size, out, 5), 0u);
+    EXPECT_EQ(UnpackIntegerBlock(packed, size, out, 0), 0u);
+    EXPECT_EQ(UnpackIntegerBlock(packed, size - 1, out, 5), 0u);
+
+    uint8_t corrupt[sizeof(packed)];
+    std::memcpy(corrupt, packed, size);
+    corrupt[0] = 3;  // Unknown encoding
+    EXPECT_EQ(UnpackIntegerBlock(corrupt, size, out, 5), 0u);
+    EXPECT_FALSE(ValidatePackedIntegers(corrupt, size, 5, sizeof(uint32_t)));
+
+    std::memcpy(corrupt, packed, size);
+    corrupt[1] = 33;  // Wider than the element
+    EXPECT_EQ(UnpackIntegerBlock(corrupt, size, out, 5), 0u);
+    EXPECT_FALSE(ValidatePackedIntegers(corrupt, size, 5, sizeof(uint32_t)));
+
+    EXPECT_FALSE(ValidatePackedIntegers(packed, size, 5, 2));
+}
+
+TEST(IntegerPackingTest, PackedArrayFieldsReadWrite) {
+    const std::vector<std::vector<uint64_t>> ids = Sequences<uint64_t>(1000);
+    const std::vector<std::vector<int64_t>> timestamps = Sequences<int64_t>(1000);
+
+    for (bool name_based : {true, false}) {
+        Writer writer(name_based);
+        auto& root = writer.RootObject();
+        root.FieldPackedUInt64Array(TAG_IDS, ids[0]);
+        root.FieldPackedInt64Array(TAG_TIMESTAMPS, timestamps[1]);
+        writer.Finish();
+
+        ASSERT_TRUE(Reader::Validate(writer.Data(), writer.Size(), name_based));
+
+        // Far smaller than the 8000 bytes of each raw array
+        EXPECT_LT(writer.Size(), 2000u);
+
+        Reader reader(writer.Data(), writer.Size(), name_based);
+        const auto& read_root = reader.RootObject();
+
+        std::vector<uint64_t> read_ids(1000);
+        EXPECT_EQ(read_root.ReadPackedUInt64Array(TAG_IDS, std::span<uint64_t>(read_ids)), 1000u);
+        EXPECT_EQ(read_ids, ids[0]);
+
+        std::vector<int64_t> read_timestamps(1000);
+        EXPECT_EQ(read_root.ReadPackedInt64Array(TAG_TIMESTAMPS, std::span<int64_t>(read_timestamps)), 1000u);
+        EXPECT_EQ(read_timestamps, timestamps[1]);
+
+        // Wrong field types and element types
+        EXPECT_FALSE(read_root.ReadPackedInt64Array(TAG_IDS).has_value());
+        uint32_t length;
+        EXPECT_EQ(read_root.ReadUInt64Array(TAG_IDS, length), nullptr);
+
+        auto array = read_root.ReadPackedUInt64Array(TAG_IDS);
+        ASSERT_TRUE(array.has_value() && array->IsValid());
+        EXPECT_EQ(array->Size(), 1000u);
+        EXPECT_EQ(array->BlockCount(), 8u);
+
+        std::vector<int64_t> wrong_sign(1000);
+        EXPECT_FALSE(array->Decode(std::span<int64_t>(wrong_sign)));
+        std::vector<uint64_t> too_small(999);
+        EXPECT_FALSE(array->Decode(std::span<uint64_t>(too_small)));
+
+        // Block by block iteration visits every element in order
+        std::vector<uint64_t> visited;
+        EXPECT_TRUE(array->ForEachBlock<uint64_t>([&](uint32_t first, std::span<const uint64_t> block) {
+            EXPECT_EQ(first, visited.size());
+            EXPECT_LE(block.size(), PACKED_BLOCK_LENGTH);
+            visited.insert(visited.end(), block.begin(), block.end());
+        }));
+        EXPECT_EQ(visited, ids[0]);
+        EXPECT_FALSE(array->ForEachBlock<uint32_t>([](uint32_t, std::span<const uint32_t>) {}));
+    }
+}
+
+TEST(IntegerPackingTest, CorruptPackedArrayIsInvalid) {
+    const std::vector<int32_t> values = Sequences<int32_t>(300)[0];
+
+    Writer writer(false);
+    writer.RootObject().FieldPackedInt32Array(TAG_IDS, values);
+    writer.Finish();
+
+    const uint8_t* begin = static_cast<const uint8_t*>(writer.Data());
+    std::vector<uint8_t> data(begin, begin + writer.Size());
+
+    size_t first_block;
+    {
+        Reader reader(data.data(), data.size(), false);
+        first_block = static_cast<size_t>(reader.RootObject().ReadPackedInt32Array(TAG_IDS)->Encoded().data() - data.data());
+    }
+    ASSERT_EQ(data[first_block], static_cast<uint8_t>(BlockEncoding::Delta));
+    data[first_block + 1] = 40;
+    EXPECT_FALSE(Reader::Validate(data.data(), data.size(), false));
+
+    Reader reader(data.data(), data.size(), false);
+    std::vector<int32_t> decoded(values.size());
+    EXPECT_FALSE(reader.RootObject().ReadPackedInt32Array(TAG_IDS, std::span<int32_t>(decoded)).has_value());
+}
@@ -24,11 +24,15 @@
  */
 
 #include "tbf/DataTag.hpp"
+#include "tbf/Endianness.hpp"
 #include "tbf/Reader.hpp"
 #include "tbf/Writer.hpp"
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+#include <span>
+#include <string>
 #include <vector>
 
 using namespace tbf;
@@ -196,3 +200,722 @@ TEST(ObjectsTest, EmptyObjectArray) {
 
     EXPECT_EQ(count, 0);
 }
+
+TEST(ObjectsTest, ManyFieldsIdBased) {
+    constexpr uint32_t FIELD_COUNT = 512;
+
+    Writer writer(false);
+    auto& root = writer.RootObject();
+
+    for (uint32_t i = 1; i <= FIELD_COUNT; i++) {
+        root.FieldInt32(DataTag(static_cast<DataTag::Id>(i)), static_cast<int32_t>(i * 3));
+    }
+
+    writer.Finish();
+
+    Reader reader(writer.Data(), writer.Size(), false);
+    const auto& read_root = reader.RootObject();
+
+    ASSERT_TRUE(read_root.IsValid());
+    EXPECT_EQ(read_root.GetAllTags().size(), FIELD_COUNT);
+
+    for (uint32_t i = 1; i <= FIELD_COUNT; i++) {
+        auto value = read_root.ReadInt32(DataTag(static_cast<DataTag::Id>(i)));
+        ASSERT_TRUE(value.has_value());
+        EXPECT_EQ(value.value(), static_cast<int32_t>(i * 3));
+    }
+
+    EXPECT_FALSE(read_root.ContainsTag(DataTag(static_cast<DataTag::Id>(FIELD_COUNT + 1))));
+}
+
+TEST(ObjectsTest, ManyFieldsNameBased) {
+    constexpr uint32_t FIELD_COUNT = 512;
+
+    std::vector<std::string> names;
+    for (uint32_t i = 0; i < FIELD_COUNT; i++) {
+        names.push_back("field_" + std::to_string(i));
+    }
+
+    Writer writer(true);
+    auto& root = writer.RootObject();
+
+    for (uint32_t i = 0; i < FIELD_COUNT; i++) {
+        root.FieldInt32(DataTag(std::string_view(names[i])), static_cast<int32_t>(i));
+    }
+
+    writer.Finish();
+
+    Reader reader(writer.Data(), writer.Size(), true);
+    const auto& read_root = reader.RootObject();
+
+    ASSERT_TRUE(read_root.IsValid());
+    EXPECT_EQ(read_root.GetAllTags().size(), FIELD_COUNT);
+
+    for (uint32_t i = 0; i < FIELD_COUNT; i++) {
+        auto value = read_root.ReadInt32(DataTag(std::string_view(names[i])));
+        ASSERT_TRUE(value.has_value());
+        EXPECT_EQ(value.value(), static_cast<int32_t>(i));
+    }
+
+    EXPECT_FALSE(read_root.ContainsTag(DataTag(std::string_view("field_"))));
+}
+
+TEST(ObjectsTest, DuplicateTagKeepsFirstOccurrence) {
+    Writer writer(true);
+    auto& root = writer.RootObject();
+
+    root.FieldInt32(TAG_ID, 1);
+    root.FieldInt32(TAG_ID, 2);
+
+    writer.Finish();
+
+    Reader reader(writer.Data(), writer.Size(), true);
+    const auto& read_root = reader.RootObject();
+
+    ASSERT_TRUE(read_root.IsValid());
+    EXPECT_EQ(read_root.GetAllTags().size(), 1);
+
+    auto id = read_root.ReadInt32(TAG_ID);
+    ASSERT_TRUE(id.has_value());
+    EXPECT_EQ(id.value(), 1);
+}
+
+TEST(ObjectsTest, LazyIndexReadsFieldsInAnyOrder) {
+    Writer writer(false);
+    auto& root = writer.RootObject();
+
+    root.FieldInt32(TAG_ID, 7);
+    root.FieldString(TAG_NAME, "Lazy");
+
+    auto settings = root.FieldObject(TAG_SETTINGS);
+    settings.FieldString(TAG_THEME, "light");
+    settings.Finish();
+
+    writer.Finish();
+
+    Reader reader(writer.Data(), writer.Size(), false, IndexMode::Lazy);
+    const auto& read_root = reader.RootObject();
+
+    auto settings_obj = read_root.ReadObject(TAG_SETTINGS);
+    ASSERT_TRUE(settings_obj.has_value());
+    EXPECT_EQ(settings_obj->GetIndexMode(), IndexMode::Lazy);
+    EXPECT_EQ(settings_obj->ReadString(TAG_THEME).value_or(""), "light");
+
+    EXPECT_EQ(read_root.ReadInt32(TAG_ID).value_or(0), 7);
+    EXPECT_EQ(read_root.ReadString(TAG_NAME).value_or(""), "Lazy");
+    EXPECT_FALSE(read_root.ContainsTag(TAG_USER));
+
+    EXPECT_TRUE(read_root.IsValid());
+    EXPECT_EQ(read_root.GetAllTags().size(), 3);
+}
+
+TEST(ObjectsTest, LazyIndexStopsAtRequestedTag) {
+    Writer writer(true);
+    auto& root = writer.RootObject();
+
+    root.FieldInt32(TAG_ID, 42);
+    root.FieldString(TAG_NAME, "Header");
+    root.FieldBoolean(TAG_NOTIFICATIONS, true);
+
+    writer.Finish();
+
+    // Corrupt the type byte of the last field: [type][name size]["notifications"][value]
+    std::vector<uint8_t> buffer(static_cast<const uint8_t*>(writer.Data()), static_cast<const uint8_t*>(writer.Data()) + writer.Size());
+    buffer[buffer.size() - (3 + TAG_NOTIFICATIONS.GetName().size())] = 0xFF;
+
+    // Fields before the malformed one are returned until a lookup reaches it
+    Reader lazy_reader(buffer.data(), buffer.size(), true, IndexMode::Lazy);
+    EXPECT_EQ(lazy_reader.RootObject().ReadInt32(TAG_ID).value_or(0), 42);
+    EXPECT_EQ(lazy_reader.RootObject().ReadString(TAG_NAME).value_or(""), "Header");
+    EXPECT_FALSE(lazy_reader.RootObject().ContainsTag(TAG_NOTIFICATIONS));
+    EXPECT_FALSE(lazy_reader.RootObject().IsValid());
+    EXPECT_FALSE(lazy_reader.RootObject().ReadInt32(TAG_ID).has_value());
+    EXPECT_FALSE(lazy_reader.RootObject().ReadString(TAG_NAME).has_value());
+
+    // Reaching it through IsValid fails the lookups the same way
+    Reader validated_reader(buffer.data(), buffer.size(), true, IndexMode::Lazy);
+    EXPECT_EQ(validated_reader.RootObject().ReadInt32(TAG_ID).value_or(0), 42);
+    EXPECT_FALSE(validated_reader.RootObject().IsValid());
+    EXPECT_FALSE(validated_reader.RootObject().ReadInt32(TAG_ID).has_value());
+
+    Reader eager_reader(buffer.data(), buffer.size(), true);
+    EXPECT_FALSE(eager_reader.RootObject().ReadInt32(TAG_ID).has_value());
+    EXPECT_FALSE(eager_reader.RootObject().IsValid());
+}
+
+TEST(ObjectsTest, DocumentIndexReadsNestedObjectsAndArrays) {
+    constexpr int32_t USER_COUNT = 20;
+
+    for (bool name_based : {true, false}) {
+        Writer writer(name_based);
+        auto& root = writer.RootObject();
+
+        root.FieldInt32(TAG_ID, 1);
+        root.FieldInt32(TAG_ID, 2);
+
+        auto users = root.FieldObjectArray(TAG_USERS_ARRAY);
+        for (int32_t i = 0; i < USER_COUNT; i++) {
+            auto user = users.CreateElement();
+            user.FieldInt32(TAG_ID, i);
+
+            auto settings = user.FieldObject(TAG_SETTINGS);
+            settings.FieldString(TAG_THEME, i % 2 == 0 ? "dark" : "light");
+            settings.Finish();
+
+            // Every third user is large enough to use a lookup table
+            if (i % 3 == 0) {
+                for (uint32_t field = 0; field < 16; field++) {
+                    std::string name = "extra_" + std::to_string(field);
+                    user.FieldUInt32(name_based ? DataTag(std::string_view(name)) : DataTag(static_cast<DataTag::Id>(100 + field)), field);
+                }
+            }
+
+            user.Finish();
+        }
+        users.Finish();
+
+        writer.Finish();
+
+        Reader reader(writer.Data(), writer.Size(), name_based, IndexMode::Document);
+        const auto& read_root = reader.RootObject();
+
+        ASSERT_TRUE(read_root.IsValid());
+        EXPECT_EQ(read_root.ReadInt32(TAG_ID).value_or(0), 1);
+        EXPECT_EQ(read_root.GetAllTags().size(), 2);
+
+        // Root, every user and every settings object
+        EXPECT_EQ(reader.GetDocumentIndex().ObjectCount(), 1 + 2 * USER_COUNT);
+
+        auto read_users = read_root.ReadObjectArray(TAG_USERS_ARRAY);
+        ASSERT_TRUE(read_users.has_value());
+        ASSERT_EQ(read_users->Size(), static_cast<uint32_t>(USER_COUNT));
+
+        int32_t expected = 0;
+        for (const auto& user : *read_users) {
+            EXPECT_EQ(user.GetIndexMode(), IndexMode::Document);
+            EXPECT_EQ(user.ReadInt32(TAG_ID).value_or(-1), expected);
+
+            auto settings = user.ReadObject(TAG_SETTINGS);
+            ASSERT_TRUE(settings.has_value());
+            EXPECT_EQ(settings->ReadString(TAG_THEME).value_or(""), expected % 2 == 0 ? "dark" : "light");
+
+            expected++;
+        }
+        EXPECT_EQ(expected, USER_COUNT);
+
+        auto user = read_users->GetElement(9);
+        ASSERT_TRUE(user.has_value());
+        EXPECT_EQ(user->GetAllTags().size(), 18);
+        EXPECT_EQ(user->ReadUInt32(name_based ? DataTag("extra_15") : DataTag(static_cast<DataTag::Id>(115))).value_or(0), 15);
+        EXPECT_FALSE(user->ContainsTag(TAG_NAME));
+        EXPECT_FALSE(read_users->GetElement(USER_COUNT).has_value());
+    }
+}
+
+TEST(ObjectsTest, DocumentIndexIsolatesMalformedNestedObject) {
+    Writer writer(false);
+    auto& root = writer.RootObject();
+
+    root.FieldInt32(TAG_ID, 5);
+    auto settings = root.FieldObject(TAG_SETTINGS);
+    settings.FieldBoolean(TAG_NOTIFICATIONS, true);
+    settings.Finish();
+
+    writer.Finish();
+
+    // Corrupt the type byte of the only field of the nested object: [type][id][value]
+    std::vector<uint8_t> buffer(static_cast<const uint8_t*>(writer.Data()), static_cast<const uint8_t*>(writer.Data()) + writer.Size());
+    buffer[buffer.size() - 4] = 0xFF;
+
+    Reader reader(buffer.data(), buffer.size(), false, IndexMode::Document);
+    const auto& read_root = reader.RootObject();
+
+    EXPECT_TRUE(read_root.IsValid());
+    EXPECT_EQ(read_root.ReadInt32(TAG_ID).value_or(0), 5);
+
+    auto read_settings = read_root.ReadObject(TAG_SETTINGS);
+    ASSERT_TRUE(read_settings.has_value());
+    EXPECT_FALSE(read_settings->IsValid());
+    EXPECT_FALSE(read_settings->ContainsTag(TAG_NOTIFICATIONS));
+}
+
+TEST(ObjectsTest, RuntimeTagHashMatchesCompileTime) {
+    // Names of every length class hashed by TagLookupHash: short, 4-7, 8 and longer than 8
+    constexpr DataTag TAG_SHORT = "ab";
+    constexpr DataTag TAG_LONG = "a_rather_long_tag_name";
+    static_assert(TAG_LONG.GetHash() == TagLookupHash("a_rather_long_tag_name"));
+
+    for (const DataTag& tag : {TAG_SHORT, TAG_ID, TAG_THEME, TAG_SETTINGS, TAG_NOTIFICATIONS, TAG_LONG}) {
+        std::string name(tag.GetName());
+        DataTag runtime_tag{std::string_view(name)};
+
+        EXPECT_EQ(runtime_tag.GetHash(), tag.GetHash()) << name;
+        EXPECT_EQ(runtime_tag, tag);
+    }
+
+    EXPECT_NE(TAG_THEME.GetHash(), TAG_NAME.GetHash());
+    EXPECT_NE(TagLookupHash("field_1"), TagLookupHash("field_2"));
+    EXPECT_NE(TagLookupHash("component_field_1"), TagLookupHash("component_field_2"));
+}
+
+TEST(ObjectsTest, PreEncodedHeadersMatchRuntimeTags) {
+    // The longest name with a pre-encoded header, one past it and one well past it
+    constexpr DataTag TAG_14 = DataTag(14, "fourteen_chars");
+    constexpr DataTag TAG_15 = DataTag(15, "fifteen_chars__");
+    constexpr DataTag TAG_LONG = DataTag(22, "a_rather_long_tag_name");
+    static_assert(TAG_14.HasNameHeader() && !TAG_15.HasNameHeader() && !TAG_LONG.HasNameHeader());
+    static_assert(TAG_ID.HasNameHeader());
+
+    const DataTag compile_time[] = {TAG_ID, TAG_14, TAG_15, TAG_LONG};
+
+    for (bool name_based : {true, false}) {
+        Writer encoded(name_based);
+        Writer runtime(name_based);
+
+        for (const DataTag& tag : compile_time) {
+            std::string name(tag.GetName());
+            DataTag runtime_tag = name_based ? DataTag(std::string_view(name)) : DataTag(tag.GetId());
+            EXPECT_FALSE(runtime_tag.HasNameHeader());
+
+            for (Writer* writer : {&encoded, &runtime}) {
+                const DataTag& write_tag = writer == &encoded ? tag : runtime_tag;
+                ObjectWriter& root = writer->RootObject();
+                root.FieldUInt8(write_tag, 7);
+                root.FieldInt64(write_tag, -5);
+                root.FieldVarUInt64(write_tag, 300);
+                root.FieldString(write_tag, "value");
+            }
+        }
+        encoded.Finish();
+        runtime.Finish();
+
+        ASSERT_EQ(encoded.Size(), runtime.Size());
+        EXPECT_EQ(std::memcmp(encoded.Data(), runtime.Data(), encoded.Size()), 0);
+
+        Reader reader(encoded.Data(), encoded.Size(), name_based);
+        for (const DataTag& tag : compile_time) {
+            EXPECT_EQ(reader.RootObject().ReadUInt8(tag).value_or(0), 7) << tag.GetName();
+        }
+    }
+}
+
+template <TagMode Mode>
+static void WriteModeDocument(BasicWriter<Mode>& writer) {
+    BasicObjectWriter<Mode>& root = writer.RootObject();
+    root.FieldInt32(TAG_ID, 42);
+    root.FieldString(TAG_NAME, "Alice");
+    {
+        BasicObjectWriter<Mode> settings = root.FieldObject(TAG_SETTINGS);
+        settings.FieldString(TAG_THEME, "dark");
+        settings.FieldBoolean(TAG_NOTIFICATIONS, true);
+        settings.Finish();
+    }
+    {
+        BasicObjectArrayWriter<Mode> users = root.FieldObjectArray(TAG_USERS_ARRAY, ArrayLayout::Indexed);
+        for (int32_t i = 0; i < 3; ++i) {
+            BasicObjectWriter<Mode> user = users.CreateElement();
+            user.FieldInt32(TAG_ID, i);
+            user.Finish();
+        }
+    }
+    writer.Finish();
+}
+
+template <TagMode Mode>
+static void ExpectModeDocument(const BasicReader<Mode>& reader) {
+    ASSERT_TRUE(reader.IsValid());
+    const ObjectReader& root = reader.RootObject();
+    EXPECT_EQ(root.ReadInt32(TAG_ID).value_or(0), 42);
+    EXPECT_EQ(root.ReadString(TAG_NAME).value_or(""), "Alice");
+
+    auto settings = root.ReadObject(TAG_SETTINGS);
+    ASSERT_TRUE(settings.has_value());
+    EXPECT_EQ(settings->ReadString(TAG_THEME).value_or(""), "dark");
+
+    auto users = root.ReadObjectArray(TAG_USERS_ARRAY);
+    ASSERT_TRUE(users.has_value());
+    int32_t count = 0;
+    for (const auto& user : *users) {
+        EXPECT_EQ(user.ReadInt32(TAG_ID).value_or(-1), count);
+        count++;
+    }
+    EXPECT_EQ(count, 3);
+}
+
+TEST(ObjectsTest, CompileTimeTagModesMatchRuntime) {
+    Writer runtime_names(true);
+    Writer runtime_ids(false);
+    NameWriter names;
+    IdWriter ids;
+    static_assert(!std::is_constructible_v<NameWriter, bool, uint32_t>);
+
+    WriteModeDocument(runtime_names);
+    WriteModeDocument(runtime_ids);
+    WriteModeDocument(names);
+    WriteModeDocument(ids);
+
+    EXPECT_TRUE(names.IsNameBased());
+    EXPECT_FALSE(ids.IsNameBased());
+    ASSERT_EQ(names.Size(), runtime_names.Size());
+    ASSERT_EQ(ids.Size(), runtime_ids.Size());
+    EXPECT_EQ(std::memcmp(names.Data(), runtime_names.Data(), names.Size()), 0);
+    EXPECT_EQ(std::memcmp(ids.Data(), runtime_ids.Data(), ids.Size()), 0);
+
+    for (IndexMode mode : {IndexMode::Eager, IndexMode::Lazy, IndexMode::Document}) {
+        ExpectModeDocument(NameReader(names.Data(), names.Size(), mode));
+        ExpectModeDocument(IdReader(ids.Data(), ids.Size(), mode));
+        ExpectModeDocument(Reader(names.Data(), names.Size(), true, mode));
+    }
+
+    EXPECT_TRUE(NameReader::Validate(names.Data(), names.Size()));
+    EXPECT_TRUE(IdReader::Validate(ids.Data(), ids.Size()));
+    EXPECT_FALSE(NameReader::Validate(ids.Data(), ids.Size()));
+}
+
+TEST(ObjectsTest, SequentialCursorHandlesAnyReadOrder) {
+    // Enough extra fields to move the per-object index out of its inline storage
+    constexpr int32_t EXTRA_FIELDS = 24;
+
+    for (bool name_based : {true, false}) {
+        for (IndexMode mode : {IndexMode::Eager, IndexMode::Lazy, IndexMode::Document}) {
+            Writer writer(name_based);
+            auto& root = writer.RootObject();
+
+            root.FieldInt32(TAG_ID, 1);
+            root.FieldString(TAG_NAME, "first");
+            root.FieldString(TAG_THEME, "dark");
+            root.FieldInt32(TAG_ID, 2);
+            root.FieldBoolean(TAG_NOTIFICATIONS, true);
+
+            std::vector<std::string> names;
+            for (int32_t i = 0; i < EXTRA_FIELDS; i++) {
+                names.push_back("extra_" + std::to_string(i));
+            }
+            auto extra_tag = [&](int32_t i) {
+                return name_based ? DataTag(std::string_view(names[i])) : DataTag(static_cast<DataTag::Id>(1000 + i));
+            };
+            for (int32_t i = 0; i < EXTRA_FIELDS; i++) {
+                root.FieldInt32(extra_tag(i), i);
+            }
+
+            writer.Finish();
+
+            Reader reader(writer.Data(), writer.Size(), name_based, mode);
+            const auto& read_root = reader.RootObject();
+
+            // In order, through the duplicated tag, which must keep its first value
+            EXPECT_EQ(read_root.ReadInt32(TAG_ID).value_or(0), 1);
+            EXPECT_EQ(read_root.ReadString(TAG_NAME).value_or(""), "first");
+            EXPECT_EQ(read_root.ReadString(TAG_THEME).value_or(""), "dark");
+            EXPECT_EQ(read_root.ReadInt32(TAG_ID).value_or(0), 1);
+            EXPECT_TRUE(read_root.ReadBoolean(TAG_NOTIFICATIONS).value_or(false));
+
+            // Skipping fields, then going backwards
+            for (int32_t i = 0; i < EXTRA_FIELDS; i += 3) {
+                EXPECT_EQ(read_root.ReadInt32(extra_tag(i)).value_or(-1), i);
+            }
+            for (int32_t i = EXTRA_FIELDS - 1; i >= 0; i--) {
+                EXPECT_EQ(read_root.ReadInt32(extra_tag(i)).value_or(-1), i);
+            }
+
+            EXPECT_EQ(read_root.ReadString(TAG_NAME).value_or(""), "first");
+            EXPECT_FALSE(read_root.ContainsTag(TAG_SETTINGS));
+            EXPECT_TRUE(read_root.IsValid());
+
+            // Tags are reported in wire order, without the duplicate
+            std::vector<DataTag> tags = read_root.GetAllTags();
+            ASSERT_EQ(tags.size(), 4u + EXTRA_FIELDS);
+            EXPECT_EQ(tags[0], TAG_ID);
+            EXPECT_EQ(tags[3], TAG_NOTIFICATIONS);
+            EXPECT_EQ(tags.back(), extra_tag(EXTRA_FIELDS - 1));
+        }
+    }
+}
+
+namespace {
+
+enum class Theme : uint8_t { Light = 1, Dark = 2 };
+
+struct Settings {
+    int32_t id = 0;
+    std::string_view name;
+    Theme theme = Theme::Light;
+    bool notifications = false;
+    std::span<const float> weights;
+    double missing = -1.0;
+};
+
+}  // namespace
+
+TEST(ObjectsTest, ReadFieldsFillsStructInOnePass) {
+    constexpr DataTag TAG_WEIGHTS = "weights";
+    constexpr DataTag TAG_MISSING = "missing";
+
+    const float weights[] = {0.5f, 1.5f, 2.5f};
+
+    for (bool name_based : {true, false}) {
+        for (IndexMode mode : {IndexMode::Eager, IndexMode::Lazy, IndexMode::Document}) {
+            Writer writer(name_based);
+            auto& root = writer.RootObject();
+
+            root.FieldArrayFloat32(TAG_WEIGHTS, weights, 3);
+            root.FieldInt32(TAG_ID, 7);
+            root.FieldString(TAG_NAME, "first");
+            root.FieldInt32(TAG_ID, 8);
+            root.FieldUInt8(TAG_THEME, static_cast<uint8_t>(Theme::Dark));
+            root.FieldInt8(TAG_NOTIFICATIONS, 1);
+
+            writer.Finish();
+
+            Reader reader(writer.Data(), writer.Size(), name_based, mode);
+
+            Settings settings;
+            ReadFieldsResult result = reader.RootObject().ReadFields(
+                settings,
+                Bind<DataType::Int32>(TAG_ID, &Settings::id),
+                Bind<DataType::String>(TAG_NAME, &Settings::name),
+                Bind<DataType::UInt8>(TAG_THEME, &Settings::theme),
+                Bind<DataType::Boolean>(TAG_NOTIFICATIONS, &Settings::notifications),
+                Bind<DataType::Float32Array>(TAG_WEIGHTS, &Settings::weights),
+                Bind<DataType::Float64>(TAG_MISSING, &Settings::missing));
+
+            EXPECT_TRUE(result.valid);
+            EXPECT_FALSE(result.Complete());
+            EXPECT_EQ(result.missing, uint64_t(1) << 5);
+            EXPECT_EQ(result.wrong_type, uint64_t(1) << 3);
+
+            EXPECT_EQ(settings.id, 7);
+            EXPECT_EQ(settings.name, "first");
+            EXPECT_EQ(settings.theme, Theme::Dark);
+            EXPECT_FALSE(settings.notifications);
+            ASSERT_EQ(settings.weights.size(), 3u);
+            EXPECT_EQ(settings.weights[2], 2.5f);
+            EXPECT_EQ(settings.missing, -1.0);
+
+            // Single field reads still work after the batch read
+            EXPECT_EQ(reader.RootObject().ReadInt32(TAG_ID).value_or(0), 7);
+        }
+    }
+}
+
+TEST(ObjectsTest, ReadFieldsReportsMalformedObject) {
+    Writer writer(true);
+    auto& root = writer.RootObject();
+    root.FieldInt32(TAG_ID, 7);
+    root.FieldString(TAG_NAME, "first");
+    writer.Finish();
+
+    std::vector<uint8_t> data(static_cast<const uint8_t*>(writer.Data()), static_cast<const uint8_t*>(writer.Data()) + writer.Size());
+
+    // Corrupt the type of the last field
+    data[data.size() - (1 + 1 + TAG_NAME.GetName().size() + 2 + 5)] = 0xEE;
+
+    Reader reader(data.data(), data.size(), true, IndexMode::Lazy);
+
+    Settings settings;
+    ReadFieldsResult result = reader.RootObject().ReadFields(
+        settings,
+        Bind<DataType::Int32>(TAG_ID, &Settings::id),
+        Bind<DataType::String>(TAG_NAME, &Settings::name));
+
+    EXPECT_FALSE(result.valid);
+    EXPECT_EQ(result.missing, 0b11u);
+    EXPECT_EQ(settings.id, 0);
+}
+
+TEST(ObjectsTest, FieldIteratorWalksWireOrder) {
+    for (bool name_based : {true, false}) {
+        Writer writer(name_based);
+        auto& root = writer.RootObject();
+
+        root.FieldInt32(TAG_ID, 1);
+        auto user = root.FieldObject(TAG_USER);
+        user.FieldString(TAG_NAME, "John");
+        user.Finish();
+        root.FieldInt32(TAG_ID, 2);
+
+        writer.Finish();
+
+        Reader reader(writer.Data(), writer.Size(), name_based);
+
+        std::vector<DataType> types;
+        std::vector<int32_t> ids;
+        for (const FieldView& field : reader.RootObject().Fields()) {
+            types.push_back(field.GetType());
+
+            int32_t id;
+            if (field.Matches(TAG_ID) && field.Get<DataType::Int32>(id)) {
+                ids.push_back(id);
+            }
+            EXPECT_EQ(field.GetTag(), field.GetType() == DataType::Object ? TAG_USER : TAG_ID);
+        }
+
+        // Duplicated tags are yielded as they appear, with the raw bytes of each field
+        EXPECT_EQ(types, (std::vector<DataType>{DataType::Int32, DataType::Object, DataType::Int32}));
+        EXPECT_EQ(ids, (std::vector<int32_t>{1, 2}));
+
+        auto it = reader.RootObject().Fields().begin();
+        EXPECT_EQ(it->GetRaw().size(), 1 + (name_based ? 1 + TAG_ID.GetName().size() : sizeof(DataTag::Id)) + sizeof(int32_t));
+
+        ++it;
+        auto nested = it->AsObject();
+        ASSERT_TRUE(nested.has_value());
+        EXPECT_EQ(nested->ReadString(TAG_NAME).value_or(""), "John");
+        EXPECT_FALSE(it->AsObjectArray().has_value());
+    }
+}
+
+namespace {
+
+// Prints the document as nested braces, skipping the contents of `skipped`
+struct DumpVisitor {
+    std::string out;
+    DataTag skipped = TAG_SETTINGS;
+
+    VisitAction OnField(const FieldView& field) {
+        out += std::string(field.GetName());
+
+        if (field.Matches(skipped)) {
+            out += "(skipped) ";
+            return VisitAction::Skip;
+        }
+        if (field.GetType() == DataType::Object || field.GetType() == DataType::ObjectArray) {
+            out += field.GetType() == DataType::Object ? "{ " : "[ ";
+        } else {
+            out += " ";
+        }
+        return VisitAction::Continue;
+    }
+
+    void OnObjectEnd(const FieldView& field) { out += field.GetType() == DataType::Object ? "} " : "] "; }
+    void OnElementBegin(uint32_t) { out += "{ "; }
+    void OnElementEnd(uint32_t) { out += "} "; }
+};
+
+}  // namespace
+
+TEST(ObjectsTest, VisitWalksNestedObjectsDepthFirst) {
+    Writer writer(true);
+    auto& root = writer.RootObject();
+
+    root.FieldInt32(TAG_ID, 1);
+
+    auto settings = root.FieldObject(TAG_SETTINGS);
+    settings.FieldString(TAG_THEME, "dark");
+    settings.Finish();
+
+    auto user = root.FieldObject(TAG_USER);
+    user.FieldString(TAG_NAME, "John");
+    user.Finish();
+
+    auto users = root.FieldObjectArray(TAG_USERS_ARRAY);
+    for (int32_t i = 0; i < 2; i++) {
+        auto element = users.CreateElement();
+        element.FieldInt32(TAG_ID, i);
+        element.Finish();
+    }
+    users.Finish();
+
+    root.FieldBoolean(TAG_NOTIFICATIONS, true);
+
+    writer.Finish();
+
+    for (IndexMode mode : {IndexMode::Eager, IndexMode::Document}) {
+        Reader reader(writer.Data(), writer.Size(), true, mode);
+
+        DumpVisitor dump;
+        EXPECT_TRUE(reader.RootObject().Visit(dump));
+        EXPECT_EQ(dump.out, "id settings(skipped) user{ name } users[ { id } { id } ] notifications ");
+
+        // Stopping ends the walk without reporting an error
+        uint32_t visited = 0;
+        EXPECT_TRUE(reader.RootObject().Visit([&visited](const FieldView& field) {
+            visited++;
+            return field.Matches(TAG_NAME) ? VisitAction::Stop : VisitAction::Continue;
+        }));
+        EXPECT_EQ(visited, 5u);
+    }
+}
+
+TEST(ObjectsTest, VisitReportsMalformedNestedObject) {
+    Writer writer(true);
+    auto& root = writer.RootObject();
+
+    auto user = root.FieldObject(TAG_USER);
+    user.FieldInt32(TAG_ID, 1);
+    user.Finish();
+    root.FieldInt32(TAG_ID, 2);
+
+    writer.Finish();
+
+    std::vector<uint8_t> data(static_cast<const uint8_t*>(writer.Data()), static_cast<const uint8_t*>(writer.Data()) + writer.Size());
+
+    // Type byte of the field inside the nested object
+    const size_t nested_field = sizeof(FieldSize) + 1 + 1 + TAG_USER.GetName().size() + sizeof(FieldSize);
+    ASSERT_EQ(data[nested_field], static_cast<uint8_t>(DataType::Int32));
+    data[nested_field] = 0xEE;
+
+    Reader reader(data.data(), data.size(), true, IndexMode::Lazy);
+
+    uint32_t visited = 0;
+    EXPECT_FALSE(reader.RootObject().Visit([&visited](const FieldView&) {
+        visited++;
+        return VisitAction::Continue;
+    }));
+    EXPECT_EQ(visited, 1u);
+
+    // The root fields themselves are well formed
+    FieldIterator it = reader.RootObject().Fields().begin();
+    uint32_t root_fields = 0;
+    for (; it != std::default_sentinel; ++it) {
+        root_fields++;
+    }
+    EXPECT_EQ(root_fields, 2u);
+    EXPECT_FALSE(it.IsMalformed());
+}
+
+// ID-based document of `depth` objects each nested in the previous one, built byte by byte since
+// writing it through nested ObjectWriters would recurse as deep
+static std::vector<uint8_t> NestedDocument(uint32_t depth) {
+    constexpr size_t FIELD_SIZE = sizeof(DataType) + sizeof(DataTag::Id) + sizeof(FieldSize);
+
+    std::vector<uint8_t> data(sizeof(FieldSize) + FIELD_SIZE * depth);
+    uint8_t* dest = data.data();
+
+    FieldSize root_size = static_cast<FieldSize>(FIELD_SIZE * depth);
+    AdjustEndianess(root_size);
+    std::memcpy(dest, &root_size, sizeof(root_size));
+    dest += sizeof(root_size);
+
+    for (uint32_t level = 0; level < depth; level++) {
+        DataTag::Id id = 1;
+        FieldSize size = static_cast<FieldSize>(FIELD_SIZE * (depth - level - 1));
+        AdjustEndianess(id);
+        AdjustEndianess(size);
+
+        *dest = static_cast<uint8_t>(DataType::Object);
+        std::memcpy(dest + sizeof(DataType), &id, sizeof(id));
+        std::memcpy(dest + sizeof(DataType) + sizeof(id), &size, sizeof(size));
+        dest += FIELD_SIZE;
+    }
+    return data;
+}
+
+TEST(ObjectsTest, VisitRejectsDocumentsNestedTooDeep) {
+    for (uint32_t depth : {ObjectReader::MAX_VISIT_DEPTH, ObjectReader::MAX_VISIT_DEPTH + 1, 2'000'000u}) {
+        const std::vector<uint8_t> data = NestedDocument(depth);
+        const bool too_deep = depth > ObjectReader::MAX_VISIT_DEPTH;
+
+        Reader reader(data.data(), data.size(), false, IndexMode::Lazy);
+        ASSERT_TRUE(reader.IsValid());
+        EXPECT_EQ(reader.Validate(), !too_deep) << depth;
+
+        uint32_t visited = 0;
+        EXPECT_EQ(reader.RootObject().Visit([&visited](const FieldView&) {
+            visited++;
+            return VisitAction::Continue;
+        }), !too_deep) << depth;
+        // The field holding the first object too deep is still visited
+        EXPECT_EQ(visited, too_deep ? ObjectReader::MAX_VISIT_DEPTH + 1 : depth);
+    }
+}
@@ -0,0 +1,187 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#include "tbf/DataTag.hpp"
+#include "tbf/Parallel.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+constexpr uint32_t ELEMENT_COUNT = 5000;
+
+constexpr DataTag TAG_NAMES = "names";
+constexpr DataTag TAG_ENTITIES = "entities";
+constexpr DataTag TAG_INDEXED_ENTITIES = "indexed_entities";
+constexpr DataTag TAG_ID = "id";
+
+void WriteEntities(ObjectWriter& root, const DataTag& tag, ArrayLayout layout) {
+    auto entities = root.FieldObjectArray(tag, layout);
+    for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+        auto entity = entities.CreateElement();
+        entity.FieldUInt32(TAG_ID, i);
+        entity.Finish();
+    }
+    entities.Finish();
+}
+
+void WriteDocument(Writer& writer) {
+    auto& root = writer.RootObject();
+
+    auto names = root.FieldStringArray(TAG_NAMES);
+    for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+        names.AddElement("name_" + std::to_string(i));
+    }
+    names.Finish();
+
+    WriteEntities(root, TAG_ENTITIES, ArrayLayout::Plain);
+    WriteEntities(root, TAG_INDEXED_ENTITIES, ArrayLayout::Indexed);
+
+    writer.Finish();
+}
+
+}  // namespace
+
+TEST(ParallelTest, ForEachVisitsEveryElementOnce) {
+    Writer writer(true);
+    WriteDocument(writer);
+
+    ThreadPool pool(4);
+
+    for (IndexMode mode : {IndexMode::Eager, IndexMode::Document}) {
+        Reader reader(writer.Data(), writer.Size(), true, mode);
+
+        for (const DataTag* tag : {&TAG_ENTITIES, &TAG_INDEXED_ENTITIES}) {
+            auto entities = reader.RootObject().ReadObjectArray(*tag);
+            ASSERT_TRUE(entities.has_value());
+
+            std::vector<std::atomic<uint32_t>> visits(ELEMENT_COUNT);
+            bool done = ParallelForEach(
+                *entities,
+                [&](uint32_t index, const ObjectReader& entity) {
+                    if (entity.ReadUInt32(TAG_ID).value_or(ELEMENT_COUNT) == index) {
+                        visits[index].fetch_add(1);
+                    }
+                },
+                pool, 64);
+            ASSERT_TRUE(done);
+
+            for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+                ASSERT_EQ(visits[i].load(), 1u) << "element " << i;
+            }
+        }
+    }
+}
+
+TEST(ParallelTest, TransformReduceIsOrdered) {
+    Writer writer(true);
+    WriteDocument(writer);
+
+    Reader reader(writer.Data(), writer.Size(), true);
+    auto names = reader.RootObject().ReadStringArray(TAG_NAMES);
+    ASSERT_TRUE(names.has_value());
+
+    std::string expected;
+    for (std::string_view name : *names) {
+        expected += name.back();
+    }
+
+    // Concatenation is not commutative, so any reordering of the chunks would show
+    auto concatenate = [](std::string accumulated, std::string value) { return accumulated + value; };
+    auto last_char = [](std::string_view name) { return std::string(1, name.back()); };
+
+    for (uint32_t threads : {1u, 2u, 4u}) {
+        ThreadPool pool(threads);
+        auto result = ParallelTransformReduce(*names, std::string(), concatenate, last_char, pool, 100);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(*result, expected) << threads << " threads";
+    }
+
+    // Object arrays, with the transform taking the element index
+    auto entities = reader.RootObject().ReadObjectArray(TAG_INDEXED_ENTITIES);
+    ASSERT_TRUE(entities.has_value());
+
+    auto sum = ParallelTransformReduce(
+        *entities, uint64_t(0), [](uint64_t a, uint64_t b) { return a + b; },
+        [](uint32_t index, const ObjectReader& entity) { return uint64_t(entity.ReadUInt32(TAG_ID).value_or(0)) * index; });
+    ASSERT_TRUE(sum.has_value());
+
+    uint64_t expected_sum = 0;
+    for (uint64_t i = 0; i < ELEMENT_COUNT; i++) {
+        expected_sum += i * i;
+    }
+    EXPECT_EQ(*sum, expected_sum);
+}
+
+TEST(ParallelTest, NestedRunsAndInvalidArrays) {
+    Writer writer(true);
+    WriteDocument(writer);
+
+    Reader reader(writer.Data(), writer.Size(), true);
+    auto entities = reader.RootObject().ReadObjectArray(TAG_ENTITIES);
+    auto names = reader.RootObject().ReadStringArray(TAG_NAMES);
+    ASSERT_TRUE(entities.has_value());
+    ASSERT_TRUE(names.has_value());
+
+    // A task starting a job on its own pool runs it inline instead of deadlocking. The inner array
+    // is shared by the tasks, so it is prepared before they start.
+    names->PrepareRandomAccess();
+    ThreadPool pool(3);
+    std::atomic<uint64_t> pairs = 0;
+    bool done = ParallelForEach(
+        *entities,
+        [&](uint32_t index, const ObjectReader&) {
+            if (index % 1000 == 0) {
+                ParallelForEach(*names, [&](std::string_view) { pairs.fetch_add(1, std::memory_order_relaxed); }, pool);
+            }
+        },
+        pool, 1000);
+    ASSERT_TRUE(done);
+    EXPECT_EQ(pairs.load(), uint64_t(ELEMENT_COUNT / 1000) * ELEMENT_COUNT);
+
+    // An object array read as a string array gives an invalid reader
+    std::optional<FieldView> object_field;
+    for (const FieldView& field : reader.RootObject().Fields()) {
+        if (field.GetType() == DataType::ObjectArray) {
+            object_field = field;
+            break;
+        }
+    }
+    ASSERT_TRUE(object_field.has_value());
+    StringArrayReader wrong_type(object_field->GetEntry());
+    EXPECT_FALSE(ParallelForEach(wrong_type, [](std::string_view) {}, pool));
+    EXPECT_FALSE(ParallelTransformReduce(wrong_type, 0, [](int a, int b) { return a + b; }, [](std::string_view) { return 1; }, pool));
+}
@@ -0,0 +1,231 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#include "tbf/DataTag.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/SizeCounter.hpp"
+#include "tbf/Writer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+constexpr DataTag TAG_ID = "id";
+constexpr DataTag TAG_NAME = "name";
+constexpr DataTag TAG_SCORE = "score";
+constexpr DataTag TAG_OFFSET = "offset";
+constexpr DataTag TAG_POSITION = "position";
+constexpr DataTag TAG_COLOR = "color";
+constexpr DataTag TAG_FLAGS = "flags";
+constexpr DataTag TAG_SAMPLES = "samples";
+constexpr DataTag TAG_TIMESTAMPS = "timestamps";
+constexpr DataTag TAG_DELTAS = "deltas";
+constexpr DataTag TAG_LABELS = "labels";
+constexpr DataTag TAG_KEYS = "keys";
+constexpr DataTag TAG_BLOBS = "blobs";
+constexpr DataTag TAG_PAYLOAD = "payload";
+constexpr DataTag TAG_CHILD = "child";
+constexpr DataTag TAG_ITEMS = "items";
+
+enum class Level : int16_t { Low = 1, High = 7 };
+
+// Writes one field of every kind through either an ObjectWriter or a SizeCounter
+template <typename Object>
+void WriteEverything(Object& root) {
+    std::vector<int64_t> timestamps;
+    std::vector<uint64_t> deltas;
+    std::vector<bool> flag_values;
+    for (int64_t i = 0; i < 700; i++) {
+        timestamps.push_back(1700000000000 + i * 1000 + (i % 3));
+        deltas.push_back(static_cast<uint64_t>(i * i));
+        flag_values.push_back(i % 5 == 0);
+    }
+    bool flags[700];
+    std::copy(flag_values.begin(), flag_values.end(), flags);
+
+    const std::string_view colors[] = {"red", "green", "red", "blue", "green", "red", "red", "blue"};
+    const std::string_view keys[] = {"alpha", "bravo", "charlie", "delta"};
+    const std::string compressible(2000, 'x');
+    const uint8_t blob_a[] = {1, 2, 3};
+    const uint8_t blob_b[] = {4, 5, 6, 7, 8};
+    const void* blobs[] = {blob_a, blob_b};
+    const uint32_t blob_sizes[] = {sizeof(blob_a), sizeof(blob_b)};
+    const float position[] = {1.0f, 2.0f, 3.0f};
+    const int32_t offsets[] = {-1, 2, -3, 4};
+
+    root.FieldInt8(TAG_ID, -3);
+    root.FieldUInt64(DataTag("a_name_longer_than_the_header"), 42);
+    root.FieldVarInt64(TAG_OFFSET, -300);
+    root.FieldVarUInt64(TAG_SCORE, 1ull << 40);
+    root.FieldFloat64(DataTag(static_cast<DataTag::Id>(900)), 0.5);
+    root.FieldString(TAG_NAME, "sensor-17");
+    root.FieldEnum(DataTag("level"), Level::High);
+    root.FieldVector3f32(TAG_POSITION, position);
+    root.FieldVector3f16(TAG_POSITION, position);
+    root.FieldVector4i32(DataTag("offsets"), offsets);
+
+    root.FieldArrayFloat16(TAG_SAMPLES, position, 3);
+    root.FieldArrayInt32(TAG_SAMPLES, std::span<const int32_t>(offsets));
+    root.FieldPackedBooleanArray(TAG_FLAGS, flags, 700);
+    root.FieldVarUInt64Array(TAG_DELTAS, deltas.data(), static_cast<uint32_t>(deltas.size()));
+    root.FieldVarInt64Array(TAG_DELTAS, timestamps.data(), 16);
+    root.FieldPackedInt64Array(TAG_TIMESTAMPS, timestamps.data(), static_cast<uint32_t>(timestamps.size()));
+    root.FieldPackedInt32Array(TAG_TIMESTAMPS, offsets, 4);
+
+    root.FieldDictionaryStringArray(TAG_COLOR, colors, 8);
+    root.FieldDictionaryStringArray(TAG_KEYS, keys, 4);
+    root.FieldStringArray(TAG_KEYS, keys, 4, ArrayLayout::Indexed);
+    root.FieldBinaryArray(TAG_BLOBS, blobs, blob_sizes, 2);
+
+    root.FieldCompressedBinary(TAG_PAYLOAD, compressible.data(), compressible.size());
+    root.FieldCompressedBinary(TAG_PAYLOAD, blob_b, sizeof(blob_b));
+    root.FieldCompressed([&](auto& obj) { obj.FieldStringArray(TAG_LABELS, keys, 4); }, 0);
+
+    auto child = root.FieldObject(TAG_CHILD);
+    child.FieldBoolean(TAG_ID, true);
+    auto grandchild = child.FieldObject(TAG_CHILD);
+    grandchild.FieldString(TAG_NAME, "");
+    grandchild.Finish();
+    child.Finish();
+
+    auto labels = root.FieldStringArray(TAG_LABELS, ArrayLayout::Indexed);
+    labels.AddElement("first");
+    labels.AddElement("second");
+    labels.Finish();
+
+    auto items = root.FieldObjectArray(TAG_ITEMS, ArrayLayout::Indexed);
+    for (int32_t i = 0; i < 3; i++) {
+        auto item = items.CreateElement();
+        item.FieldInt32(TAG_ID, i);
+        auto binaries = item.FieldBinaryArray(TAG_BLOBS);
+        binaries.AddElement(blob_a, sizeof(blob_a));
+        binaries.Finish();
+        item.Finish();
+    }
+    items.Finish();
+
+    root.Finish();
+}
+
+std::vector<uint8_t> WriteGrowing(bool name_based) {
+    Writer writer(name_based);
+    WriteEverything(writer.RootObject());
+    const uint8_t* data = static_cast<const uint8_t*>(writer.Data());
+    return std::vector<uint8_t>(data, data + writer.Size());
+}
+
+}  // namespace
+
+TEST(SizeCounterTest, CountsEveryFieldType) {
+    for (bool name_based : {true, false}) {
+        SizeCounter counter(name_based);
+        WriteEverything(counter);
+
+        EXPECT_EQ(counter.Size(), WriteGrowing(name_based).size());
+    }
+}
+
+TEST(SizeCounterTest, EmptyDocument) {
+    SizeCounter counter;
+    Writer writer;
+    writer.Finish();
+
+    EXPECT_EQ(counter.Size(), writer.Size());
+}
+
+TEST(SizeCounterTest, ExactWriterMatchesGrowingWriter) {
+    for (bool name_based : {true, false}) {
+        SizeCounter counter(name_based);
+        WriteEverything(counter);
+
+        Writer writer(counter);
+        WriteEverything(writer.RootObject());
+
+        const std::vector<uint8_t> expected = WriteGrowing(name_based);
+        ASSERT_EQ(writer.Size(), expected.size());
+        EXPECT_EQ(writer.IsNameBased(), name_based);
+        EXPECT_EQ(writer.Segments().size(), 1u);
+        EXPECT_EQ(std::memcmp(writer.Data(), expected.data(), expected.size()), 0);
+    }
+}
+
+TEST(SizeCounterTest, CallerBufferIsWrittenInPlace) {
+    for (bool name_based : {true, false}) {
+        SizeCounter counter(name_based);
+        WriteEverything(counter);
+
+        std::vector<uint8_t> buffer(counter.Capacity());
+        Writer writer(std::span<uint8_t>(buffer), name_based);
+        WriteEverything(writer.RootObject());
+
+        EXPECT_EQ(writer.Data(), buffer.data());
+        buffer.resize(writer.Size());
+        EXPECT_EQ(buffer, WriteGrowing(name_based));
+    }
+}
+
+TEST(SizeCounterTest, CallerBufferTooSmallContinuesInChunks) {
+    const std::vector<uint8_t> expected = WriteGrowing(true);
+
+    std::vector<uint8_t> buffer(expected.size() / 2);
+    Writer writer{std::span<uint8_t>(buffer)};
+    WriteEverything(writer.RootObject());
+
+    ASSERT_EQ(writer.Size(), expected.size());
+    EXPECT_NE(writer.Data(), buffer.data());
+    EXPECT_EQ(std::memcmp(writer.Data(), expected.data(), expected.size()), 0);
+
+    Reader reader(writer.Data(), writer.Size(), true);
+    EXPECT_TRUE(reader.RootObject().IsValid());
+    EXPECT_EQ(reader.RootObject().ReadInt8(TAG_ID).value_or(0), -3);
+}
+
+TEST(SizeCounterTest, CompileTimeTagModes) {
+    SizeCounter name_counter(true);
+    WriteEverything(name_counter);
+    NameWriter name_writer(name_counter);
+    WriteEverything(name_writer.RootObject());
+
+    SizeCounter id_counter(false);
+    WriteEverything(id_counter);
+    std::vector<uint8_t> buffer(id_counter.Capacity());
+    IdWriter id_writer{std::span<uint8_t>(buffer)};
+    WriteEverything(id_writer.RootObject());
+    buffer.resize(id_writer.Size());
+
+    EXPECT_EQ(name_writer.Size(), name_counter.Size());
+    EXPECT_EQ(name_writer.Segments().size(), 1u);
+    EXPECT_EQ(id_writer.Data(), buffer.data());
+    EXPECT_EQ(buffer, WriteGrowing(false));
+}
@@ -0,0 +1,236 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+#include "tbf/DataTag.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Writer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+constexpr DataTag TAG_ID = "id";
+constexpr DataTag TAG_NAME = "name";
+constexpr DataTag TAG_USER = "user";
+constexpr DataTag TAG_USERS = "users";
+constexpr DataTag TAG_ALIASES = "aliases";
+constexpr DataTag TAG_BLOBS = "blobs";
+constexpr DataTag TAG_SCORES = "scores";
+
+void WriteDocument(Writer& writer) {
+    auto& root = writer.RootObject();
+    root.FieldInt32(TAG_ID, 1);
+
+    auto user = root.FieldObject(TAG_USER);
+    user.FieldString(TAG_NAME, "John");
+
+    const float scores[] = {1.0f, 2.0f, 3.0f};
+    user.FieldArrayFloat32(TAG_SCORES, scores, 3);
+    user.Finish();
+
+    auto users = root.FieldObjectArray(TAG_USERS);
+    for (int32_t i = 0; i < 3; i++) {
+        auto element = users.CreateElement();
+        element.FieldInt32(TAG_ID, i);
+
+        auto aliases = element.FieldStringArray(TAG_ALIASES);
+        aliases.AddElement("alias");
+        aliases.AddElement("");
+        aliases.Finish();
+
+        element.Finish();
+    }
+    users.Finish();
+
+    const uint8_t blob[] = {1, 2, 3};
+    auto blobs = root.FieldBinaryArray(TAG_BLOBS);
+    blobs.AddElement(blob, 3);
+    blobs.AddElement(blob, 0);
+    blobs.Finish();
+
+    writer.Finish();
+}
+
+std::vector<uint8_t> CopyBuffer(Writer& writer) {
+    const uint8_t* data = static_cast<const uint8_t*>(writer.Data());
+    return std::vector<uint8_t>(data, data + writer.Size());
+}
+
+// Position of the first occurrence of `bytes` in `buffer`
+size_t Find(const std::vector<uint8_t>& buffer, std::string_view bytes) {
+    auto it = std::search(buffer.begin(), buffer.end(), bytes.begin(), bytes.end());
+    return static_cast<size_t>(it - buffer.begin());
+}
+
+// Position of the last occurrence of `bytes` in `buffer`
+size_t FindLast(const std::vector<uint8_t>& buffer, std::string_view bytes) {
+    auto it = std::find_end(buffer.begin(), buffer.end(), bytes.begin(), bytes.end());
+    return static_cast<size_t>(it - buffer.begin());
+}
+
+// Position of the least significant byte of the `width` byte integer at `position`
+size_t LowByte(size_t position, size_t width) {
+    return TBF_ENDIANESS == std::endian::little ? position : position + width - 1;
+}
+
+// Appends `value` in the byte order of the format
+template <typename Type>
+void Append(std::vector<uint8_t>& buffer, Type value) {
+    AdjustEndianess(value);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(Type));
+}
+
+}  // namespace
+
+TEST(ValidationTest, WellFormedDocumentPasses) {
+    for (bool name_based : {true, false}) {
+        Writer writer(name_based);
+        WriteDocument(writer);
+
+        EXPECT_TRUE(Reader::Validate(writer.Data(), writer.Size(), name_based));
+
+        Reader reader(writer.Data(), writer.Size(), name_based);
+        EXPECT_TRUE(reader.Validate());
+    }
+}
+
+TEST(ValidationTest, TrustedReaderReadsValidatedDocument) {
+    for (bool name_based : {true, false}) {
+        for (IndexMode mode : {IndexMode::Eager, IndexMode::Lazy, IndexMode::Document}) {
+            Writer writer(name_based);
+            WriteDocument(writer);
+            ASSERT_TRUE(Reader::Validate(writer.Data(), writer.Size(), name_based));
+
+            TrustedReader reader(writer.Data(), writer.Size(), name_based, mode);
+            const ObjectReader& root = reader.RootObject();
+
+            EXPECT_TRUE(root.IsTrusted());
+            EXPECT_TRUE(root.IsValid());
+            EXPECT_EQ(root.ReadInt32(TAG_ID).value_or(0), 1);
+
+            auto user = root.ReadObject(TAG_USER);
+            ASSERT_TRUE(user.has_value());
+            EXPECT_EQ(user->ReadString(TAG_NAME).value_or(""), "John");
+            EXPECT_EQ(user->ReadFloat32Array(TAG_SCORES).size(), 3u);
+
+            auto users = root.ReadObjectArray(TAG_USERS);
+            ASSERT_TRUE(users.has_value());
+            ASSERT_EQ(users->Size(), 3u);
+
+            int32_t expected = 0;
+            for (const auto& element : *users) {
+                EXPECT_EQ(element.ReadInt32(TAG_ID).value_or(-1), expected++);
+
+                auto aliases = element.ReadStringArray(TAG_ALIASES);
+                ASSERT_TRUE(aliases.has_value());
+                EXPECT_EQ(aliases->Size(), 2u);
+                EXPECT_EQ(aliases->GetElement(1).value_or("?"), "");
+            }
+
+            auto blobs = root.ReadBinaryArray(TAG_BLOBS);
+            ASSERT_TRUE(blobs.has_value());
+            EXPECT_EQ(blobs->Size(), 2u);
+        }
+    }
+}
+
+TEST(ValidationTest, CorruptNestedFieldFails) {
+    Writer writer(true);
+    WriteDocument(writer);
+
+    // Type byte of the string array inside the last object array element
+    std::vector<uint8_t> data = CopyBuffer(writer);
+    size_t type_byte = FindLast(data, TAG_ALIASES.GetName()) - 2;
+    ASSERT_EQ(data[type_byte], static_cast<uint8_t>(DataType::StringArray));
+    data[type_byte] = 0xEE;
+
+    // The root object itself still parses, only the full validation sees the corruption
+    Reader reader(data.data(), data.size(), true);
+    EXPECT_TRUE(reader.IsValid());
+    EXPECT_FALSE(reader.Validate());
+    EXPECT_FALSE(Reader::Validate(data.data(), data.size(), true));
+}
+
+TEST(ValidationTest, MalformedArraysFail) {
+    Writer writer(true);
+    WriteDocument(writer);
+    const std::vector<uint8_t> original = CopyBuffer(writer);
+
+    // Float array whose byte size is not a multiple of the element size
+    std::vector<uint8_t> data = original;
+    size_t scores_size = LowByte(Find(data, "scores") + TAG_SCORES.GetName().size(), sizeof(uint32_t));
+    ASSERT_EQ(data[scores_size], 12u);
+    data[scores_size] = 11;
+    EXPECT_FALSE(Reader::Validate(data.data(), data.size(), true));
+
+    // String array element longer than the array
+    data = original;
+    size_t alias_length = LowByte(Find(data, std::string_view("alias\0\0", 7)) - sizeof(uint16_t), sizeof(uint16_t));
+    ASSERT_EQ(data[alias_length], 5u);
+    data[alias_length] = 6;
+    EXPECT_FALSE(Reader::Validate(data.data(), data.size(), true));
+
+    // Truncated document
+    EXPECT_FALSE(Reader::Validate(original.data(), original.size() - 1, true));
+    EXPECT_FALSE(Reader::Validate(original.data(), 2, true));
+}
+
+TEST(ValidationTest, NestingDepthIsLimited) {
+    constexpr DataTag::Id TAG = 7;
+
+    // ID-based document of `depth` objects nested in each other around an Int8 field
+    auto nested_document = [](uint32_t depth) {
+        std::vector<uint8_t> object = {static_cast<uint8_t>(DataType::Int8)};
+        Append(object, TAG);
+        object.push_back(42);
+
+        for (uint32_t i = 0; i < depth; i++) {
+            std::vector<uint8_t> parent = {static_cast<uint8_t>(DataType::Object)};
+            Append(parent, TAG);
+            Append(parent, static_cast<uint32_t>(object.size()));
+            parent.insert(parent.end(), object.begin(), object.end());
+            object = std::move(parent);
+        }
+
+        std::vector<uint8_t> document;
+        Append(document, static_cast<uint32_t>(object.size()));
+        document.insert(document.end(), object.begin(), object.end());
+        return document;
+    };
+
+    std::vector<uint8_t> deepest = nested_document(Reader::MAX_VALIDATION_DEPTH);
+    EXPECT_TRUE(Reader::Validate(deepest.data(), deepest.size(), false));
+
+    std::vector<uint8_t> too_deep = nested_document(Reader::MAX_VALIDATION_DEPTH + 1);
+    EXPECT_FALSE(Reader::Validate(too_deep.data(), too_deep.size(), false));
+}
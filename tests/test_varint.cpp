@@ -0,0 +1,223 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+
+#include "tbf/DataTag.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/Varint.hpp"
+#include "tbf/Writer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+constexpr DataTag TAG_ID = "id";
+constexpr DataTag TAG_DELTA = "delta";
+constexpr DataTag TAG_IDS = "ids";
+constexpr DataTag TAG_OFFSETS = "offsets";
+
+// Mostly one byte values with longer ones mixed in, so the bulk decoder switches between paths
+std::vector<uint64_t> MixedValues(size_t count, uint32_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<uint64_t> values(count);
+    for (uint64_t& value : values) {
+        const uint64_t kind = rng() % 16;
+        if (kind < 12) {
+            value = rng() % 128;
+        } else if (kind < 15) {
+            value = rng() >> (rng() % 64);
+        } else {
+            value = std::numeric_limits<uint64_t>::max() - rng() % 4;
+        }
+    }
+    return values;
+}
+
+}  // namespace
+
+TEST(VarintTest, EncodeAndDecodeSingleValues) {
+    const uint64_t values[] = {0, 1, 127, 128, 300, 16383, 16384, 1ull << 56, 1ull << 63, std::numeric_limits<uint64_t>::max()};
+    for (uint64_t value : values) {
+        uint8_t encoded[MAX_VARINT_SIZE];
+        const uint32_t size = EncodeVarint(value, encoded);
+        EXPECT_EQ(size, VarintSize(value)) << value;
+
+        uint64_t decoded = 0;
+        EXPECT_EQ(DecodeVarint(encoded, encoded + size, decoded), size) << value;
+        EXPECT_EQ(decoded, value);
+        EXPECT_EQ(DecodeVarint(encoded, encoded + size - 1, decoded), 0u) << "truncated " << value;
+    }
+
+    EXPECT_EQ(ZigZagEncode(0), 0u);
+    EXPECT_EQ(ZigZagEncode(-1), 1u);
+    EXPECT_EQ(ZigZagEncode(1), 2u);
+    EXPECT_EQ(ZigZagEncode(std::numeric_limits<int64_t>::min()), std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(ZigZagDecode(ZigZagEncode(-123456789)), -123456789);
+
+    // More than 64 bits
+    const uint8_t overflow[] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02};
+    uint64_t decoded;
+    EXPECT_EQ(DecodeVarint(overflow, overflow + sizeof(overflow), decoded), 0u);
+}
+
+TEST(VarintTest, BulkDecodeMatchesScalar) {
+    for (size_t count : {0, 1, 15, 16, 17, 100, 10000}) {
+        const std::vector<uint64_t> values = MixedValues(count, static_cast<uint32_t>(count));
+
+        std::vector<uint8_t> encoded(count * MAX_VARINT_SIZE);
+        encoded.resize(EncodeVarints(values.data(), count, encoded.data()));
+        EXPECT_TRUE(ValidateVarints(encoded.data(), encoded.size(), count));
+
+        std::vector<uint64_t> decoded(count);
+        ASSERT_TRUE(DecodeVarints(encoded.data(), encoded.size(), decoded.data(), count)) << count;
+        EXPECT_EQ(decoded, values);
+
+        // The values must fill the data exactly
+        if (count > 0) {
+            EXPECT_FALSE(DecodeVarints(encoded.data(), encoded.size(), decoded.data(), count - 1));
+            EXPECT_FALSE(DecodeVarints(encoded.data(), encoded.size() - 1, decoded.data(), count));
+            EXPECT_FALSE(ValidateVarints(encoded.data(), encoded.size() - 1, count));
+        }
+    }
+
+    // A run of one byte values long enough for the vector path
+    std::vector<int64_t> small(40);
+    for (size_t i = 0; i < small.size(); i++) {
+        small[i] = static_cast<int64_t>(i % 2 == 0 ? i : -static_cast<int64_t>(i)) / 2;
+    }
+    std::vector<uint8_t> encoded(small.size() * MAX_VARINT_SIZE);
+    encoded.resize(EncodeZigZagVarints(small.data(), small.size(), encoded.data()));
+    EXPECT_EQ(encoded.size(), small.size());
+
+    std::vector<int64_t> decoded(small.size());
+    ASSERT_TRUE(DecodeZigZagVarints(encoded.data(), encoded.size(), decoded.data(), decoded.size()));
+    EXPECT_EQ(decoded, small);
+
+    // Values of two to four bytes, with the lengths mixed so they cross the shuffle table window
+    std::mt19937_64 rng(4);
+    std::vector<uint64_t> medium(1000);
+    for (uint64_t& value : medium) {
+        const uint32_t length = 1 + static_cast<uint32_t>(rng() % 4);
+        value = rng() >> (64 - 7 * length);
+    }
+    std::vector<uint8_t> medium_encoded(medium.size() * MAX_VARINT_SIZE);
+    medium_encoded.resize(EncodeVarints(medium.data(), medium.size(), medium_encoded.data()));
+
+    std::vector<uint64_t> medium_decoded(medium.size());
+    ASSERT_TRUE(DecodeVarints(medium_encoded.data(), medium_encoded.size(), medium_decoded.data(), medium.size()));
+    EXPECT_EQ(medium_decoded, medium);
+
+    // Leaving a value in the middle unterminated makes the lengths no longer add up
+    size_t terminator = 0;
+    for (size_t i = 0; i <= medium.size() / 2; i++) {
+        terminator += VarintSize(medium[i]);
+    }
+    medium_encoded[terminator - 1] |= 0x80;
+    EXPECT_FALSE(DecodeVarints(medium_encoded.data(), medium_encoded.size(), medium_decoded.data(), medium.size()));
+}
+
+TEST(VarintTest, VarintFieldsReadWrite) {
+    std::vector<uint64_t> ids = MixedValues(1000, 7);
+    std::vector<int64_t> offsets(1000);
+    for (size_t i = 0; i < offsets.size(); i++) {
+        offsets[i] = static_cast<int64_t>(i % 7) - 3;
+    }
+
+    Writer writer(false);
+    auto& root = writer.RootObject();
+    root.FieldVarUInt64(TAG_ID, 42);
+    root.FieldVarInt64(TAG_DELTA, -70000);
+    root.FieldVarUInt64Array(TAG_IDS, ids);
+    root.FieldVarInt64Array(TAG_OFFSETS, offsets);
+    writer.Finish();
+
+    EXPECT_TRUE(Reader::Validate(writer.Data(), writer.Size(), false));
+
+    Reader reader(writer.Data(), writer.Size(), false);
+    const auto& read_root = reader.RootObject();
+
+    EXPECT_EQ(read_root.ReadVarUInt64(TAG_ID), 42u);
+    EXPECT_EQ(read_root.ReadVarInt64(TAG_DELTA), -70000);
+    EXPECT_FALSE(read_root.ReadInt64(TAG_DELTA).has_value());
+    EXPECT_FALSE(read_root.ReadVarUInt64(TAG_DELTA).has_value());
+
+    auto id_array = read_root.ReadVarUInt64Array(TAG_IDS);
+    ASSERT_TRUE(id_array.has_value() && id_array->IsValid());
+    ASSERT_EQ(id_array->Size(), ids.size());
+
+    std::vector<uint64_t> read_ids(ids.size());
+    ASSERT_TRUE(id_array->Decode(std::span<uint64_t>(read_ids)));
+    EXPECT_EQ(read_ids, ids);
+
+    std::vector<int64_t> wrong_sign(ids.size());
+    EXPECT_FALSE(id_array->Decode(std::span<int64_t>(wrong_sign)));
+
+    // One byte per offset instead of eight
+    std::vector<int64_t> read_offsets(offsets.size());
+    EXPECT_EQ(read_root.ReadVarInt64Array(TAG_OFFSETS)->Encoded().size(), offsets.size());
+    EXPECT_EQ(read_root.ReadVarInt64Array(TAG_OFFSETS, std::span<int64_t>(read_offsets)), offsets.size());
+    EXPECT_EQ(read_offsets, offsets);
+
+    std::vector<int64_t> too_small(offsets.size() - 1);
+    EXPECT_FALSE(read_root.ReadVarInt64Array(TAG_OFFSETS, std::span<int64_t>(too_small)).has_value());
+
+    // Fields of the document can be visited and bound like fixed size integers
+    struct Header {
+        uint64_t id;
+        int64_t delta;
+    };
+    Header header{};
+    auto result = read_root.ReadFields(header, Bind<DataType::VarUInt64>(TAG_ID, &Header::id),
+                                       Bind<DataType::VarInt64>(TAG_DELTA, &Header::delta));
+    EXPECT_TRUE(result.Complete());
+    EXPECT_EQ(header.id, 42u);
+    EXPECT_EQ(header.delta, -70000);
+}
+
+TEST(VarintTest, TruncatedVarintArrayIsInvalid) {
+    const uint64_t values[] = {1, 2, 300};
+
+    Writer writer(false);
+    writer.RootObject().FieldVarUInt64Array(TAG_IDS, values, 3);
+    writer.Finish();
+
+    const uint8_t* begin = static_cast<const uint8_t*>(writer.Data());
+    std::vector<uint8_t> data(begin, begin + writer.Size());
+
+    // The last byte ends the varint of 300, setting its continuation bit leaves it unterminated
+    ASSERT_EQ(data.back(), 300 >> 7);
+    data.back() |= 0x80;
+    EXPECT_FALSE(Reader::Validate(data.data(), data.size(), false));
+
+    Reader reader(data.data(), data.size(), false);
+    std::vector<uint64_t> decoded(3);
+    EXPECT_FALSE(reader.RootObject().ReadVarUInt64Array(TAG_IDS, std::span<uint64_t>(decoded)).has_value());
+}
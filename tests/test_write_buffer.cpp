@@ -0,0 +1,236 @@
+/*  ==============================================================================
+ *  Tagged Binary Format (TBF) - www.electrodiux.com
+ *  ------------------------------------------------------------------------------
+ *  Copyright (c) 2026 Electrodiux. All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  ==============================================================================
+ */
+#include "tbf/DataTag.hpp"
+#include "tbf/Reader.hpp"
+#include "tbf/WriteBuffer.hpp"
+#include "tbf/Writer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace tbf;
+
+namespace {
+
+constexpr DataTag TAG_ITEMS = "items";
+constexpr DataTag TAG_INDEX = "index";
+constexpr DataTag TAG_NAME = "name";
+constexpr DataTag TAG_BYTES = "bytes";
+constexpr DataTag TAG_COUNT = "count";
+
+std::vector<uint8_t> Concatenate(const std::vector<std::span<const uint8_t>>& segments) {
+    std::vector<uint8_t> data;
+    for (std::span<const uint8_t> segment : segments) {
+        data.insert(data.end(), segment.begin(), segment.end());
+    }
+    return data;
+}
+
+// Objects of a few fields each, enough of them to fill several chunks of the smallest size
+void WriteItems(Writer& writer, uint32_t count) {
+    std::vector<uint8_t> bytes(300);
+    for (size_t i = 0; i < bytes.size(); i++) {
+        bytes[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    auto& root = writer.RootObject();
+    auto items = root.FieldObjectArray(TAG_ITEMS, ArrayLayout::Indexed);
+    for (uint32_t i = 0; i < count; i++) {
+        ObjectWriter item = items.CreateElement();
+        item.FieldUInt32(TAG_INDEX, i);
+        item.FieldString(TAG_NAME, "item-" + std::to_string(i));
+        item.FieldArrayUInt8(TAG_BYTES, bytes.data(), static_cast<uint32_t>(i % bytes.size()));
+        item.Finish();
+    }
+    items.Finish();
+    root.FieldUInt32(TAG_COUNT, count);
+}
+
+void ExpectItems(const void* data, size_t size, bool name_based, uint32_t count) {
+    ASSERT_TRUE(Reader::Validate(data, size, name_based));
+
+    Reader reader(data, size, name_based);
+    const auto& root = reader.RootObject();
+    EXPECT_EQ(root.ReadUInt32(TAG_COUNT).value_or(0), count);
+
+    auto items = root.ReadObjectArray(TAG_ITEMS);
+    ASSERT_TRUE(items.has_value() && items->IsValid());
+    ASSERT_EQ(items->Size(), count);
+    for (uint32_t i = 0; i < count; i += 7) {
+        auto item = items->GetElement(i);
+        ASSERT_TRUE(item.has_value());
+        EXPECT_EQ(item->ReadUInt32(TAG_INDEX).value_or(count), i);
+        EXPECT_EQ(item->ReadString(TAG_NAME).value_or(""), "item-" + std::to_string(i));
+
+        uint32_t length = 0;
+        const uint8_t* bytes = item->ReadUInt8Array(TAG_BYTES, length);
+        ASSERT_EQ(length, i % 300);
+        for (uint32_t j = 0; j < length; j++) {
+            ASSERT_EQ(bytes[j], static_cast<uint8_t>(j * 7));
+        }
+    }
+}
+
+}  // namespace
+
+TEST(WriteBufferTest, AppendsAcrossChunks) {
+    WriteBuffer buffer(64);
+    std::vector<uint8_t> expected;
+
+    for (uint32_t i = 0; i < 500; i++) {
+        std::vector<uint8_t> piece(i % 37 + (i % 50 == 0 ? 500 : 0));
+        for (size_t j = 0; j < piece.size(); j++) {
+            piece[j] = static_cast<uint8_t>(i + j);
+        }
+
+        const BufferOffset offset = buffer.Size();
+        buffer.Append(piece.data(), piece.size());
+        expected.insert(expected.end(), piece.begin(), piece.end());
+
+        // What a single Append wrote is contiguous
+        if (!piece.empty()) {
+            EXPECT_EQ(buffer.Contiguous(offset, piece.size()), buffer.Pointer(offset));
+            EXPECT_EQ(std::memcmp(buffer.Pointer(offset), piece.data(), piece.size()), 0);
+        }
+    }
+    ASSERT_EQ(buffer.Size(), expected.size());
+
+    // Chunks double up to the size written so far, so there are a few of them and never one per write
+    const auto segments = buffer.Segments();
+    EXPECT_GT(segments.size(), 3u);
+    EXPECT_LT(segments.size(), 20u);
+    EXPECT_EQ(Concatenate(segments), expected);
+
+    // Patches and reads by offset, including ranges over chunk boundaries
+    size_t boundary = segments[0].size();
+    const uint8_t patch[] = {0xA1, 0xB2, 0xC3, 0xD4};
+    std::memcpy(buffer.Pointer(boundary - 300), patch, sizeof(patch));
+    std::memcpy(expected.data() + boundary - 300, patch, sizeof(patch));
+
+    std::vector<uint8_t> range(100);
+    buffer.Read(boundary - 50, range.data(), range.size());
+    EXPECT_TRUE(std::equal(range.begin(), range.end(), expected.begin() + static_cast<std::ptrdiff_t>(boundary - 50)));
+    EXPECT_EQ(buffer.Contiguous(boundary - 50, range.size()), nullptr);
+
+    std::vector<uint8_t> copy(buffer.Size());
+    buffer.CopyTo(copy.data());
+    EXPECT_EQ(copy, expected);
+
+    // Coalescing keeps the contents, and writing goes on into a new chunk
+    const uint8_t* data = buffer.Data();
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), data));
+    EXPECT_EQ(buffer.Segments().size(), 1u);
+
+    buffer.Append(patch, sizeof(patch));
+    expected.insert(expected.end(), std::begin(patch), std::end(patch));
+    EXPECT_EQ(Concatenate(buffer.Segments()), expected);
+}
+
+TEST(WriteBufferTest, TruncateReleasesChunks) {
+    WriteBuffer buffer(64);
+    std::vector<uint8_t> expected;
+    for (uint32_t i = 0; i < 2000; i++) {
+        const uint8_t byte = static_cast<uint8_t>(i);
+        buffer.Append(&byte, 1);
+        expected.push_back(byte);
+    }
+    const size_t chunk_count = buffer.Segments().size();
+    ASSERT_GT(chunk_count, 2u);
+
+    buffer.Truncate(100);
+    expected.resize(100);
+    EXPECT_EQ(buffer.Size(), 100u);
+    EXPECT_LT(buffer.Segments().size(), chunk_count);
+    EXPECT_EQ(Concatenate(buffer.Segments()), expected);
+
+    // Truncating past the end does nothing
+    buffer.Truncate(1000);
+    EXPECT_EQ(buffer.Size(), 100u);
+
+    std::vector<uint8_t> large(5000, 0x5A);
+    buffer.Append(large.data(), large.size());
+    expected.insert(expected.end(), large.begin(), large.end());
+    EXPECT_EQ(Concatenate(buffer.Segments()), expected);
+}
+
+TEST(WriteBufferTest, DocumentsSpanningChunks) {
+    constexpr uint32_t ITEM_COUNT = 2000;
+
+    for (bool name_based : {true, false}) {
+        Writer writer(name_based, 1024);
+        WriteItems(writer, ITEM_COUNT);
+        writer.Finish();
+
+        // The sizes patched into objects and arrays count the bytes of every chunk they span
+        const auto segments = writer.Segments();
+        EXPECT_GT(segments.size(), 5u);
+        const std::vector<uint8_t> streamed = Concatenate(segments);
+        ASSERT_EQ(streamed.size(), writer.Size());
+        ExpectItems(streamed.data(), streamed.size(), name_based, ITEM_COUNT);
+
+        const uint8_t* data = static_cast<const uint8_t*>(writer.Data());
+        EXPECT_TRUE(std::equal(streamed.begin(), streamed.end(), data));
+        ExpectItems(data, writer.Size(), name_based, ITEM_COUNT);
+    }
+}
+
+TEST(WriteBufferTest, CompressedFieldsSpanningChunks) {
+    constexpr uint32_t ITEM_COUNT = 1000;
+
+    for (bool name_based : {true, false}) {
+        Writer writer(name_based, 1024);
+        writer.RootObject().FieldCompressed([&](ObjectWriter& obj) {
+            ObjectWriter nested = obj.FieldObject(TAG_ITEMS);
+            for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+                nested.FieldString(name_based ? DataTag(std::string_view("text")) : DataTag(static_cast<DataTag::Id>(1)),
+                                   "a string written over and over");
+            }
+            nested.Finish();
+        });
+        writer.RootObject().FieldUInt32(TAG_COUNT, ITEM_COUNT);
+        writer.Finish();
+
+        ASSERT_LT(writer.Size(), ITEM_COUNT * 8u);
+        const std::vector<uint8_t> streamed = Concatenate(writer.Segments());
+        ASSERT_TRUE(Reader::Validate(streamed.data(), streamed.size(), name_based));
+
+        Reader reader(streamed.data(), streamed.size(), name_based);
+        const auto& root = reader.RootObject();
+        EXPECT_EQ(root.GetCompressedType(TAG_ITEMS), DataType::Object);
+        EXPECT_EQ(root.ReadUInt32(TAG_COUNT).value_or(0), ITEM_COUNT);
+
+        std::vector<uint8_t> scratch;
+        auto items = root.ReadCompressed(TAG_ITEMS, scratch);
+        ASSERT_TRUE(items.has_value() && items->IsValid());
+        auto nested = items->ReadObject(TAG_ITEMS);
+        ASSERT_TRUE(nested.has_value());
+        EXPECT_EQ(nested->GetAllTags().size(), 1u);
+    }
+}